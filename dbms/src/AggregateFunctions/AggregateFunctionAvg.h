@@ -48,6 +48,34 @@ class AggregateFunctionAvg final
     PrecType result_prec;
     ScaleType result_scale;
 
+    using ColVecType = std::conditional_t<IsDecimal<T>, ColumnDecimal<T>, ColumnVector<T>>;
+    using SumType = std::conditional_t<IsDecimal<T>, TResult, typename NearestFieldType<T>::Type>;
+    using Data = AggregateFunctionAvgData<SumType>;
+
+    /// clang cannot vectorize the loop if accumulator is class member instead of local variable.
+    static void NO_SANITIZE_UNDEFINED NO_INLINE addMany(Data & data, const T * __restrict ptr, size_t count)
+    {
+        SumType local_sum{};
+        for (size_t i = 0; i < count; ++i)
+            local_sum += ptr[i];
+        data.sum += local_sum;
+        data.count += count;
+    }
+
+    static void NO_SANITIZE_UNDEFINED NO_INLINE addManyNotNull(Data & data, const T * __restrict ptr, const UInt8 * __restrict null_map, size_t count)
+    {
+        SumType local_sum{};
+        size_t not_null_count = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!null_map[i])
+                local_sum += ptr[i];
+            not_null_count += !null_map[i];
+        }
+        data.sum += local_sum;
+        data.count += not_null_count;
+    }
+
 public:
     AggregateFunctionAvg() = default;
     AggregateFunctionAvg(PrecType prec_, ScaleType scale_, PrecType result_prec_, ScaleType result_scale_)
@@ -77,6 +105,62 @@ public:
         ++this->data(place).count;
     }
 
+    bool isInvertible() const override { return true; }
+
+    void decrease(AggregateDataPtr __restrict place, const IColumn ** columns, size_t row_num, Arena *) const override
+    {
+        const auto & value = assert_cast<const ColVecType &>(*columns[0]).getData()[row_num];
+        if constexpr (IsDecimal<T>)
+            this->data(place).sum.value -= static_cast<typename SumType::NativeType>(value.value);
+        else
+            this->data(place).sum -= value;
+        --this->data(place).count;
+    }
+
+    /// Vectorized version when there is no GROUP BY keys.
+    void addBatchSinglePlace(
+        size_t batch_size,
+        AggregateDataPtr place,
+        const IColumn ** columns,
+        Arena * arena,
+        ssize_t if_argument_pos) const override
+    {
+        if (if_argument_pos >= 0)
+        {
+            const auto & flags = assert_cast<const ColumnUInt8 &>(*columns[if_argument_pos]).getData();
+            for (size_t i = 0; i < batch_size; ++i)
+            {
+                if (flags[i])
+                    add(place, columns, i, arena);
+            }
+        }
+        else
+        {
+            addMany(this->data(place), assert_cast<const ColVecType &>(*columns[0]).getData().data(), batch_size);
+        }
+    }
+
+    void addBatchSinglePlaceNotNull(
+        size_t batch_size,
+        AggregateDataPtr place,
+        const IColumn ** columns,
+        const UInt8 * null_map,
+        Arena * arena,
+        ssize_t if_argument_pos) const override
+    {
+        if (if_argument_pos >= 0)
+        {
+            const auto & flags = assert_cast<const ColumnUInt8 &>(*columns[if_argument_pos]).getData();
+            for (size_t i = 0; i < batch_size; ++i)
+                if (!null_map[i] && flags[i])
+                    add(place, columns, i, arena);
+        }
+        else
+        {
+            addManyNotNull(this->data(place), assert_cast<const ColVecType &>(*columns[0]).getData().data(), null_map, batch_size);
+        }
+    }
+
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs, Arena *) const override
     {
         this->data(place).sum += this->data(rhs).sum;
@@ -112,7 +196,6 @@ public:
 
     void create(AggregateDataPtr __restrict place) const override
     {
-        using Data = AggregateFunctionAvgData<std::conditional_t<IsDecimal<T>, TResult, typename NearestFieldType<T>::Type>>;
         new (place) Data;
     }
 
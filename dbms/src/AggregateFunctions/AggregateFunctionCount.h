@@ -54,6 +54,13 @@ public:
         ++data(place).count;
     }
 
+    bool isInvertible() const override { return true; }
+
+    void decrease(AggregateDataPtr __restrict place, const IColumn **, size_t, Arena *) const override
+    {
+        --data(place).count;
+    }
+
     void addBatchSinglePlace(
         size_t batch_size,
         AggregateDataPtr place,
@@ -145,6 +152,25 @@ public:
         data(place).count += !static_cast<const ColumnNullable &>(*columns[0]).isNullAt(row_num);
     }
 
+    void addBatchSinglePlace(
+        size_t batch_size,
+        AggregateDataPtr place,
+        const IColumn ** columns,
+        Arena *,
+        ssize_t if_argument_pos) const override
+    {
+        const auto & null_map = assert_cast<const ColumnNullable &>(*columns[0]).getNullMapData();
+        if (if_argument_pos >= 0)
+        {
+            const auto & flags = assert_cast<const ColumnUInt8 &>(*columns[if_argument_pos]).getData();
+            data(place).count += countBytesInFilterWithNull(flags, null_map.data());
+        }
+        else
+        {
+            data(place).count += batch_size - countBytesInFilter(null_map.data(), batch_size);
+        }
+    }
+
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs, Arena *) const override
     {
         data(place).count += data(rhs).count;
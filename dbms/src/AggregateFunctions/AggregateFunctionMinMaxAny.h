@@ -36,6 +36,8 @@ namespace DB
 template <typename T>
 struct SingleValueDataFixed
 {
+    static constexpr bool is_fixed = true;
+
 private:
     using Self = SingleValueDataFixed<T>;
 
@@ -180,6 +182,72 @@ public:
     {
         return has() && static_cast<const ColumnType &>(column).getData()[row_num] == value;
     }
+
+    /// Vectorized versions of changeIfLess/changeIfGreater over a whole batch.
+    /// Rows with null_map[i] != 0 or flags[i] == 0 are skipped when the corresponding pointer is not null.
+    void changeIfLessMany(const IColumn & column, const UInt8 * null_map, const UInt8 * flags, size_t batch_size)
+    {
+        changeManyIf<true>(column, null_map, flags, batch_size);
+    }
+
+    void changeIfGreaterMany(const IColumn & column, const UInt8 * null_map, const UInt8 * flags, size_t batch_size)
+    {
+        changeManyIf<false>(column, null_map, flags, batch_size);
+    }
+
+private:
+    template <bool is_less>
+    void changeManyIf(const IColumn & column, const UInt8 * null_map, const UInt8 * flags, size_t batch_size)
+    {
+        if (null_map && flags)
+            changeManyIfImpl<is_less, true, true>(column, null_map, flags, batch_size);
+        else if (null_map)
+            changeManyIfImpl<is_less, true, false>(column, null_map, flags, batch_size);
+        else if (flags)
+            changeManyIfImpl<is_less, false, true>(column, null_map, flags, batch_size);
+        else
+            changeManyIfImpl<is_less, false, false>(column, null_map, flags, batch_size);
+    }
+
+    template <bool has_null_map, bool has_flags>
+    static bool ALWAYS_INLINE isSelected(const UInt8 * __restrict null_map, const UInt8 * __restrict flags, size_t i)
+    {
+        bool selected = true;
+        if constexpr (has_null_map)
+            selected &= !null_map[i];
+        if constexpr (has_flags)
+            selected &= flags[i] != 0;
+        return selected;
+    }
+
+    template <bool is_less, bool has_null_map, bool has_flags>
+    void NO_INLINE changeManyIfImpl(const IColumn & column, const UInt8 * __restrict null_map, const UInt8 * __restrict flags, size_t batch_size)
+    {
+        const T * __restrict ptr = static_cast<const ColumnType &>(column).getData().data();
+        size_t i = 0;
+        if (!has())
+        {
+            while (i < batch_size && !isSelected<has_null_map, has_flags>(null_map, flags, i))
+                ++i;
+            if (i == batch_size)
+                return;
+            has_value = true;
+            value = ptr[i++];
+        }
+
+        /// clang cannot vectorize the loop if accumulator is class member instead of local variable.
+        T local = value;
+        for (; i < batch_size; ++i)
+        {
+            bool better;
+            if constexpr (is_less)
+                better = ptr[i] < local;
+            else
+                better = ptr[i] > local;
+            local = (better && isSelected<has_null_map, has_flags>(null_map, flags, i)) ? ptr[i] : local;
+        }
+        value = local;
+    }
 };
 
 
@@ -188,6 +256,8 @@ public:
   */
 struct SingleValueDataString
 {
+    static constexpr bool is_fixed = false;
+
 private:
     using Self = SingleValueDataString;
 
@@ -443,6 +513,8 @@ static_assert(
 /// For any other value types.
 struct SingleValueDataGeneric
 {
+    static constexpr bool is_fixed = false;
+
 private:
     using Self = SingleValueDataGeneric;
 
@@ -622,6 +694,13 @@ struct AggregateFunctionMinData : Data
     bool changeIfBetter(const IColumn & column, size_t row_num, Arena * arena) { return this->changeIfLess(column, row_num, arena); }
     bool changeIfBetter(const Self & to, Arena * arena) { return this->changeIfLess(to, arena); }
 
+    void changeIfBetterMany(const IColumn & column, const UInt8 * null_map, const UInt8 * flags, size_t batch_size)
+    {
+        this->changeIfLessMany(column, null_map, flags, batch_size);
+    }
+
+    static constexpr bool support_batch = Data::is_fixed;
+
     static const char * name() { return "min"; }
 };
 
@@ -633,6 +712,13 @@ struct AggregateFunctionMaxData : Data
     bool changeIfBetter(const IColumn & column, size_t row_num, Arena * arena) { return this->changeIfGreater(column, row_num, arena); }
     bool changeIfBetter(const Self & to, Arena * arena) { return this->changeIfGreater(to, arena); }
 
+    void changeIfBetterMany(const IColumn & column, const UInt8 * null_map, const UInt8 * flags, size_t batch_size)
+    {
+        this->changeIfGreaterMany(column, null_map, flags, batch_size);
+    }
+
+    static constexpr bool support_batch = Data::is_fixed;
+
     static const char * name() { return "max"; }
 };
 
@@ -737,12 +823,27 @@ struct AggregateFunctionAnyHeavyData : Data
 };
 
 
+/// Whether Data provides changeIfBetterMany, see AggregateFunctionMinData and AggregateFunctionMaxData.
+template <typename Data, typename = void>
+struct SupportBatchChange : std::false_type
+{
+};
+
+template <typename Data>
+struct SupportBatchChange<Data, std::void_t<decltype(Data::support_batch)>> : std::bool_constant<Data::support_batch>
+{
+};
+
 template <typename Data>
 class AggregateFunctionsSingleValue final : public IAggregateFunctionDataHelper<Data, AggregateFunctionsSingleValue<Data>, true>
 {
 private:
+    using Base = IAggregateFunctionDataHelper<Data, AggregateFunctionsSingleValue<Data>, true>;
+
     DataTypePtr type;
 
+    static constexpr bool support_batch = SupportBatchChange<Data>::value;
+
 public:
     explicit AggregateFunctionsSingleValue(const DataTypePtr & type)
         : type(type)
@@ -769,6 +870,48 @@ public:
         this->data(place).changeIfBetter(*columns[0], row_num, arena);
     }
 
+    /// Vectorized version of min/max over fixed size values when there is no GROUP BY keys.
+    void addBatchSinglePlace(
+        size_t batch_size,
+        AggregateDataPtr place,
+        const IColumn ** columns,
+        Arena * arena,
+        ssize_t if_argument_pos) const override
+    {
+        if constexpr (support_batch)
+        {
+            const UInt8 * flags = nullptr;
+            if (if_argument_pos >= 0)
+                flags = assert_cast<const ColumnUInt8 &>(*columns[if_argument_pos]).getData().data();
+            this->data(place).changeIfBetterMany(*columns[0], nullptr, flags, batch_size);
+        }
+        else
+        {
+            Base::addBatchSinglePlace(batch_size, place, columns, arena, if_argument_pos);
+        }
+    }
+
+    void addBatchSinglePlaceNotNull(
+        size_t batch_size,
+        AggregateDataPtr place,
+        const IColumn ** columns,
+        const UInt8 * null_map,
+        Arena * arena,
+        ssize_t if_argument_pos) const override
+    {
+        if constexpr (support_batch)
+        {
+            const UInt8 * flags = nullptr;
+            if (if_argument_pos >= 0)
+                flags = assert_cast<const ColumnUInt8 &>(*columns[if_argument_pos]).getData().data();
+            this->data(place).changeIfBetterMany(*columns[0], null_map, flags, batch_size);
+        }
+        else
+        {
+            Base::addBatchSinglePlaceNotNull(batch_size, place, columns, null_map, arena, if_argument_pos);
+        }
+    }
+
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs, Arena * arena) const override
     {
         this->data(place).changeIfBetter(this->data(rhs), arena);
@@ -442,6 +442,46 @@ public:
         }
     }
 
+    void addBatch( // NOLINT(google-default-arguments)
+        size_t batch_size,
+        AggregateDataPtr * places,
+        size_t place_offset,
+        const IColumn ** columns,
+        Arena * arena,
+        ssize_t if_argument_pos = -1) const override
+    {
+        const UInt8 * flags = nullptr;
+        if (if_argument_pos >= 0)
+            flags = assert_cast<const ColumnUInt8 &>(*columns[if_argument_pos]).getData().data();
+
+        if constexpr (input_is_nullable)
+        {
+            /// Resolve the nested column and null map once per batch instead of once per row.
+            const auto * column = assert_cast<const ColumnNullable *>(columns[0]);
+            const IColumn * nested_column = &column->getNestedColumn();
+            const UInt8 * null_map = column->getNullMapData().data();
+            for (size_t i = 0; i < batch_size; ++i)
+            {
+                if (places[i] && !null_map[i] && (!flags || flags[i]))
+                {
+                    AggregateDataPtr place = places[i] + place_offset;
+                    this->setFlag(place);
+                    this->nested_function->add(this->nestedPlace(place), &nested_column, i, arena);
+                }
+            }
+        }
+        else
+        {
+            if constexpr (result_is_nullable)
+            {
+                for (size_t i = 0; i < batch_size; ++i)
+                    if (places[i] && (!flags || flags[i]))
+                        this->setFlag(places[i] + place_offset);
+            }
+            this->nested_function->addBatch(batch_size, places, place_offset + this->prefix_size, columns, arena, if_argument_pos);
+        }
+    }
+
     void addBatchSinglePlace( // NOLINT(google-default-arguments)
         size_t batch_size,
         AggregateDataPtr place,
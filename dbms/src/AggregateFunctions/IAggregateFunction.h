@@ -109,6 +109,17 @@ public:
     /// Inserts results into a column.
     virtual void insertResultInto(ConstAggregateDataPtr __restrict place, IColumn & to, Arena * arena) const = 0;
 
+    /// Returns true if a function supports `decrease`, which is the inverse of `add`.
+    virtual bool isInvertible() const { return false; }
+
+    /** Removes a value that has been added by `add` from the aggregation data.
+      * It is used by the aggregate window functions to slide the frame without recalculating the whole frame.
+      */
+    virtual void decrease(AggregateDataPtr __restrict /*place*/, const IColumn ** /*columns*/, size_t /*row_num*/, Arena * /*arena*/) const
+    {
+        throw Exception("Method decrease is not supported for " + getName(), ErrorCodes::NOT_IMPLEMENTED);
+    }
+
     /** Returns true for aggregate functions of type -State.
       * They are executed as other aggregate functions, but not finalized (return an aggregation state that can be combined with another).
       */
@@ -0,0 +1,161 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <AggregateFunctions/registerAggregateFunctions.h>
+#include <Columns/ColumnDecimal.h>
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnsNumber.h>
+#include <Common/Arena.h>
+#include <DataTypes/DataTypeFactory.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+/// Measures rows/s of the batch interfaces of aggregate functions, which are what Aggregator calls:
+/// `addBatchSinglePlace` when there is no GROUP BY keys and `addBatch` otherwise.
+/// Each benchmark is registered with the arguments {nullable, if_combinator, group_by}.
+
+namespace DB
+{
+namespace tests
+{
+class AggregateFunctionBatchBench : public benchmark::Fixture
+{
+public:
+    static constexpr size_t rows = 65536;
+    static constexpr size_t group_by_keys = 1024;
+
+    void SetUp(const benchmark::State &) override
+    {
+        try
+        {
+            registerAggregateFunctions();
+        }
+        catch (DB::Exception &)
+        {
+            // Maybe another bench has already registered, ignore exception here.
+        }
+    }
+
+    template <typename ColumnType>
+    static bool fillColumn(IColumn & column, std::mt19937_64 & gen)
+    {
+        auto * col = typeid_cast<ColumnType *>(&column);
+        if (col == nullptr)
+            return false;
+        auto & data = col->getData();
+        using ValueType = std::decay_t<decltype(data[0])>;
+        data.resize(rows);
+        for (size_t i = 0; i < rows; ++i)
+            data[i] = static_cast<ValueType>(static_cast<Int64>(gen() % 1000000));
+        return true;
+    }
+
+    static ColumnPtr createColumn(const DataTypePtr & type, bool nullable, std::mt19937_64 & gen)
+    {
+        auto column = type->createColumn();
+        if (!fillColumn<ColumnInt64>(*column, gen)
+            && !fillColumn<ColumnFloat64>(*column, gen)
+            && !fillColumn<ColumnDecimal<Decimal128>>(*column, gen))
+            throw Exception("Unsupported type " + type->getName() + " in aggregate function bench");
+
+        if (!nullable)
+            return column;
+
+        /// About 10 percent of the rows are NULL.
+        auto null_map = ColumnUInt8::create(rows, 0);
+        for (auto & is_null : null_map->getData())
+            is_null = gen() % 10 == 0;
+        return ColumnNullable::create(std::move(column), std::move(null_map));
+    }
+
+    static void run(benchmark::State & state, const String & func_name, const String & type_name)
+    {
+        const bool nullable = state.range(0);
+        const bool if_combinator = state.range(1);
+        const bool group_by = state.range(2);
+
+        std::mt19937_64 gen(0); // NOLINT(cert-msc51-cpp)
+        auto type = DataTypeFactory::instance().get(type_name);
+        DataTypes argument_types{nullable ? makeNullable(type) : type};
+        Columns columns{createColumn(type, nullable, gen)};
+        if (if_combinator)
+        {
+            /// About half of the rows are selected.
+            auto flags = ColumnUInt8::create(rows, 0);
+            for (auto & flag : flags->getData())
+                flag = gen() % 2;
+            argument_types.push_back(std::make_shared<DataTypeUInt8>());
+            columns.push_back(std::move(flags));
+        }
+
+        auto function = AggregateFunctionFactory::instance().get(if_combinator ? func_name + "If" : func_name, argument_types);
+        std::vector<const IColumn *> column_ptrs;
+        for (const auto & column : columns)
+            column_ptrs.push_back(column.get());
+
+        Arena arena;
+        std::vector<AggregateDataPtr> states(group_by ? group_by_keys : 1);
+        for (auto & place : states)
+        {
+            place = arena.alignedAlloc(function->sizeOfData(), function->alignOfData());
+            function->create(place);
+        }
+        std::vector<AggregateDataPtr> places(rows);
+        for (size_t i = 0; i < rows; ++i)
+            places[i] = states[gen() % states.size()];
+
+        for (auto _ : state)
+        {
+            if (group_by)
+                function->addBatch(rows, places.data(), 0, column_ptrs.data(), &arena);
+            else
+                function->addBatchSinglePlace(rows, states[0], column_ptrs.data(), &arena);
+        }
+        state.SetItemsProcessed(state.iterations() * rows);
+
+        for (auto & place : states)
+            function->destroy(place);
+    }
+};
+
+#define BENCH_AGG_FUNC(func, type_label, type_name)                        \
+    BENCHMARK_DEFINE_F(AggregateFunctionBatchBench, func##_##type_label)   \
+    (benchmark::State & state)                                             \
+    try                                                                    \
+    {                                                                      \
+        run(state, #func, type_name);                                      \
+    }                                                                      \
+    CATCH                                                                  \
+    BENCHMARK_REGISTER_F(AggregateFunctionBatchBench, func##_##type_label) \
+        ->ArgNames({"nullable", "if", "group_by"})                         \
+        ->ArgsProduct({{0, 1}, {0, 1}, {0, 1}});
+
+#define BENCH_AGG_FUNC_ALL_TYPES(func)             \
+    BENCH_AGG_FUNC(func, Int64, "Int64")           \
+    BENCH_AGG_FUNC(func, Float64, "Float64")       \
+    BENCH_AGG_FUNC(func, Decimal, "Decimal(30,2)")
+
+BENCH_AGG_FUNC_ALL_TYPES(sum)
+BENCH_AGG_FUNC_ALL_TYPES(avg)
+BENCH_AGG_FUNC_ALL_TYPES(count)
+BENCH_AGG_FUNC_ALL_TYPES(min)
+BENCH_AGG_FUNC_ALL_TYPES(max)
+
+} // namespace tests
+} // namespace DB
@@ -0,0 +1,167 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnDecimal.h>
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnsNumber.h>
+#include <Common/Arena.h>
+#include <DataTypes/DataTypeFactory.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <TestUtils/AggregationTestUtils.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <random>
+
+namespace DB
+{
+namespace tests
+{
+/// Check that the vectorized batch interfaces produce the same result as calling `add` row by row.
+class AggregateFunctionBatchTest : public AggregationTest
+{
+public:
+    static constexpr size_t rows = 1000;
+    static constexpr size_t group_by_keys = 7;
+
+    template <typename ColumnType>
+    static bool fillColumn(IColumn & column, std::mt19937_64 & gen)
+    {
+        auto * col = typeid_cast<ColumnType *>(&column);
+        if (col == nullptr)
+            return false;
+        auto & data = col->getData();
+        using ValueType = std::decay_t<decltype(data[0])>;
+        data.resize(rows);
+        /// Use small integers so that the sum of floating point values is exact regardless of the order of addition.
+        for (size_t i = 0; i < rows; ++i)
+            data[i] = static_cast<ValueType>(static_cast<Int64>(gen() % 2000) - 1000);
+        return true;
+    }
+
+    static ColumnPtr createColumn(const DataTypePtr & type, bool nullable, std::mt19937_64 & gen)
+    {
+        auto column = type->createColumn();
+        if (!fillColumn<ColumnInt64>(*column, gen)
+            && !fillColumn<ColumnFloat64>(*column, gen)
+            && !fillColumn<ColumnDecimal<Decimal128>>(*column, gen))
+            throw Exception("Unsupported type " + type->getName());
+
+        if (!nullable)
+            return column;
+
+        auto null_map = ColumnUInt8::create(rows, 0);
+        for (auto & is_null : null_map->getData())
+            is_null = gen() % 3 == 0;
+        return ColumnNullable::create(std::move(column), std::move(null_map));
+    }
+
+    /// Aggregate `columns` into `group_by_keys` groups (or a single group when `group_by` is false)
+    /// either by `add` or by the batch interfaces, and return the results of all groups.
+    static ColumnPtr aggregate(
+        const AggregateFunctionPtr & function,
+        const std::vector<const IColumn *> & columns,
+        bool group_by,
+        bool use_batch)
+    {
+        Arena arena;
+        std::vector<AggregateDataPtr> states(group_by ? group_by_keys : 1);
+        for (auto & place : states)
+        {
+            place = arena.alignedAlloc(function->sizeOfData(), function->alignOfData());
+            function->create(place);
+        }
+        std::vector<AggregateDataPtr> places(rows);
+        for (size_t i = 0; i < rows; ++i)
+            places[i] = states[i % states.size()];
+
+        if (!use_batch)
+        {
+            for (size_t i = 0; i < rows; ++i)
+                function->add(places[i], columns.data(), i, &arena);
+        }
+        else if (group_by)
+        {
+            function->addBatch(rows, places.data(), 0, columns.data(), &arena);
+        }
+        else
+        {
+            /// Split into two batches to cover the case that the state already has a value.
+            function->addBatchSinglePlace(rows / 2, states[0], columns.data(), &arena);
+            std::vector<const IColumn *> rest;
+            Columns rest_holders;
+            for (const auto * column : columns)
+            {
+                rest_holders.push_back(column->cut(rows / 2, rows - rows / 2));
+                rest.push_back(rest_holders.back().get());
+            }
+            function->addBatchSinglePlace(rows - rows / 2, states[0], rest.data(), &arena);
+        }
+
+        auto result = function->getReturnType()->createColumn();
+        for (auto & place : states)
+        {
+            function->insertResultInto(place, *result, &arena);
+            function->destroy(place);
+        }
+        return result;
+    }
+};
+
+TEST_F(AggregateFunctionBatchTest, BatchEqualsRowByRow)
+try
+{
+    for (const String & func_name : {"sum", "avg", "count", "min", "max"})
+    {
+        for (const String & type_name : {"Int64", "Float64", "Decimal(30,2)"})
+        {
+            for (bool nullable : {false, true})
+            {
+                for (bool if_combinator : {false, true})
+                {
+                    std::mt19937_64 gen(0); // NOLINT(cert-msc51-cpp)
+                    auto type = DataTypeFactory::instance().get(type_name);
+                    DataTypes argument_types{nullable ? makeNullable(type) : type};
+                    Columns holders{createColumn(type, nullable, gen)};
+                    if (if_combinator)
+                    {
+                        auto flags = ColumnUInt8::create(rows, 0);
+                        for (auto & flag : flags->getData())
+                            flag = gen() % 2;
+                        argument_types.push_back(std::make_shared<DataTypeUInt8>());
+                        holders.push_back(std::move(flags));
+                    }
+                    std::vector<const IColumn *> columns;
+                    for (const auto & column : holders)
+                        columns.push_back(column.get());
+
+                    auto function = AggregateFunctionFactory::instance().get(if_combinator ? func_name + "If" : func_name, argument_types);
+                    for (bool group_by : {false, true})
+                    {
+                        auto expected = aggregate(function, columns, group_by, false);
+                        auto actual = aggregate(function, columns, group_by, true);
+                        ASSERT_TRUE(columnEqual(expected, actual))
+                            << function->getName() << "(" << argument_types[0]->getName() << ")"
+                            << " if=" << if_combinator << " group_by=" << group_by;
+                    }
+                }
+            }
+        }
+    }
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
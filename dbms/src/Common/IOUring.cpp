@@ -0,0 +1,318 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Common/Exception.h>
+#include <Common/IOUring.h>
+#include <common/logger_useful.h>
+
+#if TIFLASH_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#endif
+
+#include <atomic>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int NOT_IMPLEMENTED;
+extern const int LOGICAL_ERROR;
+} // namespace ErrorCodes
+
+namespace
+{
+std::atomic<bool> io_uring_enabled{false};
+
+#if TIFLASH_HAS_IO_URING
+int ioUringSetup(unsigned entries, io_uring_params * p)
+{
+    return syscall(__NR_io_uring_setup, entries, p);
+}
+
+int ioUringEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+}
+#endif
+} // namespace
+
+bool IOUring::isSupported()
+{
+#if TIFLASH_HAS_IO_URING
+    static const bool supported = [] {
+        // The system call may be missing, or forbidden by seccomp in containers.
+        io_uring_params p{};
+        int fd = ioUringSetup(4, &p);
+        if (fd < 0)
+        {
+            LOG_INFO(&Poco::Logger::get("IOUring"), "io_uring is not supported, errno={}", errno);
+            return false;
+        }
+        ::close(fd);
+        return true;
+    }();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void IOUring::setEnabled(bool enabled_)
+{
+    io_uring_enabled = enabled_;
+}
+
+bool IOUring::isEnabled()
+{
+    return io_uring_enabled && isSupported();
+}
+
+IOUringPtr IOUring::threadLocal()
+{
+    // Do not retry if the ring of this thread can not be created, for example because of RLIMIT_MEMLOCK.
+    thread_local bool failed = false;
+    thread_local IOUringPtr ring;
+    if (ring || failed)
+        return ring;
+    try
+    {
+        ring = std::make_shared<IOUring>(128);
+    }
+    catch (...)
+    {
+        failed = true;
+        tryLogCurrentException("IOUring", "Create io_uring failed, fall back to synchronous reads");
+    }
+    return ring;
+}
+
+#if TIFLASH_HAS_IO_URING
+IOUring::IOUring(unsigned entries_)
+{
+    io_uring_params p{};
+    ring_fd = ioUringSetup(entries_, &p);
+    if (ring_fd < 0)
+        throwFromErrno("io_uring_setup failed");
+
+    entries = p.sq_entries;
+    sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cq_size = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    sqes_size = p.sq_entries * sizeof(io_uring_sqe);
+
+    auto map = [&](size_t size, off_t offset) {
+        void * ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+        if (ptr == MAP_FAILED)
+        {
+            int saved_errno = errno;
+            release();
+            throwFromErrno("mmap of io_uring failed", 0, saved_errno);
+        }
+        return ptr;
+    };
+    sq_ptr = map(sq_size, IORING_OFF_SQ_RING);
+    cq_ptr = map(cq_size, IORING_OFF_CQ_RING);
+    sqes = static_cast<io_uring_sqe *>(map(sqes_size, IORING_OFF_SQES));
+
+    auto * sq = static_cast<char *>(sq_ptr);
+    sq_head = reinterpret_cast<unsigned *>(sq + p.sq_off.head);
+    sq_tail = reinterpret_cast<unsigned *>(sq + p.sq_off.tail);
+    sq_mask = reinterpret_cast<unsigned *>(sq + p.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned *>(sq + p.sq_off.array);
+    auto * cq = static_cast<char *>(cq_ptr);
+    cq_head = reinterpret_cast<unsigned *>(cq + p.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned *>(cq + p.cq_off.tail);
+    cq_mask = reinterpret_cast<unsigned *>(cq + p.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + p.cq_off.cqes);
+}
+
+IOUring::~IOUring()
+{
+    // The buffers wait for their own requests before being destroyed, so nothing is in flight here.
+    release();
+}
+
+void IOUring::release()
+{
+    if (sqes != nullptr)
+        ::munmap(sqes, sqes_size);
+    if (cq_ptr != nullptr)
+        ::munmap(cq_ptr, cq_size);
+    if (sq_ptr != nullptr)
+        ::munmap(sq_ptr, sq_size);
+    if (ring_fd >= 0)
+        ::close(ring_fd);
+    sqes = nullptr;
+    cq_ptr = nullptr;
+    sq_ptr = nullptr;
+    ring_fd = -1;
+}
+
+IOUring::RequestId IOUring::prepareRead(int fd, char * buf, size_t size, off_t offset)
+{
+    std::unique_lock lock(mutex);
+    // Keep the number of requests no more than the entries, so the completion queue never overflows.
+    while (to_submit + in_flight >= entries)
+    {
+        if (to_submit > 0)
+            submitLocked(lock);
+        else
+            waitForCompletionsLocked(lock);
+    }
+
+    RequestId id = next_id++;
+    auto & iov = iovecs[id];
+    iov.iov_base = buf;
+    iov.iov_len = size;
+
+    unsigned tail = *sq_tail;
+    unsigned index = tail & *sq_mask;
+    io_uring_sqe & sqe = sqes[index];
+    memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<UInt64>(&iov);
+    sqe.len = 1;
+    sqe.off = offset;
+    sqe.user_data = id;
+    sq_array[index] = index;
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ++to_submit;
+    return id;
+}
+
+void IOUring::submit()
+{
+    std::unique_lock lock(mutex);
+    if (to_submit > 0)
+        submitLocked(lock);
+}
+
+ssize_t IOUring::wait(RequestId id)
+{
+    std::unique_lock lock(mutex);
+    if (iovecs.find(id) == iovecs.end())
+        throw Exception(fmt::format("Unknown io_uring request, id={}", id), ErrorCodes::LOGICAL_ERROR);
+    while (true)
+    {
+        if (auto iter = completed.find(id); iter != completed.end())
+        {
+            ssize_t res = iter->second;
+            completed.erase(iter);
+            iovecs.erase(id);
+            return res;
+        }
+        if (to_submit > 0)
+            submitLocked(lock);
+        else if (in_flight > 0)
+            waitForCompletionsLocked(lock);
+        else
+            throw Exception(fmt::format("io_uring request is lost, id={}", id), ErrorCodes::LOGICAL_ERROR);
+    }
+}
+
+void IOUring::submitLocked(std::unique_lock<std::mutex> & lock)
+{
+    int ret = ioUringEnter(ring_fd, to_submit, 0, 0);
+    if (ret >= 0)
+    {
+        to_submit -= ret;
+        in_flight += ret;
+        return;
+    }
+    if (errno == EINTR)
+        return;
+    if (errno == EAGAIN || errno == EBUSY)
+    {
+        // The kernel is short of resources, wait for some requests to complete and retry.
+        if (in_flight > 0)
+            waitForCompletionsLocked(lock);
+        return;
+    }
+    throwFromErrno("io_uring_enter failed");
+}
+
+size_t IOUring::reapLocked()
+{
+    size_t n = 0;
+    unsigned head = *cq_head;
+    unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head, ++n)
+    {
+        const io_uring_cqe & cqe = cqes[head & *cq_mask];
+        completed[cqe.user_data] = cqe.res;
+    }
+    __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+    in_flight -= n;
+    return n;
+}
+
+void IOUring::waitForCompletionsLocked(std::unique_lock<std::mutex> & lock)
+{
+    if (reapLocked() > 0)
+        return;
+    if (reaping)
+    {
+        // Another thread is waiting in the kernel, it will reap the requests of this thread too.
+        cv.wait(lock);
+        return;
+    }
+
+    reaping = true;
+    lock.unlock();
+    int ret = ioUringEnter(ring_fd, 0, 1, IORING_ENTER_GETEVENTS);
+    int saved_errno = errno;
+    lock.lock();
+    reaping = false;
+    reapLocked();
+    cv.notify_all();
+    if (ret < 0 && saved_errno != EINTR && saved_errno != EAGAIN)
+        throwFromErrno("io_uring_enter failed", 0, saved_errno);
+}
+#else
+IOUring::IOUring(unsigned)
+{
+    throw Exception("io_uring is not supported on this platform", ErrorCodes::NOT_IMPLEMENTED);
+}
+
+IOUring::~IOUring() = default;
+
+void IOUring::release() {}
+
+IOUring::RequestId IOUring::prepareRead(int, char *, size_t, off_t)
+{
+    throw Exception("io_uring is not supported on this platform", ErrorCodes::NOT_IMPLEMENTED);
+}
+
+void IOUring::submit() {}
+
+ssize_t IOUring::wait(RequestId)
+{
+    throw Exception("io_uring is not supported on this platform", ErrorCodes::NOT_IMPLEMENTED);
+}
+#endif
+
+} // namespace DB
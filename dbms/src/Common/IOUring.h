@@ -0,0 +1,118 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <common/types.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <boost/noncopyable.hpp>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define TIFLASH_HAS_IO_URING 1
+#endif
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace DB
+{
+class IOUring;
+using IOUringPtr = std::shared_ptr<IOUring>;
+
+/** A small wrapper of io_uring, only the reads are supported.
+  *
+  * The reads are queued by `prepareRead` without any system call, and the queued reads are submitted
+  * to the kernel together by `submit`, or by `wait` if they are still queued. So the readers can queue
+  * the reads of many files and let them run in parallel by one system call.
+  *
+  * liburing is not used, the rings are set up by the system calls directly.
+  */
+class IOUring : private boost::noncopyable
+{
+public:
+    using RequestId = UInt64;
+
+    /// Whether io_uring can be used on this kernel. It is checked only once.
+    static bool isSupported();
+
+    /// io_uring is used only when it is enabled by the config and supported by the kernel.
+    static void setEnabled(bool enabled_);
+    static bool isEnabled();
+
+    /// Return the ring of the current thread, or nullptr if it can not be created.
+    /// The ring is shared by all the buffers created in this thread, and it can be used by other threads.
+    static IOUringPtr threadLocal();
+
+    explicit IOUring(unsigned entries);
+    ~IOUring();
+
+    /// Queue a read of `size` bytes at `offset` of `fd` into `buf`, without submitting it.
+    RequestId prepareRead(int fd, char * buf, size_t size, off_t offset);
+
+    /// Submit all the queued requests by one system call.
+    void submit();
+
+    /// Wait for the request, return the number of bytes read, or -errno like `pread`.
+    ssize_t wait(RequestId id);
+
+private:
+    void release();
+    void submitLocked(std::unique_lock<std::mutex> & lock);
+    /// Move the completed requests from the completion queue to `completed`, return the number of them.
+    size_t reapLocked();
+    /// Block until some of the requests are completed.
+    void waitForCompletionsLocked(std::unique_lock<std::mutex> & lock);
+
+private:
+    int ring_fd = -1;
+
+    void * sq_ptr = nullptr;
+    size_t sq_size = 0;
+    void * cq_ptr = nullptr;
+    size_t cq_size = 0;
+    io_uring_sqe * sqes = nullptr;
+    size_t sqes_size = 0;
+
+    unsigned * sq_head = nullptr;
+    unsigned * sq_tail = nullptr;
+    unsigned * sq_mask = nullptr;
+    unsigned * sq_array = nullptr;
+    unsigned * cq_head = nullptr;
+    unsigned * cq_tail = nullptr;
+    unsigned * cq_mask = nullptr;
+    io_uring_cqe * cqes = nullptr;
+    unsigned entries = 0;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    /// Whether a thread is blocked in the kernel to wait for completions.
+    bool reaping = false;
+    /// The number of requests queued but not submitted.
+    unsigned to_submit = 0;
+    /// The number of requests submitted but not reaped.
+    unsigned in_flight = 0;
+    RequestId next_id = 1;
+    /// The iovec of each request, it must be alive until the request is completed.
+    std::unordered_map<RequestId, iovec> iovecs;
+    std::unordered_map<RequestId, ssize_t> completed;
+};
+
+} // namespace DB
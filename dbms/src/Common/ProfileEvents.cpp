@@ -27,6 +27,8 @@
     M(WriteBufferFromFileDescriptorWriteBytes) \
     M(ReadBufferAIORead)                       \
     M(ReadBufferAIOReadBytes)                  \
+    M(ReadBufferIOUringRead)                   \
+    M(ReadBufferIOUringReadBytes)              \
     M(WriteBufferAIOWrite)                     \
     M(WriteBufferAIOWriteBytes)                \
                                                \
@@ -38,6 +40,7 @@
                                                \
     M(ExternalAggregationCompressedBytes)      \
     M(ExternalAggregationUncompressedBytes)    \
+    M(ExternalJoinSpill)                       \
                                                \
     M(ContextLock)                             \
                                                \
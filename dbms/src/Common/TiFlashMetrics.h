@@ -98,6 +98,13 @@ namespace DB
         F(type_broadcast_passthrough_none_compression_local, {"type", "broadcast_passthrough_none_compression_local"}), /*the local exchange data size by broadcast/passthough with no compression*/ \
         F(type_broadcast_passthrough_none_compression_remote, {"type", "broadcast_passthrough_none_compression_remote"}), /*the remote exchange data size by broadcast/passthough with no compression*/ \
     ) \
+    M(tiflash_exchange_adaptive_compression, "Statistics of the adaptive compression of hash exchange", Counter, \
+        F(type_none_packets, {"type", "none_packets"}), /*the number of packets sent with no compression*/ \
+        F(type_lz4_packets, {"type", "lz4_packets"}), /*the number of packets sent with lz4 compression*/ \
+        F(type_zstd_packets, {"type", "zstd_packets"}), /*the number of packets sent with zstd compression*/ \
+        F(type_saved_bytes, {"type", "saved_bytes"}), /*the bytes saved by compression*/ \
+        F(type_encode_ns, {"type", "encode_ns"}), /*the time spent on encoding and compression*/ \
+    ) \
     M(tiflash_schema_version, "Current version of tiflash cached schema", Gauge)                                                                    \
     M(tiflash_schema_applying, "Whether the schema is applying or not (holding lock)", Gauge)                                                       \
     M(tiflash_schema_apply_count, "Total number of each kinds of apply", Counter, F(type_diff, {"type", "diff"}),                                   \
@@ -258,6 +265,9 @@ namespace DB
         F(type_estimated_thread_usage, {"type", "estimated_thread_usage"}),                                                                         \
         F(type_thread_soft_limit, {"type", "thread_soft_limit"}),                                                                                   \
         F(type_thread_hard_limit, {"type", "thread_hard_limit"}),                                                                                   \
+        F(type_reserved_memory_usage, {"type", "reserved_memory_usage"}),                                                                           \
+        F(type_memory_soft_limit, {"type", "memory_soft_limit"}),                                                                                   \
+        F(type_memory_hard_limit, {"type", "memory_hard_limit"}),                                                                                   \
         F(type_hard_limit_exceeded_count, {"type", "hard_limit_exceeded_count"}))                                                                   \
     M(tiflash_task_scheduler_waiting_duration_seconds, "Bucketed histogram of task waiting for scheduling duration", Histogram,                     \
         F(type_task_scheduler_waiting_duration, {{"type", "task_waiting_duration"}}, ExpBuckets{0.001, 2, 20}))                                     \
@@ -277,6 +287,25 @@ namespace DB
         F(type_merged_task, {"type", "merged_task"}))                                                                                               \
     M(tiflash_storage_read_thread_seconds, "Bucketed histogram of read thread", Histogram,                                                          \
         F(type_merged_task, {{"type", "merged_task"}}, ExpBuckets{0.001, 2, 20}))                                                                   \
+    M(tiflash_storage_pack_cache, "The counter of the decompressed pack cache of DMFile", Counter,                                                 \
+        F(type_hit, {"type", "hit"}),                                                                                                               \
+        F(type_miss, {"type", "miss"}),                                                                                                             \
+        F(type_admit, {"type", "admit"}),                                                                                                           \
+        F(type_reject, {"type", "reject"}),                                                                                                         \
+        F(type_evict_bytes, {"type", "evict_bytes"}))                                                                                               \
+    M(tiflash_storage_remote_cache, "The counter of the local file cache of remote objects", Counter,                                               \
+        F(type_hit, {"type", "hit"}),                                                                                                               \
+        F(type_miss, {"type", "miss"}),                                                                                                             \
+        F(type_hit_bytes, {"type", "hit_bytes"}),                                                                                                   \
+        F(type_download_bytes, {"type", "download_bytes"}),                                                                                         \
+        F(type_evict_bytes, {"type", "evict_bytes"}))                                                                                               \
+    M(tiflash_storage_remote_cache_bytes, "The used bytes of the local file cache of remote objects", Gauge,                                        \
+        F(type_used, {"type", "used"}))                                                                                                             \
+    M(tiflash_runtime_filter, "The counter of runtime filters built by join and applied by table scan", Counter,                                    \
+        F(type_ready, {"type", "ready"}),                                                                                                           \
+        F(type_disabled, {"type", "disabled"}),                                                                                                     \
+        F(type_wait_timeout, {"type", "wait_timeout"}),                                                                                             \
+        F(type_filtered_rows, {"type", "filtered_rows"}))                                                                                           \
     M(tiflash_mpp_task_manager, "The gauge of mpp task manager", Gauge,                                                                             \
         F(type_mpp_query_count, {"type", "mpp_query_count"}))                                                                                       \
     M(tiflash_exchange_queueing_data_bytes, "Total bytes of data contained in the queue", Gauge,                                                    \
@@ -280,6 +280,25 @@ UInt64 Spiller::spilledRows(UInt64 partition_id)
     return ret;
 }
 
+std::vector<std::unique_ptr<SpilledFile>> Spiller::takeSpilledFiles(UInt64 partition_id)
+{
+    RUNTIME_CHECK_MSG(partition_id < partition_num, "{}: partition id {} exceeds partition num {}.", config.spill_id, partition_id, partition_num);
+    RUNTIME_CHECK_MSG(!enable_append_write, "{}: can not take the spilled files if append write is enabled.", config.spill_id);
+    std::lock_guard partition_lock(spilled_files[partition_id]->spilled_files_mutex);
+    assert(spilled_files[partition_id]->mutable_spilled_files.empty());
+    std::vector<std::unique_ptr<SpilledFile>> ret;
+    ret.swap(spilled_files[partition_id]->immutable_spilled_files);
+    return ret;
+}
+
+BlockInputStreamPtr Spiller::restoreSpilledFile(const SpilledFile & spilled_file) const
+{
+    RUNTIME_CHECK_MSG(spilled_file.exists(), "Spill file {} does not exists", spilled_file.path());
+    std::vector<SpilledFileInfo> file_infos;
+    file_infos.emplace_back(spilled_file.path());
+    return std::make_shared<SpilledFilesInputStream>(std::move(file_infos), input_schema, config.file_provider, spill_version);
+}
+
 String Spiller::nextSpillFileName(UInt64 partition_id)
 {
     Int64 index = tmp_file_index.fetch_add(1);
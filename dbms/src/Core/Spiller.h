@@ -92,6 +92,10 @@ public:
     UInt64 spilledRows(UInt64 partition_id);
     void finishSpill();
     bool hasSpilledData() const { return has_spilled_data; };
+    /// Move the spilled files of the partition out of the spiller. Only for the spiller that does not append write, so
+    /// each file holds the blocks of one `spillBlocks` call, and the caller restores and releases each file separately.
+    std::vector<std::unique_ptr<SpilledFile>> takeSpilledFiles(UInt64 partition_id);
+    BlockInputStreamPtr restoreSpilledFile(const SpilledFile & spilled_file) const;
     /// only for test now
     bool releaseSpilledFileOnRestore() const { return release_spilled_file_on_restore; }
 
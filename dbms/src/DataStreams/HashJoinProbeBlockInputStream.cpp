@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <DataStreams/HashJoinProbeBlockInputStream.h>
+#include <DataStreams/HashJoinRestoreBlockInputStream.h>
 
 namespace DB
 {
@@ -133,7 +134,11 @@ Block HashJoinProbeBlockInputStream::getOutputBlock()
                 if (!block)
                 {
                     finishOneProbe();
-                    if (join->needReturnNonJoinedData())
+                    /// `isSpilled` is only valid after all build finished, and a join that is not spilled
+                    /// does not need to wait for the other probe streams unless it returns non-joined data.
+                    if (join->isEnableSpill())
+                        join->waitUntilAllBuildFinished();
+                    if (join->needReturnNonJoinedData() || join->isSpilled())
                         status = ProbeStatus::WAIT_FOR_READ_NON_JOINED_DATA;
                     else
                         status = ProbeStatus::FINISHED;
@@ -142,6 +147,16 @@ Block HashJoinProbeBlockInputStream::getOutputBlock()
                 else
                 {
                     join->checkTypes(block);
+                    if (join->isEnableSpill())
+                    {
+                        join->waitUntilAllBuildFinished();
+                        if (join->isSpilled())
+                        {
+                            /// The probe block will be joined after the spilled partitions are restored.
+                            join->spillProbeBlock(block);
+                            break;
+                        }
+                    }
                     probe_process_info.resetBlock(std::move(block));
                 }
             }
@@ -150,7 +165,16 @@ Block HashJoinProbeBlockInputStream::getOutputBlock()
             return ret;
         }
         case ProbeStatus::WAIT_FOR_READ_NON_JOINED_DATA:
+            join->waitUntilAllBuildFinished();
             join->waitUntilAllProbeFinished();
+            /// For spilled join, all the joined and non-joined rows are produced by restoring the spilled partitions.
+            if (join->isSpilled())
+                non_joined_stream = std::make_shared<HashJoinRestoreBlockInputStream>(join, probe_index, children.back()->getHeader(), log->identifier(), probe_process_info.max_block_size);
+            if (!non_joined_stream)
+            {
+                status = ProbeStatus::FINISHED;
+                break;
+            }
             status = ProbeStatus::READ_NON_JOINED_DATA;
             non_joined_stream->readPrefix();
             break;
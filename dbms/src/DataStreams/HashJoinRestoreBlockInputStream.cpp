@@ -0,0 +1,81 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataStreams/HashJoinProbeBlockInputStream.h>
+#include <DataStreams/HashJoinRestoreBlockInputStream.h>
+
+namespace DB
+{
+HashJoinRestoreBlockInputStream::HashJoinRestoreBlockInputStream(
+    const JoinPtr & join_,
+    size_t probe_index_,
+    const Block & probe_header_,
+    const String & req_id,
+    UInt64 max_block_size_)
+    : log(Logger::get(req_id))
+    , join(join_)
+    , probe_index(probe_index_)
+    , probe_header(probe_header_.cloneEmpty())
+    , max_block_size(max_block_size_)
+{
+    RUNTIME_CHECK_MSG(join != nullptr, "join ptr should not be null.");
+    RUNTIME_CHECK_MSG(join->isSpilled(), "join should be spilled.");
+    ProbeProcessInfo header_probe_process_info(0);
+    header_probe_process_info.resetBlock(probe_header.cloneEmpty());
+    header = join->joinBlock(header_probe_process_info);
+}
+
+Block HashJoinRestoreBlockInputStream::readImpl()
+{
+    while (true)
+    {
+        if (isCancelledOrThrowIfKilled())
+            return {};
+
+        if (!restore_stream)
+        {
+            BlockInputStreamPtr probe_stream;
+            auto restore_join = join->restorePartition(probe_index, restore_round, probe_header, probe_stream, [this]() { return isCancelled(); });
+            if (!restore_join)
+                return {};
+            restore_stream = std::make_shared<HashJoinProbeBlockInputStream>(probe_stream, restore_join, probe_index, log->identifier(), max_block_size);
+            restore_stream->readPrefix();
+            ++restored_partitions;
+        }
+
+        if (Block block = restore_stream->read())
+        {
+            restored_rows += block.rows();
+            return block;
+        }
+        restore_stream->readSuffix();
+        restore_stream.reset();
+        join->finishRestorePartition();
+        ++restore_round;
+    }
+}
+
+void HashJoinRestoreBlockInputStream::cancel(bool kill)
+{
+    IProfilingBlockInputStream::cancel(kill);
+    /// Wake up the stream if it is waiting for the other streams to finish the current partition.
+    join->wakeUpRestoreWaiters();
+}
+
+void HashJoinRestoreBlockInputStream::readSuffixImpl()
+{
+    LOG_DEBUG(log, "Finish join restore, restored {} partitions, output rows {}", restored_partitions, restored_rows);
+}
+
+} // namespace DB
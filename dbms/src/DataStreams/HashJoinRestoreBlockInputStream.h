@@ -0,0 +1,65 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <DataStreams/IProfilingBlockInputStream.h>
+#include <Interpreters/Join.h>
+
+namespace DB
+{
+/** Join the spilled partitions of a spilled hash join.
+  * The partitions are restored one at a time and shared by all the probe streams of the join,
+  * each stream joins its share of the restored probe data with the restored build data of the partition,
+  * including its share of the non-joined rows of the build side for RIGHT/FULL join,
+  * and then waits for the other streams before moving to the next partition, see `Join::restorePartition`.
+  */
+class HashJoinRestoreBlockInputStream : public IProfilingBlockInputStream
+{
+private:
+    static constexpr auto name = "HashJoinRestore";
+
+public:
+    HashJoinRestoreBlockInputStream(
+        const JoinPtr & join_,
+        size_t probe_index_,
+        const Block & probe_header_,
+        const String & req_id,
+        UInt64 max_block_size_);
+
+    String getName() const override { return name; }
+    Block getHeader() const override { return header; }
+    void cancel(bool kill) override;
+
+protected:
+    Block readImpl() override;
+    void readSuffixImpl() override;
+
+private:
+    const LoggerPtr log;
+    JoinPtr join;
+    size_t probe_index;
+    Block probe_header;
+    Block header;
+    UInt64 max_block_size;
+
+    /// The join stream of the partition being restored.
+    BlockInputStreamPtr restore_stream;
+    /// The number of restore rounds this stream has finished, see `Join::restorePartition`.
+    size_t restore_round = 0;
+    size_t restored_partitions = 0;
+    size_t restored_rows = 0;
+};
+
+} // namespace DB
@@ -0,0 +1,82 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Stopwatch.h>
+#include <Common/TiFlashMetrics.h>
+#include <DataStreams/RuntimeFilterBlockInputStream.h>
+
+namespace DB
+{
+RuntimeFilterBlockInputStream::RuntimeFilterBlockInputStream(
+    const BlockInputStreamPtr & input,
+    const RuntimeFilters & runtime_filters_,
+    const Names & column_names_,
+    UInt64 wait_time_ms_,
+    const String & req_id)
+    : runtime_filters(runtime_filters_)
+    , column_names(column_names_)
+    , wait_time_ms(wait_time_ms_)
+    , log(Logger::get(req_id))
+{
+    RUNTIME_CHECK(runtime_filters.size() == column_names.size(), runtime_filters.size(), column_names.size());
+    children.push_back(input);
+}
+
+void RuntimeFilterBlockInputStream::waitRuntimeFilters()
+{
+    Stopwatch watch;
+    for (const auto & runtime_filter : runtime_filters)
+    {
+        UInt64 elapsed_ms = watch.elapsedMilliseconds();
+        UInt64 left_ms = elapsed_ms < wait_time_ms ? wait_time_ms - elapsed_ms : 0;
+        if (!runtime_filter->waitReady(left_ms) && runtime_filter->getStatus() == RuntimeFilter::Status::Building)
+            GET_METRIC(tiflash_runtime_filter, type_wait_timeout).Increment();
+        LOG_DEBUG(log, "Runtime filter {} after waiting {} ms", runtime_filter->toDebugString(), watch.elapsedMilliseconds());
+    }
+}
+
+Block RuntimeFilterBlockInputStream::readImpl()
+{
+    if (!waited)
+    {
+        waitRuntimeFilters();
+        waited = true;
+    }
+
+    while (true)
+    {
+        Block block = children.back()->read();
+        if (!block || block.rows() == 0)
+            return block;
+
+        size_t rows = block.rows();
+        filter.assign(rows, static_cast<UInt8>(1));
+        size_t cleared = 0;
+        for (size_t i = 0; i < runtime_filters.size(); ++i)
+            cleared += runtime_filters[i]->filterRows(block.getByName(column_names[i]), filter);
+        if (cleared == 0)
+            return block;
+
+        GET_METRIC(tiflash_runtime_filter, type_filtered_rows).Increment(cleared);
+        if (cleared == rows)
+            continue;
+
+        size_t passed = rows - cleared;
+        for (auto & column : block)
+            column.column = column.column->filter(filter, passed);
+        return block;
+    }
+}
+
+} // namespace DB
@@ -0,0 +1,59 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <DataStreams/IProfilingBlockInputStream.h>
+#include <Interpreters/RuntimeFilter.h>
+
+namespace DB
+{
+/** Filter the rows of the table scan with the runtime filters built by the join build side.
+  * Before reading the first block, it waits for the runtime filters to be ready at most `wait_time_ms`,
+  * so that the storage engine can also use them to skip packs. A runtime filter that is still
+  * building after that is applied to the following blocks once it is ready.
+  */
+class RuntimeFilterBlockInputStream : public IProfilingBlockInputStream
+{
+    static constexpr auto NAME = "RuntimeFilter";
+
+public:
+    /// `column_names[i]` is the name of the column that `runtime_filters[i]` is applied to.
+    RuntimeFilterBlockInputStream(
+        const BlockInputStreamPtr & input,
+        const RuntimeFilters & runtime_filters_,
+        const Names & column_names_,
+        UInt64 wait_time_ms_,
+        const String & req_id);
+
+    String getName() const override { return NAME; }
+    Block getHeader() const override { return children.back()->getHeader(); }
+
+protected:
+    Block readImpl() override;
+
+private:
+    void waitRuntimeFilters();
+
+    const RuntimeFilters runtime_filters;
+    const Names column_names;
+    const UInt64 wait_time_ms;
+    bool waited = false;
+
+    IColumn::Filter filter;
+
+    const LoggerPtr log;
+};
+
+} // namespace DB
@@ -0,0 +1,219 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataStreams/StreamingAggregatingBlockInputStream.h>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int LOGICAL_ERROR;
+} // namespace ErrorCodes
+
+namespace
+{
+/// The groups held in memory are bounded by the size of a block, and the spilled data can not be emitted
+/// group by group, so spilling is disabled.
+Aggregator::Params disableSpill(const Aggregator::Params & params)
+{
+    return Aggregator::Params(
+        params.src_header,
+        params.keys,
+        params.aggregates,
+        params.getGroupByTwoLevelThreshold(),
+        params.getGroupByTwoLevelThresholdBytes(),
+        /*max_bytes_before_external_group_by=*/0,
+        params.empty_result_for_aggregation_by_empty_set,
+        params.spill_config,
+        params.max_block_size,
+        params.collators);
+}
+
+Block cutBlock(const Block & block, size_t start, size_t length)
+{
+    if (start == 0 && length == block.rows())
+        return block;
+
+    Block res = block.cloneEmpty();
+    for (size_t i = 0; i < block.columns(); ++i)
+        res.getByPosition(i).column = block.getByPosition(i).column->cut(start, length);
+    return res;
+}
+} // namespace
+
+StreamingAggregatingBlockInputStream::StreamingAggregatingBlockInputStream(
+    const BlockInputStreamPtr & input,
+    const Aggregator::Params & params_,
+    bool final_,
+    const String & req_id)
+    : log(Logger::get(req_id))
+    , params(disableSpill(params_))
+    , aggregator(params, req_id)
+    , final(final_)
+    , data_variants(std::make_shared<AggregatedDataVariants>())
+    , key_columns(params.keys_size)
+    , aggregate_columns(params.aggregates_size)
+{
+    if (unlikely(params.keys_size == 0))
+        throw Exception("Streaming aggregation requires at least one group by key", ErrorCodes::LOGICAL_ERROR);
+    children.push_back(input);
+}
+
+Block StreamingAggregatingBlockInputStream::getHeader() const
+{
+    return aggregator.getHeader(final);
+}
+
+int StreamingAggregatingBlockInputStream::compareKeys(const ColumnRawPtrs & lhs, size_t lhs_row, const ColumnRawPtrs & rhs, size_t rhs_row) const
+{
+    for (size_t i = 0; i < params.keys_size; ++i)
+    {
+        const auto & collator = i < params.collators.size() ? params.collators[i] : nullptr;
+        int res = collator != nullptr
+            ? lhs[i]->compareAt(lhs_row, rhs_row, *rhs[i], 1, *collator)
+            : lhs[i]->compareAt(lhs_row, rhs_row, *rhs[i], 1);
+        if (res != 0)
+            return res;
+    }
+    return 0;
+}
+
+void StreamingAggregatingBlockInputStream::aggregate(const Block & block)
+{
+    if (block.rows() == 0)
+        return;
+    if (!aggregator.executeOnBlock(block, *data_variants, key_columns, aggregate_columns))
+        input_finished = true;
+}
+
+void StreamingAggregatingBlockInputStream::flush()
+{
+    if (data_variants->empty())
+        return;
+
+    ManyAggregatedDataVariants many_data{data_variants};
+    if (auto merging_buckets = aggregator.mergeAndConvertToBlocks(many_data, final, 1))
+    {
+        while (Block block = merging_buckets->getData(0))
+            ready_blocks.push_back(std::move(block));
+    }
+    has_emitted = true;
+    data_variants = std::make_shared<AggregatedDataVariants>();
+}
+
+void StreamingAggregatingBlockInputStream::consumeSorted(const Block & block)
+{
+    size_t rows = block.rows();
+
+    Columns materialized_columns;
+    ColumnRawPtrs keys(params.keys_size);
+    for (size_t i = 0; i < params.keys_size; ++i)
+    {
+        keys[i] = block.getByPosition(params.keys[i]).column.get();
+        if (ColumnPtr converted = keys[i]->convertToFullColumnIfConst())
+        {
+            materialized_columns.push_back(converted);
+            keys[i] = materialized_columns.back().get();
+        }
+    }
+
+    ColumnRawPtrs last_keys(params.keys_size);
+    for (size_t i = 0; i < last_key.size(); ++i)
+        last_keys[i] = last_key[i].get();
+
+    /// Find where the last group of this block starts, and check that the keys never decrease.
+    int cmp_with_last = last_key.empty() ? 1 : compareKeys(keys, 0, last_keys, 0);
+    bool sorted = cmp_with_last >= 0;
+    size_t last_group_start = 0;
+    for (size_t i = 1; sorted && i < rows; ++i)
+    {
+        int res = compareKeys(keys, i, keys, i - 1);
+        if (res < 0)
+            sorted = false;
+        else if (res > 0)
+            last_group_start = i;
+    }
+
+    if (!sorted)
+    {
+        /// The order is guaranteed by the planner, the input of a valid query never gets here.
+        if (has_emitted)
+            throw Exception("The input of streaming aggregation is not sorted by the group by keys after some groups are emitted", ErrorCodes::LOGICAL_ERROR);
+
+        LOG_INFO(log, "The input is not sorted by the group by keys, fall back to hash aggregation");
+        fallback = true;
+        aggregate(block);
+        return;
+    }
+
+    if (cmp_with_last > 0 || last_group_start > 0)
+    {
+        /// All groups before the last one of this block are finished, including the pending group of the previous blocks.
+        aggregate(cutBlock(block, 0, last_group_start));
+        flush();
+        aggregate(cutBlock(block, last_group_start, rows - last_group_start));
+    }
+    else
+    {
+        aggregate(block);
+    }
+
+    last_key.resize(params.keys_size);
+    for (size_t i = 0; i < params.keys_size; ++i)
+        last_key[i] = keys[i]->cut(rows - 1, 1);
+}
+
+Block StreamingAggregatingBlockInputStream::readImpl()
+{
+    if (!inited)
+    {
+        inited = true;
+        Aggregator::CancellationHook hook = [&]() {
+            return this->isCancelled();
+        };
+        aggregator.setCancellationHook(hook);
+        aggregator.initThresholdByAggregatedDataVariantsSize(1);
+    }
+
+    while (true)
+    {
+        if (isCancelledOrThrowIfKilled())
+            return {};
+
+        if (!ready_blocks.empty())
+        {
+            Block block = std::move(ready_blocks.front());
+            ready_blocks.pop_front();
+            return block;
+        }
+
+        if (input_finished)
+            return {};
+
+        Block block = children.back()->read();
+        if (!block)
+        {
+            input_finished = true;
+            flush();
+            continue;
+        }
+
+        if (fallback)
+            aggregate(block);
+        else if (block.rows() > 0)
+            consumeSorted(block);
+    }
+}
+
+} // namespace DB
@@ -0,0 +1,84 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <DataStreams/IProfilingBlockInputStream.h>
+#include <Interpreters/Aggregator.h>
+
+namespace DB
+{
+/** Aggregates a stream of blocks that is sorted by the key columns, e.g. a table scan that keeps the order
+  * of the handle column and is grouped by the handle column.
+  * Since all rows of a group are adjacent, a group is emitted as soon as the key changes, and only the groups
+  * of the current block are kept in memory instead of a hash table of the whole input.
+  *
+  * It must only be used when the input is guaranteed to be sorted, which is decided at plan time, see
+  * `DAGStorageInterpreter::sort_key_column_name`. The emitted groups can not be merged with the later input.
+  * The order is still checked on the fly. If the input turns out to be unsorted before any group has been
+  * emitted, it falls back to the ordinary hash aggregation which emits all groups at the end. An unsorted
+  * input after that means the guarantee is broken, which is a logical error.
+  * Spilling is not supported in either mode.
+  */
+class StreamingAggregatingBlockInputStream : public IProfilingBlockInputStream
+{
+    static constexpr auto NAME = "StreamingAggregating";
+
+public:
+    StreamingAggregatingBlockInputStream(
+        const BlockInputStreamPtr & input,
+        const Aggregator::Params & params_,
+        bool final_,
+        const String & req_id);
+
+    String getName() const override { return NAME; }
+
+    Block getHeader() const override;
+
+    bool isFallback() const { return fallback; }
+
+protected:
+    Block readImpl() override;
+
+private:
+    /// Returns the sign of comparing the key of `lhs_row` in `lhs` with the key of `rhs_row` in `rhs`.
+    int compareKeys(const ColumnRawPtrs & lhs, size_t lhs_row, const ColumnRawPtrs & rhs, size_t rhs_row) const;
+
+    void consumeSorted(const Block & block);
+    void aggregate(const Block & block);
+    /// Convert all the groups in `data_variants` to blocks and start a new `data_variants`.
+    void flush();
+
+    LoggerPtr log;
+
+    Aggregator::Params params;
+    Aggregator aggregator;
+    bool final;
+
+    bool inited = false;
+    bool input_finished = false;
+    bool fallback = false;
+    bool has_emitted = false;
+
+    AggregatedDataVariantsPtr data_variants;
+    ColumnRawPtrs key_columns;
+    Aggregator::AggregateColumns aggregate_columns;
+
+    /// The key of the last row read, which belongs to the group that is not finished yet.
+    Columns last_key;
+
+    BlocksList ready_blocks;
+};
+
+} // namespace DB
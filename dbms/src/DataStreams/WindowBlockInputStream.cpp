@@ -12,8 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/typeid_cast.h>
 #include <DataStreams/WindowBlockInputStream.h>
+#include <DataStreams/materializeBlock.h>
 #include <Interpreters/WindowDescription.h>
+#include <WindowFunctions/WindowFunctionAggregate.h>
 
 #include <magic_enum.hpp>
 
@@ -25,10 +28,22 @@ extern const int BAD_ARGUMENTS;
 extern const int NOT_IMPLEMENTED;
 } // namespace ErrorCodes
 
-WindowTransformAction::WindowTransformAction(const Block & input_header, const WindowDescription & window_description_, const String & req_id)
+WindowTransformAction::WindowTransformAction(
+    const Block & input_header,
+    const WindowDescription & window_description_,
+    size_t max_bytes_before_external_window_,
+    const SpillConfig & spill_config_,
+    const String & req_id)
     : log(Logger::get(req_id))
     , window_description(window_description_)
+    , max_bytes_before_external_window(max_bytes_before_external_window_)
 {
+    if (isSpillEnabled())
+    {
+        spill_config.emplace(spill_config_);
+        spill_schema = materializeBlock(input_header);
+    }
+
     output_header = input_header;
     for (const auto & add_column : window_description_.add_columns)
     {
@@ -40,15 +55,30 @@ WindowTransformAction::WindowTransformAction(const Block & input_header, const W
     initialPartitionAndOrderColumnIndices();
 }
 
+WindowTransformAction::~WindowTransformAction()
+{
+    for (auto & ws : workspaces)
+    {
+        if (ws.aggregate_window_function)
+            ws.aggregate_window_function->getAggregateFunction()->destroy(ws.aggregate_function_state);
+    }
+}
+
 void WindowTransformAction::cleanUp()
 {
     if (!window_blocks.empty())
         window_blocks.erase(window_blocks.begin(), window_blocks.end());
+    loaded_bytes = 0;
     input_is_finished = true;
 }
 
-WindowBlockInputStream::WindowBlockInputStream(const BlockInputStreamPtr & input, const WindowDescription & window_description_, const String & req_id)
-    : action(input->getHeader(), window_description_, req_id)
+WindowBlockInputStream::WindowBlockInputStream(
+    const BlockInputStreamPtr & input,
+    const WindowDescription & window_description_,
+    size_t max_bytes_before_external_window,
+    const SpillConfig & spill_config,
+    const String & req_id)
+    : action(input->getHeader(), window_description_, max_bytes_before_external_window, spill_config, req_id)
 {
     children.push_back(input);
 }
@@ -80,6 +110,14 @@ void WindowTransformAction::initialWorkspaces()
         WindowFunctionWorkspace workspace;
         workspace.window_function = window_function_description.window_function;
         workspace.arguments = window_function_description.arguments;
+        if (const auto * aggregate_window_function = typeid_cast<const WindowFunctionAggregate *>(workspace.window_function.get()))
+        {
+            const auto & aggregate_function = aggregate_window_function->getAggregateFunction();
+            workspace.aggregate_function_state = arena.alignedAlloc(aggregate_function->sizeOfData(), aggregate_function->alignOfData());
+            aggregate_function->create(workspace.aggregate_function_state);
+            workspace.aggregate_window_function = aggregate_window_function;
+            has_aggregate_window_function = true;
+        }
         workspaces.push_back(std::move(workspace));
     }
     only_have_row_number = onlyHaveRowNumber();
@@ -107,18 +145,29 @@ Block WindowBlockInputStream::readImpl()
         if (Block output_block = action.tryGetOutputBlock())
             return output_block;
 
-        Block block = stream->read();
-        if (!block)
-            action.input_is_finished = true;
-        else
-            action.appendBlock(block);
+        // Finish the paused calculation before reading more input.
+        if (!action.calculation_paused)
+        {
+            Block block = stream->read();
+            if (!block)
+                action.input_is_finished = true;
+            else
+                action.appendBlock(block);
+        }
         action.tryCalculate();
     }
 
-    if (returnIfCancelledOrKilled())
-        return {};
-    // return last partition block, if already return then return null
-    return action.tryGetOutputBlock();
+    while (true)
+    {
+        if (returnIfCancelledOrKilled())
+            return {};
+        // return last partition block, if already return then return null
+        if (Block output_block = action.tryGetOutputBlock())
+            return output_block;
+        if (!action.calculation_paused)
+            return {};
+        action.tryCalculate();
+    }
 }
 
 // Judge whether current_partition_row is end row of partition in current block
@@ -283,14 +332,41 @@ void WindowTransformAction::advanceFrameStart()
         break;
     case WindowFrame::BoundaryType::Current:
     {
-        RUNTIME_CHECK_MSG(
-            only_have_pure_window,
-            "window function only support pure window function in WindowFrame::BoundaryType::Current now.");
-        frame_start = current_row;
+        // The pure window functions don't care about the frame.
+        if (only_have_pure_window || window_description.frame.type == WindowFrame::FrameType::Rows)
+            frame_start = current_row;
+        else
+            frame_start = peer_group_start;
         frame_started = true;
         break;
     }
     case WindowFrame::BoundaryType::Offset:
+    {
+        if (window_description.frame.type != WindowFrame::FrameType::Rows)
+            throw Exception(
+                ErrorCodes::NOT_IMPLEMENTED,
+                "The frame begin type '{}' is only implemented for ROWS frame",
+                magic_enum::enum_name(window_description.frame.begin_type));
+
+        const auto offset = window_description.frame.begin_offset.get<UInt64>();
+        if (window_description.frame.begin_preceding)
+        {
+            frame_start = moveRowNumberBackward(current_row, offset, partition_start);
+            frame_started = true;
+        }
+        else
+        {
+            // The frame start must be a valid row of the partition or the partition end,
+            // because it is used as the reference row to find the partition end.
+            RowNumber x = current_row;
+            if (moveRowNumberForward(x, offset) && (partition_ended || x < blocksEnd()))
+            {
+                frame_start = x;
+                frame_started = true;
+            }
+        }
+        break;
+    }
     default:
         throw Exception(
             ErrorCodes::NOT_IMPLEMENTED,
@@ -352,18 +428,77 @@ bool WindowTransformAction::arePeers(const RowNumber & x, const RowNumber & y) c
 
 void WindowTransformAction::advanceFrameEndCurrentRow()
 {
-    assert(frame_end.block == partition_end.block
-           || frame_end.block + 1 == partition_end.block);
-
-    // If window only have row_number or rank/dense_rank functions, set frame_end to the next row of current_row and frame_ended to true
-    RUNTIME_CHECK_MSG(
-        only_have_pure_window,
-        "window function only support pure window function in WindowFrame::BoundaryType::Current now.");
     frame_end = current_row;
     advanceRowNumber(frame_end);
     frame_ended = true;
 }
 
+void WindowTransformAction::advanceFrameEndCurrentPeerGroup()
+{
+    // The frame of RANGE frame ends at the end of the peer group of current_row.
+    if (frame_end <= current_row)
+    {
+        frame_end = current_row;
+        advanceRowNumber(frame_end);
+    }
+
+    const RowNumber end = partition_ended ? partition_end : blocksEnd();
+    while (frame_end < end)
+    {
+        if (!arePeers(current_row, frame_end))
+        {
+            frame_ended = true;
+            return;
+        }
+        advanceRowNumber(frame_end);
+    }
+    // All the rows are peers to the end of the partition, or we need more input data to find the frame end.
+    frame_ended = partition_ended;
+}
+
+RowNumber WindowTransformAction::moveRowNumberBackward(RowNumber x, UInt64 offset, const RowNumber & bound) const
+{
+    while (x.row < offset)
+    {
+        if (x.block == bound.block)
+            return bound;
+        offset -= x.row;
+        --x.block;
+        x.row = blockRows(x.block);
+    }
+    x.row -= offset;
+    return x < bound ? bound : x;
+}
+
+bool WindowTransformAction::moveRowNumberForward(RowNumber & x, UInt64 offset) const
+{
+    const RowNumber end = blocksEnd();
+    while (offset > 0 && x < end)
+    {
+        const auto block_rows = blockRows(x.block);
+        if (x.row + offset < block_rows)
+        {
+            x.row += offset;
+            offset = 0;
+        }
+        else
+        {
+            offset -= block_rows - x.row;
+            ++x.block;
+            x.row = 0;
+        }
+    }
+
+    if (partition_ended)
+    {
+        if (offset > 0 || partition_end < x)
+            x = partition_end;
+        return true;
+    }
+    // Before the partition ends, all the rows we have belong to it.
+    return offset == 0;
+}
+
 void WindowTransformAction::advanceFrameEnd()
 {
     // frame_end must be greater or equal than frame_start, so if the
@@ -381,7 +516,11 @@ void WindowTransformAction::advanceFrameEnd()
     switch (window_description.frame.end_type)
     {
     case WindowFrame::BoundaryType::Current:
-        advanceFrameEndCurrentRow();
+        // If window only have row_number or rank/dense_rank functions, set frame_end to the next row of current_row.
+        if (only_have_pure_window || window_description.frame.type == WindowFrame::FrameType::Rows)
+            advanceFrameEndCurrentRow();
+        else
+            advanceFrameEndCurrentPeerGroup();
         break;
     case WindowFrame::BoundaryType::Unbounded:
     {
@@ -391,11 +530,92 @@ void WindowTransformAction::advanceFrameEnd()
         break;
     }
     case WindowFrame::BoundaryType::Offset:
+    {
+        if (window_description.frame.type != WindowFrame::FrameType::Rows)
+            throw Exception(ErrorCodes::NOT_IMPLEMENTED,
+                            "The frame end type '{}' is only implemented for ROWS frame",
+                            magic_enum::enum_name(window_description.frame.end_type));
+
+        // The frame end is past-the-end, so it's one row after `current_row +/- offset`.
+        const auto offset = window_description.frame.end_offset.get<UInt64>();
+        if (window_description.frame.end_preceding)
+        {
+            frame_end = current_row;
+            if (offset == 0)
+                advanceRowNumber(frame_end);
+            else
+                frame_end = moveRowNumberBackward(current_row, offset - 1, frame_start);
+            frame_ended = true;
+        }
+        else
+        {
+            RowNumber x = current_row;
+            if (moveRowNumberForward(x, offset + 1))
+            {
+                frame_end = x;
+                frame_ended = true;
+            }
+        }
+        break;
+    }
     default:
         throw Exception(ErrorCodes::NOT_IMPLEMENTED,
                         "The frame end type '{}' is not implemented",
                         magic_enum::enum_name(window_description.frame.end_type));
     }
+
+    // The frame is empty if the end is before the start, e.g. ROWS BETWEEN 1 FOLLOWING AND CURRENT ROW.
+    if (frame_ended && frame_end < frame_start)
+        frame_end = frame_start;
+}
+
+template <typename Func>
+void WindowTransformAction::forEachRow(RowNumber begin, const RowNumber & end, Func && func)
+{
+    while (begin < end)
+    {
+        const auto & columns = inputAt(begin);
+        const size_t end_row = begin.block == end.block ? end.row : blockRows(begin.block);
+        for (; begin.row < end_row; ++begin.row)
+            func(columns, begin);
+        if (begin.block != end.block)
+        {
+            ++begin.block;
+            begin.row = 0;
+        }
+    }
+}
+
+void WindowTransformAction::updateAggregationState()
+{
+    if (!has_aggregate_window_function)
+        return;
+
+    // The supported frames only slide forward, so the states are updated by adding the rows in
+    // [prev_frame_end, frame_end) and removing the rows in [prev_frame_start, frame_start).
+    // If the frame doesn't overlap the previous one, e.g. at the start of a partition, the states
+    // are rebuilt from the new frame.
+    assert(prev_frame_start <= frame_start);
+    assert(prev_frame_end <= frame_end);
+    const bool rebuild = prev_frame_end <= frame_start;
+    for (auto & ws : workspaces)
+    {
+        const auto * function = ws.aggregate_window_function;
+        if (!function)
+            continue;
+
+        if (rebuild)
+            function->reset(ws);
+        forEachRow(rebuild ? frame_start : prev_frame_end, frame_end, [&](const Columns & columns, const RowNumber & row) {
+            function->add(*this, ws, columns, row);
+        });
+        if (!rebuild)
+        {
+            forEachRow(prev_frame_start, frame_start, [&](const Columns & columns, const RowNumber & row) {
+                function->remove(ws, columns, row);
+            });
+        }
+    }
 }
 
 void WindowTransformAction::writeOutCurrentRow()
@@ -474,6 +694,11 @@ void WindowTransformAction::releaseAlreadyOutputWindowBlock()
 
     if (first_block_number < first_used_block)
     {
+        for (auto it = window_blocks.begin(); it != window_blocks.begin() + (first_used_block - first_block_number); ++it)
+        {
+            if (!it->evicted)
+                loaded_bytes -= it->bytes;
+        }
         window_blocks.erase(window_blocks.begin(),
                             window_blocks.begin() + (first_used_block - first_block_number));
         first_block_number = first_used_block;
@@ -495,6 +720,18 @@ void WindowTransformAction::appendBlock(Block & current_block)
         return;
     }
 
+    // The arguments of the aggregate window functions are accessed row by row, so they must be full columns.
+    for (const auto & ws : workspaces)
+    {
+        if (!ws.aggregate_window_function)
+            continue;
+        for (auto argument : ws.arguments)
+        {
+            auto & column = current_block.getByPosition(argument).column;
+            column = column->convertToFullColumnIfConst();
+        }
+    }
+
     window_blocks.push_back({});
     auto & window_block = window_blocks.back();
     window_block.rows = current_block.rows();
@@ -507,15 +744,105 @@ void WindowTransformAction::appendBlock(Block & current_block)
         window_block.output_columns.push_back(std::move(res));
     }
 
-    window_block.input_columns = current_block.getColumns();
+    if (isSpillEnabled())
+    {
+        // The spilled data is always materialized, materialize the input so the restored columns have the same structure.
+        window_block.input_columns = materializeBlock(current_block).getColumns();
+        for (const auto & column : window_block.input_columns)
+            window_block.bytes += column->byteSize();
+        loaded_bytes += window_block.bytes;
+        tryEvictBlocks();
+    }
+    else
+    {
+        window_block.input_columns = current_block.getColumns();
+    }
+}
+
+void WindowTransformAction::tryEvictBlocks()
+{
+    if (loaded_bytes <= max_bytes_before_external_window)
+        return;
+
+    // The blocks that will be accessed by the following calculation and output.
+    auto is_active = [&](UInt64 block_number) {
+        return (block_number >= next_output_block_number && block_number <= current_row.block)
+            || block_number == peer_group_last.block
+            || block_number == prev_frame_start.block
+            || block_number == partition_end.block
+            || block_number + 1 == blocksEnd().block;
+    };
+
+    std::vector<UInt64> blocks_to_spill;
+    for (UInt64 block_number = first_block_number; block_number < blocksEnd().block; ++block_number)
+    {
+        auto & window_block = window_blocks[block_number - first_block_number];
+        if (window_block.evicted || is_active(block_number))
+            continue;
+        if (window_block.spilled_file)
+            evictBlock(window_block, block_number);
+        else
+            blocks_to_spill.push_back(block_number);
+    }
+    if (blocks_to_spill.empty())
+        return;
+
+    // The spiller does not append write(`is_input_sorted` = true), so each block is spilled to its own file
+    // and can be restored separately. The files are handed over to the blocks and removed with them.
+    if (!spiller)
+        spiller = std::make_unique<Spiller>(*spill_config, true, 1, spill_schema, log, 1, false);
+    for (auto block_number : blocks_to_spill)
+    {
+        auto & window_block = window_blocks[block_number - first_block_number];
+        Columns columns = window_block.input_columns;
+        spiller->spillBlocks({spill_schema.cloneWithColumns(std::move(columns))}, 0);
+        auto spilled_files = spiller->takeSpilledFiles(0);
+        RUNTIME_CHECK(spilled_files.size() == 1);
+        window_block.spilled_file = std::move(spilled_files.back());
+        evictBlock(window_block, block_number);
+    }
+    LOG_DEBUG(log, "Spill {} window blocks, {} bytes remain in memory", blocks_to_spill.size(), loaded_bytes);
+}
+
+void WindowTransformAction::evictBlock(WindowBlock & window_block, UInt64 block_number)
+{
+    assert(!window_block.evicted && window_block.spilled_file);
+    window_block.input_columns.clear();
+    // The output columns of the block that has not been calculated are empty, drop the reserved memory.
+    if (block_number >= next_output_block_number)
+    {
+        for (auto & column : window_block.output_columns)
+            column = column->cloneEmpty();
+    }
+    window_block.evicted = true;
+    loaded_bytes -= window_block.bytes;
+}
+
+void WindowTransformAction::restoreBlock(WindowBlock & window_block)
+{
+    assert(window_block.evicted && window_block.spilled_file);
+    Blocks blocks;
+    auto stream = spiller->restoreSpilledFile(*window_block.spilled_file);
+    stream->readPrefix();
+    while (Block block = stream->read())
+        blocks.push_back(std::move(block));
+    stream->readSuffix();
+    Block restored_block = blocks.size() == 1 ? std::move(blocks.back()) : vstackBlocks(std::move(blocks));
+    RUNTIME_CHECK_MSG(restored_block.rows() == window_block.rows, "Restored window block has {} rows, expect {} rows", restored_block.rows(), window_block.rows);
+    window_block.input_columns = restored_block.getColumns();
+    window_block.evicted = false;
+    loaded_bytes += window_block.bytes;
 }
 
 void WindowTransformAction::tryCalculate()
 {
+    calculation_paused = false;
     // Start the calculations. First, advance the partition end.
     for (;;)
     {
-        advancePartitionEnd();
+        // The partition end may have been found before the calculation paused.
+        if (!partition_ended)
+            advancePartitionEnd();
 
         // Either we ran out of data or we found the end of partition (maybe
         // both, but this only happens at the total end of data).
@@ -534,6 +861,7 @@ void WindowTransformAction::tryCalculate()
                 // peer_group_last save the row before current_row
                 if (!arePeers(peer_group_last, current_row))
                 {
+                    peer_group_start = current_row;
                     peer_group_start_row_number = current_row_number;
                     ++peer_group_number;
                 }
@@ -569,11 +897,14 @@ void WindowTransformAction::tryCalculate()
             assert(frame_ended);
             assert(frame_start <= frame_end);
 
+            updateAggregationState();
+
             // Write out the results.
             // TODO execute the window function by block instead of row.
             writeOutCurrentRow();
 
             prev_frame_start = frame_start;
+            prev_frame_end = frame_end;
 
             // Move to the next row. The frame will have to be recalculated.
             // The peer group start is updated at the beginning of the loop,
@@ -583,6 +914,15 @@ void WindowTransformAction::tryCalculate()
             first_not_ready_row = current_row;
             frame_ended = false;
             frame_started = false;
+
+            if (isSpillEnabled() && current_row.row == 0 && current_row < partition_end)
+            {
+                // A block has been calculated, pause to output it, so the calculated blocks
+                // of a large partition are not kept in memory.
+                tryEvictBlocks();
+                calculation_paused = true;
+                return;
+            }
         }
 
         if (input_is_finished)
@@ -612,9 +952,11 @@ void WindowTransformAction::tryCalculate()
         frame_start = partition_start;
         frame_end = partition_start;
         prev_frame_start = partition_start;
+        prev_frame_end = partition_start;
         assert(current_row == partition_start);
         current_row_number = 1;
         peer_group_last = partition_start;
+        peer_group_start = partition_start;
         peer_group_start_row_number = 1;
         peer_group_number = 1;
     }
@@ -647,7 +989,7 @@ void WindowTransformAction::advanceRowNumber(RowNumber & x) const
     assert(x.block >= first_block_number);
     assert(x.block - first_block_number < window_blocks.size());
 
-    const auto block_rows = blockAt(x).rows;
+    const auto block_rows = blockRows(x.block);
     assert(x.row < block_rows);
 
     ++x.row;
@@ -669,7 +1011,7 @@ bool WindowTransformAction::lead(RowNumber & x, size_t offset) const
     assert(x.block >= first_block_number);
     assert(x.block - first_block_number < window_blocks.size());
 
-    const auto block_rows = blockAt(x).rows;
+    const auto block_rows = blockRows(x.block);
     assert(x.row < block_rows);
 
     x.row += offset;
@@ -706,7 +1048,7 @@ bool WindowTransformAction::lag(RowNumber & x, size_t offset) const
 
     --x.block;
     size_t new_offset = offset - x.row - 1;
-    x.row = blockAt(x.block).rows - 1;
+    x.row = blockRows(x.block) - 1;
     return lag(x, new_offset);
 }
 } // namespace DB
@@ -14,24 +14,21 @@
 
 #pragma once
 
+#include <AggregateFunctions/IAggregateFunction.h>
+#include <Common/Arena.h>
 #include <Common/FmtUtils.h>
 #include <Core/ColumnNumbers.h>
+#include <Core/Spiller.h>
 #include <DataStreams/IProfilingBlockInputStream.h>
 #include <Interpreters/WindowDescription.h>
 
 #include <deque>
 #include <memory>
+#include <optional>
 
 namespace DB
 {
-// Runtime data for computing one window function.
-struct WindowFunctionWorkspace
-{
-    // TODO add aggregation function
-    WindowFunctionPtr window_function = nullptr;
-
-    ColumnNumbers arguments;
-};
+class WindowFunctionAggregate;
 
 struct WindowBlock
 {
@@ -39,6 +36,13 @@ struct WindowBlock
     MutableColumns output_columns;
 
     size_t rows = 0;
+    size_t bytes = 0;
+
+    // If `spilled_file` is set, the input columns have been spilled to it,
+    // and they can be dropped from memory(`evicted` = true) and restored when they are accessed again.
+    // The file is removed when the block is released.
+    std::unique_ptr<SpilledFile> spilled_file;
+    bool evicted = false;
 };
 
 struct RowNumber
@@ -68,10 +72,34 @@ struct RowNumber
     }
 };
 
+// Runtime data for computing one window function.
+struct WindowFunctionWorkspace
+{
+    WindowFunctionPtr window_function = nullptr;
+
+    // Set if `window_function` is an aggregate window function. The following fields
+    // hold the aggregation of the rows in [prev_frame_start, prev_frame_end).
+    const WindowFunctionAggregate * aggregate_window_function = nullptr;
+    AggregateDataPtr aggregate_function_state = nullptr;
+    // The number of rows whose arguments are not null.
+    UInt64 not_null_rows = 0;
+    // Used by min/max, the candidate rows of the result, the front one is the result.
+    std::deque<RowNumber> monotonic_rows;
+
+    ColumnNumbers arguments;
+};
+
 /* Implementation details.*/
 struct WindowTransformAction
 {
-    WindowTransformAction(const Block & input_header, const WindowDescription & window_description_, const String & req_id);
+    WindowTransformAction(
+        const Block & input_header,
+        const WindowDescription & window_description_,
+        size_t max_bytes_before_external_window_,
+        const SpillConfig & spill_config_,
+        const String & req_id);
+
+    ~WindowTransformAction();
 
     void cleanUp();
 
@@ -82,8 +110,20 @@ struct WindowTransformAction
 
     void advanceFrameStart();
     void advanceFrameEndCurrentRow();
+    void advanceFrameEndCurrentPeerGroup();
     void advanceFrameEnd();
 
+    // Move `x` backward by `offset` rows, stop at `bound`.
+    RowNumber moveRowNumberBackward(RowNumber x, UInt64 offset, const RowNumber & bound) const;
+    // Move `x` forward by `offset` rows, stop at the partition end.
+    // Return false if the result is unknown because the rows haven't been read yet.
+    bool moveRowNumberForward(RowNumber & x, UInt64 offset) const;
+
+    void updateAggregationState();
+
+    template <typename Func>
+    void forEachRow(RowNumber begin, const RowNumber & end, Func && func);
+
     void writeOutCurrentRow();
 
     Block tryGetOutputBlock();
@@ -94,9 +134,7 @@ struct WindowTransformAction
 
     Columns & inputAt(const RowNumber & x)
     {
-        assert(x.block >= first_block_number);
-        assert(x.block - first_block_number < window_blocks.size());
-        return window_blocks[x.block - first_block_number].input_columns;
+        return blockAt(x).input_columns;
     }
 
     const Columns & inputAt(const RowNumber & x) const
@@ -104,38 +142,48 @@ struct WindowTransformAction
         return const_cast<WindowTransformAction *>(this)->inputAt(x);
     }
 
-    auto & blockAt(const UInt64 block_number)
+    // The evicted block is restored from disk when it is accessed.
+    WindowBlock & blockAt(const UInt64 block_number)
     {
         assert(block_number >= first_block_number);
         assert(block_number - first_block_number < window_blocks.size());
-        return window_blocks[block_number - first_block_number];
+        auto & window_block = window_blocks[block_number - first_block_number];
+        if (unlikely(window_block.evicted))
+            restoreBlock(window_block);
+        return window_block;
     }
 
-    const auto & blockAt(const UInt64 block_number) const
+    const WindowBlock & blockAt(const UInt64 block_number) const
     {
         return const_cast<WindowTransformAction *>(this)->blockAt(block_number);
     }
 
-    auto & blockAt(const RowNumber & x)
+    WindowBlock & blockAt(const RowNumber & x)
     {
         return blockAt(x.block);
     }
 
-    const auto & blockAt(const RowNumber & x) const
+    const WindowBlock & blockAt(const RowNumber & x) const
     {
         return const_cast<WindowTransformAction *>(this)->blockAt(x);
     }
 
+    // Unlike `blockAt`, it never restores the evicted block.
+    size_t blockRows(const UInt64 block_number) const
+    {
+        assert(block_number >= first_block_number);
+        assert(block_number - first_block_number < window_blocks.size());
+        return window_blocks[block_number - first_block_number].rows;
+    }
+
     size_t blockRowsNumber(const RowNumber & x) const
     {
-        return blockAt(x).rows;
+        return blockRows(x.block);
     }
 
     MutableColumns & outputAt(const RowNumber & x)
     {
-        assert(x.block >= first_block_number);
-        assert(x.block - first_block_number < window_blocks.size());
-        return window_blocks[x.block - first_block_number].output_columns;
+        return blockAt(x).output_columns;
     }
 
     void advanceRowNumber(RowNumber & x) const;
@@ -161,6 +209,16 @@ struct WindowTransformAction
 
     void appendInfo(FmtBuffer & buffer) const;
 
+    bool isSpillEnabled() const { return max_bytes_before_external_window > 0; }
+
+    // Spill and evict the blocks that are not needed by the calculation and the output in the near future
+    // if the bytes of blocks in memory exceeds `max_bytes_before_external_window`.
+    void tryEvictBlocks();
+
+    void evictBlock(WindowBlock & window_block, UInt64 block_number);
+
+    void restoreBlock(WindowBlock & window_block);
+
     LoggerPtr log;
 
     bool input_is_finished = false;
@@ -176,6 +234,9 @@ struct WindowTransformAction
 
     // Per-window-function scratch spaces.
     std::vector<WindowFunctionWorkspace> workspaces;
+    bool has_aggregate_window_function = false;
+    // Holds the states of the aggregate window functions.
+    Arena arena;
 
     // A sliding window of blocks we currently need. We add the input blocks as
     // they arrive, and discard the blocks we don't need anymore. The blocks
@@ -206,6 +267,8 @@ struct WindowTransformAction
     // For ROWS frame, always equal to the current row, and for RANGE and GROUP
     // frames may be earlier.
     RowNumber peer_group_last;
+    // The first row of current peer group, needed for CURRENT ROW frame start of RANGE frame.
+    RowNumber peer_group_start;
 
     // Row and group numbers in partition for calculating rank() and friends.
     UInt64 current_row_number = 1;
@@ -230,10 +293,22 @@ struct WindowTransformAction
     // aggregate function. We use them to determine how to update the aggregation
     // state after we find the new frame.
     RowNumber prev_frame_start;
+    RowNumber prev_frame_end;
 
     //TODO: used as template parameters
     bool only_have_row_number = false;
     bool only_have_pure_window = false;
+
+    // For spill, the window blocks except the ones near the current row can be evicted from memory,
+    // and the calculation pauses at the end of each block to output the calculated blocks timely.
+    size_t max_bytes_before_external_window = 0;
+    std::optional<SpillConfig> spill_config;
+    Block spill_schema;
+    // Created by the first eviction and shared by all the evictions.
+    std::unique_ptr<Spiller> spiller;
+    // The bytes of input columns of the window blocks in memory.
+    size_t loaded_bytes = 0;
+    bool calculation_paused = false;
 };
 
 class WindowBlockInputStream : public IProfilingBlockInputStream
@@ -241,7 +316,12 @@ class WindowBlockInputStream : public IProfilingBlockInputStream
     static constexpr auto NAME = "Window";
 
 public:
-    WindowBlockInputStream(const BlockInputStreamPtr & input, const WindowDescription & window_description_, const String & req_id);
+    WindowBlockInputStream(
+        const BlockInputStreamPtr & input,
+        const WindowDescription & window_description_,
+        size_t max_bytes_before_external_window,
+        const SpillConfig & spill_config,
+        const String & req_id);
 
     Block getHeader() const override { return action.output_header; };
 
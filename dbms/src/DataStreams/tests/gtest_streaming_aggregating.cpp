@@ -0,0 +1,127 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataStreams/AggregatingBlockInputStream.h>
+#include <DataStreams/BlocksListBlockInputStream.h>
+#include <DataStreams/StreamingAggregatingBlockInputStream.h>
+#include <Interpreters/Context.h>
+#include <TestUtils/AggregationTestUtils.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <map>
+
+namespace DB
+{
+namespace tests
+{
+class StreamingAggregatingBlockInputStreamTest : public AggregationTest
+{
+public:
+    static Block makeBlock(const std::vector<Int64> & keys, const std::vector<Int64> & values)
+    {
+        return Block{createColumn<Int64>(keys, "k"), createColumn<Int64>(values, "v")};
+    }
+
+    static Aggregator::Params buildParams(const Block & header)
+    {
+        auto context = TiFlashTestEnv::getContext();
+        AggregateDescription sum;
+        sum.function = AggregateFunctionFactory::instance().get("sum", {std::make_shared<DataTypeInt64>()});
+        sum.arguments = {1};
+        sum.argument_names = {"v"};
+        sum.column_name = "sum(v)";
+        SpillConfig spill_config(context.getTemporaryPath(), "streaming_agg_test", 0, 0, 0, context.getFileProvider());
+        return Aggregator::Params(header, {0}, {sum}, 0, 0, 0, false, spill_config, DEFAULT_BLOCK_SIZE);
+    }
+
+    /// Read all the results as key -> sum, and check every group is emitted only once.
+    static std::map<Int64, Int64> readAll(IBlockInputStream & stream, size_t * block_count = nullptr)
+    {
+        std::map<Int64, Int64> res;
+        size_t blocks = 0;
+        stream.readPrefix();
+        while (Block block = stream.read())
+        {
+            ++blocks;
+            const auto & key_column = *block.getByName("k").column;
+            const auto & sum_column = *block.getByName("sum(v)").column;
+            for (size_t i = 0; i < block.rows(); ++i)
+            {
+                auto [_, inserted] = res.emplace(key_column[i].get<Int64>(), sum_column[i].get<Int64>());
+                EXPECT_TRUE(inserted) << "duplicated group " << key_column[i].get<Int64>();
+            }
+        }
+        stream.readSuffix();
+        if (block_count)
+            *block_count = blocks;
+        return res;
+    }
+
+    static std::map<Int64, Int64> hashAggregate(const BlocksList & blocks)
+    {
+        AggregatingBlockInputStream stream(std::make_shared<BlocksListBlockInputStream>(BlocksList(blocks)), buildParams(blocks.front().cloneEmpty()), true, "");
+        return readAll(stream);
+    }
+};
+
+TEST_F(StreamingAggregatingBlockInputStreamTest, SortedInput)
+try
+{
+    /// Groups span several blocks, and some blocks contain only one group.
+    BlocksList blocks{
+        makeBlock({1, 1, 2, 3, 3}, {1, 2, 3, 4, 5}),
+        makeBlock({3, 3, 3}, {6, 7, 8}),
+        makeBlock({4}, {9}),
+        makeBlock({5, 6, 6, 7}, {10, 11, 12, 13}),
+        makeBlock({7, 7}, {14, 15}),
+    };
+    StreamingAggregatingBlockInputStream stream(std::make_shared<BlocksListBlockInputStream>(BlocksList(blocks)), buildParams(blocks.front().cloneEmpty()), true, "");
+    size_t block_count = 0;
+    auto res = readAll(stream, &block_count);
+    ASSERT_FALSE(stream.isFallback());
+    ASSERT_EQ(res, hashAggregate(blocks));
+    /// Groups are emitted while reading the input instead of at the end.
+    ASSERT_GT(block_count, 1);
+}
+CATCH
+
+TEST_F(StreamingAggregatingBlockInputStreamTest, FallbackOnUnsortedInput)
+try
+{
+    BlocksList blocks{
+        makeBlock({1, 3, 2, 1}, {1, 2, 3, 4}),
+        makeBlock({3, 2}, {5, 6}),
+    };
+    StreamingAggregatingBlockInputStream stream(std::make_shared<BlocksListBlockInputStream>(BlocksList(blocks)), buildParams(blocks.front().cloneEmpty()), true, "");
+    auto res = readAll(stream);
+    ASSERT_TRUE(stream.isFallback());
+    ASSERT_EQ(res, hashAggregate(blocks));
+}
+CATCH
+
+TEST_F(StreamingAggregatingBlockInputStreamTest, UnsortedAfterEmitted)
+try
+{
+    BlocksList blocks{
+        makeBlock({1, 2, 3}, {1, 2, 3}),
+        makeBlock({1}, {4}),
+    };
+    StreamingAggregatingBlockInputStream stream(std::make_shared<BlocksListBlockInputStream>(BlocksList(blocks)), buildParams(blocks.front().cloneEmpty()), true, "");
+    ASSERT_THROW(readAll(stream), Exception);
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
@@ -36,6 +36,10 @@ struct CompressedSeekableReaderBuffer : public BufferWithOwnMemory<ReadBuffer>
 
     virtual void seek(size_t offset_in_compressed_file, size_t offset_in_decompressed_block) = 0;
 
+    /// Start reading the compressed data at `offset_in_compressed_file` in background if it is supported by
+    /// the file buffer. It is a hint for the following `seek`.
+    virtual void prefetch(size_t /*offset_in_compressed_file*/) {}
+
     CompressedSeekableReaderBuffer()
         : BufferWithOwnMemory<ReadBuffer>(0)
     {}
@@ -85,6 +89,13 @@ public:
 
     void seek(size_t offset_in_compressed_file, size_t offset_in_decompressed_block) override;
 
+    void prefetch(size_t offset_in_compressed_file) override
+    {
+        // `file_in` no longer points to the end of the block in `working_buffer`.
+        if (file_in.prefetch(offset_in_compressed_file))
+            size_compressed = 0;
+    }
+
     size_t readBig(char * to, size_t n) override;
 
     void setProfileCallback(
@@ -20,6 +20,7 @@
 #endif
 #include <Common/ProfileEvents.h>
 #include <IO/ChecksumBuffer.h>
+#include <IO/ReadBufferIOUring.h>
 
 namespace DB
 {
@@ -42,6 +43,12 @@ std::unique_ptr<ReadBufferFromFileBase> createReadBufferFromFileBaseByFileProvid
 {
     if ((aio_threshold == 0) || (estimated_size < aio_threshold))
     {
+        // io_uring reads the file directly, so it can not be used by encrypted files or rate limited reads.
+        if (IOUring::isEnabled() && read_limiter == nullptr && !file_provider->isFileEncrypted(encryption_path_))
+        {
+            if (auto ring = IOUring::threadLocal(); ring)
+                return std::make_unique<ReadBufferIOUring>(ring, filename_, buffer_size_, flags_, existing_memory_, alignment);
+        }
         return std::make_unique<ReadBufferFromFileProvider>(
             file_provider,
             filename_,
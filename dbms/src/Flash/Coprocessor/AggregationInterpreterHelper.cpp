@@ -73,6 +73,15 @@ bool isGroupByCollationSensitive(const Context & context)
     return context.getSettingsRef().group_by_collation_sensitive || context.getDAGContext()->isMPPTask();
 }
 
+bool isAllowToUseStreamingAgg(const Context & context, size_t before_agg_streams_size, const Names & key_names, const String & sort_key_column_name)
+{
+    return context.getSettingsRef().enable_streaming_agg
+        && before_agg_streams_size == 1
+        && !sort_key_column_name.empty()
+        && key_names.size() == 1
+        && key_names[0] == sort_key_column_name;
+}
+
 Aggregator::Params buildParams(
     const Context & context,
     const Block & before_agg_header,
@@ -92,6 +101,9 @@ Aggregator::Params buildParams(
 
     const Settings & settings = context.getSettingsRef();
 
+    /// With fine grained shuffle, every stream is aggregated by its own aggregator and nothing is merged between
+    /// streams. Two-level hash table is still allowed there: it is only used above the group by thresholds, and
+    /// then the result is converted to blocks bucket by bucket instead of all at once, which bounds the peak memory.
     bool allow_to_use_two_level_group_by = isAllowToUseTwoLevelGroupBy(before_agg_streams_size, settings);
     auto total_two_level_threshold_bytes = allow_to_use_two_level_group_by ? settings.group_by_two_level_threshold_bytes : SettingUInt64(0);
 
@@ -33,6 +33,10 @@ bool isFinalAgg(const tipb::Aggregation & aggregation);
 
 bool isGroupByCollationSensitive(const Context & context);
 
+/// Whether the aggregation can emit a group as soon as its key changes, that is
+/// the input is a single stream sorted by the only group by key.
+bool isAllowToUseStreamingAgg(const Context & context, size_t before_agg_streams_size, const Names & key_names, const String & sort_key_column_name);
+
 Aggregator::Params buildParams(
     const Context & context,
     const Block & before_agg_header,
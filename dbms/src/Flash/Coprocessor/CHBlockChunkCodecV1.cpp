@@ -16,6 +16,7 @@
 
 #include <DataTypes/DataTypeFactory.h>
 #include <Flash/Coprocessor/CHBlockChunkCodecV1.h>
+#include <Flash/Coprocessor/LightweightColumnCodec.h>
 #include <IO/ReadBufferFromString.h>
 
 namespace DB
@@ -90,7 +91,7 @@ Block DecodeHeader(ReadBuffer & istr, const Block & header, size_t & total_rows)
     return res;
 }
 
-static inline void decodeColumnsByBlock(ReadBuffer & istr, Block & res, size_t rows_to_read, size_t reserve_size)
+static inline void decodeColumnsByBlock(ReadBuffer & istr, Block & res, size_t rows_to_read, size_t reserve_size, bool lightweight_encoding)
 {
     if (!rows_to_read)
         return;
@@ -115,6 +116,11 @@ static inline void decodeColumnsByBlock(ReadBuffer & istr, Block & res, size_t r
         // Decode columns of one block
         for (size_t i = 0; i < res.columns(); ++i)
         {
+            if (lightweight_encoding)
+            {
+                DecodeColumnLightweight(*res.getByPosition(i).type, *mutable_columns[i], istr, sz);
+                continue;
+            }
             /// Data
             res.getByPosition(i).type->deserializeBinaryBulkWithMultipleStreams(
                 *mutable_columns[i],
@@ -133,9 +139,9 @@ static inline void decodeColumnsByBlock(ReadBuffer & istr, Block & res, size_t r
     res.setColumns(std::move(mutable_columns));
 }
 
-void DecodeColumns(ReadBuffer & istr, Block & res, size_t rows_to_read, size_t reserve_size)
+void DecodeColumns(ReadBuffer & istr, Block & res, size_t rows_to_read, size_t reserve_size, bool lightweight_encoding)
 {
-    return decodeColumnsByBlock(istr, res, rows_to_read, reserve_size);
+    return decodeColumnsByBlock(istr, res, rows_to_read, reserve_size, lightweight_encoding);
 }
 
 CompressionMethod ToInternalCompressionMethod(tipb::CompressionMode compression_mode)
@@ -303,7 +309,15 @@ struct CHBlockChunkCodecV1Impl
         {
             auto && col_type_name = inner.header.getByPosition(col_index);
             auto && column_ptr = toColumnPtr(std::forward<ColumnsHolder>(columns_holder), col_index);
-            WriteColumnData(*col_type_name.type, column_ptr, *ostr_ptr, 0, 0);
+            if (inner.lightweight_encoding)
+            {
+                ColumnPtr full_column = column_ptr->convertToFullColumnIfConst();
+                EncodeColumnLightweight(*col_type_name.type, full_column ? *full_column : *column_ptr, *ostr_ptr);
+            }
+            else
+            {
+                WriteColumnData(*col_type_name.type, column_ptr, *ostr_ptr, 0, 0);
+            }
         }
 
         inner.encoded_rows += rows;
@@ -426,9 +440,10 @@ struct CHBlockChunkCodecV1Impl
     }
 };
 
-CHBlockChunkCodecV1::CHBlockChunkCodecV1(const Block & header_)
+CHBlockChunkCodecV1::CHBlockChunkCodecV1(const Block & header_, bool lightweight_encoding_)
     : header(header_)
     , header_size(ApproxBlockHeaderBytes(header))
+    , lightweight_encoding(lightweight_encoding_)
 {
 }
 
@@ -495,16 +510,16 @@ CHBlockChunkCodecV1::EncodeRes CHBlockChunkCodecV1::encode(const std::vector<Blo
     return CHBlockChunkCodecV1Impl{*this}.encode(blocks, compression_method);
 }
 
-static Block decodeCompression(const Block & header, ReadBuffer & istr)
+static Block decodeCompression(const Block & header, ReadBuffer & istr, bool lightweight_encoding)
 {
     size_t decoded_rows{};
     auto decoded_block = DecodeHeader(istr, header, decoded_rows);
-    DecodeColumns(istr, decoded_block, decoded_rows, 0);
+    DecodeColumns(istr, decoded_block, decoded_rows, 0, lightweight_encoding);
     assert(decoded_rows == decoded_block.rows());
     return decoded_block;
 }
 
-Block CHBlockChunkCodecV1::decode(const Block & header, std::string_view str)
+Block CHBlockChunkCodecV1::decode(const Block & header, std::string_view str, bool lightweight_encoding)
 {
     assert(!str.empty());
 
@@ -513,11 +528,11 @@ Block CHBlockChunkCodecV1::decode(const Block & header, std::string_view str)
     {
         str = str.substr(1, str.size() - 1);
         ReadBufferFromString buff_str(str);
-        return decodeCompression(header, buff_str);
+        return decodeCompression(header, buff_str, lightweight_encoding);
     }
     ReadBufferFromString buff_str(str);
     auto && istr = CompressedCHBlockChunkReadBuffer(buff_str);
-    return decodeCompression(header, istr);
+    return decodeCompression(header, istr, lightweight_encoding);
 }
 
 } // namespace DB
\ No newline at end of file
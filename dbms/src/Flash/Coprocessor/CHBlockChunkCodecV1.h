@@ -25,7 +25,7 @@ size_t ApproxBlockHeaderBytes(const Block & block);
 using CompressedCHBlockChunkReadBuffer = CompressedReadBuffer<false>;
 using CompressedCHBlockChunkWriteBuffer = CompressedWriteBuffer<false>;
 void EncodeHeader(WriteBuffer & ostr, const Block & header, size_t rows);
-void DecodeColumns(ReadBuffer & istr, Block & res, size_t rows_to_read, size_t reserve_size = 0);
+void DecodeColumns(ReadBuffer & istr, Block & res, size_t rows_to_read, size_t reserve_size = 0, bool lightweight_encoding = false);
 Block DecodeHeader(ReadBuffer & istr, const Block & header, size_t & rows);
 CompressionMethod ToInternalCompressionMethod(tipb::CompressionMode compression_mode);
 extern void WriteColumnData(const IDataType & type, const ColumnPtr & column, WriteBuffer & ostr, size_t offset, size_t limit);
@@ -37,13 +37,15 @@ struct CHBlockChunkCodecV1 : boost::noncopyable
 
     const Block & header;
     const size_t header_size;
+    // Whether to encode columns by `EncodeColumnLightweight`, used by MPPDataPacketV2
+    const bool lightweight_encoding;
 
     size_t encoded_rows{};
     size_t original_size{};
     size_t compressed_size{};
 
     void clear();
-    explicit CHBlockChunkCodecV1(const Block & header_);
+    explicit CHBlockChunkCodecV1(const Block & header_, bool lightweight_encoding_ = false);
     //
     EncodeRes encode(const MutableColumns & columns, CompressionMethod compression_method);
     EncodeRes encode(std::vector<MutableColumns> && columns, CompressionMethod compression_method);
@@ -54,7 +56,7 @@ struct CHBlockChunkCodecV1 : boost::noncopyable
     EncodeRes encode(const Block & block, CompressionMethod compression_method, bool check_schema = true);
     EncodeRes encode(const std::vector<Block> & blocks, CompressionMethod compression_method, bool check_schema = true);
     //
-    static Block decode(const Block & header, std::string_view str);
+    static Block decode(const Block & header, std::string_view str, bool lightweight_encoding = false);
 };
 
 } // namespace DB
@@ -26,7 +26,7 @@ CHBlockChunkDecodeAndSquash::CHBlockChunkDecodeAndSquash(
 {
 }
 
-std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquashV1(std::string_view sv)
+std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquashV1(std::string_view sv, bool lightweight_encoding)
 {
     if unlikely (sv.empty())
     {
@@ -40,15 +40,15 @@ std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquashV1(std::string_
     if (static_cast<CompressionMethodByte>(sv[0]) == CompressionMethodByte::NONE)
     {
         ReadBufferFromString istr(sv.substr(1, sv.size() - 1));
-        return decodeAndSquashV1Impl(istr);
+        return decodeAndSquashV1Impl(istr, lightweight_encoding);
     }
 
     ReadBufferFromString istr(sv);
     auto && compress_buffer = CompressedCHBlockChunkReadBuffer(istr);
-    return decodeAndSquashV1Impl(compress_buffer);
+    return decodeAndSquashV1Impl(compress_buffer, lightweight_encoding);
 }
 
-std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquashV1Impl(ReadBuffer & istr)
+std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquashV1Impl(ReadBuffer & istr, bool lightweight_encoding)
 {
     std::optional<Block> res;
 
@@ -58,7 +58,7 @@ std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquashV1Impl(ReadBuff
         Block block = DecodeHeader(istr, codec.header, rows);
         if (rows)
         {
-            DecodeColumns(istr, block, rows, static_cast<size_t>(rows_limit * 1.5));
+            DecodeColumns(istr, block, rows, static_cast<size_t>(rows_limit * 1.5), lightweight_encoding);
             accumulated_block.emplace(std::move(block));
         }
     }
@@ -66,7 +66,7 @@ std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquashV1Impl(ReadBuff
     {
         size_t rows{};
         DecodeHeader(istr, codec.header, rows);
-        DecodeColumns(istr, *accumulated_block, rows, 0);
+        DecodeColumns(istr, *accumulated_block, rows, 0, lightweight_encoding);
     }
 
     if (accumulated_block && accumulated_block->rows() >= rows_limit)
@@ -27,11 +27,11 @@ public:
     CHBlockChunkDecodeAndSquash(const Block & header, size_t rows_limit_);
     ~CHBlockChunkDecodeAndSquash() = default;
     std::optional<Block> decodeAndSquash(const String &);
-    std::optional<Block> decodeAndSquashV1(std::string_view);
+    std::optional<Block> decodeAndSquashV1(std::string_view, bool lightweight_encoding = false);
     std::optional<Block> flush();
 
 private:
-    std::optional<Block> decodeAndSquashV1Impl(ReadBuffer & istr);
+    std::optional<Block> decodeAndSquashV1Impl(ReadBuffer & istr, bool lightweight_encoding);
 
 private:
     CHBlockChunkCodec codec;
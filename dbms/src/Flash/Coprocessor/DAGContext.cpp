@@ -13,8 +13,11 @@
 // limitations under the License.
 
 #include <DataStreams/IProfilingBlockInputStream.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <Flash/Coprocessor/DAGCodec.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/DAGUtils.h>
+#include <Flash/Coprocessor/JoinInterpreterHelper.h>
 #include <Flash/Coprocessor/collectOutputFieldTypes.h>
 #include <Flash/Mpp/ExchangeReceiver.h>
 #include <Flash/Statistics/traverseExecutors.h>
@@ -207,6 +210,87 @@ void DAGContext::initExecutorIdToJoinIdMap()
     });
 }
 
+namespace
+{
+bool isIntegerColumnType(Int32 tp)
+{
+    switch (tp)
+    {
+    case TiDB::TypeTiny:
+    case TiDB::TypeShort:
+    case TiDB::TypeInt24:
+    case TiDB::TypeLong:
+    case TiDB::TypeLongLong:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Return the table scan under the probe side of the join, skipping the selections.
+const tipb::Executor * getProbeTableScan(const tipb::Executor & probe_child)
+{
+    const tipb::Executor * executor = &probe_child;
+    while (executor->tp() == tipb::ExecType::TypeSelection)
+        executor = &executor->selection().child();
+    if (executor->tp() == tipb::ExecType::TypeTableScan || executor->tp() == tipb::ExecType::TypePartitionTableScan)
+        return executor;
+    return nullptr;
+}
+} // namespace
+
+void DAGContext::initRuntimeFilters(size_t max_in_values, size_t bloom_filter_bits)
+{
+    // for mpp, all executor has executor id.
+    if (!isMPPTask())
+        return;
+
+    join_runtime_filters.clear();
+    table_scan_runtime_filters.clear();
+    traverseExecutors(dag_request, [&](const tipb::Executor & executor) {
+        if (executor.tp() != tipb::ExecType::TypeJoin || executor.join().left_join_keys_size() == 0)
+            return true;
+        const auto & join = executor.join();
+        JoinInterpreterHelper::TiFlashJoin tiflash_join{join};
+        // Only the probe rows matched by some build rows are output by inner and (tiflash) right join.
+        if (tiflash_join.kind != ASTTableJoin::Kind::Inner && tiflash_join.kind != ASTTableJoin::Kind::Right)
+            return true;
+        const auto * table_scan = getProbeTableScan(join.children(1 - tiflash_join.build_side_index));
+        if (!table_scan)
+            return true;
+        const auto & columns = table_scan->tp() == tipb::ExecType::TypeTableScan
+            ? table_scan->tbl_scan().columns()
+            : table_scan->partition_table_scan().columns();
+
+        const auto & probe_keys = tiflash_join.getProbeJoinKeys();
+        for (int i = 0; i < probe_keys.size(); ++i)
+        {
+            const auto & key = probe_keys[i];
+            if (!isColumnExpr(key) || !removeNullable(tiflash_join.join_key_types[i].key_type)->isInteger())
+                continue;
+            auto column_index = decodeDAGInt64(key.val());
+            if (column_index < 0 || column_index >= columns.size() || !isIntegerColumnType(columns[column_index].tp()))
+                continue;
+            auto runtime_filter = std::make_shared<RuntimeFilter>(i, columns[column_index].column_id(), column_index, max_in_values, bloom_filter_bits);
+            join_runtime_filters[executor.executor_id()].push_back(runtime_filter);
+            table_scan_runtime_filters[table_scan->executor_id()].push_back(runtime_filter);
+        }
+        return true;
+    });
+}
+
+RuntimeFilters DAGContext::getJoinRuntimeFilters(const String & join_executor_id) const
+{
+    auto it = join_runtime_filters.find(join_executor_id);
+    return it == join_runtime_filters.end() ? RuntimeFilters{} : it->second;
+}
+
+RuntimeFilters DAGContext::getTableScanRuntimeFilters(const String & table_scan_executor_id) const
+{
+    auto it = table_scan_runtime_filters.find(table_scan_executor_id);
+    return it == table_scan_runtime_filters.end() ? RuntimeFilters{} : it->second;
+}
+
 std::unordered_map<String, std::vector<String>> & DAGContext::getExecutorIdToJoinIdMap()
 {
     return executor_id_to_join_id_map;
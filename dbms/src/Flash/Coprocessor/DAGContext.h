@@ -31,6 +31,7 @@
 #include <Flash/Coprocessor/FineGrainedShuffle.h>
 #include <Flash/Coprocessor/TablesRegionsInfo.h>
 #include <Flash/Mpp/MPPTaskId.h>
+#include <Interpreters/RuntimeFilter.h>
 #include <Interpreters/SubqueryForSet.h>
 #include <Parsers/makeDummyQuery.h>
 #include <Storages/Transaction/TiDB.h>
@@ -144,6 +145,14 @@ public:
 
     std::unordered_map<String, JoinExecuteInfo> & getJoinExecuteInfoMap();
     std::unordered_map<String, BlockInputStreams> & getInBoundIOInputStreamsMap();
+
+    /// Register the runtime filters for the joins whose probe side is a table scan in the same mpp task.
+    /// It must be called before the executors are built, because the probe side table scan may be built before the join.
+    void initRuntimeFilters(size_t max_in_values, size_t bloom_filter_bits);
+    /// The runtime filters built by the join executor.
+    RuntimeFilters getJoinRuntimeFilters(const String & join_executor_id) const;
+    /// The runtime filters applied by the table scan executor.
+    RuntimeFilters getTableScanRuntimeFilters(const String & table_scan_executor_id) const;
     void handleTruncateError(const String & msg);
     void handleOverflowError(const String & msg, const TiFlashError & error);
     void handleDivisionByZero();
@@ -327,6 +336,10 @@ private:
     /// join_execute_info_map is a map that maps from join_probe_executor_id to JoinExecuteInfo
     /// DAGResponseWriter / JoinStatistics gets JoinExecuteInfo through it.
     std::unordered_map<std::string, JoinExecuteInfo> join_execute_info_map;
+    /// join executor id -> runtime filters built by the join.
+    std::unordered_map<String, RuntimeFilters> join_runtime_filters;
+    /// table scan executor id -> runtime filters applied by the table scan.
+    std::unordered_map<String, RuntimeFilters> table_scan_runtime_filters;
     /// profile_streams_map is a map that maps from executor_id (table_scan / exchange_receiver) to BlockInputStreams.
     /// BlockInputStreams contains ExchangeReceiverInputStream, CoprocessorBlockInputStream and local_read_input_stream etc.
     std::unordered_map<String, BlockInputStreams> inbound_io_input_streams_map;
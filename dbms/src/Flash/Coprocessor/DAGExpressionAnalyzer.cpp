@@ -186,6 +186,7 @@ void appendWindowDescription(
     window_function_description.argument_names = arg_names;
     window_function_description.column_name = func_string;
     window_function_description.window_function = WindowFunctionFactory::instance().get(window_func_name, arg_types);
+    window_function_description.window_function->setCollators(arg_collators);
     DataTypePtr result_type = window_function_description.window_function->getReturnType();
     window_description.window_functions_descriptions.emplace_back(std::move(window_function_description));
     window_columns.emplace_back(func_string, result_type);
@@ -456,7 +457,7 @@ std::tuple<Names, TiDB::TiDBCollators, AggregateDescriptions, ExpressionActionsP
     source_columns = std::move(aggregated_columns);
 
     auto before_agg = chain.getLastActions();
-    chain.finalize();
+    chain.finalize(context.getSettingsRef().enable_short_circuit_evaluation);
     chain.clear();
 
     auto & after_agg_step = initAndGetLastStep(chain);
@@ -481,6 +482,41 @@ bool isWindowFunctionsValid(const tipb::Window & window)
     return !(has_agg_func && has_window_func);
 }
 
+String getAggWindowFunctionName(const tipb::Expr & expr)
+{
+    RUNTIME_CHECK_MSG(!expr.has_distinct(), "distinct aggregate function is not supported in window.");
+    // avg is always split into sum and count in aggregation, so it isn't in the map of aggregate function names.
+    if (expr.tp() == tipb::ExprType::Avg)
+        return "avg";
+    return getAggFunctionName(expr);
+}
+
+/// The precision of the decimal which can hold all the values of the integer type.
+PrecType getIntegerPrecision(const IDataType & type)
+{
+    switch (type.getTypeId())
+    {
+    case TypeIndex::Int8:
+        return IntPrec<Int8>::prec;
+    case TypeIndex::UInt8:
+        return IntPrec<UInt8>::prec;
+    case TypeIndex::Int16:
+        return IntPrec<Int16>::prec;
+    case TypeIndex::UInt16:
+        return IntPrec<UInt16>::prec;
+    case TypeIndex::Int32:
+        return IntPrec<Int32>::prec;
+    case TypeIndex::UInt32:
+        return IntPrec<UInt32>::prec;
+    case TypeIndex::Int64:
+        return IntPrec<Int64>::prec;
+    case TypeIndex::UInt64:
+        return IntPrec<UInt64>::prec;
+    default:
+        throw Exception(fmt::format("{} is not an integer type", type.getName()), ErrorCodes::LOGICAL_ERROR);
+    }
+}
+
 SortDescription DAGExpressionAnalyzer::getWindowSortDescription(const ::google::protobuf::RepeatedPtrField<tipb::ByItem> & by_items) const
 {
     NamesAndTypes by_item_columns;
@@ -574,6 +610,41 @@ void DAGExpressionAnalyzer::buildLeadLag(
         window_columns);
 }
 
+void DAGExpressionAnalyzer::buildAvgWindowFunc(
+    const tipb::Expr & expr,
+    const ExpressionActionsPtr & actions,
+    WindowDescription & window_description,
+    NamesAndTypes & source_columns,
+    NamesAndTypes & window_columns)
+{
+    RUNTIME_CHECK_MSG(expr.children_size() == 1, "avg window function must have exactly one argument.");
+    Names arg_names;
+    DataTypes arg_types;
+    TiDB::TiDBCollators arg_collators;
+    fillArgumentDetail(actions, expr.children(0), arg_names, arg_types, arg_collators);
+
+    // avg of integers returns Float64, which loses precision when it is cast to the decimal result type of TiDB.
+    // Cast the integer argument to decimal so that avg keeps the exact result like the decimal arguments.
+    const auto & nested_type = removeNullable(arg_types[0]);
+    if (nested_type->isInteger())
+    {
+        DataTypePtr decimal_type = createDecimal(getIntegerPrecision(*nested_type), 0);
+        if (arg_types[0]->isNullable())
+            decimal_type = makeNullable(decimal_type);
+        arg_names[0] = appendCast(decimal_type, actions, arg_names[0]);
+        arg_types[0] = decimal_type;
+    }
+
+    appendWindowDescription(
+        arg_names,
+        arg_types,
+        arg_collators,
+        getAggWindowFunctionName(expr),
+        window_description,
+        source_columns,
+        window_columns);
+}
+
 void DAGExpressionAnalyzer::buildCommonWindowFunc(
     const tipb::Expr & expr,
     const ExpressionActionsPtr & actions,
@@ -610,7 +681,18 @@ void DAGExpressionAnalyzer::appendWindowColumns(WindowDescription & window_descr
     NamesAndTypes window_columns;
     for (const tipb::Expr & expr : window.func_desc())
     {
-        RUNTIME_CHECK_MSG(isWindowFunctionExpr(expr), "Now Window Operator only support window function.");
+        if (expr.tp() == tipb::ExprType::Avg)
+        {
+            buildAvgWindowFunc(expr, actions, window_description, source_columns, window_columns);
+            continue;
+        }
+        if (isAggFunctionExpr(expr))
+        {
+            buildCommonWindowFunc(expr, actions, getAggWindowFunctionName(expr), window_description, source_columns, window_columns);
+            continue;
+        }
+
+        RUNTIME_CHECK_MSG(isWindowFunctionExpr(expr), "Now Window Operator only support window function and aggregate function.");
         if (expr.tp() == tipb::ExprType::Lead || expr.tp() == tipb::ExprType::Lag)
         {
             buildLeadLag(expr, actions, getWindowFunctionName(expr), window_description, source_columns, window_columns);
@@ -647,7 +729,7 @@ WindowDescription DAGExpressionAnalyzer::buildWindowDescription(const tipb::Wind
     }
 
     window_description.before_window = chain.getLastActions();
-    chain.finalize();
+    chain.finalize(context.getSettingsRef().enable_short_circuit_evaluation);
     chain.clear();
 
 
@@ -656,7 +738,7 @@ WindowDescription DAGExpressionAnalyzer::buildWindowDescription(const tipb::Wind
     window_description.after_window_columns = getCurrentInputColumns();
     appendSourceColumnsToRequireOutput(after_window_step);
     window_description.after_window = chain.getLastActions();
-    chain.finalize();
+    chain.finalize(context.getSettingsRef().enable_short_circuit_evaluation);
     chain.clear();
 
     return window_description;
@@ -855,7 +937,7 @@ ExpressionActionsPtr DAGExpressionAnalyzer::appendExpand(
     last_step.actions->add(ExpressionAction::expandSource(grouping_sets));
 
     auto before_expand = chain.getLastActions();
-    chain.finalize();
+    chain.finalize(context.getSettingsRef().enable_short_circuit_evaluation);
     chain.clear();
 
     auto & after_expand_step = initAndGetLastStep(chain);
@@ -232,6 +232,13 @@ private:
         NamesAndTypes & source_columns,
         NamesAndTypes & window_columns);
 
+    void buildAvgWindowFunc(
+        const tipb::Expr & expr,
+        const ExpressionActionsPtr & actions,
+        WindowDescription & window_description,
+        NamesAndTypes & source_columns,
+        NamesAndTypes & window_columns);
+
     void buildCommonWindowFunc(
         const tipb::Expr & expr,
         const ExpressionActionsPtr & actions,
@@ -28,6 +28,7 @@
 #include <DataStreams/MockTableScanBlockInputStream.h>
 #include <DataStreams/NullBlockInputStream.h>
 #include <DataStreams/ParallelAggregatingBlockInputStream.h>
+#include <DataStreams/StreamingAggregatingBlockInputStream.h>
 #include <DataStreams/TiRemoteBlockInputStream.h>
 #include <DataStreams/WindowBlockInputStream.h>
 #include <Flash/Coprocessor/AggregationInterpreterHelper.h>
@@ -154,7 +155,7 @@ AnalysisResult analyzeExpressions(
 
     res.before_select = chain.getLastActions();
 
-    chain.finalize();
+    chain.finalize(context.getSettingsRef().enable_short_circuit_evaluation);
     chain.clear();
     //todo need call prependProjectInput??
     return res;
@@ -212,6 +213,7 @@ void DAGQueryBlockInterpreter::handleTableScan(const TiDBTableScan & table_scan,
         storage_interpreter.execute(pipeline);
 
         analyzer = std::move(storage_interpreter.analyzer);
+        sort_key_column_name = storage_interpreter.sort_key_column_name;
     }
 }
 
@@ -288,6 +290,9 @@ void DAGQueryBlockInterpreter::handleJoin(const tipb::Join & join, DAGPipeline &
         max_block_size_for_cross_join,
         match_helper_name);
 
+    JoinInterpreterHelper::setJoinSpillConfig(context, *join_ptr, log->identifier());
+    join_ptr->setRuntimeFilters(dagContext().getJoinRuntimeFilters(query_block.source_name));
+
     recordJoinExecuteInfo(tiflash_join.build_side_index, join_ptr);
 
     auto & join_execute_info = dagContext().getJoinExecuteInfoMap()[query_block.source_name];
@@ -370,11 +375,14 @@ void DAGQueryBlockInterpreter::executeWindow(
 {
     executeExpression(pipeline, window_description.before_window, log, "before window");
 
+    const Settings & settings = context.getSettingsRef();
+    SpillConfig spill_config(context.getTemporaryPath(), fmt::format("{}_window", log->identifier()), settings.max_cached_data_bytes_in_spiller, settings.max_spilled_rows_per_file, settings.max_spilled_bytes_per_file, context.getFileProvider());
+
     if (enable_fine_grained_shuffle)
     {
         /// Window function can be multiple threaded when fine grained shuffle is enabled.
         pipeline.transform([&](auto & stream) {
-            stream = std::make_shared<WindowBlockInputStream>(stream, window_description, log->identifier());
+            stream = std::make_shared<WindowBlockInputStream>(stream, window_description, settings.max_bytes_before_external_window, spill_config, log->identifier());
             stream->setExtraInfo(String(enableFineGrainedShuffleExtraInfo));
         });
     }
@@ -383,7 +391,7 @@ void DAGQueryBlockInterpreter::executeWindow(
         /// If there are several streams, we merge them into one.
         executeUnion(pipeline, max_streams, log, false, "merge into one for window input");
         assert(pipeline.streams.size() == 1);
-        pipeline.firstStream() = std::make_shared<WindowBlockInputStream>(pipeline.firstStream(), window_description, log->identifier());
+        pipeline.firstStream() = std::make_shared<WindowBlockInputStream>(pipeline.firstStream(), window_description, settings.max_bytes_before_external_window, spill_config, log->identifier());
     }
 }
 
@@ -427,6 +435,16 @@ void DAGQueryBlockInterpreter::executeAggregation(
         });
         recordProfileStreams(pipeline, query_block.aggregation_name);
     }
+    else if (AggregationInterpreterHelper::isAllowToUseStreamingAgg(context, pipeline.streams.size(), key_names, sort_key_column_name))
+    {
+        /// The input is sorted by the group by key, emit every group once its key changes instead of building a hash table.
+        pipeline.firstStream() = std::make_shared<StreamingAggregatingBlockInputStream>(
+            pipeline.firstStream(),
+            params,
+            true,
+            log->identifier());
+        recordProfileStreams(pipeline, query_block.aggregation_name);
+    }
     else if (pipeline.streams.size() > 1)
     {
         /// If there are several sources, then we perform parallel aggregation
@@ -786,6 +804,8 @@ void DAGQueryBlockInterpreter::handleExchangeSender(DAGPipeline & pipeline)
             batch_size,
             exchange_sender.compression(),
             context.getSettingsRef().batch_send_min_limit_compression,
+            context.getSettingsRef().mpp_exchange_adaptive_compression_bandwidth,
+            context.getSettingsRef().mpp_exchange_lightweight_encoding,
             log->identifier());
         stream = std::make_shared<ExchangeSenderBlockInputStream>(stream, std::move(response_writer), log->identifier());
         stream->setExtraInfo(extra_info);
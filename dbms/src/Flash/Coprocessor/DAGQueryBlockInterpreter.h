@@ -107,6 +107,8 @@ private:
     size_t max_streams = 1;
 
     std::unique_ptr<DAGExpressionAnalyzer> analyzer;
+    /// The column that the output of the table scan is sorted by, empty if it is not sorted.
+    String sort_key_column_name;
 
     LoggerPtr log;
 };
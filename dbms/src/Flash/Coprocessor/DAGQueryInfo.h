@@ -17,6 +17,7 @@
 #include <Core/NamesAndTypes.h>
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
 #include <Flash/Coprocessor/DAGQuerySource.h>
+#include <Interpreters/RuntimeFilter.h>
 
 #include <unordered_map>
 
@@ -43,5 +44,8 @@ struct DAGQueryInfo
     const NamesAndTypes & source_columns;
 
     const TimezoneInfo & timezone_info;
+    // Runtime filters pushed down from the joins whose probe side is this table scan,
+    // they may still be building when the storage engine reads.
+    RuntimeFilters runtime_filters;
 };
 } // namespace DB
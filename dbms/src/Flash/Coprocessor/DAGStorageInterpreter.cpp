@@ -23,7 +23,9 @@
 #include <DataStreams/IProfilingBlockInputStream.h>
 #include <DataStreams/MultiplexInputStream.h>
 #include <DataStreams/NullBlockInputStream.h>
+#include <DataStreams/RuntimeFilterBlockInputStream.h>
 #include <DataStreams/TiRemoteBlockInputStream.h>
+#include <DataTypes/DataTypeNullable.h>
 #include <Flash/Coprocessor/ChunkCodec.h>
 #include <Flash/Coprocessor/CoprocessorReader.h>
 #include <Flash/Coprocessor/DAGContext.h>
@@ -266,6 +268,7 @@ DAGStorageInterpreter::DAGStorageInterpreter(
     , log(Logger::get(context.getDAGContext()->log ? context.getDAGContext()->log->identifier() : ""))
     , logical_table_id(table_scan.getLogicalTableID())
     , tmt(context.getTMTContext())
+    , runtime_filters(dagContext().getTableScanRuntimeFilters(table_scan.getTableScanExecutorID()))
     , mvcc_query_info(new MvccQueryInfo(true, context.getSettingsRef().read_tso))
 {
     if (unlikely(!hasRegionToRead(dagContext(), table_scan)))
@@ -338,8 +341,15 @@ void DAGStorageInterpreter::executeImpl(DAGPipeline & pipeline)
     executeCastAfterTableScan(remote_read_streams_start_index, pipeline);
     /// handle generated column if necessary.
     executeGeneratedColumnPlaceholder(remote_read_streams_start_index, generated_column_infos, log, pipeline);
+    /// handle runtime filters from the join build side for local and remote table scan.
+    executeRuntimeFilter(pipeline);
     recordProfileStreams(pipeline, table_scan.getTableScanExecutorID());
 
+    /// A single local stream of a single physical table that keeps order is sorted by the handle, and the streams appended above keep the order.
+    /// The streaming aggregation relies on it, see `StreamingAggregatingBlockInputStream`.
+    if (handle_column_index && isSortedByHandle(table_scan, local_physical_table_num, !remote_requests.empty(), pipeline.streams.size()))
+        sort_key_column_name = analyzer->getCurrentInputColumns()[*handle_column_index].name;
+
     /// handle filter conditions for local and remote table scan.
     if (filter_conditions.hasValue())
     {
@@ -409,6 +419,28 @@ void DAGStorageInterpreter::executeCastAfterTableScan(
     }
 }
 
+void DAGStorageInterpreter::executeRuntimeFilter(DAGPipeline & pipeline)
+{
+    RuntimeFilters filters;
+    Names column_names;
+    const auto & source_columns = analyzer->getCurrentInputColumns();
+    for (const auto & runtime_filter : runtime_filters)
+    {
+        auto index = runtime_filter->target_column_index;
+        if (index >= source_columns.size() || table_scan.getColumns()[index].hasGeneratedColumnFlag())
+            continue;
+        filters.push_back(runtime_filter);
+        column_names.push_back(source_columns[index].name);
+    }
+    if (filters.empty())
+        return;
+
+    UInt64 wait_time_ms = context.getSettingsRef().runtime_filter_wait_time_ms;
+    pipeline.transform([&](auto & stream) {
+        stream = std::make_shared<RuntimeFilterBlockInputStream>(stream, filters, column_names, wait_time_ms, log->identifier());
+    });
+}
+
 std::vector<pingcap::coprocessor::CopTask> DAGStorageInterpreter::buildCopTasks(const std::vector<RemoteRequest> & remote_requests)
 {
     assert(!remote_requests.empty());
@@ -486,6 +518,16 @@ DAGContext & DAGStorageInterpreter::dagContext() const
     return *context.getDAGContext();
 }
 
+bool DAGStorageInterpreter::isSortedByHandle(
+    const TiDBTableScan & table_scan,
+    size_t local_physical_table_num,
+    bool has_remote_requests,
+    size_t stream_num)
+{
+    return table_scan.keepOrder() && !table_scan.isFastScan() && !table_scan.isPartitionTableScan()
+        && local_physical_table_num == 1 && !has_remote_requests && stream_num == 1;
+}
+
 void DAGStorageInterpreter::recordProfileStreams(DAGPipeline & pipeline, const String & key)
 {
     auto & profile_streams = dagContext().getProfileStreamsMap()[key];
@@ -586,6 +628,7 @@ std::unordered_map<TableID, SelectQueryInfo> DAGStorageInterpreter::generateSele
             analyzer->getPreparedSets(),
             analyzer->getCurrentInputColumns(),
             context.getTimezoneInfo());
+        query_info.dag_query->runtime_filters = runtime_filters;
         query_info.req_id = fmt::format("{} table_id={}", log->identifier(), table_id);
         query_info.keep_order = table_scan.keepOrder();
         query_info.is_fast_scan = table_scan.isFastScan();
@@ -741,6 +784,7 @@ void DAGStorageInterpreter::buildLocalStreams(DAGPipeline & pipeline, size_t max
         return;
     mvcc_query_info->scan_context->total_local_region_num = total_local_region_num;
     const auto table_query_infos = generateSelectQueryInfos();
+    local_physical_table_num = table_query_infos.size();
     bool has_multiple_partitions = table_query_infos.size() > 1;
     // MultiPartitionStreamPool will be disabled in no partition mode or single-partition case
     std::shared_ptr<MultiPartitionStreamPool> stream_pool = has_multiple_partitions ? std::make_shared<MultiPartitionStreamPool>() : nullptr;
@@ -970,6 +1014,10 @@ std::tuple<Names, NamesAndTypes, std::vector<ExtraCastAfterTSMode>> DAGStorageIn
             auto pair = storage_for_logical_table->getColumns().getPhysical(name);
             source_columns_tmp.emplace_back(std::move(pair));
         }
+        // The storage sorts the int handle as Int64, so an unsigned handle column is not in order.
+        if (!storage_for_logical_table->getTableInfo().is_common_handle && name == handle_column_name
+            && !removeNullable(source_columns_tmp.back().type)->isUnsignedInteger())
+            handle_column_index = i;
         required_columns_tmp.emplace_back(std::move(name));
         if (cid != -1 && ci.tp == TiDB::TypeTimestamp)
             need_cast_column.push_back(ExtraCastAfterTSMode::AppendTimeZoneCast);
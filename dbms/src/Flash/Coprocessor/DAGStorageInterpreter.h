@@ -20,6 +20,7 @@
 #include <Flash/Coprocessor/FilterConditions.h>
 #include <Flash/Coprocessor/RemoteRequest.h>
 #include <Flash/Coprocessor/TiDBTableScan.h>
+#include <Interpreters/RuntimeFilter.h>
 #include <Storages/RegionQueryInfo.h>
 #include <Storages/SelectQueryInfo.h>
 #include <Storages/TableLockHolder.h>
@@ -29,6 +30,7 @@
 #include <Storages/Transaction/Types.h>
 #include <pingcap/coprocessor/Client.h>
 
+#include <optional>
 #include <vector>
 
 namespace DB
@@ -51,9 +53,22 @@ public:
 
     void execute(DAGPipeline & pipeline);
 
+    /// Whether the local streams of the table scan are sorted by the handle.
+    /// Only a single stream reading a single physical table keeps the order,
+    /// the streams of a partition table scan are multiplexed across partitions, see `MultiplexInputStream`.
+    static bool isSortedByHandle(
+        const TiDBTableScan & table_scan,
+        size_t local_physical_table_num,
+        bool has_remote_requests,
+        size_t stream_num);
+
     /// Members will be transferred to DAGQueryBlockInterpreter after execute
 
     std::unique_ptr<DAGExpressionAnalyzer> analyzer;
+    /// The column that the output stream is sorted by, empty if the output is not sorted.
+    /// It is only set when there is a single stream that reads the signed int handle of a single physical table
+    /// in order from the local storage, which guarantees the order.
+    String sort_key_column_name;
 
 private:
     struct StorageWithStructureLock
@@ -98,6 +113,8 @@ private:
         size_t remote_read_streams_start_index,
         DAGPipeline & pipeline);
 
+    void executeRuntimeFilter(DAGPipeline & pipeline);
+
     void prepare();
 
     void executeImpl(DAGPipeline & pipeline);
@@ -119,6 +136,8 @@ private:
 
     const TableID logical_table_id;
     TMTContext & tmt;
+    /// Runtime filters pushed down from the joins whose probe side is this table scan.
+    const RuntimeFilters runtime_filters;
 
     /// Intermediate variables shared by multiple member functions
 
@@ -136,6 +155,10 @@ private:
     NamesAndTypes source_columns;
     // For generated column, just need a placeholder, and TiDB will fill this column.
     std::vector<std::tuple<UInt64, String, DataTypePtr>> generated_column_infos;
+    // The index of the int handle column in the table scan columns, if it is read.
+    std::optional<size_t> handle_column_index;
+    // The number of physical tables read from the local storage.
+    size_t local_physical_table_num = 0;
 };
 
 } // namespace DB
@@ -352,5 +352,27 @@ std::tuple<ExpressionActionsPtr, Names, String> prepareJoin(
     dag_analyzer.appendJoinKeyAndJoinFilters(chain, keys, join_key_types, key_names, left, is_right_out_join, filters, filter_column_name);
     return {chain.getLastActions(), std::move(key_names), std::move(filter_column_name)};
 }
+
+void setJoinSpillConfig(const Context & context, Join & join, const String & req_id)
+{
+    const auto & settings = context.getSettingsRef();
+    if (settings.max_bytes_before_external_join == 0)
+        return;
+    SpillConfig build_spill_config(
+        context.getTemporaryPath(),
+        fmt::format("{}_hash_join_build", req_id),
+        settings.max_cached_data_bytes_in_spiller,
+        settings.max_spilled_rows_per_file,
+        settings.max_spilled_bytes_per_file,
+        context.getFileProvider());
+    SpillConfig probe_spill_config(
+        context.getTemporaryPath(),
+        fmt::format("{}_hash_join_probe", req_id),
+        settings.max_cached_data_bytes_in_spiller,
+        settings.max_spilled_rows_per_file,
+        settings.max_spilled_bytes_per_file,
+        context.getFileProvider());
+    join.setSpillConfig(build_spill_config, probe_spill_config, settings.max_bytes_before_external_join, settings.join_spill_partition_num);
+}
 } // namespace JoinInterpreterHelper
 } // namespace DB
@@ -28,6 +28,7 @@
 namespace DB
 {
 class Context;
+class Join;
 
 struct JoinKeyType
 {
@@ -127,5 +128,8 @@ std::tuple<ExpressionActionsPtr, Names, String> prepareJoin(
     bool left,
     bool is_right_out_join,
     const google::protobuf::RepeatedPtrField<tipb::Expr> & filters);
+
+/// Enable spill to disk for the join if `max_bytes_before_external_join` is set.
+void setJoinSpillConfig(const Context & context, Join & join, const String & req_id);
 } // namespace JoinInterpreterHelper
 } // namespace DB
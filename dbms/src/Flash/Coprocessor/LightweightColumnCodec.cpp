@@ -0,0 +1,446 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
+#include <Common/Exception.h>
+#include <Common/HashTable/HashMap.h>
+#include <Common/typeid_cast.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <Flash/Coprocessor/LightweightColumnCodec.h>
+#include <IO/ReadHelpers.h>
+#include <IO/WriteHelpers.h>
+
+namespace DB
+{
+namespace
+{
+/// Map integers to UInt64 keeping the order, so that signed and unsigned integers share the same code.
+template <typename T>
+UInt64 toOrdered(T value)
+{
+    if constexpr (std::is_signed_v<T>)
+        return static_cast<UInt64>(static_cast<Int64>(value)) ^ (1ULL << 63);
+    else
+        return static_cast<UInt64>(value);
+}
+
+template <typename T>
+T fromOrdered(UInt64 value)
+{
+    if constexpr (std::is_signed_v<T>)
+        return static_cast<T>(static_cast<Int64>(value ^ (1ULL << 63)));
+    else
+        return static_cast<T>(value);
+}
+
+UInt8 bitWidth(UInt64 value)
+{
+    return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+size_t bitPackedBytes(size_t count, UInt8 width)
+{
+    return (count * width + 7) / 8;
+}
+
+/// Write the lowest `width` bits of `get(i)` for each i in [0, count) in little endian.
+template <typename Getter>
+void writeBitPacked(size_t count, UInt8 width, Getter && get, WriteBuffer & ostr)
+{
+    if (width == 0)
+        return;
+    std::vector<UInt64> words((count * width + 63) / 64, 0);
+    size_t bit = 0;
+    for (size_t i = 0; i < count; ++i, bit += width)
+    {
+        const UInt64 value = get(i);
+        const size_t index = bit / 64;
+        const size_t offset = bit % 64;
+        words[index] |= value << offset;
+        if (offset + width > 64)
+            words[index + 1] |= value >> (64 - offset);
+    }
+    ostr.write(reinterpret_cast<const char *>(words.data()), bitPackedBytes(count, width));
+}
+
+template <typename Setter>
+void readBitPacked(size_t count, UInt8 width, Setter && set, ReadBuffer & istr)
+{
+    if (width == 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+            set(i, 0);
+        return;
+    }
+    // One more word, so that the value across the last word boundary can be read without checking.
+    std::vector<UInt64> words((count * width + 63) / 64 + 1, 0);
+    istr.readStrict(reinterpret_cast<char *>(words.data()), bitPackedBytes(count, width));
+    const UInt64 mask = width == 64 ? ~0ULL : (1ULL << width) - 1;
+    size_t bit = 0;
+    for (size_t i = 0; i < count; ++i, bit += width)
+    {
+        const size_t index = bit / 64;
+        const size_t offset = bit % 64;
+        UInt64 value = words[index] >> offset;
+        if (offset + width > 64)
+            value |= words[index + 1] << (64 - offset);
+        set(i, value & mask);
+    }
+}
+
+void writeEncoding(LightweightEncoding encoding, WriteBuffer & ostr)
+{
+    writeBinary(static_cast<UInt8>(encoding), ostr);
+}
+
+LightweightEncoding readEncoding(ReadBuffer & istr)
+{
+    UInt8 encoding = 0;
+    readBinary(encoding, istr);
+    return static_cast<LightweightEncoding>(encoding);
+}
+
+void writePlain(const IDataType & type, const IColumn & column, WriteBuffer & ostr)
+{
+    writeEncoding(LightweightEncoding::Plain, ostr);
+    type.serializeBinaryBulkWithMultipleStreams(
+        column,
+        [&](const IDataType::SubstreamPath &) { return &ostr; },
+        0,
+        0,
+        false,
+        {});
+}
+
+void readPlain(const IDataType & type, IColumn & column, ReadBuffer & istr, size_t rows)
+{
+    type.deserializeBinaryBulkWithMultipleStreams(
+        column,
+        [&](const IDataType::SubstreamPath &) { return &istr; },
+        rows,
+        0,
+        false,
+        {});
+}
+
+template <typename T>
+LightweightEncoding encodeInteger(const PaddedPODArray<T> & data, WriteBuffer & ostr)
+{
+    const size_t rows = data.size();
+    const size_t plain_bytes = rows * sizeof(T);
+    if (rows < 2)
+    {
+        writeEncoding(LightweightEncoding::Plain, ostr);
+        ostr.write(reinterpret_cast<const char *>(data.data()), plain_bytes);
+        return LightweightEncoding::Plain;
+    }
+
+    size_t runs = 1;
+    UInt64 min_value = toOrdered(data[0]);
+    UInt64 max_value = min_value;
+    Int64 min_delta = std::numeric_limits<Int64>::max();
+    Int64 max_delta = std::numeric_limits<Int64>::min();
+    for (size_t i = 1; i < rows; ++i)
+    {
+        const UInt64 value = toOrdered(data[i]);
+        const auto delta = static_cast<Int64>(value - toOrdered(data[i - 1]));
+        runs += delta != 0;
+        min_value = std::min(min_value, value);
+        max_value = std::max(max_value, value);
+        min_delta = std::min(min_delta, delta);
+        max_delta = std::max(max_delta, delta);
+    }
+    const UInt8 for_width = bitWidth(max_value - min_value);
+    const UInt8 delta_width = bitWidth(static_cast<UInt64>(max_delta) - static_cast<UInt64>(min_delta));
+
+    // Estimate the encoded sizes, the varint run length is assumed to take 2 bytes.
+    LightweightEncoding encoding = LightweightEncoding::Plain;
+    size_t min_bytes = plain_bytes;
+    auto try_encoding = [&](LightweightEncoding candidate, size_t bytes) {
+        if (bytes < min_bytes)
+        {
+            encoding = candidate;
+            min_bytes = bytes;
+        }
+    };
+    try_encoding(LightweightEncoding::RLE, sizeof(UInt64) + runs * (sizeof(T) + 2));
+    try_encoding(LightweightEncoding::FrameOfReference, sizeof(UInt64) + 1 + bitPackedBytes(rows, for_width));
+    try_encoding(LightweightEncoding::Delta, 2 * sizeof(UInt64) + 1 + bitPackedBytes(rows - 1, delta_width));
+
+    writeEncoding(encoding, ostr);
+    switch (encoding)
+    {
+    case LightweightEncoding::Plain:
+        ostr.write(reinterpret_cast<const char *>(data.data()), plain_bytes);
+        break;
+    case LightweightEncoding::RLE:
+    {
+        writeVarUInt(runs, ostr);
+        size_t begin = 0;
+        for (size_t i = 1; i <= rows; ++i)
+        {
+            if (i == rows || data[i] != data[begin])
+            {
+                writePODBinary(data[begin], ostr);
+                writeVarUInt(i - begin, ostr);
+                begin = i;
+            }
+        }
+        break;
+    }
+    case LightweightEncoding::FrameOfReference:
+        writeBinary(min_value, ostr);
+        writeBinary(for_width, ostr);
+        writeBitPacked(
+            rows,
+            for_width,
+            [&](size_t i) { return toOrdered(data[i]) - min_value; },
+            ostr);
+        break;
+    case LightweightEncoding::Delta:
+        writeBinary(toOrdered(data[0]), ostr);
+        writeBinary(min_delta, ostr);
+        writeBinary(delta_width, ostr);
+        writeBitPacked(
+            rows - 1,
+            delta_width,
+            [&](size_t i) { return toOrdered(data[i + 1]) - toOrdered(data[i]) - static_cast<UInt64>(min_delta); },
+            ostr);
+        break;
+    default:
+        break;
+    }
+    return encoding;
+}
+
+template <typename T>
+void decodeInteger(LightweightEncoding encoding, PaddedPODArray<T> & data, ReadBuffer & istr, size_t rows)
+{
+    const size_t old_size = data.size();
+    switch (encoding)
+    {
+    case LightweightEncoding::Plain:
+        data.resize(old_size + rows);
+        istr.readStrict(reinterpret_cast<char *>(&data[old_size]), rows * sizeof(T));
+        break;
+    case LightweightEncoding::RLE:
+    {
+        size_t runs = 0;
+        readVarUInt(runs, istr);
+        data.reserve(old_size + rows);
+        for (size_t i = 0; i < runs; ++i)
+        {
+            T value;
+            size_t length = 0;
+            readPODBinary(value, istr);
+            readVarUInt(length, istr);
+            RUNTIME_CHECK_MSG(data.size() + length <= old_size + rows, "Too many rows in RLE encoded column, expect {}", rows);
+            data.resize_fill(data.size() + length, value);
+        }
+        break;
+    }
+    case LightweightEncoding::FrameOfReference:
+    {
+        UInt64 min_value = 0;
+        UInt8 width = 0;
+        readBinary(min_value, istr);
+        readBinary(width, istr);
+        data.resize(old_size + rows);
+        readBitPacked(
+            rows,
+            width,
+            [&](size_t i, UInt64 value) { data[old_size + i] = fromOrdered<T>(min_value + value); },
+            istr);
+        break;
+    }
+    case LightweightEncoding::Delta:
+    {
+        RUNTIME_CHECK(rows > 0);
+        UInt64 value = 0;
+        Int64 min_delta = 0;
+        UInt8 width = 0;
+        readBinary(value, istr);
+        readBinary(min_delta, istr);
+        readBinary(width, istr);
+        data.resize(old_size + rows);
+        data[old_size] = fromOrdered<T>(value);
+        readBitPacked(
+            rows - 1,
+            width,
+            [&](size_t i, UInt64 delta) {
+                value += static_cast<UInt64>(min_delta) + delta;
+                data[old_size + i + 1] = fromOrdered<T>(value);
+            },
+            istr);
+        break;
+    }
+    default:
+        throw Exception(fmt::format("Unexpected encoding {} of integer column", static_cast<int>(encoding)), ErrorCodes::LOGICAL_ERROR);
+    }
+    RUNTIME_CHECK_MSG(data.size() == old_size + rows, "Decoded rows mismatch, expect {}, actual {}", rows, data.size() - old_size);
+}
+
+LightweightEncoding encodeString(const IDataType & type, const ColumnString & column, WriteBuffer & ostr)
+{
+    const size_t rows = column.size();
+    if (rows >= 2)
+    {
+        // Give up once the dictionary takes more than half of the rows.
+        const size_t max_dict_size = rows / 2;
+        HashMap<StringRef, UInt32, StringRefHash> dict;
+        std::vector<StringRef> dict_values;
+        PaddedPODArray<UInt32> indexes(rows);
+        size_t dict_bytes = 0;
+        for (size_t i = 0; i < rows && dict_values.size() <= max_dict_size; ++i)
+        {
+            const auto value = column.getDataAt(i);
+            HashMap<StringRef, UInt32, StringRefHash>::LookupResult it;
+            bool inserted = false;
+            dict.emplace(value, it, inserted);
+            if (inserted)
+            {
+                it->getMapped() = static_cast<UInt32>(dict_values.size());
+                dict_values.push_back(value);
+                dict_bytes += value.size + 1;
+            }
+            indexes[i] = it->getMapped();
+        }
+
+        // The plain serialization takes about `chars.size()` bytes, a varint length instead of the
+        // terminating zero for each row.
+        const UInt8 width = bitWidth(dict_values.size() - 1);
+        if (dict_values.size() <= max_dict_size
+            && sizeof(UInt64) + dict_bytes + 1 + bitPackedBytes(rows, width) < column.getChars().size())
+        {
+            writeEncoding(LightweightEncoding::Dictionary, ostr);
+            writeVarUInt(dict_values.size(), ostr);
+            for (const auto & value : dict_values)
+                writeStringBinary(value, ostr);
+            writeBinary(width, ostr);
+            writeBitPacked(
+                rows,
+                width,
+                [&](size_t i) { return indexes[i]; },
+                ostr);
+            return LightweightEncoding::Dictionary;
+        }
+    }
+    writePlain(type, column, ostr);
+    return LightweightEncoding::Plain;
+}
+
+void decodeString(LightweightEncoding encoding, const IDataType & type, ColumnString & column, ReadBuffer & istr, size_t rows)
+{
+    if (encoding == LightweightEncoding::Plain)
+        return readPlain(type, column, istr, rows);
+
+    RUNTIME_CHECK_MSG(encoding == LightweightEncoding::Dictionary, "Unexpected encoding {} of string column", static_cast<int>(encoding));
+    size_t dict_size = 0;
+    readVarUInt(dict_size, istr);
+    std::vector<String> dict(dict_size);
+    for (auto & value : dict)
+        readStringBinary(value, istr);
+    UInt8 width = 0;
+    readBinary(width, istr);
+    readBitPacked(
+        rows,
+        width,
+        [&](size_t, UInt64 index) {
+            RUNTIME_CHECK_MSG(index < dict_size, "Dictionary index {} out of range {}", index, dict_size);
+            column.insertData(dict[index].data(), dict[index].size());
+        },
+        istr);
+}
+
+template <typename T>
+bool tryEncodeInteger(const IColumn & column, WriteBuffer & ostr, LightweightEncoding & encoding)
+{
+    if (const auto * column_vector = typeid_cast<const ColumnVector<T> *>(&column))
+    {
+        encoding = encodeInteger(column_vector->getData(), ostr);
+        return true;
+    }
+    return false;
+}
+
+template <typename T>
+bool tryDecodeInteger(LightweightEncoding encoding, IColumn & column, ReadBuffer & istr, size_t rows)
+{
+    if (auto * column_vector = typeid_cast<ColumnVector<T> *>(&column))
+    {
+        decodeInteger(encoding, column_vector->getData(), istr, rows);
+        return true;
+    }
+    return false;
+}
+} // namespace
+
+LightweightEncoding EncodeColumnLightweight(const IDataType & type, const IColumn & column, WriteBuffer & ostr)
+{
+    const auto * nullable_type = typeid_cast<const DataTypeNullable *>(&type);
+    if (const auto * nullable_column = typeid_cast<const ColumnNullable *>(&column); nullable_column && nullable_type)
+    {
+        encodeInteger(nullable_column->getNullMapData(), ostr);
+        return EncodeColumnLightweight(*nullable_type->getNestedType(), nullable_column->getNestedColumn(), ostr);
+    }
+
+    LightweightEncoding encoding = LightweightEncoding::Plain;
+    if (tryEncodeInteger<UInt8>(column, ostr, encoding)
+        || tryEncodeInteger<UInt16>(column, ostr, encoding)
+        || tryEncodeInteger<UInt32>(column, ostr, encoding)
+        || tryEncodeInteger<UInt64>(column, ostr, encoding)
+        || tryEncodeInteger<Int8>(column, ostr, encoding)
+        || tryEncodeInteger<Int16>(column, ostr, encoding)
+        || tryEncodeInteger<Int32>(column, ostr, encoding)
+        || tryEncodeInteger<Int64>(column, ostr, encoding))
+        return encoding;
+
+    if (const auto * column_string = typeid_cast<const ColumnString *>(&column))
+        return encodeString(type, *column_string, ostr);
+
+    writePlain(type, column, ostr);
+    return LightweightEncoding::Plain;
+}
+
+void DecodeColumnLightweight(const IDataType & type, IColumn & column, ReadBuffer & istr, size_t rows)
+{
+    const auto * nullable_type = typeid_cast<const DataTypeNullable *>(&type);
+    if (auto * nullable_column = typeid_cast<ColumnNullable *>(&column); nullable_column && nullable_type)
+    {
+        decodeInteger(readEncoding(istr), nullable_column->getNullMapData(), istr, rows);
+        return DecodeColumnLightweight(*nullable_type->getNestedType(), nullable_column->getNestedColumn(), istr, rows);
+    }
+
+    const auto encoding = readEncoding(istr);
+    if (tryDecodeInteger<UInt8>(encoding, column, istr, rows)
+        || tryDecodeInteger<UInt16>(encoding, column, istr, rows)
+        || tryDecodeInteger<UInt32>(encoding, column, istr, rows)
+        || tryDecodeInteger<UInt64>(encoding, column, istr, rows)
+        || tryDecodeInteger<Int8>(encoding, column, istr, rows)
+        || tryDecodeInteger<Int16>(encoding, column, istr, rows)
+        || tryDecodeInteger<Int32>(encoding, column, istr, rows)
+        || tryDecodeInteger<Int64>(encoding, column, istr, rows))
+        return;
+
+    if (auto * column_string = typeid_cast<ColumnString *>(&column))
+        return decodeString(encoding, type, *column_string, istr, rows);
+
+    RUNTIME_CHECK_MSG(encoding == LightweightEncoding::Plain, "Unexpected encoding {} of column {}", static_cast<int>(encoding), column.getName());
+    readPlain(type, column, istr, rows);
+}
+
+} // namespace DB
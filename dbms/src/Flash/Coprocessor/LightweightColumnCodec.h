@@ -0,0 +1,48 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <Columns/IColumn.h>
+#include <DataTypes/IDataType.h>
+#include <IO/ReadBuffer.h>
+#include <IO/WriteBuffer.h>
+
+namespace DB
+{
+/// The lightweight encodings of column data used by MPPDataPacketV2.
+/// Each column starts with one byte of `LightweightEncoding`, and the nested column of
+/// a Nullable column is encoded in the same way right after its null map.
+enum class LightweightEncoding : UInt8
+{
+    /// The native serialization of the data type.
+    Plain = 0,
+    /// Integers: runs of (value, length), for constants and sorted low-cardinality values.
+    RLE = 1,
+    /// Integers: the min value and the bit-packed `value - min`.
+    FrameOfReference = 2,
+    /// Integers: the first value, the min delta and the bit-packed `delta - min delta`, for monotonic values.
+    Delta = 3,
+    /// Strings: the distinct values and the bit-packed indexes of the rows.
+    Dictionary = 4,
+};
+
+/// Encode all rows of `column` with the encoding of the smallest estimated size.
+LightweightEncoding EncodeColumnLightweight(const IDataType & type, const IColumn & column, WriteBuffer & ostr);
+
+/// Decode `rows` rows written by `EncodeColumnLightweight` and append them to `column`.
+void DecodeColumnLightweight(const IDataType & type, IColumn & column, ReadBuffer & istr, size_t rows);
+
+} // namespace DB
@@ -0,0 +1,64 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Coprocessor/DAGContext.h>
+#include <Flash/Coprocessor/DAGStorageInterpreter.h>
+#include <gtest/gtest.h>
+
+namespace DB
+{
+namespace tests
+{
+TEST(DAGStorageInterpreterTest, SortedByHandleForSingleTable)
+{
+    DAGContext dag_context(1024);
+    dag_context.tables_regions_info = TablesRegionsInfo(true);
+
+    tipb::Executor executor;
+    executor.set_tp(tipb::ExecType::TypeTableScan);
+    executor.mutable_tbl_scan()->set_table_id(100);
+    executor.mutable_tbl_scan()->set_keep_order(true);
+    TiDBTableScan table_scan(&executor, "table_scan_0", dag_context);
+
+    ASSERT_TRUE(DAGStorageInterpreter::isSortedByHandle(table_scan, 1, false, 1));
+    ASSERT_FALSE(DAGStorageInterpreter::isSortedByHandle(table_scan, 1, false, 2));
+    ASSERT_FALSE(DAGStorageInterpreter::isSortedByHandle(table_scan, 1, true, 1));
+
+    executor.mutable_tbl_scan()->set_keep_order(false);
+    TiDBTableScan unordered_table_scan(&executor, "table_scan_0", dag_context);
+    ASSERT_FALSE(DAGStorageInterpreter::isSortedByHandle(unordered_table_scan, 1, false, 1));
+}
+
+TEST(DAGStorageInterpreterTest, NotSortedByHandleForPartitionTable)
+{
+    DAGContext dag_context(1024);
+    dag_context.tables_regions_info.getOrCreateTableRegionInfoByTableID(101);
+    dag_context.tables_regions_info.getOrCreateTableRegionInfoByTableID(102);
+
+    tipb::Executor executor;
+    executor.set_tp(tipb::ExecType::TypePartitionTableScan);
+    auto * partition_table_scan = executor.mutable_partition_table_scan();
+    partition_table_scan->set_table_id(100);
+    partition_table_scan->add_partition_ids(101);
+    partition_table_scan->add_partition_ids(102);
+    TiDBTableScan table_scan(&executor, "partition_table_scan_0", dag_context);
+    ASSERT_EQ(table_scan.getPhysicalTableIDs().size(), 2UL);
+
+    /// The streams of all the partitions are multiplexed into one stream, which is not sorted by the handle.
+    ASSERT_FALSE(DAGStorageInterpreter::isSortedByHandle(table_scan, 2, false, 1));
+    ASSERT_FALSE(DAGStorageInterpreter::isSortedByHandle(table_scan, 1, false, 1));
+}
+
+} // namespace tests
+} // namespace DB
@@ -0,0 +1,158 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Flash/Coprocessor/CHBlockChunkCodecV1.h>
+#include <Flash/Coprocessor/LightweightColumnCodec.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <random>
+
+namespace DB
+{
+namespace tests
+{
+namespace
+{
+// Encode `column`, check the chosen encoding, and return the encoded bytes after checking the decoded column.
+size_t checkRoundTrip(const ColumnWithTypeAndName & column, LightweightEncoding expected_encoding)
+{
+    WriteBufferFromOwnString write_buf;
+    auto encoding = EncodeColumnLightweight(*column.type, *column.column, write_buf);
+    EXPECT_EQ(static_cast<int>(encoding), static_cast<int>(expected_encoding));
+    auto data = write_buf.releaseStr();
+
+    // Decode twice into the same column to check that the rows are appended.
+    auto decoded = column.type->createColumn();
+    for (size_t i = 0; i < 2; ++i)
+    {
+        ReadBufferFromString read_buf(data);
+        DecodeColumnLightweight(*column.type, *decoded, read_buf, column.column->size());
+        EXPECT_TRUE(read_buf.eof());
+    }
+    auto expected = column.column->cloneEmpty();
+    expected->insertRangeFrom(*column.column, 0, column.column->size());
+    expected->insertRangeFrom(*column.column, 0, column.column->size());
+    EXPECT_TRUE(columnEqual(ColumnWithTypeAndName(std::move(expected), column.type, ""), ColumnWithTypeAndName(std::move(decoded), column.type, "")));
+    return data.size();
+}
+} // namespace
+
+TEST(LightweightColumnCodecTest, Integer)
+try
+{
+    const size_t rows = 8192;
+    std::vector<Int64> constant(rows, -7);
+    std::vector<UInt64> timestamps;
+    std::vector<Int32> narrow;
+    std::vector<Int64> random;
+    std::vector<Int64> descending;
+    std::mt19937_64 rng(2023);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        timestamps.push_back(1680000000000ULL + i * 1000 + rng() % 10);
+        narrow.push_back(-100 + static_cast<Int32>(rng() % 200));
+        random.push_back(static_cast<Int64>(rng()));
+        descending.push_back(std::numeric_limits<Int64>::max() - static_cast<Int64>(i) * 3);
+    }
+
+    // A constant is a frame of reference with 0 bit width.
+    ASSERT_LT(checkRoundTrip(createColumn<Int64>(constant), LightweightEncoding::FrameOfReference), 32);
+    ASSERT_LT(checkRoundTrip(createColumn<UInt64>(timestamps), LightweightEncoding::Delta), rows);
+    ASSERT_LT(checkRoundTrip(createColumn<Int32>(narrow), LightweightEncoding::FrameOfReference), rows * 2);
+    ASSERT_LT(checkRoundTrip(createColumn<Int64>(descending), LightweightEncoding::Delta), 32);
+    checkRoundTrip(createColumn<Int64>(random), LightweightEncoding::Plain);
+
+    // Sorted runs of a few values.
+    std::vector<UInt8> runs;
+    for (size_t i = 0; i < rows; ++i)
+        runs.push_back(i * 4 / rows);
+    checkRoundTrip(createColumn<UInt8>(runs), LightweightEncoding::RLE);
+
+    // Extreme values.
+    checkRoundTrip(createColumn<Int64>({std::numeric_limits<Int64>::min(), std::numeric_limits<Int64>::max(), 0, -1, 1}), LightweightEncoding::Plain);
+    checkRoundTrip(createColumn<UInt64>({std::numeric_limits<UInt64>::max(), 0, std::numeric_limits<UInt64>::max()}), LightweightEncoding::Plain);
+    std::vector<Int8> alternate;
+    for (size_t i = 0; i < 64; ++i)
+        alternate.push_back(i % 2 ? -127 : -128);
+    checkRoundTrip(createColumn<Int8>(alternate), LightweightEncoding::FrameOfReference);
+
+    // Few rows.
+    checkRoundTrip(createColumn<Int64>(std::vector<Int64>{}), LightweightEncoding::Plain);
+    checkRoundTrip(createColumn<Int64>({1}), LightweightEncoding::Plain);
+}
+CATCH
+
+TEST(LightweightColumnCodecTest, String)
+try
+{
+    const size_t rows = 8192;
+    std::vector<String> low_cardinality;
+    std::vector<String> unique;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        low_cardinality.push_back(i % 3 == 0 ? "" : fmt::format("category_{}", i % 17));
+        unique.push_back(fmt::format("value_{}", i));
+    }
+
+    ASSERT_LT(checkRoundTrip(createColumn<String>(low_cardinality), LightweightEncoding::Dictionary), rows);
+    checkRoundTrip(createColumn<String>(unique), LightweightEncoding::Plain);
+    checkRoundTrip(createColumn<String>(std::vector<String>(rows, "constant")), LightweightEncoding::Dictionary);
+    checkRoundTrip(createColumn<String>({"a"}), LightweightEncoding::Plain);
+}
+CATCH
+
+TEST(LightweightColumnCodecTest, NullableAndOthers)
+try
+{
+    // The returned encoding is the one of the nested column.
+    checkRoundTrip(createColumn<Nullable<Int64>>({1, std::nullopt, 1, 1, std::nullopt, 1, 1, 1}), LightweightEncoding::FrameOfReference);
+    checkRoundTrip(createColumn<Nullable<String>>({"a", std::nullopt, "a", "a", std::nullopt, "a", "a", "a"}), LightweightEncoding::Dictionary);
+    checkRoundTrip(createColumn<Nullable<String>>({std::nullopt, std::nullopt}), LightweightEncoding::Plain);
+    checkRoundTrip(createColumn<Float64>({1.5, 1.5, 1.5, 1.5}), LightweightEncoding::Plain);
+    checkRoundTrip(createColumn<Decimal64>(std::make_tuple(12, 2), {"1.00", "1.00", "2.50"}), LightweightEncoding::Plain);
+}
+CATCH
+
+TEST(LightweightColumnCodecTest, BlockChunkCodec)
+try
+{
+    const size_t rows = 4096;
+    std::vector<Int64> ids;
+    std::vector<std::optional<String>> names;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        ids.push_back(static_cast<Int64>(i));
+        names.push_back(i % 5 == 0 ? std::nullopt : std::optional<String>(fmt::format("name_{}", i % 10)));
+    }
+    Block block{createColumn<Int64>(ids, "id"), createColumn<Nullable<String>>(names, "name")};
+    Block header = block.cloneEmpty();
+
+    for (auto method : {CompressionMethod::NONE, CompressionMethod::LZ4})
+    {
+        auto plain_codec = CHBlockChunkCodecV1{header};
+        auto plain = plain_codec.encode(block, method);
+        auto codec = CHBlockChunkCodecV1{header, /*lightweight_encoding_=*/true};
+        auto encoded = codec.encode(block, method);
+        ASSERT_LT(encoded.size(), plain.size());
+        ASSERT_BLOCK_EQ(block, CHBlockChunkCodecV1::decode(header, encoded, /*lightweight_encoding=*/true));
+    }
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
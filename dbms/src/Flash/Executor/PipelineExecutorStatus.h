@@ -63,6 +63,17 @@ public:
         return is_cancelled.load(std::memory_order_acquire);
     }
 
+    // The execute time of all tasks of this query, used by MultiLevelFeedbackQueue.
+    void addExecuteTime(UInt64 execute_time_ns)
+    {
+        execute_time_ns_sum.fetch_add(execute_time_ns, std::memory_order_relaxed);
+    }
+
+    UInt64 getExecuteTime() const
+    {
+        return execute_time_ns_sum.load(std::memory_order_relaxed);
+    }
+
 private:
     std::mutex mu;
     std::condition_variable cv;
@@ -70,5 +81,7 @@ private:
     UInt32 active_event_count{0};
 
     std::atomic_bool is_cancelled{false};
+
+    std::atomic<UInt64> execute_time_ns_sum{0};
 };
 } // namespace DB
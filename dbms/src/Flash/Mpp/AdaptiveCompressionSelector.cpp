@@ -0,0 +1,92 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Common/Exception.h>
+#include <Flash/Mpp/AdaptiveCompressionSelector.h>
+
+namespace DB
+{
+namespace
+{
+// The weight of the newest sample in the moving average.
+constexpr double SMOOTHING_FACTOR = 0.3;
+} // namespace
+
+AdaptiveCompressionSelector::AdaptiveCompressionSelector(UInt64 bandwidth_mib)
+    : network_ns_per_byte(1e9 / (static_cast<double>(std::max<UInt64>(bandwidth_mib, 1)) * 1024 * 1024))
+{}
+
+size_t AdaptiveCompressionSelector::indexOf(CompressionMethod method)
+{
+    for (size_t i = 0; i < CANDIDATES.size(); ++i)
+    {
+        if (CANDIDATES[i] == method)
+            return i;
+    }
+    throw Exception(fmt::format("Unexpected compression method {}", static_cast<int>(method)), ErrorCodes::LOGICAL_ERROR);
+}
+
+CompressionMethod AdaptiveCompressionSelector::choose()
+{
+    ++packets;
+    for (size_t i = 0; i < CANDIDATES.size(); ++i)
+    {
+        if (!stats[i].sampled)
+            return CANDIDATES[i];
+    }
+    if (packets % PROBE_INTERVAL == 0)
+    {
+        next_probe = (next_probe + 1) % CANDIDATES.size();
+        if (next_probe == best)
+            next_probe = (next_probe + 1) % CANDIDATES.size();
+        return CANDIDATES[next_probe];
+    }
+    return CANDIDATES[best];
+}
+
+void AdaptiveCompressionSelector::update(CompressionMethod method, size_t original_bytes, size_t compressed_bytes, UInt64 encode_ns)
+{
+    if (original_bytes == 0)
+        return;
+
+    auto & stat = stats[indexOf(method)];
+    const double encode_ns_per_byte = static_cast<double>(encode_ns) / original_bytes;
+    const double compressed_ratio = static_cast<double>(compressed_bytes) / original_bytes;
+    if (stat.sampled)
+    {
+        stat.encode_ns_per_byte += SMOOTHING_FACTOR * (encode_ns_per_byte - stat.encode_ns_per_byte);
+        stat.compressed_ratio += SMOOTHING_FACTOR * (compressed_ratio - stat.compressed_ratio);
+    }
+    else
+    {
+        stat.sampled = true;
+        stat.encode_ns_per_byte = encode_ns_per_byte;
+        stat.compressed_ratio = compressed_ratio;
+    }
+
+    for (size_t i = 0; i < CANDIDATES.size(); ++i)
+    {
+        if (stats[i].sampled && (!stats[best].sampled || estimateCost(CANDIDATES[i]) < estimateCost(CANDIDATES[best])))
+            best = i;
+    }
+}
+
+double AdaptiveCompressionSelector::estimateCost(CompressionMethod method) const
+{
+    const auto & stat = stats[indexOf(method)];
+    return stat.encode_ns_per_byte + stat.compressed_ratio * network_ns_per_byte;
+}
+
+} // namespace DB
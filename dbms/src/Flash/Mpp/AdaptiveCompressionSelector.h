@@ -0,0 +1,64 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <IO/CompressedStream.h>
+#include <common/types.h>
+
+#include <array>
+
+namespace DB
+{
+/// Choose the compression method for the packets sent through one tunnel.
+/// The cost of sending one original byte with a method is estimated as
+///     encode_ns_per_byte + compressed_ratio * network_ns_per_byte
+/// So a fast network prefers NONE or LZ4 and a slow one prefers ZSTD.
+/// Each method is probed once at first, then the cheapest one is used and the others are
+/// probed again every `PROBE_INTERVAL` packets, since the data may change over time.
+class AdaptiveCompressionSelector
+{
+public:
+    static constexpr size_t PROBE_INTERVAL = 64;
+    static constexpr std::array<CompressionMethod, 3> CANDIDATES{CompressionMethod::NONE, CompressionMethod::LZ4, CompressionMethod::ZSTD};
+
+    /// `bandwidth_mib` is the expected network bandwidth of the sender in MiB/s.
+    explicit AdaptiveCompressionSelector(UInt64 bandwidth_mib);
+
+    CompressionMethod choose();
+
+    /// Record the result of encoding `original_bytes` into `compressed_bytes` by `method` in `encode_ns`.
+    void update(CompressionMethod method, size_t original_bytes, size_t compressed_bytes, UInt64 encode_ns);
+
+    double estimateCost(CompressionMethod method) const;
+
+private:
+    struct MethodStat
+    {
+        bool sampled = false;
+        double encode_ns_per_byte = 0;
+        double compressed_ratio = 1;
+    };
+
+    static size_t indexOf(CompressionMethod method);
+
+    double network_ns_per_byte;
+    std::array<MethodStat, CANDIDATES.size()> stats;
+    size_t packets = 0;
+    size_t next_probe = 0;
+    size_t best = 0;
+};
+
+} // namespace DB
@@ -686,10 +686,11 @@ DecodeDetail ExchangeReceiverBase<RPCContext>::decodeChunks(
         return detail;
     }
     case DB::MPPDataPacketV1:
+    case DB::MPPDataPacketV2:
     {
         for (const auto * chunk : recv_msg->chunks)
         {
-            auto && result = decoder_ptr->decodeAndSquashV1(*chunk);
+            auto && result = decoder_ptr->decodeAndSquashV1(*chunk, version == DB::MPPDataPacketV2);
             if (!result || !result->rows())
                 continue;
             detail.rows += result->rows();
@@ -315,6 +315,9 @@ void MPPTask::prepare(const mpp::DispatchTaskRequest & task_request)
     dag_context->log = log;
     dag_context->tables_regions_info = std::move(tables_regions_info);
     dag_context->tidb_host = context->getClientInfo().current_address.toString();
+    const auto & settings = context->getSettingsRef();
+    if (settings.enable_runtime_filter)
+        dag_context->initRuntimeFilters(settings.runtime_filter_max_in_values, settings.runtime_filter_bloom_filter_bits);
 
     context->setDAGContext(dag_context.get());
     process_list_entry = setProcessListElement(*context, dag_context->dummy_query_string, dag_context->dummy_ast.get());
@@ -387,6 +390,9 @@ void MPPTask::runImpl()
         preprocess();
         schedule_entry.setNeededThreads(estimateCountOfNewThreads());
         LOG_DEBUG(log, "Estimate new thread count of query: {} including tunnel_threads: {}, receiver_threads: {}", schedule_entry.getNeededThreads(), dag_context->tunnel_set->getExternalThreadCnt(), new_thread_count_of_mpp_receiver);
+        schedule_entry.setEstimatedMemory(estimateMemoryUsage(schedule_entry.getNeededThreads()));
+        schedule_entry.setMemoryTracker(process_list_entry->get().getMemoryTrackerPtr());
+        LOG_DEBUG(log, "Estimate memory usage of task: {}", schedule_entry.getEstimatedMemory());
 
         scheduleOrWait();
 
@@ -562,4 +568,40 @@ int MPPTask::estimateCountOfNewThreads()
         + new_thread_count_of_mpp_receiver;
 }
 
+Int64 MPPTask::estimateMemoryUsage(int needed_threads)
+{
+    const auto & settings = context->getSettingsRef();
+    // Each thread holds several blocks in flight, including the packets buffered by tunnels and receivers.
+    Int64 estimated_memory = needed_threads * static_cast<Int64>(settings.task_scheduler_estimated_memory_per_thread.get());
+    // The stateful executors keep their data in memory, which is bounded by the spill threshold if it is set.
+    auto memory_of_stateful_executor = [&](UInt64 spill_threshold) {
+        return static_cast<Int64>(spill_threshold > 0 ? spill_threshold : settings.task_scheduler_estimated_memory_per_stateful_executor.get());
+    };
+    traverseExecutors(&dag_req, [&](const tipb::Executor & executor) {
+        switch (executor.tp())
+        {
+        case tipb::ExecType::TypeJoin:
+            estimated_memory += memory_of_stateful_executor(settings.max_bytes_before_external_join.get());
+            break;
+        case tipb::ExecType::TypeAggregation:
+            estimated_memory += memory_of_stateful_executor(settings.max_bytes_before_external_group_by.get());
+            break;
+        case tipb::ExecType::TypeTopN:
+        case tipb::ExecType::TypeSort:
+            estimated_memory += memory_of_stateful_executor(settings.max_bytes_before_external_sort.get());
+            break;
+        case tipb::ExecType::TypeWindow:
+            estimated_memory += memory_of_stateful_executor(settings.max_bytes_before_external_window.get());
+            break;
+        default:
+            break;
+        }
+        return true;
+    });
+    // The task can not use more memory than its limit.
+    if (auto memory_limit = process_list_entry->get().getMemoryTrackerPtr()->getLimit(); memory_limit > 0)
+        estimated_memory = std::min(estimated_memory, memory_limit);
+    return estimated_memory;
+}
+
 } // namespace DB
@@ -104,6 +104,9 @@ private:
 
     int estimateCountOfNewThreads();
 
+    /// Estimate the memory usage of this task by its threads and the stateful executors in the plan.
+    Int64 estimateMemoryUsage(int needed_threads);
+
     void registerTunnels(const mpp::DispatchTaskRequest & task_request);
 
     void initExchangeReceivers();
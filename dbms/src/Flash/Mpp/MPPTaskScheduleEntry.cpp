@@ -31,7 +31,7 @@ MPPTaskScheduleEntry::~MPPTaskScheduleEntry()
 {
     if (schedule_state == ScheduleState::SCHEDULED)
     {
-        manager->releaseThreadsFromScheduler(needed_threads);
+        manager->releaseResourcesFromScheduler(*this);
         schedule_state = ScheduleState::COMPLETED;
     }
 }
@@ -62,7 +62,7 @@ void MPPTaskScheduleEntry::waitForSchedule()
 
         if (schedule_state == ScheduleState::EXCEEDED)
         {
-            throw Exception(fmt::format("{} is failed to schedule because of exceeding the thread hard limit in min-tso scheduler after waiting for {}s.", id.toString(), time_cost));
+            throw Exception(fmt::format("{} is failed to schedule because of exceeding the thread or memory hard limit in min-tso scheduler after waiting for {}s.", id.toString(), time_cost));
         }
         else if (schedule_state == ScheduleState::FAILED)
         {
@@ -91,4 +91,11 @@ void MPPTaskScheduleEntry::setNeededThreads(int needed_threads_)
     needed_threads = needed_threads_;
 }
 
+Int64 MPPTaskScheduleEntry::getReservedMemory() const
+{
+    if (memory_tracker == nullptr)
+        return estimated_memory;
+    return std::max(estimated_memory, memory_tracker->get());
+}
+
 } // namespace DB
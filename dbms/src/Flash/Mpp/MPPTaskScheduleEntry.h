@@ -15,6 +15,7 @@
 #pragma once
 
 #include <Common/Logger.h>
+#include <Common/MemoryTracker.h>
 #include <Flash/Mpp/MPPTaskId.h>
 
 namespace DB
@@ -36,6 +37,13 @@ public:
     int getNeededThreads() const;
     void setNeededThreads(int needed_threads_);
 
+    Int64 getEstimatedMemory() const { return estimated_memory; }
+    void setEstimatedMemory(Int64 estimated_memory_) { estimated_memory = estimated_memory_; }
+    void setMemoryTracker(const MemoryTrackerPtr & memory_tracker_) { memory_tracker = memory_tracker_; }
+    /// The memory held by this task in the scheduler, which is the estimated memory before the task runs,
+    /// and the actual memory usage once it exceeds the estimation.
+    Int64 getReservedMemory() const;
+
     bool schedule(ScheduleState state);
     void waitForSchedule();
 
@@ -50,6 +58,8 @@ private:
     MPPTaskId id;
 
     int needed_threads;
+    Int64 estimated_memory = 0;
+    MemoryTrackerPtr memory_tracker;
 
     std::mutex schedule_mu;
     std::condition_variable schedule_cv;
@@ -30,6 +30,7 @@ TrackedMppDataPacketPtr ToPacket(
 
     auto && codec = CHBlockChunkCodecV1{
         header,
+        version == MPPDataPacketV2,
     };
 
     auto && res = codec.encode(std::move(part_columns), method);
@@ -75,6 +76,7 @@ TrackedMppDataPacketPtr ToFineGrainedPacket(
 
     auto && codec = CHBlockChunkCodecV1{
         header,
+        version == MPPDataPacketV2,
     };
     auto tracked_packet = std::make_shared<TrackedMppDataPacket>(version);
 
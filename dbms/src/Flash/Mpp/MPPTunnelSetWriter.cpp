@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Common/Exception.h>
+#include <Common/Stopwatch.h>
 #include <Common/TiFlashMetrics.h>
 #include <Flash/Coprocessor/CHBlockChunkCodecV1.h>
 #include <Flash/Mpp/MPPTunnelSetHelper.h>
@@ -75,17 +76,60 @@ void updatePartitionWriterMetrics(CompressionMethod method, size_t original_size
         break;
     }
 }
+
+void updateAdaptiveCompressionMetrics(CompressionMethod method, size_t original_size, size_t sz, UInt64 encode_ns)
+{
+    switch (method)
+    {
+    case CompressionMethod::NONE:
+        GET_METRIC(tiflash_exchange_adaptive_compression, type_none_packets).Increment();
+        break;
+    case CompressionMethod::LZ4:
+        GET_METRIC(tiflash_exchange_adaptive_compression, type_lz4_packets).Increment();
+        break;
+    case CompressionMethod::ZSTD:
+        GET_METRIC(tiflash_exchange_adaptive_compression, type_zstd_packets).Increment();
+        break;
+    default:
+        break;
+    }
+    if (original_size > sz)
+        GET_METRIC(tiflash_exchange_adaptive_compression, type_saved_bytes).Increment(original_size - sz);
+    GET_METRIC(tiflash_exchange_adaptive_compression, type_encode_ns).Increment(encode_ns);
+}
 } // namespace
 
 MPPTunnelSetWriterBase::MPPTunnelSetWriterBase(
     const MPPTunnelSetPtr & mpp_tunnel_set_,
     const std::vector<tipb::FieldType> & result_field_types_,
-    const String & req_id)
+    const String & req_id,
+    UInt64 adaptive_compression_bandwidth)
     : mpp_tunnel_set(mpp_tunnel_set_)
     , result_field_types(result_field_types_)
     , log(Logger::get(req_id))
 {
     RUNTIME_CHECK(mpp_tunnel_set->getPartitionNum() > 0);
+    if (adaptive_compression_bandwidth > 0)
+        compression_selectors.resize(mpp_tunnel_set->getPartitionNum(), AdaptiveCompressionSelector(adaptive_compression_bandwidth));
+}
+
+CompressionMethod MPPTunnelSetWriterBase::chooseCompressionMethod(int16_t partition_id, CompressionMethod compression_method)
+{
+    if (mpp_tunnel_set->isLocal(partition_id))
+        return CompressionMethod::NONE;
+    if (compression_selectors.empty())
+        return compression_method;
+    return compression_selectors[partition_id].choose();
+}
+
+void MPPTunnelSetWriterBase::updateCompressionStat(int16_t partition_id, CompressionMethod compression_method, size_t original_size, size_t packet_bytes, UInt64 encode_ns)
+{
+    bool is_local = mpp_tunnel_set->isLocal(partition_id);
+    updatePartitionWriterMetrics(compression_method, original_size, packet_bytes, is_local);
+    if (is_local || compression_selectors.empty())
+        return;
+    compression_selectors[partition_id].update(compression_method, original_size, packet_bytes, encode_ns);
+    updateAdaptiveCompressionMetrics(compression_method, original_size, packet_bytes, encode_ns);
 }
 
 void MPPTunnelSetWriterBase::write(tipb::SelectResponse & response)
@@ -147,18 +191,19 @@ void MPPTunnelSetWriterBase::partitionWrite(
 {
     assert(version > MPPDataPacketV0);
 
-    bool is_local = mpp_tunnel_set->isLocal(partition_id);
-    compression_method = is_local ? CompressionMethod::NONE : compression_method;
+    compression_method = chooseCompressionMethod(partition_id, compression_method);
 
     size_t original_size = 0;
+    Stopwatch watch;
     auto tracked_packet = MPPTunnelSetHelper::ToPacket(header, std::move(part_columns), version, compression_method, original_size);
     if (!tracked_packet)
         return;
+    auto encode_ns = watch.elapsed();
 
     auto packet_bytes = tracked_packet->getPacket().ByteSizeLong();
     checkPacketSize(packet_bytes);
     writeToTunnel(std::move(tracked_packet), partition_id);
-    updatePartitionWriterMetrics(compression_method, original_size, packet_bytes, is_local);
+    updateCompressionStat(partition_id, compression_method, original_size, packet_bytes, encode_ns);
 }
 
 void MPPTunnelSetWriterBase::fineGrainedShuffleWrite(
@@ -174,10 +219,10 @@ void MPPTunnelSetWriterBase::fineGrainedShuffleWrite(
     if (version == MPPDataPacketV0)
         return fineGrainedShuffleWrite(header, scattered, bucket_idx, fine_grained_shuffle_stream_count, num_columns, partition_id);
 
-    bool is_local = mpp_tunnel_set->isLocal(partition_id);
-    compression_method = is_local ? CompressionMethod::NONE : compression_method;
+    compression_method = chooseCompressionMethod(partition_id, compression_method);
 
     size_t original_size = 0;
+    Stopwatch watch;
     auto tracked_packet = MPPTunnelSetHelper::ToFineGrainedPacket(
         header,
         scattered,
@@ -190,11 +235,12 @@ void MPPTunnelSetWriterBase::fineGrainedShuffleWrite(
 
     if unlikely (tracked_packet->getPacket().chunks_size() <= 0)
         return;
+    auto encode_ns = watch.elapsed();
 
     auto packet_bytes = tracked_packet->getPacket().ByteSizeLong();
     checkPacketSize(packet_bytes);
     writeToTunnel(std::move(tracked_packet), partition_id);
-    updatePartitionWriterMetrics(compression_method, original_size, packet_bytes, is_local);
+    updateCompressionStat(partition_id, compression_method, original_size, packet_bytes, encode_ns);
 }
 
 void MPPTunnelSetWriterBase::fineGrainedShuffleWrite(
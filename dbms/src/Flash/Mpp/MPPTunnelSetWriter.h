@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Flash/Mpp/AdaptiveCompressionSelector.h>
 #include <Flash/Mpp/MPPTunnelSet.h>
 
 namespace DB
@@ -21,10 +22,13 @@ namespace DB
 class MPPTunnelSetWriterBase : private boost::noncopyable
 {
 public:
+    /// If `adaptive_compression_bandwidth` is not 0, the compression method of the packets sent to each
+    /// remote tunnel by data codec version > V0 is chosen by `AdaptiveCompressionSelector`.
     MPPTunnelSetWriterBase(
         const MPPTunnelSetPtr & mpp_tunnel_set_,
         const std::vector<tipb::FieldType> & result_field_types_,
-        const String & req_id);
+        const String & req_id,
+        UInt64 adaptive_compression_bandwidth = 0);
 
     virtual ~MPPTunnelSetWriterBase() = default;
 
@@ -65,10 +69,16 @@ protected:
     virtual void writeToTunnel(TrackedMppDataPacketPtr && data, size_t index) = 0;
     virtual void writeToTunnel(tipb::SelectResponse & response, size_t index) = 0;
 
+private:
+    CompressionMethod chooseCompressionMethod(int16_t partition_id, CompressionMethod compression_method);
+    void updateCompressionStat(int16_t partition_id, CompressionMethod compression_method, size_t original_size, size_t packet_bytes, UInt64 encode_ns);
+
 protected:
     MPPTunnelSetPtr mpp_tunnel_set;
     std::vector<tipb::FieldType> result_field_types;
     const LoggerPtr log;
+    /// One for each partition, empty if adaptive compression is disabled.
+    std::vector<AdaptiveCompressionSelector> compression_selectors;
 };
 
 class SyncMPPTunnelSetWriter : public MPPTunnelSetWriterBase
@@ -77,8 +87,9 @@ public:
     SyncMPPTunnelSetWriter(
         const MPPTunnelSetPtr & mpp_tunnel_set_,
         const std::vector<tipb::FieldType> & result_field_types_,
-        const String & req_id)
-        : MPPTunnelSetWriterBase(mpp_tunnel_set_, result_field_types_, req_id)
+        const String & req_id,
+        UInt64 adaptive_compression_bandwidth = 0)
+        : MPPTunnelSetWriterBase(mpp_tunnel_set_, result_field_types_, req_id, adaptive_compression_bandwidth)
     {}
 
     // For sync writer, `isReadyForWrite` will not be called, so an exception is thrown here.
@@ -96,8 +107,9 @@ public:
     AsyncMPPTunnelSetWriter(
         const MPPTunnelSetPtr & mpp_tunnel_set_,
         const std::vector<tipb::FieldType> & result_field_types_,
-        const String & req_id)
-        : MPPTunnelSetWriterBase(mpp_tunnel_set_, result_field_types_, req_id)
+        const String & req_id,
+        UInt64 adaptive_compression_bandwidth = 0)
+        : MPPTunnelSetWriterBase(mpp_tunnel_set_, result_field_types_, req_id, adaptive_compression_bandwidth)
     {}
 
     bool isReadyForWrite() const override { return mpp_tunnel_set->isReadyForWrite(); }
@@ -27,11 +27,14 @@ extern const char random_min_tso_scheduler_failpoint[];
 
 constexpr UInt64 OS_THREAD_SOFT_LIMIT = 100000;
 
-MinTSOScheduler::MinTSOScheduler(UInt64 soft_limit, UInt64 hard_limit, UInt64 active_set_soft_limit_)
+MinTSOScheduler::MinTSOScheduler(UInt64 soft_limit, UInt64 hard_limit, UInt64 active_set_soft_limit_, UInt64 memory_soft_limit_, UInt64 memory_hard_limit_, bool enable_fair_share_)
     : min_query_id(MPPTaskId::Max_Query_Id)
     , thread_soft_limit(soft_limit)
     , thread_hard_limit(hard_limit)
     , estimated_thread_usage(0)
+    , memory_soft_limit(memory_soft_limit_)
+    , memory_hard_limit(memory_hard_limit_)
+    , enable_fair_share(enable_fair_share_)
     , active_set_soft_limit(active_set_soft_limit_)
     , log(Logger::get())
 {
@@ -57,10 +60,19 @@ MinTSOScheduler::MinTSOScheduler(UInt64 soft_limit, UInt64 hard_limit, UInt64 ac
         {
             LOG_INFO(log, "thread_hard_limit is {}, thread_soft_limit is {}, and active_set_soft_limit is {} in MinTSOScheduler.", thread_hard_limit, thread_soft_limit, active_set_soft_limit);
         }
+        if (memory_hard_limit > 0 && (memory_soft_limit == 0 || memory_soft_limit > memory_hard_limit))
+        {
+            LOG_INFO(log, "memory soft limit {} should be in (0, memory hard limit {}], so MinTSOScheduler set it as {}.", memory_soft_limit, memory_hard_limit, memory_hard_limit);
+            memory_soft_limit = memory_hard_limit;
+        }
+        LOG_INFO(log, "memory_soft_limit is {}, memory_hard_limit is {}, enable_fair_share is {} in MinTSOScheduler.", memory_soft_limit, memory_hard_limit, enable_fair_share);
         GET_METRIC(tiflash_task_scheduler, type_min_tso).Set(min_query_id.query_ts);
         GET_METRIC(tiflash_task_scheduler, type_thread_soft_limit).Set(thread_soft_limit);
         GET_METRIC(tiflash_task_scheduler, type_thread_hard_limit).Set(thread_hard_limit);
         GET_METRIC(tiflash_task_scheduler, type_estimated_thread_usage).Set(estimated_thread_usage);
+        GET_METRIC(tiflash_task_scheduler, type_memory_soft_limit).Set(memory_soft_limit);
+        GET_METRIC(tiflash_task_scheduler, type_memory_hard_limit).Set(memory_hard_limit);
+        GET_METRIC(tiflash_task_scheduler, type_reserved_memory_usage).Set(0);
         GET_METRIC(tiflash_task_scheduler, type_waiting_queries_count).Set(0);
         GET_METRIC(tiflash_task_scheduler, type_active_queries_count).Set(0);
         GET_METRIC(tiflash_task_scheduler, type_waiting_tasks_count).Set(0);
@@ -84,7 +96,8 @@ bool MinTSOScheduler::tryToSchedule(MPPTaskScheduleEntry & schedule_entry, MPPTa
         return true;
     }
     bool has_error = false;
-    return scheduleImp(id.query_id, query_task_set, schedule_entry, false, has_error);
+    bool exceed_fair_share = false;
+    return scheduleImp(id.query_id, query_task_set, schedule_entry, false, has_error, exceed_fair_share);
 }
 
 /// after finishing the query, there would be no threads released soon, so the updated min-query-id query with waiting tasks should be scheduled.
@@ -126,18 +139,28 @@ void MinTSOScheduler::deleteQuery(const MPPQueryId & query_id, MPPTaskManager &
 }
 
 /// NOTE: should not throw exceptions due to being called when destruction.
-void MinTSOScheduler::releaseThreadsThenSchedule(const int needed_threads, MPPTaskManager & task_manager)
+void MinTSOScheduler::releaseResourcesThenSchedule(const MPPTaskScheduleEntry & schedule_entry, MPPTaskManager & task_manager)
 {
     if (isDisabled())
     {
         return;
     }
 
+    const auto & query_id = schedule_entry.getMPPTaskId().query_id;
+    if (auto iter = scheduled_entries.find(query_id); iter != scheduled_entries.end())
+    {
+        iter->second.erase(&schedule_entry);
+        if (iter->second.empty())
+            scheduled_entries.erase(iter);
+    }
+
+    auto needed_threads = schedule_entry.getNeededThreads();
     auto updated_estimated_threads = static_cast<Int64>(estimated_thread_usage) - needed_threads;
     RUNTIME_ASSERT(updated_estimated_threads >= 0, log, "estimated_thread_usage should not be smaller than 0, actually is {}.", updated_estimated_threads);
 
     estimated_thread_usage = updated_estimated_threads;
     GET_METRIC(tiflash_task_scheduler, type_estimated_thread_usage).Set(estimated_thread_usage);
+    GET_METRIC(tiflash_task_scheduler, type_reserved_memory_usage).Set(getReservedMemory());
     GET_METRIC(tiflash_task_scheduler, type_active_tasks_count).Decrement();
     /// as tasks release some threads, so some tasks would get scheduled.
     scheduleWaitingQueries(task_manager);
@@ -146,16 +169,17 @@ void MinTSOScheduler::releaseThreadsThenSchedule(const int needed_threads, MPPTa
 void MinTSOScheduler::scheduleWaitingQueries(MPPTaskManager & task_manager)
 {
     /// schedule new tasks
-    while (!waiting_set.empty())
+    auto waiting_iter = waiting_set.begin();
+    while (waiting_iter != waiting_set.end())
     {
-        auto current_query_id = *waiting_set.begin();
+        auto current_query_id = *waiting_iter;
         auto query_task_set = task_manager.getQueryTaskSetWithoutLock(current_query_id);
         if (nullptr == query_task_set) /// silently solve this rare case
         {
             LOG_ERROR(log, "the waiting query {} is not in the task manager.", current_query_id.toString());
             updateMinQueryId(current_query_id, true, "as it is not in the task manager.");
             active_set.erase(current_query_id);
-            waiting_set.erase(current_query_id);
+            waiting_iter = waiting_set.erase(waiting_iter);
             GET_METRIC(tiflash_task_scheduler, type_waiting_queries_count).Set(waiting_set.size());
             GET_METRIC(tiflash_task_scheduler, type_active_queries_count).Set(active_set.size());
             continue;
@@ -163,34 +187,95 @@ void MinTSOScheduler::scheduleWaitingQueries(MPPTaskManager & task_manager)
 
         LOG_DEBUG(log, "query {} (is min = {}) with {} tasks is to be scheduled from waiting set (size = {}).", current_query_id.toString(), current_query_id == min_query_id, query_task_set->waiting_tasks.size(), waiting_set.size());
         /// schedule tasks one by one
+        bool exceed_fair_share = false;
         while (!query_task_set->waiting_tasks.empty())
         {
             auto task_it = query_task_set->task_map.find(query_task_set->waiting_tasks.front());
             bool has_error = false;
-            if (task_it != query_task_set->task_map.end() && task_it->second != nullptr && !scheduleImp(current_query_id, query_task_set, task_it->second->getScheduleEntry(), true, has_error))
+            if (task_it != query_task_set->task_map.end() && task_it->second != nullptr && !scheduleImp(current_query_id, query_task_set, task_it->second->getScheduleEntry(), true, has_error, exceed_fair_share))
             {
                 if (has_error)
                 {
                     query_task_set->waiting_tasks.pop(); /// it should be pop from the waiting queue, because the task is scheduled with errors.
                     GET_METRIC(tiflash_task_scheduler, type_waiting_tasks_count).Decrement();
+                    return;
                 }
+                if (exceed_fair_share)
+                    break; /// the limits are not reached yet, so the newer queries still have chance to be scheduled.
                 return;
             }
             query_task_set->waiting_tasks.pop();
             GET_METRIC(tiflash_task_scheduler, type_waiting_tasks_count).Decrement();
         }
+        if (exceed_fair_share)
+        {
+            ++waiting_iter;
+            continue;
+        }
         LOG_DEBUG(log, "query {} (is min = {}) is scheduled from waiting set (size = {}).", current_query_id.toString(), current_query_id == min_query_id, waiting_set.size());
-        waiting_set.erase(current_query_id); /// all waiting tasks of this query are fully active
+        waiting_iter = waiting_set.erase(waiting_iter); /// all waiting tasks of this query are fully active
         GET_METRIC(tiflash_task_scheduler, type_waiting_queries_count).Set(waiting_set.size());
     }
 }
 
+Int64 MinTSOScheduler::getReservedMemory() const
+{
+    if (!isMemoryLimited())
+        return 0;
+    /// The actual memory usage changes all the time, so sum it up every time. There are at most thousands of scheduled tasks.
+    Int64 reserved_memory = 0;
+    for (const auto & [query_id, entries] : scheduled_entries)
+    {
+        for (const auto * entry : entries)
+            reserved_memory += entry->getReservedMemory();
+    }
+    return reserved_memory;
+}
+
+/// Only check when some other queries are waiting, and the query already has some running tasks, so that a query can always start.
+/// The min_query_id query is never checked, so the fair share does not break the deadlock-free guarantee.
+bool MinTSOScheduler::isWithinFairShare(const MPPQueryId & query_id, int needed_threads, Int64 needed_memory) const
+{
+    bool has_other_waiting_queries = waiting_set.size() > 1 || (waiting_set.size() == 1 && *waiting_set.begin() != query_id);
+    if (!has_other_waiting_queries)
+        return true;
+    auto iter = scheduled_entries.find(query_id);
+    if (iter == scheduled_entries.end())
+        return true;
+
+    size_t query_count = active_set.size();
+    for (const auto & waiting_query_id : waiting_set)
+        query_count += active_set.count(waiting_query_id) == 0;
+    query_count += active_set.count(query_id) == 0 && waiting_set.count(query_id) == 0;
+
+    UInt64 used_threads = 0;
+    Int64 used_memory = 0;
+    for (const auto * entry : iter->second)
+    {
+        used_threads += entry->getNeededThreads();
+        used_memory += entry->getReservedMemory();
+    }
+    if (used_threads + needed_threads > thread_soft_limit / query_count)
+        return false;
+    return memory_soft_limit == 0 || used_memory + needed_memory <= static_cast<Int64>(memory_soft_limit / query_count);
+}
+
 /// [directly schedule, from waiting set] * [is min_query_id query, not] * [can schedule, can't] totally 8 cases.
-bool MinTSOScheduler::scheduleImp(const MPPQueryId & query_id, const MPPQueryTaskSetPtr & query_task_set, MPPTaskScheduleEntry & schedule_entry, const bool isWaiting, bool & has_error)
+bool MinTSOScheduler::scheduleImp(const MPPQueryId & query_id, const MPPQueryTaskSetPtr & query_task_set, MPPTaskScheduleEntry & schedule_entry, const bool isWaiting, bool & has_error, bool & exceed_fair_share)
 {
     auto needed_threads = schedule_entry.getNeededThreads();
-    auto check_for_new_min_tso = query_id <= min_query_id && estimated_thread_usage + needed_threads <= thread_hard_limit;
-    auto check_for_not_min_tso = (active_set.size() < active_set_soft_limit || query_id <= *active_set.rbegin()) && (estimated_thread_usage + needed_threads <= thread_soft_limit);
+    auto needed_memory = schedule_entry.getEstimatedMemory();
+    auto reserved_memory = getReservedMemory();
+    auto memory_available = [&](UInt64 memory_limit) {
+        return memory_limit == 0 || reserved_memory + needed_memory <= static_cast<Int64>(memory_limit);
+    };
+    auto check_for_new_min_tso = query_id <= min_query_id && estimated_thread_usage + needed_threads <= thread_hard_limit && memory_available(memory_hard_limit);
+    auto check_for_not_min_tso = (active_set.size() < active_set_soft_limit || query_id <= *active_set.rbegin()) && (estimated_thread_usage + needed_threads <= thread_soft_limit) && memory_available(memory_soft_limit);
+    if (enable_fair_share && check_for_not_min_tso && !check_for_new_min_tso && !isWithinFairShare(query_id, needed_threads, needed_memory))
+    {
+        check_for_not_min_tso = false;
+        exceed_fair_share = true;
+    }
     if (check_for_new_min_tso || check_for_not_min_tso)
     {
         updateMinQueryId(query_id, false, isWaiting ? "from the waiting set" : "when directly schedule it");
@@ -198,11 +283,14 @@ bool MinTSOScheduler::scheduleImp(const MPPQueryId & query_id, const MPPQueryTas
         if (schedule_entry.schedule(ScheduleState::SCHEDULED))
         {
             estimated_thread_usage += needed_threads;
+            reserved_memory += needed_memory;
+            scheduled_entries[query_id].insert(&schedule_entry);
             GET_METRIC(tiflash_task_scheduler, type_active_tasks_count).Increment();
         }
         GET_METRIC(tiflash_task_scheduler, type_active_queries_count).Set(active_set.size());
         GET_METRIC(tiflash_task_scheduler, type_estimated_thread_usage).Set(estimated_thread_usage);
-        LOG_INFO(log, "{} is scheduled (active set size = {}) due to available threads {}, after applied for {} threads, used {} of the thread {} limit {}.", schedule_entry.getMPPTaskId().toString(), active_set.size(), isWaiting ? "from the waiting set" : "directly", needed_threads, estimated_thread_usage, min_query_id == query_id ? "hard" : "soft", min_query_id == query_id ? thread_hard_limit : thread_soft_limit);
+        GET_METRIC(tiflash_task_scheduler, type_reserved_memory_usage).Set(reserved_memory);
+        LOG_INFO(log, "{} is scheduled (active set size = {}) due to available resources {}, after applied for {} threads and {} bytes memory, used {} of the thread {} limit {} and {} bytes memory.", schedule_entry.getMPPTaskId().toString(), active_set.size(), isWaiting ? "from the waiting set" : "directly", needed_threads, needed_memory, estimated_thread_usage, min_query_id == query_id ? "hard" : "soft", min_query_id == query_id ? thread_hard_limit : thread_soft_limit, reserved_memory);
         return true;
     }
     else
@@ -212,7 +300,7 @@ bool MinTSOScheduler::scheduleImp(const MPPQueryId & query_id, const MPPQueryTas
         if (is_query_id_min) /// the min_query_id query should fully run, otherwise throw errors here.
         {
             has_error = true;
-            auto msg = fmt::format("threads are unavailable for the query {} ({} min_query_id {}) {}, need {}, but used {} of the thread hard limit {}, {} active and {} waiting queries.", query_id.toString(), query_id == min_query_id ? "is" : "is newer than", min_query_id.toString(), isWaiting ? "from the waiting set" : "when directly schedule it", needed_threads, estimated_thread_usage, thread_hard_limit, active_set.size(), waiting_set.size());
+            auto msg = fmt::format("threads or memory are unavailable for the query {} ({} min_query_id {}) {}, need {} threads and {} bytes memory, but used {} of the thread hard limit {} and {} of the memory hard limit {}, {} active and {} waiting queries.", query_id.toString(), query_id == min_query_id ? "is" : "is newer than", min_query_id.toString(), isWaiting ? "from the waiting set" : "when directly schedule it", needed_threads, needed_memory, estimated_thread_usage, thread_hard_limit, reserved_memory, memory_hard_limit, active_set.size(), waiting_set.size());
             LOG_ERROR(log, "{}", msg);
             GET_METRIC(tiflash_task_scheduler, type_hard_limit_exceeded_count).Increment();
             if (isWaiting)
@@ -234,7 +322,7 @@ bool MinTSOScheduler::scheduleImp(const MPPQueryId & query_id, const MPPQueryTas
             GET_METRIC(tiflash_task_scheduler, type_waiting_queries_count).Set(waiting_set.size());
             GET_METRIC(tiflash_task_scheduler, type_waiting_tasks_count).Increment();
         }
-        LOG_INFO(log, "threads are unavailable for the query {} or active set is full (size =  {}), need {}, but used {} of the thread soft limit {},{} waiting set size = {}", query_id.toString(), active_set.size(), needed_threads, estimated_thread_usage, thread_soft_limit, isWaiting ? "" : " put into", waiting_set.size());
+        LOG_INFO(log, "threads or memory are unavailable for the query {}, or active set is full (size =  {}), or it exceeds the fair share = {}, need {} threads and {} bytes memory, but used {} of the thread soft limit {} and {} of the memory soft limit {},{} waiting set size = {}", query_id.toString(), active_set.size(), exceed_fair_share, needed_threads, needed_memory, estimated_thread_usage, thread_soft_limit, reserved_memory, memory_soft_limit, isWaiting ? "" : " put into", waiting_set.size());
         return false;
     }
 }
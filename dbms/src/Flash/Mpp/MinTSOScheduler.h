@@ -17,6 +17,9 @@
 #include <Flash/Mpp/MPPTask.h>
 #include <common/logger_useful.h>
 
+#include <unordered_map>
+#include <unordered_set>
+
 namespace DB
 {
 class MinTSOScheduler;
@@ -30,12 +33,15 @@ using MPPQueryTaskSetPtr = std::shared_ptr<MPPQueryTaskSet>;
 
 /// scheduling tasks in the set according to the tso order under the soft limit of threads, but allow the min_query_id query to preempt threads under the hard limit of threads.
 /// The min_query_id query avoids the deadlock resulted from threads competition among nodes.
+/// If the memory limits are set, a task is also admitted by its estimated memory against the memory soft/hard limit in the same way.
+/// The memory held by a scheduled task is the larger one of its estimation and the actual usage of its memory tracker.
+/// If the fair share is enabled, when some other queries are waiting, a query except the min_query_id one can not hold more than its fair share of the soft limits.
 /// schedule tasks under the lock protection of the task manager.
 /// NOTE: if the updated min-tso query has waiting tasks, necessarily scheduling them, otherwise the query would hang.
 class MinTSOScheduler : private boost::noncopyable
 {
 public:
-    MinTSOScheduler(UInt64 soft_limit, UInt64 hard_limit, UInt64 active_set_soft_limit_);
+    MinTSOScheduler(UInt64 soft_limit, UInt64 hard_limit, UInt64 active_set_soft_limit_, UInt64 memory_soft_limit_ = 0, UInt64 memory_hard_limit_ = 0, bool enable_fair_share_ = false);
     ~MinTSOScheduler() = default;
     /// try to schedule this task if it is the min_query_id query or there are enough threads, otherwise put it into the waiting set.
     /// NOTE: call tryToSchedule under the lock protection of MPPTaskManager
@@ -45,23 +51,35 @@ public:
     /// NOTE: call deleteQuery under the lock protection of MPPTaskManager
     void deleteQuery(const MPPQueryId & query_id, MPPTaskManager & task_manager, const bool is_cancelled);
 
-    /// all scheduled tasks should finally call this function to release threads and schedule new tasks
-    void releaseThreadsThenSchedule(const int needed_threads, MPPTaskManager & task_manager);
+    /// all scheduled tasks should finally call this function to release threads and memory and schedule new tasks
+    void releaseResourcesThenSchedule(const MPPTaskScheduleEntry & schedule_entry, MPPTaskManager & task_manager);
 
 private:
-    bool scheduleImp(const MPPQueryId & query_id, const MPPQueryTaskSetPtr & query_task_set, MPPTaskScheduleEntry & schedule_entry, const bool isWaiting, bool & has_error);
+    bool scheduleImp(const MPPQueryId & query_id, const MPPQueryTaskSetPtr & query_task_set, MPPTaskScheduleEntry & schedule_entry, const bool isWaiting, bool & has_error, bool & exceed_fair_share);
     bool updateMinQueryId(const MPPQueryId & query_id, const bool retired, const String & msg);
     void scheduleWaitingQueries(MPPTaskManager & task_manager);
     bool isDisabled()
     {
         return thread_hard_limit == 0 && thread_soft_limit == 0;
     }
+    bool isMemoryLimited() const
+    {
+        return memory_soft_limit > 0 || memory_hard_limit > 0;
+    }
+    Int64 getReservedMemory() const;
+    bool isWithinFairShare(const MPPQueryId & query_id, int needed_threads, Int64 needed_memory) const;
     std::set<MPPQueryId> waiting_set;
     std::set<MPPQueryId> active_set;
     MPPQueryId min_query_id;
     UInt64 thread_soft_limit;
     UInt64 thread_hard_limit;
     UInt64 estimated_thread_usage;
+    /// 0 means no limit
+    UInt64 memory_soft_limit;
+    UInt64 memory_hard_limit;
+    bool enable_fair_share;
+    /// the scheduled and not yet finished tasks of each query
+    std::unordered_map<MPPQueryId, std::unordered_set<const MPPTaskScheduleEntry *>, MPPQueryIdHash> scheduled_entries;
     /// to prevent from too many queries just issue a part of tasks to occupy threads, in proportion to the hardware cores.
     size_t active_set_soft_limit;
     LoggerPtr log;
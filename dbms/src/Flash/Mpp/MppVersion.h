@@ -30,6 +30,8 @@ enum MPPDataPacketVersion : int64_t
 {
     MPPDataPacketV0 = 0,
     MPPDataPacketV1,
+    // V1 with the lightweight column encodings in `LightweightColumnCodec.h`
+    MPPDataPacketV2,
     //
     MPPDataPacketMAX,
 };
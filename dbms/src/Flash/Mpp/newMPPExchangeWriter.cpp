@@ -37,7 +37,8 @@ std::unique_ptr<DAGResponseWriter> buildMPPExchangeWriter(
     UInt64 fine_grained_shuffle_stream_count,
     UInt64 fine_grained_shuffle_batch_size,
     tipb::CompressionMode compression_mode,
-    Int64 batch_send_min_limit_compression)
+    Int64 batch_send_min_limit_compression,
+    bool enable_lightweight_encoding)
 {
     if (dag_context.isRootMPPTask())
     {
@@ -59,7 +60,7 @@ std::unique_ptr<DAGResponseWriter> buildMPPExchangeWriter(
             auto mpp_version = dag_context.getMPPTaskMeta().mpp_version();
             auto data_codec_version = mpp_version == MppVersionV0
                 ? MPPDataPacketV0
-                : MPPDataPacketV1;
+                : (enable_lightweight_encoding ? MPPDataPacketV2 : MPPDataPacketV1);
 
             if (enable_fine_grained_shuffle)
             {
@@ -116,13 +117,15 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
     UInt64 fine_grained_shuffle_batch_size,
     tipb::CompressionMode compression_mode,
     Int64 batch_send_min_limit_compression,
+    UInt64 adaptive_compression_bandwidth,
+    bool enable_lightweight_encoding,
     const String & req_id,
     bool is_async)
 {
     RUNTIME_CHECK_MSG(dag_context.isMPPTask() && dag_context.tunnel_set != nullptr, "exchange writer only run in MPP");
     if (is_async)
     {
-        auto writer = std::make_shared<AsyncMPPTunnelSetWriter>(dag_context.tunnel_set, dag_context.result_field_types, req_id);
+        auto writer = std::make_shared<AsyncMPPTunnelSetWriter>(dag_context.tunnel_set, dag_context.result_field_types, req_id, adaptive_compression_bandwidth);
         return buildMPPExchangeWriter(
             writer,
             partition_col_ids,
@@ -135,11 +138,12 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
             fine_grained_shuffle_stream_count,
             fine_grained_shuffle_batch_size,
             compression_mode,
-            batch_send_min_limit_compression);
+            batch_send_min_limit_compression,
+            enable_lightweight_encoding);
     }
     else
     {
-        auto writer = std::make_shared<SyncMPPTunnelSetWriter>(dag_context.tunnel_set, dag_context.result_field_types, req_id);
+        auto writer = std::make_shared<SyncMPPTunnelSetWriter>(dag_context.tunnel_set, dag_context.result_field_types, req_id, adaptive_compression_bandwidth);
         return buildMPPExchangeWriter(
             writer,
             partition_col_ids,
@@ -152,7 +156,8 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
             fine_grained_shuffle_stream_count,
             fine_grained_shuffle_batch_size,
             compression_mode,
-            batch_send_min_limit_compression);
+            batch_send_min_limit_compression,
+            enable_lightweight_encoding);
     }
 }
 } // namespace DB
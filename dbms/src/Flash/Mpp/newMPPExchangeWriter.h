@@ -31,6 +31,8 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
     UInt64 fine_grained_shuffle_batch_size,
     tipb::CompressionMode compression_mode,
     Int64 batch_send_min_limit_compression,
+    UInt64 adaptive_compression_bandwidth,
+    bool enable_lightweight_encoding,
     const String & req_id,
     bool is_async = false);
 
@@ -0,0 +1,123 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Flash/Mpp/AdaptiveCompressionSelector.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <map>
+
+namespace DB
+{
+namespace tests
+{
+namespace
+{
+constexpr size_t ORIGINAL_BYTES = 1024 * 1024;
+
+size_t scaled(double per_byte)
+{
+    return static_cast<size_t>(per_byte * ORIGINAL_BYTES);
+}
+
+// Feed the selector with the given cost of each method until it settles.
+void train(AdaptiveCompressionSelector & selector, double none_ns_per_byte, double lz4_ratio, double lz4_ns_per_byte, double zstd_ratio, double zstd_ns_per_byte)
+{
+    for (size_t i = 0; i < 3 * AdaptiveCompressionSelector::PROBE_INTERVAL; ++i)
+    {
+        auto method = selector.choose();
+        switch (method)
+        {
+        case CompressionMethod::NONE:
+            selector.update(method, ORIGINAL_BYTES, ORIGINAL_BYTES, scaled(none_ns_per_byte));
+            break;
+        case CompressionMethod::LZ4:
+            selector.update(method, ORIGINAL_BYTES, scaled(lz4_ratio), scaled(lz4_ns_per_byte));
+            break;
+        case CompressionMethod::ZSTD:
+            selector.update(method, ORIGINAL_BYTES, scaled(zstd_ratio), scaled(zstd_ns_per_byte));
+            break;
+        default:
+            FAIL() << "unexpected method " << static_cast<int>(method);
+        }
+    }
+}
+
+// Count the methods chosen in the next `n` packets.
+std::map<CompressionMethod, size_t> countChosen(AdaptiveCompressionSelector & selector, size_t n)
+{
+    std::map<CompressionMethod, size_t> res;
+    for (size_t i = 0; i < n; ++i)
+        ++res[selector.choose()];
+    return res;
+}
+} // namespace
+
+TEST(AdaptiveCompressionSelectorTest, ProbeAllMethodsFirst)
+{
+    AdaptiveCompressionSelector selector(1024);
+    for (auto method : AdaptiveCompressionSelector::CANDIDATES)
+    {
+        ASSERT_EQ(selector.choose(), method);
+        ASSERT_EQ(selector.choose(), method);
+        selector.update(method, ORIGINAL_BYTES, ORIGINAL_BYTES, ORIGINAL_BYTES);
+    }
+}
+
+TEST(AdaptiveCompressionSelectorTest, FastNetworkPrefersNoCompression)
+{
+    // 25GbE
+    AdaptiveCompressionSelector selector(3000);
+    train(selector, 0.2, 0.5, 1.5, 0.3, 6.0);
+    ASSERT_LT(selector.estimateCost(CompressionMethod::NONE), selector.estimateCost(CompressionMethod::LZ4));
+
+    auto chosen = countChosen(selector, 10 * AdaptiveCompressionSelector::PROBE_INTERVAL);
+    // The other methods are still probed once every `PROBE_INTERVAL` packets.
+    ASSERT_EQ(chosen[CompressionMethod::NONE], 10 * AdaptiveCompressionSelector::PROBE_INTERVAL - 10);
+    ASSERT_EQ(chosen[CompressionMethod::LZ4] + chosen[CompressionMethod::ZSTD], 10);
+}
+
+TEST(AdaptiveCompressionSelectorTest, SlowNetworkPrefersZstd)
+{
+    AdaptiveCompressionSelector selector(10);
+    train(selector, 0.2, 0.5, 1.5, 0.2, 6.0);
+    ASSERT_LT(selector.estimateCost(CompressionMethod::ZSTD), selector.estimateCost(CompressionMethod::LZ4));
+
+    auto chosen = countChosen(selector, AdaptiveCompressionSelector::PROBE_INTERVAL);
+    ASSERT_EQ(chosen[CompressionMethod::ZSTD], AdaptiveCompressionSelector::PROBE_INTERVAL - 1);
+}
+
+TEST(AdaptiveCompressionSelectorTest, IncompressibleData)
+{
+    // Compression does not help on incompressible data, even if the network is slow.
+    AdaptiveCompressionSelector selector(100);
+    train(selector, 0.2, 1.01, 1.0, 1.0, 4.0);
+    auto chosen = countChosen(selector, AdaptiveCompressionSelector::PROBE_INTERVAL);
+    ASSERT_EQ(chosen[CompressionMethod::NONE], AdaptiveCompressionSelector::PROBE_INTERVAL - 1);
+}
+
+TEST(AdaptiveCompressionSelectorTest, AdaptToDataChange)
+{
+    AdaptiveCompressionSelector selector(100);
+    train(selector, 0.2, 1.0, 1.0, 1.0, 4.0);
+    ASSERT_LT(selector.estimateCost(CompressionMethod::NONE), selector.estimateCost(CompressionMethod::LZ4));
+
+    // The data becomes compressible, the probes find out that LZ4 is better now.
+    train(selector, 0.2, 0.1, 1.0, 0.08, 20.0);
+    ASSERT_LT(selector.estimateCost(CompressionMethod::LZ4), selector.estimateCost(CompressionMethod::NONE));
+    ASSERT_LT(selector.estimateCost(CompressionMethod::LZ4), selector.estimateCost(CompressionMethod::ZSTD));
+}
+
+} // namespace tests
+} // namespace DB
@@ -66,11 +66,12 @@ void Pipeline::toSelfString(FmtBuffer & buffer, size_t level) const
 void Pipeline::toTreeString(FmtBuffer & buffer, size_t level) const
 {
     toSelfString(buffer, level);
-    if (!children.empty())
-        buffer.append("\n");
     ++level;
     for (const auto & child : children)
+    {
+        buffer.append("\n");
         child->toTreeString(buffer, level);
+    }
 }
 
 void Pipeline::addGetResultSink(ResultHandler && result_handler)
@@ -144,6 +145,8 @@ bool Pipeline::isSupported(const tipb::DAGRequest & dag_request)
             case tipb::ExecType::TypeExchangeSender:
             case tipb::ExecType::TypeExchangeReceiver:
             case tipb::ExecType::TypeExpand:
+            case tipb::ExecType::TypeAggregation:
+            case tipb::ExecType::TypeJoin:
                 return true;
             default:
                 is_supported = false;
@@ -0,0 +1,146 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Flash/Pipeline/Schedule/TaskQueues/MultiLevelFeedbackQueue.h>
+#include <assert.h>
+#include <common/likely.h>
+
+#include <limits>
+
+namespace DB
+{
+MultiLevelFeedbackQueue::MultiLevelFeedbackQueue()
+{
+    UInt64 time_slice = 0;
+    double factor = 1;
+    for (size_t i = 0; i < QUEUE_SIZE; ++i)
+    {
+        time_slice += LEVEL_TIME_SLICE_BASE_NS * (i + 1);
+        level_time_slices[i] = time_slice;
+
+        level_queues[i].factor_for_normal = factor;
+        factor /= RATIO_OF_ADJACENT_QUEUE;
+    }
+}
+
+size_t MultiLevelFeedbackQueue::computeQueueLevel(const TaskPtr & task) const
+{
+    auto query_execute_time = task->getQueryExecuteTime();
+    // A task will only be demoted.
+    size_t level = task->mlfq_level;
+    while (level < QUEUE_SIZE - 1 && query_execute_time >= level_time_slices[level])
+        ++level;
+    return level;
+}
+
+void MultiLevelFeedbackQueue::submitTaskWithoutLock(TaskPtr && task)
+{
+    assert(task);
+    task->mlfq_level = computeQueueLevel(task);
+    auto & unit_queue = level_queues[task->mlfq_level];
+    if (unit_queue.task_queue.empty())
+    {
+        // A level that has been idle for a long time has a small consumed time,
+        // align it with the running levels to prevent it from monopolizing all threads.
+        double min_normalized_time = std::numeric_limits<double>::max();
+        for (const auto & queue : level_queues)
+        {
+            if (!queue.task_queue.empty())
+                min_normalized_time = std::min(min_normalized_time, queue.normalizedTime());
+        }
+        if (min_normalized_time != std::numeric_limits<double>::max())
+            unit_queue.accu_consume_time = std::max(unit_queue.accu_consume_time, min_normalized_time * unit_queue.factor_for_normal);
+    }
+    unit_queue.task_queue.push_back(std::move(task));
+}
+
+void MultiLevelFeedbackQueue::submit(TaskPtr && task)
+{
+    {
+        std::lock_guard lock(mu);
+        submitTaskWithoutLock(std::move(task));
+    }
+    cv.notify_one();
+}
+
+void MultiLevelFeedbackQueue::submit(std::vector<TaskPtr> & tasks)
+{
+    if (tasks.empty())
+        return;
+
+    std::lock_guard lock(mu);
+    for (auto & task : tasks)
+    {
+        submitTaskWithoutLock(std::move(task));
+        cv.notify_one();
+    }
+}
+
+bool MultiLevelFeedbackQueue::take(TaskPtr & task)
+{
+    assert(!task);
+    {
+        std::unique_lock lock(mu);
+        UnitQueue * selected = nullptr;
+        while (true)
+        {
+            if (unlikely(is_closed))
+                return false;
+            for (auto & queue : level_queues)
+            {
+                if (queue.task_queue.empty())
+                    continue;
+                if (!selected || queue.normalizedTime() < selected->normalizedTime())
+                    selected = &queue;
+            }
+            if (selected)
+                break;
+            cv.wait(lock);
+        }
+
+        task = std::move(selected->task_queue.front());
+        selected->task_queue.pop_front();
+    }
+    assert(task);
+    return true;
+}
+
+void MultiLevelFeedbackQueue::updateStatistics(const TaskPtr & task, size_t inc_value)
+{
+    assert(task);
+    std::lock_guard lock(mu);
+    level_queues[task->mlfq_level].accu_consume_time += inc_value;
+}
+
+bool MultiLevelFeedbackQueue::empty()
+{
+    std::lock_guard lock(mu);
+    for (const auto & queue : level_queues)
+    {
+        if (!queue.task_queue.empty())
+            return false;
+    }
+    return true;
+}
+
+void MultiLevelFeedbackQueue::close()
+{
+    {
+        std::lock_guard lock(mu);
+        is_closed = true;
+    }
+    cv.notify_all();
+}
+} // namespace DB
@@ -0,0 +1,88 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <Flash/Pipeline/Schedule/TaskQueues/TaskQueue.h>
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace DB
+{
+/// A multi-level feedback queue.
+/// - The level of a task is decided by the accumulated execute time of the query that the task belongs to,
+///   compared with the cumulative bounds of the levels,
+///   so the tasks of a long-running query are demoted level by level and never promoted.
+/// - The cpu time share of level i+1 is 1/RATIO_OF_ADJACENT_QUEUE of level i.
+///   `take` always picks the non-empty level that has the least normalized consumed time,
+///   so the tasks of short queries are executed first and the long-running queries will not be starved.
+class MultiLevelFeedbackQueue : public TaskQueue
+{
+public:
+    MultiLevelFeedbackQueue();
+
+    void submit(TaskPtr && task) override;
+
+    void submit(std::vector<TaskPtr> & tasks) override;
+
+    bool take(TaskPtr & task) override;
+
+    void updateStatistics(const TaskPtr & task, size_t inc_value) override;
+
+    bool empty() override;
+
+    void close() override;
+
+    size_t computeQueueLevel(const TaskPtr & task) const;
+
+public:
+    static constexpr size_t QUEUE_SIZE = 8;
+
+    // The i-th level covers (i+1)*LEVEL_TIME_SLICE_BASE_NS of the accumulated query execute time, so a query leaves
+    // the i-th level after (i+1)*(i+2)/2*LEVEL_TIME_SLICE_BASE_NS in total, see `level_time_slices`.
+    static constexpr UInt64 LEVEL_TIME_SLICE_BASE_NS = 200'000'000L;
+
+    static constexpr double RATIO_OF_ADJACENT_QUEUE = 1.2;
+
+private:
+    struct UnitQueue
+    {
+        double normalizedTime() const
+        {
+            return accu_consume_time / factor_for_normal;
+        }
+
+        std::deque<TaskPtr> task_queue;
+        // The total execute time of the tasks taken from this level.
+        double accu_consume_time = 0;
+        double factor_for_normal = 0;
+    };
+
+    void submitTaskWithoutLock(TaskPtr && task);
+
+private:
+    std::mutex mu;
+    std::condition_variable cv;
+    bool is_closed = false;
+
+    std::array<UnitQueue, QUEUE_SIZE> level_queues;
+    // The cumulative upper bound of the accumulated query execute time for each level,
+    // level_time_slices[i] is the sum of the time slices of the levels 0..i.
+    std::array<UInt64, QUEUE_SIZE> level_time_slices;
+};
+} // namespace DB
@@ -21,8 +21,14 @@
 
 namespace DB
 {
+enum class TaskQueueType
+{
+    FIFO,
+    MLFQ,
+    WORK_STEALING,
+};
+
 // TODO support more kind of TaskQueue, such as
-// - multi-level feedback queue
 // - resource group queue
 class TaskQueue
 {
@@ -36,6 +42,9 @@ public:
     // return false if the queue had been closed.
     virtual bool take(TaskPtr & task) = 0;
 
+    // Called after the task has been executed for a round, before it is submitted again.
+    virtual void updateStatistics(const TaskPtr & /*task*/, size_t /*inc_value*/) {}
+
     virtual bool empty() = 0;
 
     virtual void close() = 0;
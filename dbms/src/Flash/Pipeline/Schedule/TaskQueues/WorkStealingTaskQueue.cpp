@@ -0,0 +1,167 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Common/Exception.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/WorkStealingTaskQueue.h>
+#include <assert.h>
+#include <common/likely.h>
+
+namespace DB
+{
+namespace
+{
+// The id of queue is used instead of its address, because the address may be reused by a new queue.
+std::atomic<UInt64> queue_id_generator{1};
+
+// The queue that the current thread is registered to.
+thread_local UInt64 local_owner_id = 0;
+thread_local size_t local_queue_index = 0;
+} // namespace
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(size_t worker_num)
+    : queue_id(queue_id_generator.fetch_add(1))
+    , local_queues(worker_num)
+{
+    RUNTIME_CHECK(worker_num > 0);
+}
+
+size_t WorkStealingTaskQueue::getLocalQueueIndex() const
+{
+    return local_owner_id == queue_id ? local_queue_index : local_queues.size();
+}
+
+size_t WorkStealingTaskQueue::registerWorker()
+{
+    auto index = next_worker_index.fetch_add(1);
+    RUNTIME_CHECK_MSG(index < local_queues.size(), "The number of workers exceeds {}", local_queues.size());
+    local_owner_id = queue_id;
+    local_queue_index = index;
+    return index;
+}
+
+size_t WorkStealingTaskQueue::selectQueueForSubmit()
+{
+    auto index = getLocalQueueIndex();
+    if (index < local_queues.size())
+        return index;
+    return next_submit_index.fetch_add(1, std::memory_order_relaxed) % local_queues.size();
+}
+
+void WorkStealingTaskQueue::pushTask(size_t queue_index, TaskPtr && task)
+{
+    assert(task);
+    auto & local_queue = local_queues[queue_index];
+    std::lock_guard lock(local_queue.mu);
+    // Count the task before publishing it, otherwise a stealer may take it and decrease `task_count` first.
+    task_count.fetch_add(1);
+    local_queue.task_queue.push_back(std::move(task));
+}
+
+bool WorkStealingTaskQueue::popTask(size_t queue_index, TaskPtr & task)
+{
+    auto & local_queue = local_queues[queue_index];
+    std::lock_guard lock(local_queue.mu);
+    if (local_queue.task_queue.empty())
+        return false;
+    task = std::move(local_queue.task_queue.front());
+    local_queue.task_queue.pop_front();
+    return true;
+}
+
+bool WorkStealingTaskQueue::stealTask(size_t queue_index, TaskPtr & task)
+{
+    for (size_t i = 1; i < local_queues.size(); ++i)
+    {
+        auto & victim = local_queues[(queue_index + i) % local_queues.size()];
+        // Skip the busy victims instead of waiting for them.
+        std::unique_lock lock(victim.mu, std::try_to_lock);
+        if (!lock.owns_lock() || victim.task_queue.empty())
+            continue;
+        task = std::move(victim.task_queue.back());
+        victim.task_queue.pop_back();
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingTaskQueue::notifyIdleWorkers(size_t task_num)
+{
+    // `task_count` has been increased before reading `idle_worker_num`,
+    // and an idle worker increases `idle_worker_num` before checking `task_count`,
+    // so either the idle worker sees the new tasks or it is notified here.
+    if (idle_worker_num.load() == 0)
+        return;
+    std::lock_guard lock(mu);
+    if (task_num == 1)
+        cv.notify_one();
+    else
+        cv.notify_all();
+}
+
+void WorkStealingTaskQueue::submit(TaskPtr && task)
+{
+    pushTask(selectQueueForSubmit(), std::move(task));
+    notifyIdleWorkers(1);
+}
+
+void WorkStealingTaskQueue::submit(std::vector<TaskPtr> & tasks)
+{
+    if (tasks.empty())
+        return;
+
+    for (auto & task : tasks)
+        pushTask(selectQueueForSubmit(), std::move(task));
+    notifyIdleWorkers(tasks.size());
+}
+
+bool WorkStealingTaskQueue::take(TaskPtr & task)
+{
+    assert(!task);
+    auto queue_index = getLocalQueueIndex();
+    if (unlikely(queue_index == local_queues.size()))
+        queue_index = registerWorker();
+
+    while (true)
+    {
+        if (unlikely(is_closed.load()))
+            return false;
+        if (popTask(queue_index, task) || stealTask(queue_index, task))
+        {
+            task_count.fetch_sub(1);
+            assert(task);
+            return true;
+        }
+
+        std::unique_lock lock(mu);
+        idle_worker_num.fetch_add(1);
+        cv.wait(lock, [&] { return is_closed.load() || task_count.load() > 0; });
+        idle_worker_num.fetch_sub(1);
+    }
+}
+
+bool WorkStealingTaskQueue::empty()
+{
+    return task_count.load() == 0;
+}
+
+void WorkStealingTaskQueue::close()
+{
+    {
+        std::lock_guard lock(mu);
+        is_closed.store(true);
+    }
+    cv.notify_all();
+}
+} // namespace DB
@@ -0,0 +1,88 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <Flash/Pipeline/Schedule/TaskQueues/TaskQueue.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace DB
+{
+/// A task queue with a local deque for each worker thread.
+/// - A worker takes tasks from the front of its own deque first, and steals from the back of other deques if its own deque is empty.
+/// - A task submitted by a worker, e.g. re-submitted after `execute`, goes back to the deque of that worker to keep cache locality.
+/// - A task submitted by other threads is distributed to the deques in round-robin.
+/// So in most cases, a worker only contends with the stealers for the lock of its own deque.
+class WorkStealingTaskQueue : public TaskQueue
+{
+public:
+    explicit WorkStealingTaskQueue(size_t worker_num);
+
+    void submit(TaskPtr && task) override;
+
+    void submit(std::vector<TaskPtr> & tasks) override;
+
+    // Must be called by a fixed set of at most `worker_num` threads.
+    bool take(TaskPtr & task) override;
+
+    bool empty() override;
+
+    void close() override;
+
+private:
+    struct LocalQueue
+    {
+        std::mutex mu;
+        std::deque<TaskPtr> task_queue;
+    };
+
+    // Return the index of the local queue of the current thread,
+    // or `local_queues.size()` if the current thread is not a worker of this queue.
+    size_t getLocalQueueIndex() const;
+
+    size_t registerWorker();
+
+    size_t selectQueueForSubmit();
+
+    void pushTask(size_t queue_index, TaskPtr && task);
+
+    bool popTask(size_t queue_index, TaskPtr & task);
+
+    bool stealTask(size_t queue_index, TaskPtr & task);
+
+    void notifyIdleWorkers(size_t task_num);
+
+private:
+    const UInt64 queue_id;
+
+    std::vector<LocalQueue> local_queues;
+
+    std::atomic<size_t> next_worker_index{0};
+    std::atomic<size_t> next_submit_index{0};
+
+    // The number of tasks in all local queues.
+    std::atomic<size_t> task_count{0};
+
+    // Only used for the idle workers to sleep and wake up.
+    std::mutex mu;
+    std::condition_variable cv;
+    std::atomic<size_t> idle_worker_num{0};
+    std::atomic_bool is_closed{false};
+};
+} // namespace DB
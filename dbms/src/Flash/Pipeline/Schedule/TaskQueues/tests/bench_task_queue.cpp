@@ -0,0 +1,161 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Common/Stopwatch.h>
+#include <Flash/Pipeline/Schedule/TaskScheduler.h>
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace DB
+{
+namespace bench
+{
+namespace
+{
+void spin(UInt64 ns)
+{
+    Stopwatch stopwatch{CLOCK_MONOTONIC};
+    while (stopwatch.elapsed() < ns)
+    {
+    }
+}
+
+// Simulate a long-running scan which computes a block every 1ms until stopped.
+class ScanTask : public Task
+{
+public:
+    explicit ScanTask(const std::atomic_bool & stop_)
+        : Task(nullptr)
+        , stop(stop_)
+    {}
+
+protected:
+    ExecTaskStatus executeImpl() override
+    {
+        if (stop.load(std::memory_order_relaxed))
+            return ExecTaskStatus::FINISHED;
+        spin(1'000'000);
+        return ExecTaskStatus::RUNNING;
+    }
+
+private:
+    const std::atomic_bool & stop;
+};
+
+struct LatencyRecorder
+{
+    void record(UInt64 latency_ns)
+    {
+        {
+            std::lock_guard lock(mu);
+            latencies.push_back(latency_ns);
+        }
+        cv.notify_one();
+    }
+
+    void waitFor(size_t count)
+    {
+        std::unique_lock lock(mu);
+        cv.wait(lock, [&] { return latencies.size() >= count; });
+    }
+
+    double percentileMs(double percentile)
+    {
+        std::lock_guard lock(mu);
+        std::sort(latencies.begin(), latencies.end());
+        size_t index = std::min(latencies.size() - 1, static_cast<size_t>(percentile * latencies.size()));
+        return latencies[index] / 1'000'000.0;
+    }
+
+    std::mutex mu;
+    std::condition_variable cv;
+    std::vector<UInt64> latencies;
+};
+
+// Simulate a short query which needs about 5ms cpu time.
+class ShortQueryTask : public Task
+{
+public:
+    explicit ShortQueryTask(LatencyRecorder & recorder_)
+        : Task(nullptr)
+        , recorder(recorder_)
+    {}
+
+protected:
+    ExecTaskStatus executeImpl() override
+    {
+        spin(1'000'000);
+        if (--remaining_rounds > 0)
+            return ExecTaskStatus::RUNNING;
+        recorder.record(stopwatch.elapsed());
+        return ExecTaskStatus::FINISHED;
+    }
+
+private:
+    LatencyRecorder & recorder;
+    size_t remaining_rounds = 5;
+    Stopwatch stopwatch{CLOCK_MONOTONIC};
+};
+} // namespace
+
+// Measure the latency of short queries under a background scan load.
+// Arg: TaskQueueType.
+static void ShortQueryLatencyUnderScan(benchmark::State & state)
+{
+    const auto queue_type = static_cast<TaskQueueType>(state.range(0));
+    constexpr size_t thread_num = 4;
+    constexpr size_t scan_task_num = 4 * thread_num;
+    constexpr size_t short_query_num = 50;
+
+    for (auto _ : state)
+    {
+        std::atomic_bool stop{false};
+        LatencyRecorder recorder;
+        {
+            TaskScheduler scheduler(TaskSchedulerConfig{thread_num, queue_type});
+
+            std::vector<TaskPtr> scan_tasks;
+            for (size_t i = 0; i < scan_task_num; ++i)
+                scan_tasks.push_back(std::make_unique<ScanTask>(stop));
+            scheduler.submit(scan_tasks);
+            // Warm up so that the scan tasks have run long enough to be demoted by mlfq.
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+
+            for (size_t i = 0; i < short_query_num; ++i)
+            {
+                std::vector<TaskPtr> short_query;
+                short_query.push_back(std::make_unique<ShortQueryTask>(recorder));
+                scheduler.submit(short_query);
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+            recorder.waitFor(short_query_num);
+            stop.store(true, std::memory_order_relaxed);
+        }
+        state.counters["p50_ms"] = recorder.percentileMs(0.5);
+        state.counters["p99_ms"] = recorder.percentileMs(0.99);
+    }
+}
+BENCHMARK(ShortQueryLatencyUnderScan)
+    ->Arg(static_cast<int64_t>(TaskQueueType::FIFO))
+    ->Arg(static_cast<int64_t>(TaskQueueType::MLFQ))
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace bench
+} // namespace DB
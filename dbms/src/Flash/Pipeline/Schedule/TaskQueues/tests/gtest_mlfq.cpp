@@ -0,0 +1,190 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Common/ThreadManager.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/MultiLevelFeedbackQueue.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace DB::tests
+{
+namespace
+{
+class IndexTask : public Task
+{
+public:
+    explicit IndexTask(size_t index_)
+        : Task(nullptr)
+        , index(index_)
+    {}
+
+    ExecTaskStatus executeImpl() override { return ExecTaskStatus::FINISHED; }
+
+    size_t index;
+};
+
+TaskPtr newTaskWithExecuteTime(size_t index, UInt64 execute_time_ns)
+{
+    auto task = std::make_unique<IndexTask>(index);
+    task->profileExecuteTime(execute_time_ns);
+    return task;
+}
+
+size_t getIndex(const TaskPtr & task)
+{
+    return static_cast<IndexTask *>(task.get())->index;
+}
+} // namespace
+
+class MLFQTestRunner : public ::testing::Test
+{
+};
+
+TEST_F(MLFQTestRunner, base)
+try
+{
+    MultiLevelFeedbackQueue queue;
+
+    auto thread_manager = newThreadManager();
+    size_t valid_task_num = 1000;
+
+    // submit valid task
+    thread_manager->schedule(false, "submit", [&]() {
+        for (size_t i = 0; i < valid_task_num; ++i)
+            queue.submit(std::make_unique<IndexTask>(i));
+        // Close the queue after all valid tasks have been consumed.
+        while (!queue.empty())
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        queue.close();
+    });
+    // take valid task
+    thread_manager->schedule(false, "take", [&]() {
+        TaskPtr task;
+        size_t expect_index = 0;
+        while (queue.take(task))
+        {
+            ASSERT_TRUE(task);
+            // All tasks are in the first level, so they are taken in fifo order.
+            ASSERT_EQ(getIndex(task), expect_index++);
+            task.reset();
+        }
+        ASSERT_EQ(expect_index, valid_task_num);
+    });
+    thread_manager->wait();
+
+    // No tasks are taken after the queue is closed.
+    queue.submit(std::make_unique<IndexTask>(valid_task_num));
+    TaskPtr task;
+    ASSERT_FALSE(queue.take(task));
+}
+CATCH
+
+TEST_F(MLFQTestRunner, computeQueueLevel)
+try
+{
+    MultiLevelFeedbackQueue queue;
+    const auto base = MultiLevelFeedbackQueue::LEVEL_TIME_SLICE_BASE_NS;
+
+    auto task = newTaskWithExecuteTime(0, 0);
+    ASSERT_EQ(queue.computeQueueLevel(task), 0);
+
+    // The time slice of level i is (i+1)*base.
+    task->profileExecuteTime(base - 1);
+    ASSERT_EQ(queue.computeQueueLevel(task), 0);
+    task->profileExecuteTime(1);
+    ASSERT_EQ(queue.computeQueueLevel(task), 1);
+    task->profileExecuteTime(2 * base);
+    ASSERT_EQ(queue.computeQueueLevel(task), 2);
+
+    // The last level has no upper bound.
+    task->profileExecuteTime(1000 * base);
+    ASSERT_EQ(queue.computeQueueLevel(task), MultiLevelFeedbackQueue::QUEUE_SIZE - 1);
+
+    // A task is never promoted.
+    auto new_task = newTaskWithExecuteTime(1, 0);
+    new_task->mlfq_level = 3;
+    ASSERT_EQ(queue.computeQueueLevel(new_task), 3);
+}
+CATCH
+
+TEST_F(MLFQTestRunner, feedback)
+try
+{
+    MultiLevelFeedbackQueue queue;
+    const auto base = MultiLevelFeedbackQueue::LEVEL_TIME_SLICE_BASE_NS;
+
+    // index 0 is a long-running task, index 1 is a short one.
+    queue.submit(newTaskWithExecuteTime(0, 100 * base));
+    queue.submit(newTaskWithExecuteTime(1, 0));
+
+    // The short task is taken first even though it is submitted later.
+    TaskPtr task;
+    ASSERT_TRUE(queue.take(task));
+    ASSERT_EQ(getIndex(task), 1);
+    ASSERT_EQ(task->mlfq_level, 0);
+    // The short task takes up much cpu time, but it is still in the first level.
+    queue.updateStatistics(task, base / 2);
+    task->profileExecuteTime(base / 2);
+    queue.submit(std::move(task));
+
+    // The first level has consumed more normalized time than the last level, so the long-running task is not starved.
+    ASSERT_TRUE(queue.take(task));
+    ASSERT_EQ(getIndex(task), 0);
+    ASSERT_EQ(task->mlfq_level, MultiLevelFeedbackQueue::QUEUE_SIZE - 1);
+    queue.updateStatistics(task, base);
+    task.reset();
+
+    ASSERT_TRUE(queue.take(task));
+    ASSERT_EQ(getIndex(task), 1);
+    task.reset();
+    ASSERT_TRUE(queue.empty());
+}
+CATCH
+
+TEST_F(MLFQTestRunner, idleLevel)
+try
+{
+    MultiLevelFeedbackQueue queue;
+    const auto base = MultiLevelFeedbackQueue::LEVEL_TIME_SLICE_BASE_NS;
+
+    // Only the first level is running for a long time.
+    TaskPtr task;
+    queue.submit(newTaskWithExecuteTime(0, 0));
+    ASSERT_TRUE(queue.take(task));
+    queue.updateStatistics(task, 10 * base);
+    task.reset();
+
+    // Tasks of the last level are submitted while the first level is busy,
+    // the idle last level is aligned with the first level instead of monopolizing the queue.
+    queue.submit(newTaskWithExecuteTime(1, 0));
+    queue.submit(newTaskWithExecuteTime(2, 100 * base));
+    queue.submit(newTaskWithExecuteTime(3, 100 * base));
+
+    ASSERT_TRUE(queue.take(task));
+    ASSERT_EQ(getIndex(task), 1);
+    task.reset();
+    ASSERT_TRUE(queue.take(task));
+    ASSERT_EQ(getIndex(task), 2);
+    task.reset();
+    ASSERT_TRUE(queue.take(task));
+    ASSERT_EQ(getIndex(task), 3);
+    task.reset();
+    ASSERT_TRUE(queue.empty());
+}
+CATCH
+
+} // namespace DB::tests
@@ -0,0 +1,164 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Common/ThreadManager.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/WorkStealingTaskQueue.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace DB::tests
+{
+namespace
+{
+class IndexTask : public Task
+{
+public:
+    explicit IndexTask(size_t index_)
+        : Task(nullptr)
+        , index(index_)
+    {}
+
+    ExecTaskStatus executeImpl() override { return ExecTaskStatus::FINISHED; }
+
+    size_t index;
+};
+
+size_t getIndex(const TaskPtr & task)
+{
+    return static_cast<IndexTask *>(task.get())->index;
+}
+} // namespace
+
+class WorkStealingTestRunner : public ::testing::Test
+{
+};
+
+TEST_F(WorkStealingTestRunner, base)
+try
+{
+    WorkStealingTaskQueue queue(1);
+
+    auto thread_manager = newThreadManager();
+    size_t valid_task_num = 1000;
+
+    // submit valid task
+    thread_manager->schedule(false, "submit", [&]() {
+        for (size_t i = 0; i < valid_task_num; ++i)
+            queue.submit(std::make_unique<IndexTask>(i));
+        // Close the queue after all valid tasks have been consumed.
+        while (!queue.empty())
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        queue.close();
+    });
+    // take valid task
+    thread_manager->schedule(false, "take", [&]() {
+        TaskPtr task;
+        size_t expect_index = 0;
+        while (queue.take(task))
+        {
+            ASSERT_TRUE(task);
+            // There is only one worker, so the tasks are taken in fifo order.
+            ASSERT_EQ(getIndex(task), expect_index++);
+            task.reset();
+        }
+        ASSERT_EQ(expect_index, valid_task_num);
+    });
+    thread_manager->wait();
+
+    // No tasks are taken after the queue is closed.
+    queue.submit(std::make_unique<IndexTask>(valid_task_num));
+    TaskPtr task;
+    ASSERT_FALSE(queue.take(task));
+}
+CATCH
+
+TEST_F(WorkStealingTestRunner, multiWorkers)
+try
+{
+    size_t worker_num = 4;
+    WorkStealingTaskQueue queue(worker_num);
+
+    auto thread_manager = newThreadManager();
+    size_t valid_task_num = 10000;
+    std::vector<std::vector<size_t>> taken_indexes(worker_num);
+    for (size_t i = 0; i < worker_num; ++i)
+    {
+        thread_manager->schedule(false, "take", [&, i]() {
+            TaskPtr task;
+            while (queue.take(task))
+            {
+                ASSERT_TRUE(task);
+                taken_indexes[i].push_back(getIndex(task));
+                task.reset();
+            }
+        });
+    }
+    thread_manager->schedule(false, "submit", [&]() {
+        for (size_t i = 0; i < valid_task_num; ++i)
+            queue.submit(std::make_unique<IndexTask>(i));
+        while (!queue.empty())
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        queue.close();
+    });
+    thread_manager->wait();
+
+    // Every task is taken exactly once.
+    std::vector<size_t> all_indexes;
+    for (const auto & indexes : taken_indexes)
+        all_indexes.insert(all_indexes.end(), indexes.begin(), indexes.end());
+    std::sort(all_indexes.begin(), all_indexes.end());
+    ASSERT_EQ(all_indexes.size(), valid_task_num);
+    for (size_t i = 0; i < valid_task_num; ++i)
+        ASSERT_EQ(all_indexes[i], i);
+}
+CATCH
+
+TEST_F(WorkStealingTestRunner, localityAndSteal)
+try
+{
+    WorkStealingTaskQueue queue(2);
+
+    // Submitted by a non-worker thread, task 0 goes to the first local queue and task 1 goes to the second one.
+    queue.submit(std::make_unique<IndexTask>(0));
+    queue.submit(std::make_unique<IndexTask>(1));
+
+    auto thread_manager = newThreadManager();
+    thread_manager->schedule(false, "worker", [&]() {
+        TaskPtr task;
+        // The first worker is registered to the first local queue.
+        ASSERT_TRUE(queue.take(task));
+        ASSERT_EQ(getIndex(task), 0);
+
+        // The task re-submitted by the worker goes back to its local queue.
+        queue.submit(std::move(task));
+        ASSERT_TRUE(queue.take(task));
+        ASSERT_EQ(getIndex(task), 0);
+        task.reset();
+
+        // Steal from the second local queue when the local queue is empty.
+        ASSERT_TRUE(queue.take(task));
+        ASSERT_EQ(getIndex(task), 1);
+        task.reset();
+        ASSERT_TRUE(queue.empty());
+    });
+    thread_manager->wait();
+    queue.close();
+}
+CATCH
+
+} // namespace DB::tests
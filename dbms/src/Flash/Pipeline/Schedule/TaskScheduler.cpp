@@ -23,7 +23,7 @@
 namespace DB
 {
 TaskScheduler::TaskScheduler(const TaskSchedulerConfig & config)
-    : task_thread_pool(*this, config.task_thread_pool_size)
+    : task_thread_pool(*this, config.task_thread_pool_size, config.task_queue_type)
     , wait_reactor(*this)
 {
 }
@@ -24,6 +24,7 @@ namespace DB
 struct TaskSchedulerConfig
 {
     size_t task_thread_pool_size;
+    TaskQueueType task_queue_type = TaskQueueType::FIFO;
 };
 
 /**
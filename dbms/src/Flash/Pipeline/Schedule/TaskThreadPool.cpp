@@ -16,6 +16,8 @@
 #include <Common/Stopwatch.h>
 #include <Common/setThreadName.h>
 #include <Flash/Pipeline/Schedule/TaskQueues/FiFOTaskQueue.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/MultiLevelFeedbackQueue.h>
+#include <Flash/Pipeline/Schedule/TaskQueues/WorkStealingTaskQueue.h>
 #include <Flash/Pipeline/Schedule/TaskScheduler.h>
 #include <Flash/Pipeline/Schedule/TaskThreadPool.h>
 #include <Flash/Pipeline/Schedule/Tasks/TaskHelper.h>
@@ -24,8 +26,25 @@
 
 namespace DB
 {
-TaskThreadPool::TaskThreadPool(TaskScheduler & scheduler_, size_t thread_num)
-    : task_queue(std::make_unique<FIFOTaskQueue>())
+namespace
+{
+TaskQueuePtr newTaskQueue(TaskQueueType queue_type, size_t thread_num)
+{
+    switch (queue_type)
+    {
+    case TaskQueueType::FIFO:
+        return std::make_unique<FIFOTaskQueue>();
+    case TaskQueueType::MLFQ:
+        return std::make_unique<MultiLevelFeedbackQueue>();
+    case TaskQueueType::WORK_STEALING:
+        return std::make_unique<WorkStealingTaskQueue>(thread_num);
+    }
+    __builtin_unreachable();
+}
+} // namespace
+
+TaskThreadPool::TaskThreadPool(TaskScheduler & scheduler_, size_t thread_num, TaskQueueType queue_type)
+    : task_queue(newTaskQueue(queue_type, thread_num))
     , scheduler(scheduler_)
 {
     RUNTIME_CHECK(thread_num > 0);
@@ -79,6 +98,9 @@ void TaskThreadPool::handleTask(TaskPtr & task, const LoggerPtr & log)
         if (status != ExecTaskStatus::RUNNING || stopwatch.elapsed() >= YIELD_MAX_TIME_SPENT_NS)
             break;
     }
+    auto inc_time_spent = stopwatch.elapsed();
+    task->profileExecuteTime(inc_time_spent);
+    task_queue->updateStatistics(task, inc_time_spent);
 
     switch (status)
     {
@@ -28,7 +28,7 @@ class TaskScheduler;
 class TaskThreadPool
 {
 public:
-    TaskThreadPool(TaskScheduler & scheduler_, size_t thread_num);
+    TaskThreadPool(TaskScheduler & scheduler_, size_t thread_num, TaskQueueType queue_type);
 
     void close();
 
@@ -49,6 +49,16 @@ void EventTask::finalize()
     }
 }
 
+UInt64 EventTask::getQueryExecuteTime() const
+{
+    return exec_status.getExecuteTime();
+}
+
+void EventTask::addQueryExecuteTime(UInt64 execute_time_ns)
+{
+    exec_status.addExecuteTime(execute_time_ns);
+}
+
 ExecTaskStatus EventTask::executeImpl()
 {
     return doTaskAction([&] { return doExecuteImpl(); });
@@ -32,7 +32,11 @@ public:
 
     ~EventTask();
 
+    UInt64 getQueryExecuteTime() const override;
+
 protected:
+    void addQueryExecuteTime(UInt64 execute_time_ns) override;
+
     ExecTaskStatus executeImpl() override;
     virtual ExecTaskStatus doExecuteImpl() = 0;
 
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <Common/MemoryTracker.h>
+#include <common/types.h>
 #include <memory.h>
 
 namespace DB
@@ -62,12 +63,33 @@ public:
         return awaitImpl();
     }
 
+    // Called by task thread pool after each round of execution.
+    void profileExecuteTime(UInt64 execute_time_ns)
+    {
+        task_execute_time_ns += execute_time_ns;
+        addQueryExecuteTime(execute_time_ns);
+    }
+
+    UInt64 getTaskExecuteTime() const { return task_execute_time_ns; }
+
+    // The accumulated execute time of the query that this task belongs to.
+    // By default, a task is regarded as a query by itself.
+    virtual UInt64 getQueryExecuteTime() const { return task_execute_time_ns; }
+
 protected:
     virtual ExecTaskStatus executeImpl() = 0;
     virtual ExecTaskStatus awaitImpl() { return ExecTaskStatus::RUNNING; }
 
+    virtual void addQueryExecuteTime(UInt64 /*execute_time_ns*/) {}
+
+public:
+    // Only used by MultiLevelFeedbackQueue.
+    size_t mlfq_level{0};
+
 private:
     MemoryTrackerPtr mem_tracker;
+
+    UInt64 task_execute_time_ns{0};
 };
 using TaskPtr = std::unique_ptr<Task>;
 
@@ -0,0 +1,112 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Common/Stopwatch.h>
+#include <Flash/Pipeline/Schedule/TaskScheduler.h>
+#include <benchmark/benchmark.h>
+
+#include <condition_variable>
+#include <mutex>
+
+namespace DB
+{
+namespace bench
+{
+namespace
+{
+struct Waiter
+{
+    explicit Waiter(size_t task_num)
+        : remaining(task_num)
+    {}
+
+    void notify()
+    {
+        if (remaining.fetch_sub(1) == 1)
+        {
+            std::lock_guard lock(mu);
+            cv.notify_one();
+        }
+    }
+
+    void wait()
+    {
+        std::unique_lock lock(mu);
+        cv.wait(lock, [&] { return remaining.load() == 0; });
+    }
+
+    std::atomic<size_t> remaining;
+    std::mutex mu;
+    std::condition_variable cv;
+};
+
+// Simulate a task which only processes a tiny block.
+class TinyTask : public Task
+{
+public:
+    explicit TinyTask(Waiter & waiter_)
+        : Task(nullptr)
+        , waiter(waiter_)
+    {}
+
+protected:
+    ExecTaskStatus executeImpl() override
+    {
+        Stopwatch stopwatch{CLOCK_MONOTONIC};
+        while (stopwatch.elapsed() < 1'000)
+        {
+        }
+        waiter.notify();
+        return ExecTaskStatus::FINISHED;
+    }
+
+private:
+    Waiter & waiter;
+};
+} // namespace
+
+// Measure the scheduling throughput of the task thread pool with a large number of tiny tasks.
+// Args: TaskQueueType, thread num.
+static void TaskSchedulerThroughput(benchmark::State & state)
+{
+    const auto queue_type = static_cast<TaskQueueType>(state.range(0));
+    const auto thread_num = static_cast<size_t>(state.range(1));
+    constexpr size_t task_num = 100'000;
+
+    TaskScheduler scheduler(TaskSchedulerConfig{thread_num, queue_type});
+    for (auto _ : state)
+    {
+        Waiter waiter(task_num);
+        std::vector<TaskPtr> tasks;
+        tasks.reserve(task_num);
+        for (size_t i = 0; i < task_num; ++i)
+            tasks.push_back(std::make_unique<TinyTask>(waiter));
+        scheduler.submit(tasks);
+        waiter.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * task_num);
+}
+BENCHMARK(TaskSchedulerThroughput)
+    ->Args({static_cast<int64_t>(TaskQueueType::FIFO), 4})
+    ->Args({static_cast<int64_t>(TaskQueueType::WORK_STEALING), 4})
+    ->Args({static_cast<int64_t>(TaskQueueType::FIFO), 16})
+    ->Args({static_cast<int64_t>(TaskQueueType::WORK_STEALING), 16})
+    ->Args({static_cast<int64_t>(TaskQueueType::FIFO), 64})
+    ->Args({static_cast<int64_t>(TaskQueueType::WORK_STEALING), 64})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace bench
+} // namespace DB
@@ -236,6 +236,7 @@ DAGContext & PhysicalPlan::dagContext() const
 void PhysicalPlan::pushBack(const PhysicalPlanNodePtr & plan_node)
 {
     assert(plan_node);
+    plan_node->setEnableShortCircuit(context.getSettingsRef().enable_short_circuit_evaluation);
     cur_plan_nodes.push_back(plan_node);
 }
 
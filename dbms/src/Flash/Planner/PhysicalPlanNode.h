@@ -76,6 +76,9 @@ public:
 
     void disableRestoreConcurrency() { is_restore_concurrency = false; }
 
+    /// See the setting `enable_short_circuit_evaluation`.
+    void setEnableShortCircuit(bool enable_short_circuit_) { enable_short_circuit = enable_short_circuit_; }
+
     String toString();
 
     String toSimpleString();
@@ -91,6 +94,8 @@ protected:
 
     bool is_tidb_operator = true;
     bool is_restore_concurrency = true;
+    /// Whether the expressions of this plan node evaluate the branches of and/or/if/multiIf lazily, see `ExpressionActions::finalize`.
+    bool enable_short_circuit = false;
 
     LoggerPtr log;
 };
@@ -38,6 +38,10 @@ struct PlanType
         Join = 13,
         GetResult = 14,
         Expand = 15,
+        AggregationBuild = 16,
+        AggregationConvergent = 17,
+        JoinBuild = 18,
+        JoinProbe = 19,
     };
     PlanTypeEnum enum_value;
 
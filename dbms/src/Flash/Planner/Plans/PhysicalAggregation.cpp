@@ -25,6 +25,8 @@
 #include <Flash/Planner/FinalizeHelper.h>
 #include <Flash/Planner/PhysicalPlanHelper.h>
 #include <Flash/Planner/Plans/PhysicalAggregation.h>
+#include <Flash/Planner/Plans/PhysicalAggregationBuild.h>
+#include <Flash/Planner/Plans/PhysicalAggregationConvergent.h>
 #include <Interpreters/Context.h>
 
 namespace DB
@@ -155,23 +157,40 @@ void PhysicalAggregation::buildBlockInputStreamImpl(DAGPipeline & pipeline, Cont
 
 void PhysicalAggregation::buildPipeline(PipelineBuilder & builder)
 {
-    // Break the pipeline for pre-agg.
-    // FIXME: Should be newly created PhysicalPreAgg.
-    auto pre_agg_builder = builder.breakPipeline(shared_from_this());
-    // Pre-agg pipeline.
-    child->buildPipeline(pre_agg_builder);
-    pre_agg_builder.build();
-    // Final-agg pipeline.
-    // FIXME: Should be newly created PhysicalFinalAgg.
-    builder.addPlanNode(shared_from_this());
-    throw Exception("Unsupport");
+    // TODO support fine grained shuffle.
+    assert(!fine_grained_shuffle.enable());
+    auto aggregate_context = std::make_shared<AggregateContext>(log->identifier());
+    auto agg_build = std::make_shared<PhysicalAggregationBuild>(
+        executor_id,
+        schema,
+        log->identifier(),
+        child,
+        before_agg_actions,
+        aggregation_keys,
+        aggregation_collators,
+        is_final_agg,
+        aggregate_descriptions,
+        aggregate_context);
+    // Break the pipeline for agg_build.
+    auto agg_build_builder = builder.breakPipeline(agg_build);
+    // agg_build pipeline.
+    child->buildPipeline(agg_build_builder);
+    agg_build_builder.build();
+    // agg_convergent pipeline.
+    auto agg_convergent = std::make_shared<PhysicalAggregationConvergent>(
+        executor_id,
+        schema,
+        log->identifier(),
+        expr_after_agg,
+        aggregate_context);
+    builder.addPlanNode(agg_convergent);
 }
 
 void PhysicalAggregation::finalize(const Names & parent_require)
 {
     // schema.size() >= parent_require.size()
     FinalizeHelper::checkSchemaContainsParentRequire(schema, parent_require);
-    expr_after_agg->finalize(DB::toNames(schema));
+    expr_after_agg->finalize(DB::toNames(schema), enable_short_circuit);
 
     Names before_agg_output;
     // set required output for agg funcs's arguments and group by keys.
@@ -185,7 +204,7 @@ void PhysicalAggregation::finalize(const Names & parent_require)
         before_agg_output.push_back(aggregation_key);
     }
 
-    before_agg_actions->finalize(before_agg_output);
+    before_agg_actions->finalize(before_agg_output, enable_short_circuit);
     child->finalize(before_agg_actions->getRequiredColumns());
     FinalizeHelper::prependProjectInputIfNeed(before_agg_actions, child->getSampleBlock().columns());
 
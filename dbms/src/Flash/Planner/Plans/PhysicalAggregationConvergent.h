@@ -0,0 +1,60 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <Flash/Planner/Plans/PhysicalLeaf.h>
+#include <Interpreters/ExpressionActions.h>
+#include <Operators/AggregateContext.h>
+
+namespace DB
+{
+class PhysicalAggregationConvergent : public PhysicalLeaf
+{
+public:
+    PhysicalAggregationConvergent(
+        const String & executor_id_,
+        const NamesAndTypes & schema_,
+        const String & req_id,
+        const ExpressionActionsPtr & expr_after_agg_,
+        const AggregateContextPtr & aggregate_context_)
+        : PhysicalLeaf(executor_id_, PlanType::AggregationConvergent, schema_, req_id)
+        , expr_after_agg(expr_after_agg_)
+        , aggregate_context(aggregate_context_)
+    {}
+
+    void buildPipelineExec(PipelineExecGroupBuilder & group_builder, Context & /*context*/, size_t /*concurrency*/) override;
+
+    void finalize(const Names &) override
+    {
+        throw Exception("Unsupport");
+    }
+
+    const Block & getSampleBlock() const override
+    {
+        return expr_after_agg->getSampleBlock();
+    }
+
+private:
+    void buildBlockInputStreamImpl(DAGPipeline &, Context &, size_t) override
+    {
+        throw Exception("Unsupport");
+    }
+
+private:
+    ExpressionActionsPtr expr_after_agg;
+    AggregateContextPtr aggregate_context;
+};
+} // namespace DB
@@ -81,6 +81,8 @@ void PhysicalExchangeSender::buildBlockInputStreamImpl(DAGPipeline & pipeline, C
             fine_grained_shuffle.batch_size,
             compression_mode,
             context.getSettingsRef().batch_send_min_limit_compression,
+            context.getSettingsRef().mpp_exchange_adaptive_compression_bandwidth,
+            context.getSettingsRef().mpp_exchange_lightweight_encoding,
             log->identifier());
         stream = std::make_shared<ExchangeSenderBlockInputStream>(stream, std::move(response_writer), log->identifier());
         stream->setExtraInfo(extra_info);
@@ -106,6 +108,8 @@ void PhysicalExchangeSender::buildPipelineExec(PipelineExecGroupBuilder & group_
             fine_grained_shuffle.batch_size,
             compression_mode,
             context.getSettingsRef().batch_send_min_limit_compression,
+            context.getSettingsRef().mpp_exchange_adaptive_compression_bandwidth,
+            context.getSettingsRef().mpp_exchange_lightweight_encoding,
             log->identifier(),
             /*is_async=*/true);
         builder.setSinkOp(std::make_unique<ExchangeSenderSinkOp>(group_builder.exec_status, std::move(response_writer), log->identifier()));
@@ -100,7 +100,7 @@ void PhysicalExpand::finalize(const Names & parent_require)
     FinalizeHelper::checkSchemaContainsParentRequire(schema, parent_require);
     Names required_output = parent_require;
     required_output.emplace_back(Expand::grouping_identifier_column_name);
-    expand_actions->finalize(required_output);
+    expand_actions->finalize(required_output, enable_short_circuit);
 
     child->finalize(expand_actions->getRequiredColumns());
     FinalizeHelper::prependProjectInputIfNeed(expand_actions, child->getSampleBlock().columns());
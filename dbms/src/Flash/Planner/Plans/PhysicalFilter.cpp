@@ -69,7 +69,7 @@ void PhysicalFilter::finalize(const Names & parent_require)
 {
     Names required_output = parent_require;
     required_output.emplace_back(filter_column);
-    before_filter_actions->finalize(required_output);
+    before_filter_actions->finalize(required_output, enable_short_circuit);
 
     child->finalize(before_filter_actions->getRequiredColumns());
     FinalizeHelper::prependProjectInputIfNeed(before_filter_actions, child->getSampleBlock().columns());
@@ -27,6 +27,8 @@
 #include <Flash/Planner/FinalizeHelper.h>
 #include <Flash/Planner/PhysicalPlanHelper.h>
 #include <Flash/Planner/Plans/PhysicalJoin.h>
+#include <Flash/Planner/Plans/PhysicalJoinBuild.h>
+#include <Flash/Planner/Plans/PhysicalJoinProbe.h>
 #include <Interpreters/Context.h>
 #include <common/logger_useful.h>
 #include <fmt/format.h>
@@ -136,6 +138,9 @@ PhysicalPlanNodePtr PhysicalJoin::build(
         max_block_size_for_cross_join,
         match_helper_name);
 
+    JoinInterpreterHelper::setJoinSpillConfig(context, *join_ptr, log->identifier());
+    join_ptr->setRuntimeFilters(dag_context.getJoinRuntimeFilters(executor_id));
+
     recordJoinExecuteInfo(dag_context, executor_id, build_plan->execId(), join_ptr);
 
     auto physical_join = std::make_shared<PhysicalJoin>(
@@ -236,17 +241,33 @@ void PhysicalJoin::doSchemaProject(DAGPipeline & pipeline)
 
 void PhysicalJoin::buildPipeline(PipelineBuilder & builder)
 {
+    // TODO support fine grained shuffle.
+    assert(!fine_grained_shuffle.enable());
+    auto join_build = std::make_shared<PhysicalJoinBuild>(
+        executor_id,
+        build()->getSchema(),
+        log->identifier(),
+        build(),
+        join_ptr,
+        build_side_prepare_actions);
     // Break the pipeline for join build.
-    // FIXME: Should be newly created PhysicalJoinBuild.
-    auto join_build_builder = builder.breakPipeline(shared_from_this());
+    auto join_build_builder = builder.breakPipeline(join_build);
     // Join build pipeline.
     build()->buildPipeline(join_build_builder);
     join_build_builder.build();
+
     // Join probe pipeline.
+    // The non-joined data of right/full join is also output by the probe pipeline after all probes finish.
     probe()->buildPipeline(builder);
-    // FIXME: Should be newly created PhysicalJoinProbe.
-    builder.addPlanNode(shared_from_this());
-    throw Exception("Unsupport");
+    auto join_probe = std::make_shared<PhysicalJoinProbe>(
+        executor_id,
+        schema,
+        log->identifier(),
+        probe(),
+        join_ptr,
+        probe_side_prepare_actions,
+        sample_block);
+    builder.addPlanNode(join_probe);
 }
 
 void PhysicalJoin::finalize(const Names & parent_require)
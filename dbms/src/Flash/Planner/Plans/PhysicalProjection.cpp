@@ -161,7 +161,7 @@ void PhysicalProjection::finalize(const Names & parent_require)
     if (project_actions->getActions().empty())
         PhysicalPlanHelper::addParentRequireProjectAction(project_actions, parent_require);
 
-    project_actions->finalize(parent_require);
+    project_actions->finalize(parent_require, enable_short_circuit);
     child->finalize(project_actions->getRequiredColumns());
     FinalizeHelper::prependProjectInputIfNeed(project_actions, child->getSampleBlock().columns());
 
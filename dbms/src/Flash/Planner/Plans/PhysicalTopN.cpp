@@ -87,7 +87,7 @@ void PhysicalTopN::finalize(const Names & parent_require)
     required_output.reserve(required_output.size() + order_descr.size());
     for (const auto & desc : order_descr)
         required_output.emplace_back(desc.column_name);
-    before_sort_actions->finalize(required_output);
+    before_sort_actions->finalize(required_output, enable_short_circuit);
 
     child->finalize(before_sort_actions->getRequiredColumns());
     FinalizeHelper::prependProjectInputIfNeed(before_sort_actions, child->getSampleBlock().columns());
@@ -68,11 +68,14 @@ void PhysicalWindow::buildBlockInputStreamImpl(DAGPipeline & pipeline, Context &
     executeExpression(pipeline, window_description.before_window, log, "before window");
     window_description.fillArgColumnNumbers();
 
+    const Settings & settings = context.getSettingsRef();
+    SpillConfig spill_config(context.getTemporaryPath(), fmt::format("{}_window", log->identifier()), settings.max_cached_data_bytes_in_spiller, settings.max_spilled_rows_per_file, settings.max_spilled_bytes_per_file, context.getFileProvider());
+
     if (fine_grained_shuffle.enable())
     {
         /// Window function can be multiple threaded when fine grained shuffle is enabled.
         pipeline.transform([&](auto & stream) {
-            stream = std::make_shared<WindowBlockInputStream>(stream, window_description, log->identifier());
+            stream = std::make_shared<WindowBlockInputStream>(stream, window_description, settings.max_bytes_before_external_window, spill_config, log->identifier());
             stream->setExtraInfo(String(enableFineGrainedShuffleExtraInfo));
         });
     }
@@ -81,7 +84,7 @@ void PhysicalWindow::buildBlockInputStreamImpl(DAGPipeline & pipeline, Context &
         /// If there are several streams, we merge them into one.
         executeUnion(pipeline, max_streams, log, false, "merge into one for window input");
         assert(pipeline.streams.size() == 1);
-        pipeline.firstStream() = std::make_shared<WindowBlockInputStream>(pipeline.firstStream(), window_description, log->identifier());
+        pipeline.firstStream() = std::make_shared<WindowBlockInputStream>(pipeline.firstStream(), window_description, settings.max_bytes_before_external_window, spill_config, log->identifier());
     }
 
     executeExpression(pipeline, window_description.after_window, log, "expr after window");
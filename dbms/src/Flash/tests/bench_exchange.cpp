@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Flash/Coprocessor/CHBlockChunkCodecV1.h>
+#include <Flash/Coprocessor/ChunkDecodeAndSquash.h>
 #include <Flash/tests/bench_exchange.h>
 #include <fmt/core.h>
 
@@ -450,6 +452,60 @@ BENCHMARK_REGISTER_F(ExchangeBench, basic_send_receive)
     ->Args({8, 1, 1024 * 1000, 8, 10000})
     ->Args({8, 1, 1024 * 1000, 8, 100000});
 
+// Encode and decode the packets of a hash exchange with or without the lightweight column encodings.
+// `bytes_per_row` is the size on the wire, `rows_per_second` is the end-to-end throughput.
+BENCHMARK_DEFINE_F(ExchangeBench, lightweight_encoding)
+(benchmark::State & state)
+try
+{
+    const bool lightweight_encoding = state.range(0);
+    const auto compression_method = static_cast<CompressionMethod>(state.range(1));
+    const size_t row_num = 8192;
+
+    // Sorted handles, low-cardinality strings, timestamps and random integers.
+    std::mt19937_64 mt(rd());
+    InferredDataVector<Int64> handles;
+    InferredDataVector<Nullable<String>> status;
+    InferredDataVector<UInt64> timestamps;
+    InferredDataVector<Nullable<Int64>> amounts;
+    for (size_t i = 0; i < row_num; ++i)
+    {
+        handles.push_back(1000000 + i);
+        status.push_back(i % 11 == 0 ? std::nullopt : std::optional<String>(fmt::format("status_{}", mt() % 8)));
+        timestamps.push_back(1680000000000ULL + i * 100 + mt() % 100);
+        amounts.push_back(static_cast<Int64>(mt() % 1000000));
+    }
+    Block block{
+        createColumn<Int64>(handles, "handle"),
+        createColumn<Nullable<String>>(status, "status"),
+        createColumn<UInt64>(timestamps, "ts"),
+        createColumn<Nullable<Int64>>(amounts, "amount")};
+    Block header = block.cloneEmpty();
+
+    CHBlockChunkCodecV1 codec(header, lightweight_encoding);
+    size_t wire_bytes = 0;
+    size_t rows = 0;
+    for (auto _ : state)
+    {
+        auto str = codec.encode(block, compression_method);
+        CHBlockChunkDecodeAndSquash decoder(header, row_num);
+        auto res = decoder.decodeAndSquashV1(str, lightweight_encoding);
+        benchmark::DoNotOptimize(res);
+        wire_bytes += str.size();
+        rows += row_num;
+    }
+    state.counters["bytes_per_row"] = static_cast<double>(wire_bytes) / std::max<size_t>(rows, 1);
+    state.counters["rows_per_second"] = benchmark::Counter(rows, benchmark::Counter::kIsRate);
+}
+CATCH
+BENCHMARK_REGISTER_F(ExchangeBench, lightweight_encoding)
+    ->Args({0, static_cast<Int64>(CompressionMethod::NONE)})
+    ->Args({1, static_cast<Int64>(CompressionMethod::NONE)})
+    ->Args({0, static_cast<Int64>(CompressionMethod::LZ4)})
+    ->Args({1, static_cast<Int64>(CompressionMethod::LZ4)})
+    ->Args({0, static_cast<Int64>(CompressionMethod::ZSTD)})
+    ->Args({1, static_cast<Int64>(CompressionMethod::ZSTD)});
+
 
 } // namespace tests
 } // namespace DB
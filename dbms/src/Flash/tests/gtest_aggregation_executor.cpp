@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Flash/Coprocessor/AggregationInterpreterHelper.h>
 #include <TestUtils/ExecutorTestUtils.h>
 #include <TestUtils/mockExecutor.h>
 
@@ -625,5 +626,37 @@ try
 }
 CATCH
 
+TEST_F(AggExecutorTestRunner, FineGrainedShuffleTwoLevelThreshold)
+try
+{
+    Block header{toVec<Int64>("s1", {}), toVec<Int64>("s2", {})};
+    AggregateDescriptions aggregate_descriptions;
+    SpillConfig spill_config(context.context.getTemporaryPath(), "test_aggregation", 0, 0, 0, context.context.getFileProvider());
+    auto build_params = [&](size_t before_agg_streams_size, size_t agg_streams_size) {
+        return AggregationInterpreterHelper::buildParams(
+            context.context,
+            header,
+            before_agg_streams_size,
+            agg_streams_size,
+            {"s2"},
+            {nullptr},
+            aggregate_descriptions,
+            true,
+            spill_config);
+    };
+    context.context.setSetting("group_by_two_level_threshold", Field(static_cast<UInt64>(100)));
+    context.context.setSetting("max_bytes_before_external_group_by", Field(static_cast<UInt64>(0)));
+    // The results of parallel aggregation are merged between streams.
+    ASSERT_EQ(build_params(8, 1).getGroupByTwoLevelThreshold(), 100);
+    // With fine grained shuffle, a big hash table still converts to two-level, so that it is emitted bucket by bucket.
+    ASSERT_EQ(build_params(8, 8).getGroupByTwoLevelThreshold(), 100);
+    // A single stream never needs two-level hash table unless spilling.
+    ASSERT_EQ(build_params(1, 1).getGroupByTwoLevelThreshold(), 0);
+    context.context.setSetting("max_bytes_before_external_group_by", Field(static_cast<UInt64>(1024)));
+    ASSERT_EQ(build_params(1, 1).getGroupByTwoLevelThreshold(), 100);
+    context.context.setSetting("max_bytes_before_external_group_by", Field(static_cast<UInt64>(0)));
+}
+CATCH
+
 } // namespace tests
 } // namespace DB
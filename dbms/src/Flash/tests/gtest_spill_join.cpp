@@ -0,0 +1,180 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/ProfileEvents.h>
+#include <TestUtils/ColumnGenerator.h>
+#include <TestUtils/ExecutorTestUtils.h>
+#include <TestUtils/mockExecutor.h>
+
+namespace ProfileEvents
+{
+extern const Event ExternalJoinSpill;
+}
+
+namespace DB
+{
+namespace tests
+{
+class SpillJoinTestRunner : public DB::tests::ExecutorTest
+{
+public:
+    void initializeContext() override
+    {
+        ExecutorTest::initializeContext();
+    }
+
+    /// The number of joins that have spilled the build data.
+    static UInt64 spilledJoinCount()
+    {
+        return ProfileEvents::get(ProfileEvents::ExternalJoinSpill);
+    }
+
+    static constexpr size_t join_type_num = 6;
+
+    static constexpr tipb::JoinType join_types[join_type_num] = {
+        tipb::JoinType::TypeInnerJoin,
+        tipb::JoinType::TypeLeftOuterJoin,
+        tipb::JoinType::TypeRightOuterJoin,
+        tipb::JoinType::TypeSemiJoin,
+        tipb::JoinType::TypeAntiSemiJoin,
+        tipb::JoinType::TypeLeftOuterSemiJoin,
+    };
+};
+
+TEST_F(SpillJoinTestRunner, SimpleCase)
+try
+{
+    DB::MockColumnInfoVec left_column_infos{{"a", TiDB::TP::TypeLongLong}, {"b", TiDB::TP::TypeLongLong}};
+    DB::MockColumnInfoVec right_column_infos{{"a", TiDB::TP::TypeLongLong}, {"c", TiDB::TP::TypeLongLong}};
+    DB::MockColumnInfoVec right_partition_column_infos{{"a", TiDB::TP::TypeLongLong}};
+    ColumnsWithTypeAndName left_column_data;
+    ColumnsWithTypeAndName right_column_data;
+    size_t table_rows = 51200;
+    size_t common_rows = 10240;
+    UInt64 max_block_size = 500;
+    size_t original_max_streams = 10;
+    size_t fine_grained_shuffle_stream_count = 5;
+    size_t right_data_size = 0;
+    for (const auto & column_info : mockColumnInfosToTiDBColumnInfos(left_column_infos))
+    {
+        ColumnGeneratorOpts opts{table_rows, getDataTypeByColumnInfoForComputingLayer(column_info)->getName(), RANDOM, column_info.name};
+        left_column_data.push_back(ColumnGenerator::instance().generate(opts));
+    }
+    for (const auto & column_info : mockColumnInfosToTiDBColumnInfos(right_column_infos))
+    {
+        ColumnGeneratorOpts opts{table_rows, getDataTypeByColumnInfoForComputingLayer(column_info)->getName(), RANDOM, column_info.name};
+        right_column_data.push_back(ColumnGenerator::instance().generate(opts));
+    }
+    /// make some rows joined
+    right_column_data[0].column->assumeMutable()->insertRangeFrom(*left_column_data[0].column, 0, common_rows);
+    right_column_data[1].column->assumeMutable()->insertRangeFrom(*right_column_data[1].column, 0, common_rows);
+    for (const auto & column_data : right_column_data)
+        right_data_size += column_data.column->byteSize();
+
+    context.addMockTable("spill_join_test", "left_table", left_column_infos, left_column_data, 4);
+    context.addMockTable("spill_join_test", "right_table", right_column_infos, right_column_data, 4);
+    context.addExchangeReceiver("right_exchange_receiver", right_column_infos, right_column_data, fine_grained_shuffle_stream_count, right_partition_column_infos);
+    context.context.setSetting("max_block_size", Field(static_cast<UInt64>(max_block_size)));
+
+    WRAP_FOR_TEST_BEGIN
+    for (auto join_type : join_types)
+    {
+        auto request = context
+                           .scan("spill_join_test", "left_table")
+                           .join(context.scan("spill_join_test", "right_table"), join_type, {col("a")})
+                           .build(context);
+        auto fine_grained_shuffle_request = context
+                                                .scan("spill_join_test", "left_table")
+                                                .join(context.receive("right_exchange_receiver", fine_grained_shuffle_stream_count), join_type, {col("a")}, {}, {}, {}, {}, fine_grained_shuffle_stream_count)
+                                                .build(context);
+        /// disable spill
+        context.context.setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(0)));
+        auto ref_columns = executeStreams(request, original_max_streams);
+        /// enable spill
+        context.context.setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(right_data_size / 20)));
+        auto spilled_join_count = spilledJoinCount();
+        ASSERT_COLUMNS_EQ_UR(ref_columns, executeStreams(request, 1));
+        ASSERT_GT(spilledJoinCount(), spilled_join_count);
+        spilled_join_count = spilledJoinCount();
+        ASSERT_COLUMNS_EQ_UR(ref_columns, executeStreams(request, original_max_streams));
+        ASSERT_GT(spilledJoinCount(), spilled_join_count);
+        /// build side is a fine grained shuffle exchange receiver
+        spilled_join_count = spilledJoinCount();
+        ASSERT_COLUMNS_EQ_UR(ref_columns, executeStreams(fine_grained_shuffle_request, original_max_streams));
+        ASSERT_GT(spilledJoinCount(), spilled_join_count);
+        /// a threshold that can not be reached
+        context.context.setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(right_data_size * 10)));
+        spilled_join_count = spilledJoinCount();
+        ASSERT_COLUMNS_EQ_UR(ref_columns, executeStreams(request, original_max_streams));
+        ASSERT_EQ(spilledJoinCount(), spilled_join_count);
+    }
+    WRAP_FOR_TEST_END
+}
+CATCH
+
+TEST_F(SpillJoinTestRunner, OtherConditionAndRightCondition)
+try
+{
+    DB::MockColumnInfoVec left_column_infos{{"a", TiDB::TP::TypeLong}, {"b", TiDB::TP::TypeLong}};
+    DB::MockColumnInfoVec right_column_infos{{"a", TiDB::TP::TypeLong}, {"c", TiDB::TP::TypeLong}};
+    ColumnsWithTypeAndName left_column_data;
+    ColumnsWithTypeAndName right_column_data;
+    size_t table_rows = 20480;
+    size_t common_rows = 4096;
+    size_t original_max_streams = 10;
+    size_t right_data_size = 0;
+    for (const auto & column_info : mockColumnInfosToTiDBColumnInfos(left_column_infos))
+    {
+        ColumnGeneratorOpts opts{table_rows, getDataTypeByColumnInfoForComputingLayer(column_info)->getName(), RANDOM, column_info.name};
+        left_column_data.push_back(ColumnGenerator::instance().generate(opts));
+    }
+    for (const auto & column_info : mockColumnInfosToTiDBColumnInfos(right_column_infos))
+    {
+        ColumnGeneratorOpts opts{table_rows, getDataTypeByColumnInfoForComputingLayer(column_info)->getName(), RANDOM, column_info.name};
+        right_column_data.push_back(ColumnGenerator::instance().generate(opts));
+    }
+    right_column_data[0].column->assumeMutable()->insertRangeFrom(*left_column_data[0].column, 0, common_rows);
+    right_column_data[1].column->assumeMutable()->insertRangeFrom(*right_column_data[1].column, 0, common_rows);
+    for (const auto & column_data : right_column_data)
+        right_data_size += column_data.column->byteSize();
+
+    context.addMockTable("spill_join_test", "left_table_2", left_column_infos, left_column_data, 4);
+    context.addMockTable("spill_join_test", "right_table_2", right_column_infos, right_column_data, 4);
+
+    WRAP_FOR_TEST_BEGIN
+    /// right join with right condition
+    auto right_condition_request = context
+                                       .scan("spill_join_test", "left_table_2")
+                                       .join(context.scan("spill_join_test", "right_table_2"), tipb::JoinType::TypeRightOuterJoin, {col("a")}, {}, {gt(col("right_table_2.c"), lit(Field(static_cast<Int64>(0))))}, {}, {}, 0)
+                                       .build(context);
+    /// left join with other condition
+    auto other_condition_request = context
+                                       .scan("spill_join_test", "left_table_2")
+                                       .join(context.scan("spill_join_test", "right_table_2"), tipb::JoinType::TypeLeftOuterJoin, {col("a")}, {}, {}, {gt(col("left_table_2.b"), col("right_table_2.c"))}, {}, 0)
+                                       .build(context);
+    for (const auto & request : {right_condition_request, other_condition_request})
+    {
+        context.context.setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(0)));
+        auto ref_columns = executeStreams(request, original_max_streams);
+        context.context.setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(right_data_size / 20)));
+        auto spilled_join_count = spilledJoinCount();
+        ASSERT_COLUMNS_EQ_UR(ref_columns, executeStreams(request, original_max_streams));
+        ASSERT_GT(spilledJoinCount(), spilled_join_count);
+    }
+    WRAP_FOR_TEST_END
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
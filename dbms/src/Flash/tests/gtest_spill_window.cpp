@@ -0,0 +1,96 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <TestUtils/ExecutorTestUtils.h>
+#include <TestUtils/mockExecutor.h>
+
+namespace DB
+{
+namespace tests
+{
+class SpillWindowTestRunner : public DB::tests::ExecutorTest
+{
+public:
+    void initializeContext() override
+    {
+        ExecutorTest::initializeContext();
+    }
+};
+
+TEST_F(SpillWindowTestRunner, LargePartition)
+try
+{
+    size_t table_rows = 40960;
+    size_t large_partition_rows = 36864;
+    UInt64 max_block_size = 500;
+    std::vector<Int64> partitions;
+    std::vector<Int64> orders;
+    std::vector<Int64> values;
+    for (size_t i = 0; i < table_rows; ++i)
+    {
+        /// partition 0 is the large partition, and the others are small partitions.
+        partitions.push_back(i < large_partition_rows ? 0 : 1 + i % 16);
+        /// make the order column unique so that the result is deterministic.
+        orders.push_back((i * 7919) % table_rows);
+        values.push_back(i % 100);
+    }
+    context.addMockTable(
+        {"spill_window_test", "test_table"},
+        {{"partition", TiDB::TP::TypeLongLong}, {"order", TiDB::TP::TypeLongLong}, {"value", TiDB::TP::TypeLongLong}},
+        {toVec<Int64>("partition", partitions), toVec<Int64>("order", orders), toVec<Int64>("value", values)});
+    size_t total_data_size = table_rows * sizeof(Int64) * 3;
+    context.context.setSetting("max_block_size", Field(static_cast<UInt64>(max_block_size)));
+
+    std::vector<std::shared_ptr<tipb::DAGRequest>> requests;
+    /// rows frame ends at current row
+    requests.push_back(context
+                           .scan("spill_window_test", "test_table")
+                           .sort({{"partition", false}, {"order", false}}, true)
+                           .window(RowNumber(), {"order", false}, {"partition", false}, buildDefaultRowsFrame())
+                           .build(context));
+    /// the default frame ends at the end of partition
+    requests.push_back(context
+                           .scan("spill_window_test", "test_table")
+                           .sort({{"partition", false}, {"order", false}}, true)
+                           .window({Rank(), DenseRank()}, {{"order", false}}, {{"partition", false}}, MockWindowFrame())
+                           .build(context));
+    /// lead/lag access the rows around the current row
+    requests.push_back(context
+                           .scan("spill_window_test", "test_table")
+                           .sort({{"partition", false}, {"order", false}}, true)
+                           .window(Lead2(col("value"), lit(Field(static_cast<UInt64>(1200)))), {"order", false}, {"partition", false}, MockWindowFrame())
+                           .build(context));
+    requests.push_back(context
+                           .scan("spill_window_test", "test_table")
+                           .sort({{"partition", false}, {"order", false}}, true)
+                           .window(Lag2(col("value"), lit(Field(static_cast<UInt64>(1200)))), {"order", false}, {"partition", false}, MockWindowFrame())
+                           .build(context));
+
+    for (const auto & request : requests)
+    {
+        /// disable spill
+        context.context.setSetting("max_bytes_before_external_window", Field(static_cast<UInt64>(0)));
+        auto ref_columns = executeStreams(request, 1);
+        /// enable spill
+        context.context.setSetting("max_bytes_before_external_window", Field(static_cast<UInt64>(total_data_size / 20)));
+        ASSERT_COLUMNS_EQ_UR(ref_columns, executeStreams(request, 1));
+        /// spill every block
+        context.context.setSetting("max_bytes_before_external_window", Field(static_cast<UInt64>(1)));
+        ASSERT_COLUMNS_EQ_UR(ref_columns, executeStreams(request, 1));
+    }
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
@@ -25,6 +25,8 @@
 #include <Storages/Transaction/JsonBinary.h>
 #include <Storages/Transaction/JsonPathExprRef.h>
 
+#include <mutex>
+
 namespace DB
 {
 /** Json related functions:
@@ -148,14 +150,13 @@ public:
                 "None const type of json path argument of function " + getName(),
                 ErrorCodes::ILLEGAL_TYPE_OF_ARGUMENT);
 
-        /// Parses all paths
-        std::vector<JsonPathExprRefContainerPtr> path_expr_container_vec;
-        path_expr_container_vec.reserve(arguments_size - 1);
+        /// Gets all paths
+        std::vector<StringRef> path_strs;
+        path_strs.reserve(arguments_size - 1);
         for (size_t i = 1; i < arguments_size; ++i)
         {
             const ColumnPtr column = block.getByPosition(arguments[i]).column;
             const auto * nested_column = static_cast<const ColumnConst *>(column.get())->getDataColumnPtr().get();
-            StringRef path_str;
             if (const auto * nullable_string_path_col = checkAndGetColumn<ColumnNullable>(nested_column))
             {
                 if unlikely (nullable_string_path_col->isNullAt(0))
@@ -168,35 +169,107 @@ public:
 
             if (const auto * col = checkAndGetColumn<ColumnString>(nested_column))
             {
-                path_str = col->getDataAt(0);
+                path_strs.push_back(col->getDataAt(0));
             }
             else if (const auto * fixed_string_col = checkAndGetColumn<ColumnFixedString>(nested_column))
             {
-                path_str = fixed_string_col->getDataAt(0);
+                path_strs.push_back(fixed_string_col->getDataAt(0));
             }
             else
                 throw Exception(fmt::format("Illegal column {} of argument of function {}", column->getName(), getName()), ErrorCodes::ILLEGAL_COLUMN);
-
-            auto path_expr = JsonPathExpr::parseJsonPathExpr(path_str);
-            /// If any path_expr failed to parse, return null
-            if (!path_expr)
-                throw Exception(fmt::format("Illegal json path expression {} of argument of function {}", column->getName(), getName()), ErrorCodes::ILLEGAL_COLUMN);
-            path_expr_container_vec.push_back(std::make_unique<JsonPathExprRefContainer>(path_expr));
         }
 
-        const ColumnPtr column = block.getByPosition(arguments[0]).column;
-        if (const_json)
+        std::vector<JsonPathExprPtr> path_exprs = getCompiledPaths(block, arguments, path_strs);
+
+        MutableColumnPtr nullable_col;
+        if (path_exprs.size() == 1 && !path_exprs[0]->couldMatchMultipleValues())
         {
-            auto nullable_col = calculateResultCol(source_data_column_ptr, source_nullable_column_ptr, path_expr_container_vec);
-            block.getByPosition(result).column = ColumnConst::create(std::move(nullable_col), rows);
+            nullable_col = calculateResultColForSinglePath(source_data_column_ptr, source_nullable_column_ptr, *path_exprs[0]);
         }
         else
         {
-            block.getByPosition(result).column = calculateResultCol(source_data_column_ptr, source_nullable_column_ptr, path_expr_container_vec);
+            std::vector<JsonPathExprRefContainerPtr> path_expr_container_vec;
+            path_expr_container_vec.reserve(path_exprs.size());
+            for (const auto & path_expr : path_exprs)
+                path_expr_container_vec.push_back(std::make_unique<JsonPathExprRefContainer>(path_expr));
+            nullable_col = calculateResultCol(source_data_column_ptr, source_nullable_column_ptr, path_expr_container_vec);
         }
+
+        if (const_json)
+            block.getByPosition(result).column = ColumnConst::create(std::move(nullable_col), rows);
+        else
+            block.getByPosition(result).column = std::move(nullable_col);
     }
 
 private:
+    /// The path arguments are constants, so they are parsed once and cached in the function, which is reused for every block.
+    /// The cached paths may be used by several threads at the same time, so the key index caching of the legs, which
+    /// mutates the path in `JsonBinary::extract`, is disabled. A single path that matches at most one value is extracted
+    /// by `JsonBinary::extractSinglePath` with its own key hints instead.
+    std::vector<JsonPathExprPtr> getCompiledPaths(const Block & block, const ColumnNumbers & arguments, const std::vector<StringRef> & path_strs) const
+    {
+        std::lock_guard lock(compiled_paths_mutex);
+        bool hit = compiled_path_strs.size() == path_strs.size();
+        for (size_t i = 0; hit && i < path_strs.size(); ++i)
+            hit = StringRef(compiled_path_strs[i]) == path_strs[i];
+        if (hit)
+            return compiled_paths;
+
+        std::vector<JsonPathExprPtr> path_exprs;
+        path_exprs.reserve(path_strs.size());
+        for (size_t i = 0; i < path_strs.size(); ++i)
+        {
+            auto path_expr = JsonPathExpr::parseJsonPathExpr(path_strs[i]);
+            /// If any path_expr failed to parse, throw
+            if (!path_expr)
+                throw Exception(fmt::format("Illegal json path expression {} of argument of function {}", block.getByPosition(arguments[i + 1]).column->getName(), getName()), ErrorCodes::ILLEGAL_COLUMN);
+            path_expr->disableKeyCache();
+            path_exprs.push_back(std::move(path_expr));
+        }
+
+        compiled_path_strs.clear();
+        for (const auto & path_str : path_strs)
+            compiled_path_strs.push_back(path_str.toString());
+        compiled_paths = path_exprs;
+        return path_exprs;
+    }
+
+    static MutableColumnPtr calculateResultColForSinglePath(const ColumnString * source_col, const ColumnNullable * source_nullable_col, const JsonPathExpr & path_expr)
+    {
+        size_t rows = source_col->size();
+        const ColumnString::Chars_t & data_from = source_col->getChars();
+        const IColumn::Offsets & offsets_from = source_col->getOffsets();
+        const auto * source_null_map = source_nullable_col ? &source_nullable_col->getNullMapColumn().getData() : nullptr;
+
+        auto col_to = ColumnString::create();
+        ColumnString::Chars_t & data_to = col_to->getChars();
+        ColumnString::Offsets & offsets_to = col_to->getOffsets();
+        offsets_to.resize(rows);
+        ColumnUInt8::MutablePtr col_null_map = ColumnUInt8::create(rows, 0);
+        ColumnUInt8::Container & vec_null_map = col_null_map->getData();
+        WriteBufferFromVector<ColumnString::Chars_t> write_buffer(data_to);
+        std::vector<UInt32> key_hints;
+        size_t current_offset = 0;
+        for (size_t i = 0; i < rows; ++i)
+        {
+            size_t next_offset = offsets_from[i];
+            size_t data_length = next_offset - current_offset - 1;
+            bool found = false;
+            if (!(source_null_map && (*source_null_map)[i]) && !isNullJsonBinary(data_length))
+            {
+                JsonBinary json_binary(data_from[current_offset], StringRef(&data_from[current_offset + 1], data_length - 1));
+                found = json_binary.extractSinglePath(path_expr, key_hints, write_buffer);
+            }
+            if (!found)
+                vec_null_map[i] = 1;
+            writeChar(0, write_buffer);
+            offsets_to[i] = write_buffer.count();
+            current_offset = next_offset;
+        }
+        data_to.resize(write_buffer.count());
+        return ColumnNullable::create(std::move(col_to), std::move(col_null_map));
+    }
+
     static MutableColumnPtr calculateResultCol(const ColumnString * source_col, const ColumnNullable * source_nullable_col, std::vector<JsonPathExprRefContainerPtr> & path_expr_container_vec)
     {
         size_t rows = source_col->size();
@@ -255,6 +328,10 @@ private:
             ret &= (data[i] != 0);
         return ret;
     }
+
+    mutable std::mutex compiled_paths_mutex;
+    mutable std::vector<String> compiled_path_strs;
+    mutable std::vector<JsonPathExprPtr> compiled_paths;
 };
 
 
@@ -0,0 +1,243 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Functions/FunctionFactory.h>
+#include <Functions/FunctionsJson.h>
+#include <Functions/registerFunctions.h>
+#include <IO/Endian.h>
+#include <Storages/Transaction/JsonPathExprRef.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+
+namespace DB
+{
+namespace tests
+{
+/// Benchmarks of json_extract over event-like documents: `{"a": {"b": ..., "x00": ..., ...}, "k00": ..., ..., "k19": ...}`.
+class JsonExtractBench : public benchmark::Fixture
+{
+public:
+    static constexpr size_t rows = 8192;
+    static constexpr size_t blocks = 16;
+
+    /// A value in TiDB's binary JSON format: the type code and the encoded value.
+    using JsonValue = std::pair<JsonBinary::JsonType, String>;
+
+    ColumnWithTypeAndName json_column;
+
+    void SetUp(const benchmark::State &) override
+    {
+        try
+        {
+            DB::registerFunctions();
+        }
+        catch (DB::Exception &)
+        {
+            // Maybe another test has already registered, ignore exception here.
+        }
+
+        auto nested_col = ColumnString::create();
+        for (size_t i = 0; i < rows; ++i)
+        {
+            std::vector<std::pair<String, JsonValue>> inner{{"b", jsonInt(i)}};
+            for (size_t k = 0; k < 10; ++k)
+                inner.emplace_back(fmt::format("x{:02}", k), jsonString(fmt::format("value_{}_{}", i, k)));
+
+            std::vector<std::pair<String, JsonValue>> outer{{"a", jsonObject(inner)}};
+            for (size_t k = 0; k < 20; ++k)
+                outer.emplace_back(fmt::format("k{:02}", k), k % 2 ? jsonInt(i * k) : jsonString(fmt::format("event_{}", i + k)));
+
+            auto doc = jsonObject(outer);
+            String row(1, static_cast<char>(doc.first));
+            row += doc.second;
+            nested_col->insertData(row.data(), row.size());
+        }
+        json_column = ColumnWithTypeAndName(
+            ColumnNullable::create(std::move(nested_col), ColumnUInt8::create(rows, 0)),
+            makeNullable(std::make_shared<DataTypeString>()),
+            "payload");
+    }
+
+    static JsonValue jsonInt(Int64 value)
+    {
+        String res(sizeof(Int64), '\0');
+        toLittleEndianInPlace(value);
+        memcpy(res.data(), &value, sizeof(Int64));
+        return {JsonBinary::TYPE_CODE_INT64, res};
+    }
+
+    static JsonValue jsonString(const String & value)
+    {
+        RUNTIME_CHECK(value.size() < 128);
+        String res(1, static_cast<char>(value.size())); /// var-length uint of 1 byte
+        res += value;
+        return {JsonBinary::TYPE_CODE_STRING, res};
+    }
+
+    static JsonValue jsonObject(std::vector<std::pair<String, JsonValue>> fields)
+    {
+        std::sort(fields.begin(), fields.end(), [](const auto & l, const auto & r) { return l.first < r.first; });
+        constexpr size_t header_size = 8;
+        constexpr size_t key_entry_size = 6;
+        constexpr size_t value_entry_size = 5;
+        const size_t count = fields.size();
+
+        String entries;
+        String keys;
+        String values;
+        size_t key_offset = header_size + count * (key_entry_size + value_entry_size);
+        size_t value_offset = key_offset;
+        for (const auto & field : fields)
+            value_offset += field.first.size();
+
+        auto append = [](String & to, auto value) {
+            toLittleEndianInPlace(value);
+            to.append(reinterpret_cast<const char *>(&value), sizeof(value));
+        };
+        for (const auto & field : fields)
+        {
+            append(entries, static_cast<UInt32>(key_offset + keys.size()));
+            append(entries, static_cast<UInt16>(field.first.size()));
+            keys += field.first;
+        }
+        for (const auto & field : fields)
+        {
+            entries.push_back(static_cast<char>(field.second.first));
+            append(entries, static_cast<UInt32>(value_offset + values.size()));
+            values += field.second.second;
+        }
+
+        String res;
+        append(res, static_cast<UInt32>(count));
+        append(res, static_cast<UInt32>(header_size + entries.size() + keys.size() + values.size()));
+        res += entries;
+        res += keys;
+        res += values;
+        return {JsonBinary::TYPE_CODE_OBJECT, res};
+    }
+
+    void runFunction(benchmark::State & state, const std::vector<String> & paths)
+    {
+        auto context = TiFlashTestEnv::getContext();
+        ColumnsWithTypeAndName arguments{json_column};
+        for (const auto & path : paths)
+            arguments.push_back(createConstColumn<String>(rows, path));
+        auto function = FunctionFactory::instance().get("json_extract", context)->build(arguments);
+
+        ColumnNumbers argument_numbers(arguments.size());
+        for (size_t i = 0; i < arguments.size(); ++i)
+            argument_numbers[i] = i;
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < blocks; ++i)
+            {
+                Block block(arguments);
+                block.insert({nullptr, function->getReturnType(), "res"});
+                function->execute(block, argument_numbers, arguments.size());
+                benchmark::DoNotOptimize(block);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * rows * blocks);
+    }
+};
+
+BENCHMARK_DEFINE_F(JsonExtractBench, nestedKey)
+(benchmark::State & state)
+try
+{
+    runFunction(state, {"$.a.b"});
+}
+CATCH
+BENCHMARK_REGISTER_F(JsonExtractBench, nestedKey);
+
+BENCHMARK_DEFINE_F(JsonExtractBench, topLevelKey)
+(benchmark::State & state)
+try
+{
+    runFunction(state, {"$.k13"});
+}
+CATCH
+BENCHMARK_REGISTER_F(JsonExtractBench, topLevelKey);
+
+BENCHMARK_DEFINE_F(JsonExtractBench, missingKey)
+(benchmark::State & state)
+try
+{
+    runFunction(state, {"$.a.y"});
+}
+CATCH
+BENCHMARK_REGISTER_F(JsonExtractBench, missingKey);
+
+BENCHMARK_DEFINE_F(JsonExtractBench, object)
+(benchmark::State & state)
+try
+{
+    runFunction(state, {"$.a"});
+}
+CATCH
+BENCHMARK_REGISTER_F(JsonExtractBench, object);
+
+BENCHMARK_DEFINE_F(JsonExtractBench, multiplePaths)
+(benchmark::State & state)
+try
+{
+    runFunction(state, {"$.a.b", "$.k13"});
+}
+CATCH
+BENCHMARK_REGISTER_F(JsonExtractBench, multiplePaths);
+
+BENCHMARK_DEFINE_F(JsonExtractBench, asterisk)
+(benchmark::State & state)
+try
+{
+    runFunction(state, {"$.*.b"});
+}
+CATCH
+BENCHMARK_REGISTER_F(JsonExtractBench, asterisk);
+
+/// Compare `JsonBinary::extract` and `JsonBinary::extractSinglePath` for the same path, row by row.
+BENCHMARK_DEFINE_F(JsonExtractBench, rowwise)
+(benchmark::State & state)
+try
+{
+    const bool single_path = state.range(0);
+    auto path_expr = JsonPathExpr::parseJsonPathExpr("$.a.b");
+    std::vector<JsonPathExprRefContainerPtr> path_expr_container_vec;
+    path_expr_container_vec.push_back(std::make_unique<JsonPathExprRefContainer>(path_expr));
+    std::vector<UInt32> key_hints;
+
+    const auto & source = static_cast<const ColumnString &>(static_cast<const ColumnNullable &>(*json_column.column).getNestedColumn());
+    ColumnString::Chars_t data_to;
+    for (auto _ : state)
+    {
+        WriteBufferFromVector<ColumnString::Chars_t> write_buffer(data_to);
+        for (size_t i = 0; i < rows; ++i)
+        {
+            auto row = source.getDataAt(i);
+            JsonBinary json_binary(row.data[0], StringRef(row.data + 1, row.size - 1));
+            bool found = single_path
+                ? json_binary.extractSinglePath(*path_expr, key_hints, write_buffer)
+                : json_binary.extract(path_expr_container_vec, write_buffer);
+            benchmark::DoNotOptimize(found);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+CATCH
+BENCHMARK_REGISTER_F(JsonExtractBench, rowwise)->Arg(0)->Arg(1);
+
+} // namespace tests
+} // namespace DB
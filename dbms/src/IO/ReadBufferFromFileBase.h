@@ -39,6 +39,10 @@ public:
     virtual std::string getFileName() const = 0;
     virtual int getFD() const = 0;
 
+    /// Start reading the data at `offset` in background, a following seek to `offset` can use the data without waiting.
+    /// Return false if it is not supported, then nothing is changed.
+    virtual bool prefetch(off_t /*offset*/) { return false; }
+
     /// It is possible to get information about the time of each reading.
     struct ProfileInfo
     {
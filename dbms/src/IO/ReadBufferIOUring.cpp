@@ -0,0 +1,182 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Common/ProfileEvents.h>
+#include <Common/Stopwatch.h>
+#include <IO/ReadBufferIOUring.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace ProfileEvents
+{
+extern const Event FileOpen;
+extern const Event FileOpenFailed;
+extern const Event ReadBufferIOUringRead;
+extern const Event ReadBufferIOUringReadBytes;
+} // namespace ProfileEvents
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int FILE_DOESNT_EXIST;
+extern const int CANNOT_OPEN_FILE;
+extern const int CANNOT_READ_FROM_FILE_DESCRIPTOR;
+extern const int ARGUMENT_OUT_OF_BOUND;
+} // namespace ErrorCodes
+
+ReadBufferIOUring::ReadBufferIOUring(
+    const IOUringPtr & ring_,
+    const std::string & filename_,
+    size_t buffer_size_,
+    int flags_,
+    char * existing_memory_,
+    size_t alignment)
+    : ReadBufferFromFileBase(buffer_size_, existing_memory_, alignment)
+    , ring(ring_)
+    , fill_buffer(BufferWithOwnMemory<ReadBuffer>(internalBuffer().size(), nullptr, alignment))
+    , filename(filename_)
+{
+    ProfileEvents::increment(ProfileEvents::FileOpen);
+
+    fd = ::open(filename.c_str(), flags_ == -1 ? O_RDONLY : flags_);
+    if (fd == -1)
+    {
+        ProfileEvents::increment(ProfileEvents::FileOpenFailed);
+        auto error_code = (errno == ENOENT) ? ErrorCodes::FILE_DOESNT_EXIST : ErrorCodes::CANNOT_OPEN_FILE;
+        throwFromErrno("Cannot open file " + filename, error_code);
+    }
+}
+
+ReadBufferIOUring::~ReadBufferIOUring()
+{
+    // The kernel may still write into `fill_buffer`, so the pending read must be waited.
+    if (pending_read)
+    {
+        try
+        {
+            ring->wait(*pending_read);
+        }
+        catch (...)
+        {
+            tryLogCurrentException(__PRETTY_FUNCTION__);
+        }
+    }
+
+    if (fd != -1)
+        ::close(fd);
+}
+
+void ReadBufferIOUring::prepareRead()
+{
+    if (pending_read)
+        return;
+    pending_read_size = fill_buffer.internalBuffer().size();
+    pending_read = ring->prepareRead(fd, fill_buffer.internalBuffer().begin(), pending_read_size, first_unread_pos_in_file);
+}
+
+size_t ReadBufferIOUring::waitForRead()
+{
+    ssize_t res = ring->wait(*pending_read);
+    pending_read.reset();
+    if (res < 0)
+        throwFromErrno("Cannot read from file " + filename, ErrorCodes::CANNOT_READ_FROM_FILE_DESCRIPTOR, -res);
+
+    ProfileEvents::increment(ProfileEvents::ReadBufferIOUringRead);
+    ProfileEvents::increment(ProfileEvents::ReadBufferIOUringReadBytes, res);
+    return res;
+}
+
+bool ReadBufferIOUring::prefetch(off_t offset)
+{
+    seek(offset, SEEK_SET);
+    prepareRead();
+    return true;
+}
+
+bool ReadBufferIOUring::nextImpl()
+{
+    std::optional<Stopwatch> watch;
+    if (profile_callback)
+        watch.emplace(clock_type);
+
+    prepareRead();
+    size_t bytes_read = waitForRead();
+
+    if (profile_callback)
+    {
+        ProfileInfo info;
+        info.bytes_requested = pending_read_size;
+        info.bytes_read = bytes_read;
+        info.nanoseconds = watch->elapsed();
+        profile_callback(info);
+    }
+
+    if (bytes_read == 0)
+        return false;
+
+    /// Swap the main and fill buffers.
+    internalBuffer().swap(fill_buffer.internalBuffer());
+    working_buffer = Buffer(internalBuffer().begin(), internalBuffer().begin() + bytes_read);
+    first_unread_pos_in_file += bytes_read;
+
+    // Read the next buffer in background, a short read means the end of the file.
+    if (bytes_read == pending_read_size)
+    {
+        prepareRead();
+        ring->submit();
+    }
+    return true;
+}
+
+off_t ReadBufferIOUring::doSeek(off_t off, int whence)
+{
+    off_t new_pos_in_file;
+    if (whence == SEEK_SET)
+    {
+        if (off < 0)
+            throw Exception("SEEK_SET underflow", ErrorCodes::ARGUMENT_OUT_OF_BOUND);
+        new_pos_in_file = off;
+    }
+    else if (whence == SEEK_CUR)
+    {
+        new_pos_in_file = getPositionInFile() + off;
+        if (new_pos_in_file < 0)
+            throw Exception("SEEK_CUR underflow", ErrorCodes::ARGUMENT_OUT_OF_BOUND);
+    }
+    else
+        throw Exception("ReadBufferIOUring::seek expects SEEK_SET or SEEK_CUR as whence", ErrorCodes::ARGUMENT_OUT_OF_BOUND);
+
+    if (new_pos_in_file == getPositionInFile())
+        return new_pos_in_file;
+
+    off_t first_read_pos_in_file = first_unread_pos_in_file - static_cast<off_t>(working_buffer.size());
+    if (new_pos_in_file >= first_read_pos_in_file && new_pos_in_file <= first_unread_pos_in_file)
+    {
+        /// Moved, but remained within the buffer.
+        pos = working_buffer.begin() + (new_pos_in_file - first_read_pos_in_file);
+        return new_pos_in_file;
+    }
+
+    /// Moved past the buffer, the pending read of the next buffer is useless.
+    if (pending_read)
+        waitForRead();
+    working_buffer.resize(0);
+    pos = working_buffer.end();
+    first_unread_pos_in_file = new_pos_in_file;
+    return new_pos_in_file;
+}
+
+} // namespace DB
@@ -0,0 +1,90 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <Common/CurrentMetrics.h>
+#include <Common/IOUring.h>
+#include <Common/nocopyable.h>
+#include <Core/Defines.h>
+#include <IO/BufferWithOwnMemory.h>
+#include <IO/ReadBuffer.h>
+#include <IO/ReadBufferFromFileBase.h>
+
+#include <optional>
+#include <string>
+
+namespace CurrentMetrics
+{
+extern const Metric OpenFileForRead;
+}
+
+namespace DB
+{
+/** Read a file by io_uring.
+  * Like ReadBufferAIO, it has two buffers: the data of one of them is being consumed while the next
+  * buffer is being read in background. The read of the first buffer can be queued by `prefetch` without
+  * being submitted, so the first reads of many files are submitted to the kernel by one system call.
+  */
+class ReadBufferIOUring : public ReadBufferFromFileBase
+{
+public:
+    ReadBufferIOUring(
+        const IOUringPtr & ring_,
+        const std::string & filename_,
+        size_t buffer_size_ = DBMS_DEFAULT_BUFFER_SIZE,
+        int flags_ = -1,
+        char * existing_memory_ = nullptr,
+        size_t alignment = 0);
+    ~ReadBufferIOUring() override;
+
+    DISALLOW_COPY(ReadBufferIOUring);
+
+    off_t getPositionInFile() override { return first_unread_pos_in_file - (working_buffer.end() - pos); }
+    std::string getFileName() const override { return filename; }
+    int getFD() const override { return fd; }
+
+    bool prefetch(off_t offset) override;
+
+private:
+    bool nextImpl() override;
+    off_t doSeek(off_t off, int whence) override;
+
+    /// Queue the read of `fill_buffer` at `first_unread_pos_in_file` if there is no pending read.
+    void prepareRead();
+    /// Wait for the pending read and return the number of bytes read into `fill_buffer`.
+    size_t waitForRead();
+
+private:
+    IOUringPtr ring;
+
+    /// The buffer that the next data is read into.
+    BufferWithOwnMemory<ReadBuffer> fill_buffer;
+
+    const std::string filename;
+
+    int fd = -1;
+
+    /// The position in the file of the first byte that has not been read into `working_buffer`.
+    off_t first_unread_pos_in_file = 0;
+
+    /// The read into `fill_buffer` at `first_unread_pos_in_file` that has not been waited.
+    std::optional<IOUring::RequestId> pending_read;
+    size_t pending_read_size = 0;
+
+    CurrentMetrics::Increment metric_increment{CurrentMetrics::OpenFileForRead};
+};
+
+} // namespace DB
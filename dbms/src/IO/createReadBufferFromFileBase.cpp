@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <IO/ReadBufferFromFile.h>
+#include <IO/ReadBufferIOUring.h>
 #include <IO/createReadBufferFromFileBase.h>
 
 #if !defined(__APPLE__) && !defined(__FreeBSD__) && !defined(_MSC_VER)
@@ -39,6 +40,11 @@ createReadBufferFromFileBase(
 {
     if ((aio_threshold == 0) || (estimated_size < aio_threshold))
     {
+        if (IOUring::isEnabled())
+        {
+            if (auto ring = IOUring::threadLocal(); ring)
+                return std::make_unique<ReadBufferIOUring>(ring, filename_, buffer_size_, flags_, existing_memory_, alignment);
+        }
         return std::make_unique<ReadBufferFromFile>(filename_, buffer_size_, flags_, existing_memory_, alignment);
     }
     else
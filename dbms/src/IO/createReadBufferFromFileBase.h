@@ -28,6 +28,7 @@ namespace DB
   *
   * If aio_threshold = 0 or estimated_size < aio_threshold, read operations are executed synchronously.
   * Otherwise, the read operations are performed asynchronously.
+  * The synchronous reads are replaced by io_uring if it is enabled and supported by the kernel.
   */
 std::unique_ptr<ReadBufferFromFileBase>
 createReadBufferFromFileBase(
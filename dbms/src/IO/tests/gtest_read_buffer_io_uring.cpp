@@ -0,0 +1,119 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#include <gtest/gtest.h>
+#pragma GCC diagnostic pop
+#include <Common/IOUring.h>
+#include <IO/ReadBufferIOUring.h>
+#include <IO/WriteBufferFromFile.h>
+#include <Poco/File.h>
+#include <fmt/format.h>
+
+#include <random>
+
+namespace DB
+{
+namespace tests
+{
+namespace
+{
+constexpr char IO_URING_TEST_PATH[] = "/tmp/tiflash_io_uring_gtest";
+
+class ReadBufferIOUringTest : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        if (!IOUring::isSupported())
+            GTEST_SKIP() << "io_uring is not supported by the kernel";
+        Poco::File(IO_URING_TEST_PATH).createDirectories();
+    }
+
+    void TearDown() override
+    {
+        Poco::File dir(IO_URING_TEST_PATH);
+        if (dir.exists())
+            dir.remove(true);
+    }
+
+    static std::string writeFile(const std::string & name, size_t size, std::string & data)
+    {
+        std::mt19937 gen(size); // NOLINT(cert-msc51-cpp)
+        data.resize(size);
+        for (auto & c : data)
+            c = static_cast<char>(gen());
+        auto path = fmt::format("{}/{}", IO_URING_TEST_PATH, name);
+        WriteBufferFromFile out(path);
+        out.write(data.data(), data.size());
+        out.sync();
+        return path;
+    }
+};
+} // namespace
+
+TEST_F(ReadBufferIOUringTest, SequentialRead)
+{
+    for (size_t size : {0, 1, 4095, 4096, 100000})
+    {
+        std::string data;
+        auto path = writeFile(fmt::format("seq_{}", size), size, data);
+        ReadBufferIOUring in(std::make_shared<IOUring>(8), path, /*buffer_size*/ 4096);
+        std::string res(size, '\0');
+        ASSERT_EQ(in.readBig(res.data(), size), size);
+        ASSERT_EQ(res, data);
+        ASSERT_TRUE(in.eof());
+    }
+}
+
+TEST_F(ReadBufferIOUringTest, Seek)
+{
+    std::string data;
+    auto path = writeFile("seek", 100000, data);
+    ReadBufferIOUring in(std::make_shared<IOUring>(8), path, /*buffer_size*/ 4096);
+    for (off_t offset : {50000, 50010, 49990, 0, 99999, 70000})
+    {
+        ASSERT_EQ(in.seek(offset), offset);
+        ASSERT_EQ(in.getPositionInFile(), offset);
+        char c;
+        ASSERT_EQ(in.read(&c, 1), 1);
+        ASSERT_EQ(c, data[offset]) << offset;
+    }
+}
+
+TEST_F(ReadBufferIOUringTest, PrefetchManyFiles)
+{
+    // Queue the first reads of all files, then they are submitted together by the first wait.
+    auto ring = std::make_shared<IOUring>(4);
+    std::vector<std::string> data(10);
+    std::vector<std::unique_ptr<ReadBufferIOUring>> buffers;
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        auto path = writeFile(fmt::format("prefetch_{}", i), 20000, data[i]);
+        buffers.emplace_back(std::make_unique<ReadBufferIOUring>(ring, path, /*buffer_size*/ 4096));
+        ASSERT_TRUE(buffers.back()->prefetch(1000 * i));
+    }
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        buffers[i]->seek(1000 * i);
+        std::string res(20000 - 1000 * i, '\0');
+        ASSERT_EQ(buffers[i]->readBig(res.data(), res.size()), res.size());
+        ASSERT_EQ(res, data[i].substr(1000 * i));
+    }
+}
+
+} // namespace tests
+} // namespace DB
@@ -55,6 +55,7 @@
 #include <Storages/BackgroundProcessingPool.h>
 #include <Storages/DeltaMerge/ColumnFile/ColumnFileSchema.h>
 #include <Storages/DeltaMerge/DeltaIndexManager.h>
+#include <Storages/DeltaMerge/File/DMFilePackCache.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
 #include <Storages/DeltaMerge/StoragePool.h>
 #include <Storages/IStorage.h>
@@ -146,6 +147,7 @@ struct ContextShared
     mutable DBGInvoker dbg_invoker; /// Execute inner functions, debug only.
     mutable MarkCachePtr mark_cache; /// Cache of marks in compressed files.
     mutable DM::MinMaxIndexCachePtr minmax_index_cache; /// Cache of minmax index in compressed files.
+    mutable DM::DMFilePackCachePtr dmfile_pack_cache; /// Cache of decompressed packs in DMFiles.
     mutable DM::DeltaIndexManagerPtr delta_index_manager; /// Manage the Delta Indies of Segments.
     ProcessList process_list; /// Executing queries at the moment.
     ViewDependencies view_dependencies; /// Current dependencies
@@ -1364,6 +1366,29 @@ void Context::dropMinMaxIndexCache() const
         shared->minmax_index_cache->reset();
 }
 
+void Context::setDMFilePackCache(size_t cache_size_in_bytes)
+{
+    auto lock = getLock();
+
+    if (shared->dmfile_pack_cache)
+        throw Exception("DMFile pack cache has been already created.", ErrorCodes::LOGICAL_ERROR);
+
+    shared->dmfile_pack_cache = std::make_shared<DM::DMFilePackCache>(cache_size_in_bytes);
+}
+
+DM::DMFilePackCachePtr Context::getDMFilePackCache() const
+{
+    auto lock = getLock();
+    return shared->dmfile_pack_cache;
+}
+
+void Context::dropDMFilePackCache() const
+{
+    auto lock = getLock();
+    if (shared->dmfile_pack_cache)
+        shared->dmfile_pack_cache->reset();
+}
+
 bool Context::isDeltaIndexLimited() const
 {
     // Don't need to use a lock here, as delta_index_manager should be set at starting up.
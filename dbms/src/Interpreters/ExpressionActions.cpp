@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include <Columns/ColumnArray.h>
+#include <Columns/ColumnConst.h>
 #include <Columns/ColumnNullable.h>
+#include <Columns/ColumnsCommon.h>
 #include <Columns/ColumnsNumber.h>
 #include <Common/ProfileEvents.h>
 #include <Common/typeid_cast.h>
@@ -40,10 +42,93 @@ extern const int TOO_MANY_TEMPORARY_COLUMNS;
 extern const int TOO_MANY_TEMPORARY_NON_CONST_COLUMNS;
 } // namespace ErrorCodes
 
+namespace
+{
+/// If the rows that need a lazy argument are at least this fraction of the block, the argument is computed
+/// on the whole block, because filtering the inputs and scattering the result back costs more than it saves.
+constexpr double short_circuit_full_evaluation_ratio = 0.8;
+
+/// The result of these functions may be decided by their first arguments, so the following arguments
+/// only need to be computed for the remaining rows.
+/// Note that ifNull and the `If*` and `CaseWhen*` functions of TiDB are all rewritten to multiIf.
+bool isShortCircuitFunction(const String & name)
+{
+    return name == "and" || name == "or" || name == "if" || name == "multiIf";
+}
+
+constexpr UInt8 truth_false = 0;
+constexpr UInt8 truth_true = 1;
+constexpr UInt8 truth_null = 2;
+
+template <typename T>
+bool getTruthValuesImpl(const IColumn & column, PaddedPODArray<UInt8> & res)
+{
+    const auto * col = typeid_cast<const ColumnVector<T> *>(&column);
+    if (!col)
+        return false;
+    const auto & data = col->getData();
+    for (size_t i = 0; i < data.size(); ++i)
+        res[i] = data[i] != 0 ? truth_true : truth_false;
+    return true;
+}
+
+/// Fill `res` with truth_false/truth_true/truth_null for each row of a condition column.
+/// Returns false if the column is not a number, then the caller should assume every row is undecided.
+bool getTruthValues(const ColumnPtr & column, size_t rows, PaddedPODArray<UInt8> & res)
+{
+    res.resize(rows);
+    if (const auto * col_const = typeid_cast<const ColumnConst *>(column.get()))
+    {
+        PaddedPODArray<UInt8> value;
+        if (!getTruthValues(col_const->getDataColumnPtr(), 1, value))
+            return false;
+        std::fill(res.begin(), res.end(), value[0]);
+        return true;
+    }
+
+    const IColumn * nested = column.get();
+    const NullMap * null_map = nullptr;
+    if (const auto * col_nullable = typeid_cast<const ColumnNullable *>(column.get()))
+    {
+        nested = &col_nullable->getNestedColumn();
+        null_map = &col_nullable->getNullMapData();
+    }
+
+    if (!(getTruthValuesImpl<UInt8>(*nested, res)
+          || getTruthValuesImpl<UInt16>(*nested, res)
+          || getTruthValuesImpl<UInt32>(*nested, res)
+          || getTruthValuesImpl<UInt64>(*nested, res)
+          || getTruthValuesImpl<Int8>(*nested, res)
+          || getTruthValuesImpl<Int16>(*nested, res)
+          || getTruthValuesImpl<Int32>(*nested, res)
+          || getTruthValuesImpl<Int64>(*nested, res)
+          || getTruthValuesImpl<Float32>(*nested, res)
+          || getTruthValuesImpl<Float64>(*nested, res)))
+        return false;
+
+    if (null_map)
+    {
+        for (size_t i = 0; i < rows; ++i)
+        {
+            if ((*null_map)[i])
+                res[i] = truth_null;
+        }
+    }
+    return true;
+}
+} // namespace
 
 Names ExpressionAction::getNeededColumns() const
 {
-    Names res = argument_names;
+    Names res;
+    for (size_t i = 0; i < argument_names.size(); ++i)
+    {
+        /// A lazy argument is computed by this action itself, from the inputs of its lazy actions.
+        if (i < lazy_arguments.size() && !lazy_arguments[i].empty())
+            res.insert(res.end(), lazy_argument_inputs[i].begin(), lazy_argument_inputs[i].end());
+        else
+            res.push_back(argument_names[i]);
+    }
 
     for (const auto & column : projections)
         res.push_back(column.first);
@@ -318,6 +403,9 @@ void ExpressionAction::execute(Block & block) const
     {
     case APPLY_FUNCTION:
     {
+        if (hasLazyArguments())
+            executeLazyArguments(block);
+
         ColumnNumbers arguments(argument_names.size());
         for (size_t i = 0; i < argument_names.size(); ++i)
         {
@@ -386,6 +474,113 @@ void ExpressionAction::execute(Block & block) const
 }
 
 
+void ExpressionAction::executeLazyArguments(Block & block) const
+{
+    const size_t rows = block.rows();
+    const size_t num_arguments = argument_names.size();
+
+    auto get_argument = [&](size_t i, const IColumn::Filter & needed_rows) -> ColumnPtr {
+        if (i >= lazy_arguments.size() || lazy_arguments[i].empty())
+            return block.getByName(argument_names[i]).column;
+        ColumnPtr column = executeLazyArgument(block, i, needed_rows);
+        block.insert({column, lazy_arguments[i].back().result_type, argument_names[i]});
+        return column;
+    };
+
+    /// The rows whose result is not decided by the arguments computed so far.
+    IColumn::Filter undecided(rows, 1);
+    PaddedPODArray<UInt8> truth_values;
+
+    const String & name = function->getName();
+    if (name == "and" || name == "or")
+    {
+        /// A false argument decides `and`, and a true argument decides `or`, even if there are nulls.
+        const UInt8 decisive = name == "and" ? truth_false : truth_true;
+        for (size_t i = 0; i < num_arguments; ++i)
+        {
+            ColumnPtr column = get_argument(i, undecided);
+            if (i + 1 == num_arguments || !getTruthValues(column, rows, truth_values))
+                continue;
+            for (size_t row = 0; row < rows; ++row)
+                undecided[row] &= truth_values[row] != decisive;
+        }
+    }
+    else
+    {
+        /// if(cond, then, else) has the same layout as multiIf(cond_1, then_1, ..., cond_n, then_n, else),
+        /// and a null condition is treated as false by both.
+        IColumn::Filter needed_rows(rows);
+        for (size_t i = 0; i + 1 < num_arguments; i += 2)
+        {
+            ColumnPtr cond = get_argument(i, undecided);
+            bool known = getTruthValues(cond, rows, truth_values);
+            for (size_t row = 0; row < rows; ++row)
+                needed_rows[row] = undecided[row] && (!known || truth_values[row] == truth_true);
+
+            get_argument(i + 1, needed_rows);
+
+            if (!known)
+                continue;
+            for (size_t row = 0; row < rows; ++row)
+                undecided[row] &= truth_values[row] != truth_true;
+        }
+        if (num_arguments % 2)
+            get_argument(num_arguments - 1, undecided);
+    }
+}
+
+ColumnPtr ExpressionAction::executeLazyArgument(const Block & block, size_t arg_index, const IColumn::Filter & needed_rows) const
+{
+    const auto & actions = lazy_arguments[arg_index];
+    const auto & inputs = lazy_argument_inputs[arg_index];
+    const auto & result_name = argument_names[arg_index];
+    const size_t rows = block.rows();
+    const size_t needed = countBytesInFilter(needed_rows);
+
+    if (needed == 0)
+    {
+        auto column = actions.back().result_type->createColumn();
+        column->insertManyDefaults(rows);
+        return column;
+    }
+
+    Block sub_block;
+    const bool full = needed >= rows * short_circuit_full_evaluation_ratio;
+    for (const auto & input : inputs)
+    {
+        const auto & column = block.getByName(input);
+        sub_block.insert({full ? column.column : column.column->filter(needed_rows, needed), column.type, column.name});
+    }
+
+    for (const auto & action : actions)
+        action.execute(sub_block);
+
+    ColumnPtr sub_result = sub_block.getByName(result_name).column;
+    if (full)
+        return sub_result;
+
+    /// Scatter the result back, the rows that do not need it are filled with default values.
+    sub_result = sub_result->convertToFullColumnIfConst();
+    auto column = sub_result->cloneEmpty();
+    column->reserve(rows);
+    size_t sub_row = 0;
+    for (size_t row = 0; row < rows;)
+    {
+        size_t end = row;
+        while (end < rows && needed_rows[end] == needed_rows[row])
+            ++end;
+        if (needed_rows[row])
+        {
+            column->insertRangeFrom(*sub_result, sub_row, end - row);
+            sub_row += end - row;
+        }
+        else
+            column->insertManyDefaults(end - row);
+        row = end;
+    }
+    return column;
+}
+
 void ExpressionAction::executeOnTotals(Block & block) const
 {
     if (type != JOIN)
@@ -424,6 +619,19 @@ String ExpressionAction::toString() const
             ss << argument_names[i];
         }
         ss << ")";
+        for (size_t i = 0; i < lazy_arguments.size(); ++i)
+        {
+            if (lazy_arguments[i].empty())
+                continue;
+            ss << " LAZY " << argument_names[i] << " = [";
+            for (size_t j = 0; j < lazy_arguments[i].size(); ++j)
+            {
+                if (j)
+                    ss << "; ";
+                ss << lazy_arguments[i][j].toString();
+            }
+            ss << "]";
+        }
         break;
 
     case JOIN:
@@ -568,7 +776,122 @@ std::string ExpressionActions::getSmallestColumn(const NamesAndTypesList & colum
     return res;
 }
 
-void ExpressionActions::finalize(const Names & output_columns)
+void ExpressionActions::setupShortCircuitArguments(const NameSet & final_columns)
+{
+    /// The columns used by JOIN are not reported by getNeededColumns, so it is not safe to move any action.
+    for (const auto & action : actions)
+    {
+        if (action.type == ExpressionAction::JOIN)
+            return;
+    }
+
+    auto is_movable = [](const ExpressionAction & action) {
+        return action.type == ExpressionAction::ADD_COLUMN
+            || (action.type == ExpressionAction::APPLY_FUNCTION && action.function && action.function->isDeterministic());
+    };
+
+    std::vector<bool> moved(actions.size(), false);
+    for (size_t i = 0; i < actions.size(); ++i)
+    {
+        ExpressionAction & action = actions[i];
+        if (action.type != ExpressionAction::APPLY_FUNCTION || !action.function || !isShortCircuitFunction(action.function->getName()))
+            continue;
+
+        /// Only the actions after the last one that may drop or rename columns can be moved,
+        /// so that the inputs of the lazy actions are still in the block when this action is executed.
+        size_t begin = i;
+        while (begin > 0
+               && (actions[begin - 1].type == ExpressionAction::ADD_COLUMN
+                   || actions[begin - 1].type == ExpressionAction::APPLY_FUNCTION
+                   || actions[begin - 1].type == ExpressionAction::COPY_COLUMN))
+            --begin;
+
+        std::unordered_map<String, size_t> producers;
+        std::unordered_map<String, size_t> use_count;
+        for (const auto & name : final_columns)
+            ++use_count[name];
+        for (size_t j = 0; j < actions.size(); ++j)
+        {
+            if (moved[j])
+                continue;
+            for (const auto & name : actions[j].getNeededColumns())
+                ++use_count[name];
+            if (j >= begin && j < i && is_movable(actions[j]))
+                producers[actions[j].result_name] = j;
+        }
+
+        const size_t num_arguments = action.argument_names.size();
+        action.lazy_arguments.resize(num_arguments);
+        action.lazy_argument_inputs.resize(num_arguments);
+        bool has_lazy_argument = false;
+        /// The first argument is always needed.
+        for (size_t k = 1; k < num_arguments; ++k)
+        {
+            const String & argument = action.argument_names[k];
+            auto root = producers.find(argument);
+            if (root == producers.end() || actions[root->second].type != ExpressionAction::APPLY_FUNCTION)
+                continue;
+
+            /// Collect the actions whose results are only used to compute this argument.
+            std::vector<size_t> subtree;
+            Names inputs;
+            NameSet input_set;
+            Names stack{argument};
+            while (!stack.empty())
+            {
+                String name = std::move(stack.back());
+                stack.pop_back();
+                auto producer = producers.find(name);
+                if (producer != producers.end() && !moved[producer->second] && use_count[name] == 1)
+                {
+                    subtree.push_back(producer->second);
+                    moved[producer->second] = true;
+                    for (auto & needed : actions[producer->second].getNeededColumns())
+                        stack.push_back(std::move(needed));
+                }
+                else if (input_set.insert(name).second)
+                {
+                    inputs.push_back(name);
+                }
+            }
+
+            /// Without inputs the sub block can not know the number of rows, and such an argument is cheap anyway.
+            if (subtree.empty() || inputs.empty())
+            {
+                for (size_t idx : subtree)
+                    moved[idx] = false;
+                continue;
+            }
+
+            std::sort(subtree.begin(), subtree.end());
+            for (size_t idx : subtree)
+            {
+                action.lazy_arguments[k].push_back(actions[idx]);
+                if (actions[idx].result_name != argument && sample_block.has(actions[idx].result_name))
+                    sample_block.erase(actions[idx].result_name);
+            }
+            action.lazy_argument_inputs[k] = std::move(inputs);
+            has_lazy_argument = true;
+        }
+
+        if (!has_lazy_argument)
+        {
+            action.lazy_arguments.clear();
+            action.lazy_argument_inputs.clear();
+        }
+    }
+
+    Actions new_actions;
+    new_actions.reserve(actions.size());
+    for (size_t i = 0; i < actions.size(); ++i)
+    {
+        if (!moved[i])
+            new_actions.push_back(std::move(actions[i]));
+    }
+    actions.swap(new_actions);
+}
+
+void ExpressionActions::finalize(const Names & output_columns, bool enable_short_circuit)
 {
     NameSet final_columns;
     for (const auto & name : output_columns)
@@ -668,6 +991,9 @@ void ExpressionActions::finalize(const Names & output_columns)
         }
     }
 
+    if (enable_short_circuit)
+        setupShortCircuitArguments(final_columns);
+
     /*    std::cerr << "\n";
     for (const auto & action : actions)
         std::cerr << action.toString() << "\n";
@@ -689,6 +1015,12 @@ void ExpressionActions::finalize(const Names & output_columns)
         for (const auto & name : action.argument_names)
             ++columns_refcount[name];
 
+        for (const auto & inputs : action.lazy_argument_inputs)
+        {
+            for (const auto & name : inputs)
+                ++columns_refcount[name];
+        }
+
         for (const auto & name_alias : action.projections)
             ++columns_refcount[name_alias.first];
     }
@@ -716,6 +1048,12 @@ void ExpressionActions::finalize(const Names & output_columns)
         for (const auto & name : action.argument_names)
             process(name);
 
+        for (const auto & inputs : action.lazy_argument_inputs)
+        {
+            for (const auto & name : inputs)
+                process(name);
+        }
+
         /// For `projection`, there is no reduction in `refcount`, because the `project` action replaces the names of the columns, in effect, already deleting them under the old names.
     }
 
@@ -761,7 +1099,7 @@ void ExpressionActionsChain::addStep()
     steps.push_back(Step(std::make_shared<ExpressionActions>(columns)));
 }
 
-void ExpressionActionsChain::finalize()
+void ExpressionActionsChain::finalize(bool enable_short_circuit)
 {
     /// Finalize all steps. Right to left to define unnecessary input columns.
     for (int i = static_cast<int>(steps.size()) - 1; i >= 0; --i)
@@ -772,7 +1110,7 @@ void ExpressionActionsChain::finalize()
             for (const auto & it : steps[i + 1].actions->getRequiredColumnsWithTypes())
                 required_output.push_back(it.name);
         }
-        steps[i].actions->finalize(required_output);
+        steps[i].actions->finalize(required_output, enable_short_circuit);
     }
 
     /// Adding the ejection of unnecessary columns to the beginning of each step.
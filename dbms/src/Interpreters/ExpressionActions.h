@@ -86,6 +86,11 @@ public:
     FunctionBasePtr function;
     Names argument_names;
     TiDB::TiDBCollatorPtr collator = nullptr;
+    /// For APPLY_FUNCTION of short-circuit functions (and, or, if, multiIf), filled by ExpressionActions::finalize.
+    /// If lazy_arguments[i] is not empty, argument_names[i] is not computed ahead of this action, instead it is
+    /// computed by lazy_arguments[i] from lazy_argument_inputs[i], only for the rows whose result depends on it.
+    std::vector<std::vector<ExpressionAction>> lazy_arguments;
+    std::vector<Names> lazy_argument_inputs;
 
     /// For JOIN
     std::shared_ptr<const Join> join;
@@ -123,6 +128,11 @@ private:
     void prepare(Block & sample_block);
     void execute(Block & block) const;
     void executeOnTotals(Block & block) const;
+
+    bool hasLazyArguments() const { return !lazy_arguments.empty(); }
+    /// Compute the lazy arguments and insert them into the block.
+    void executeLazyArguments(Block & block) const;
+    ColumnPtr executeLazyArgument(const Block & block, size_t arg_index, const IColumn::Filter & needed_rows) const;
 };
 
 
@@ -177,7 +187,9 @@ public:
     /// - Does not reorder the columns.
     /// - Does not remove "unexpected" columns (for example, added by functions).
     /// - If output_columns is empty, leaves one arbitrary column (so that the number of rows in the block is not lost).
-    void finalize(const Names & output_columns);
+    /// - If enable_short_circuit, makes the branches of and/or/if/multiIf evaluated lazily on the rows that need them,
+    ///   it is controlled by the setting `enable_short_circuit_evaluation` for the DAG request.
+    void finalize(const Names & output_columns, bool enable_short_circuit = false);
 
     const Actions & getActions() const { return actions; }
 
@@ -215,6 +227,9 @@ private:
     Block sample_block;
 
     void addImpl(ExpressionAction action, Names & new_names);
+
+    /// Move the actions that only compute a branch of a short-circuit function into its lazy arguments.
+    void setupShortCircuitArguments(const NameSet & final_columns);
 };
 
 using ExpressionActionsPtr = std::shared_ptr<ExpressionActions>;
@@ -248,7 +263,7 @@ struct ExpressionActionsChain
 
     void addStep();
 
-    void finalize();
+    void finalize(bool enable_short_circuit = false);
 
     void clear()
     {
@@ -18,10 +18,13 @@
 #include <Columns/ColumnString.h>
 #include <Common/ColumnsHashing.h>
 #include <Common/FailPoint.h>
+#include <Common/ProfileEvents.h>
+#include <Common/ThreadManager.h>
 #include <Common/typeid_cast.h>
 #include <Core/ColumnNumbers.h>
 #include <DataStreams/IProfilingBlockInputStream.h>
 #include <DataStreams/NonJoinedBlockInputStream.h>
+#include <DataStreams/NullBlockInputStream.h>
 #include <DataStreams/materializeBlock.h>
 #include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/DataTypesNumber.h>
@@ -31,6 +34,10 @@
 #include <Interpreters/NullableUtils.h>
 #include <common/logger_useful.h>
 
+namespace ProfileEvents
+{
+extern const Event ExternalJoinSpill;
+}
 
 namespace DB
 {
@@ -168,14 +175,27 @@ Join::Join(
 }
 
 void Join::meetError(const String & error_message_)
+{
+    {
+        std::lock_guard lk(build_probe_mutex);
+        if (meet_error)
+            return;
+        meet_error = true;
+        error_message = error_message_.empty() ? "Join meet error" : error_message_;
+        for (const auto & runtime_filter : runtime_filters)
+            runtime_filter->disable(error_message);
+        build_cv.notify_all();
+        probe_cv.notify_all();
+    }
+    /// restore_mutex must not be acquired while holding build_probe_mutex, see `restorePartition`.
+    std::lock_guard lk(restore_mutex);
+    restore_cv.notify_all();
+}
+
+bool Join::hasMeetError() const
 {
     std::lock_guard lk(build_probe_mutex);
-    if (meet_error)
-        return;
-    meet_error = true;
-    error_message = error_message_.empty() ? "Join meet error" : error_message_;
-    build_cv.notify_all();
-    probe_cv.notify_all();
+    return meet_error;
 }
 
 bool CanAsColumnString(const IColumn * column)
@@ -531,6 +551,7 @@ void Join::init(const Block & sample_block, size_t build_concurrency_)
     /// Choose data structure to use for JOIN.
     initMapImpl(chooseMethod(getKeyColumns(key_names_right, sample_block), key_sizes));
     setSampleBlock(sample_block);
+    build_sample_block = sample_block.cloneEmpty();
 }
 
 namespace
@@ -848,6 +869,7 @@ void Join::insertFromBlock(const Block & block)
     if (unlikely(!initialized))
         throw Exception("Logical error: Join was not initialized", ErrorCodes::LOGICAL_ERROR);
     total_input_build_rows += block.rows();
+    insertToRuntimeFilters(block);
     blocks.push_back(block);
     Block * stored_block = &blocks.back();
     insertFromBlockInternal(stored_block, 0);
@@ -861,6 +883,13 @@ void Join::insertFromBlock(const Block & block, size_t stream_index)
 
     if (unlikely(!initialized))
         throw Exception("Logical error: Join was not initialized", ErrorCodes::LOGICAL_ERROR);
+    insertToRuntimeFilters(block);
+    if (is_spilled)
+    {
+        total_input_build_rows += block.rows();
+        spillBuildBlock(block);
+        return;
+    }
     Block * stored_block = nullptr;
     {
         std::lock_guard lk(blocks_lock);
@@ -870,6 +899,25 @@ void Join::insertFromBlock(const Block & block, size_t stream_index)
         original_blocks.push_back(block);
     }
     insertFromBlockInternal(stored_block, stream_index);
+
+    if (isEnableSpill())
+    {
+        total_input_build_bytes += block.bytes();
+        if (total_input_build_bytes > max_bytes_before_external_join)
+        {
+            lock.unlock();
+            std::unique_lock spill_lock(rwlock);
+            /// Other build streams may have spilled the build data.
+            if (!is_spilled)
+                spillAllBuildData();
+        }
+    }
+}
+
+void Join::insertToRuntimeFilters(const Block & block)
+{
+    for (const auto & runtime_filter : runtime_filters)
+        runtime_filter->insert(block.getByName(key_names_right[runtime_filter->build_key_index]));
 }
 
 void Join::insertFromBlockInternal(Block * stored_block, size_t stream_index)
@@ -967,6 +1015,343 @@ void Join::insertFromBlockInternal(Block * stored_block, size_t stream_index)
 }
 
 
+void Join::setSpillConfig(
+    const SpillConfig & build_spill_config_,
+    const SpillConfig & probe_spill_config_,
+    size_t max_bytes_before_external_join_,
+    size_t spill_partition_num_)
+{
+    RUNTIME_CHECK_MSG(!initialized, "Spill config must be set before the join is initialized");
+    RUNTIME_CHECK_MSG(spill_partition_num_ > 1, "Join spill partition num must be greater than 1, got {}", spill_partition_num_);
+    build_spill_config.emplace(build_spill_config_);
+    probe_spill_config.emplace(probe_spill_config_);
+    max_bytes_before_external_join = max_bytes_before_external_join_;
+    spill_partition_num = spill_partition_num_;
+}
+
+bool Join::isEnableSpill() const
+{
+    /// The result of null-aware semi join depends on all the build rows, so it can not be joined partition by partition.
+    return max_bytes_before_external_join > 0 && !isCrossJoin(kind) && other_eq_filter_from_in_column.empty();
+}
+
+Blocks Join::partitionBlock(const Block & block, const Names & key_names) const
+{
+    Block materialized_block = materializeBlock(block);
+    size_t rows = materialized_block.rows();
+    ColumnRawPtrs key_columns;
+    TiDB::TiDBCollators key_collators;
+    key_columns.reserve(key_names.size());
+    for (size_t i = 0; i < key_names.size(); ++i)
+    {
+        key_columns.push_back(materialized_block.getByName(key_names[i]).column.get());
+        key_collators.push_back(i < collators.size() ? collators[i] : nullptr);
+    }
+    WeakHash32 hash(0);
+    std::vector<String> partition_key_containers(key_names.size());
+    HashBaseWriterHelper::computeHash(rows, key_columns, key_collators, partition_key_containers, hash);
+
+    /// Use the most significant bits of the hash value, so the partitions are independent of the hash map segments,
+    /// which are chosen by the least significant bits.
+    IColumn::Selector selector(rows);
+    const auto & hash_data = hash.getData();
+    for (size_t i = 0; i < rows; ++i)
+        selector[i] = (static_cast<UInt64>(hash_data[i]) * spill_partition_num) >> 32u;
+
+    Blocks partitions(spill_partition_num);
+    for (auto & partition : partitions)
+        partition = materialized_block.cloneEmpty();
+    for (size_t col_id = 0; col_id < materialized_block.columns(); ++col_id)
+    {
+        auto scattered_columns = materialized_block.getByPosition(col_id).column->scatter(spill_partition_num, selector);
+        for (size_t i = 0; i < spill_partition_num; ++i)
+            partitions[i].getByPosition(col_id).column = std::move(scattered_columns[i]);
+    }
+    return partitions;
+}
+
+void Join::spillBuildBlock(const Block & block)
+{
+    auto partitions = partitionBlock(block, key_names_right);
+    for (size_t i = 0; i < spill_partition_num; ++i)
+    {
+        if (partitions[i].rows() > 0)
+            build_spiller->spillBlocks({std::move(partitions[i])}, i);
+    }
+}
+
+void Join::spillAllBuildData()
+{
+    assert(!is_spilled);
+    LOG_INFO(log, "Build data size {} bytes exceeds max_bytes_before_external_join {}, spill the build data into {} partitions", total_input_build_bytes.load(), max_bytes_before_external_join, spill_partition_num);
+    ProfileEvents::increment(ProfileEvents::ExternalJoinSpill);
+    build_spiller = std::make_unique<Spiller>(*build_spill_config, false, spill_partition_num, materializeBlock(build_sample_block), log);
+    for (const auto & block : original_blocks)
+        spillBuildBlock(block);
+
+    /// Release the in-memory build data.
+    blocks.clear();
+    original_blocks.clear();
+    maps_any = MapsAny{};
+    maps_all = MapsAll{};
+    maps_any_full = MapsAnyFull{};
+    maps_all_full = MapsAllFull{};
+    initMapImpl(type);
+    for (auto & pool : pools)
+        pool = std::make_shared<Arena>();
+    for (auto & rows : rows_not_inserted_to_map)
+        rows = std::make_unique<RowRefList>();
+    is_spilled = true;
+}
+
+void Join::spillProbeBlock(const Block & block)
+{
+    assert(is_spilled);
+    {
+        std::lock_guard lock(probe_spiller_mutex);
+        if (!probe_spiller)
+            probe_spiller = std::make_unique<Spiller>(*probe_spill_config, false, spill_partition_num, materializeBlock(block.cloneEmpty()), log);
+    }
+    auto partitions = partitionBlock(block, key_names_left);
+    for (size_t i = 0; i < spill_partition_num; ++i)
+    {
+        if (partitions[i].rows() > 0)
+            probe_spiller->spillBlocks({std::move(partitions[i])}, i);
+    }
+}
+
+JoinPtr Join::buildRestoreJoin(size_t partition_index)
+{
+    LOG_DEBUG(log, "Restore the spilled partition {}", partition_index);
+    auto join = std::make_shared<Join>(
+        key_names_left,
+        key_names_right,
+        kind,
+        original_strictness,
+        log->identifier(),
+        false,
+        0,
+        collators,
+        left_filter_column,
+        right_filter_column,
+        other_filter_column,
+        other_eq_filter_from_in_column,
+        other_condition_ptr,
+        max_block_size_for_cross_join,
+        match_helper_name);
+    join->init(build_sample_block, 1);
+    join->setInitActiveBuildConcurrency();
+    for (const auto & build_stream : build_spiller->restoreBlocks(partition_index, 1))
+    {
+        build_stream->readPrefix();
+        while (Block block = build_stream->read())
+            join->insertFromBlock(block, 0);
+        build_stream->readSuffix();
+    }
+    join->finishOneBuild();
+    return join;
+}
+
+bool Join::isRestorePartitionReady(size_t restore_round) const
+{
+    std::lock_guard lock(restore_mutex);
+    /// A failed restore is also ready, `tryRestorePartitionAsync` throws the error then.
+    return hasMeetError() || isRestorePartitionReadyNoLock(restore_round);
+}
+
+bool Join::isRestorePartitionReadyNoLock(size_t restore_round) const
+{
+    /// Either the partition of this round has been restored, or all the probe streams have finished the previous one.
+    return !is_restoring && (restored_rounds > restore_round || active_restore_probe_concurrency == 0);
+}
+
+bool Join::nextRestorePartitionNoLock(size_t & partition_index)
+{
+    /// Skip the partitions without any spilled data.
+    while (next_restore_partition < spill_partition_num
+           && build_spiller->spilledRows(next_restore_partition) == 0
+           && (probe_spiller == nullptr || probe_spiller->spilledRows(next_restore_partition) == 0))
+        ++next_restore_partition;
+    if (next_restore_partition >= spill_partition_num)
+        return false;
+    partition_index = next_restore_partition++;
+    is_restoring = true;
+    return true;
+}
+
+void Join::buildRestorePartition(size_t partition_index, const Block & probe_header, JoinPtr & join, BlockInputStreams & probe_streams)
+{
+    size_t restore_probe_concurrency = getProbeConcurrency();
+    join = buildRestoreJoin(partition_index);
+    join->setProbeConcurrency(restore_probe_concurrency);
+    if (probe_spiller)
+    {
+        probe_streams = probe_spiller->restoreBlocks(partition_index, restore_probe_concurrency, true);
+    }
+    else
+    {
+        for (size_t i = 0; i < restore_probe_concurrency; ++i)
+            probe_streams.push_back(std::make_shared<NullBlockInputStream>(probe_header));
+    }
+    RUNTIME_CHECK(probe_streams.size() == restore_probe_concurrency, probe_streams.size(), restore_probe_concurrency);
+}
+
+void Join::setRestoredPartitionNoLock(JoinPtr && join, BlockInputStreams && probe_streams)
+{
+    if (join)
+    {
+        is_restoring = false;
+        active_restore_probe_concurrency = probe_streams.size();
+    }
+    restore_join = std::move(join);
+    restore_probe_streams = std::move(probe_streams);
+    ++restored_rounds;
+    restore_cv.notify_all();
+}
+
+bool Join::tryRestorePartition(
+    size_t probe_index,
+    size_t restore_round,
+    const Block & probe_header,
+    JoinPtr & restored_join,
+    BlockInputStreamPtr & probe_stream)
+{
+    assert(is_spilled);
+    std::unique_lock lock(restore_mutex);
+    if (!isRestorePartitionReadyNoLock(restore_round))
+        return false;
+
+    if (restored_rounds == restore_round)
+    {
+        /// The first probe stream of the round restores the next non-empty partition, the others wait until it is built.
+        JoinPtr join;
+        BlockInputStreams probe_streams;
+        size_t partition_index = 0;
+        if (nextRestorePartitionNoLock(partition_index))
+        {
+            lock.unlock();
+            try
+            {
+                buildRestorePartition(partition_index, probe_header, join, probe_streams);
+            }
+            catch (...)
+            {
+                lock.lock();
+                is_restoring = false;
+                restore_cv.notify_all();
+                throw;
+            }
+            lock.lock();
+        }
+        setRestoredPartitionNoLock(std::move(join), std::move(probe_streams));
+    }
+
+    restored_join = restore_join;
+    if (restored_join)
+        probe_stream = restore_probe_streams[probe_index];
+    return true;
+}
+
+bool Join::tryRestorePartitionAsync(
+    size_t probe_index,
+    size_t restore_round,
+    const Block & probe_header,
+    JoinPtr & restored_join,
+    BlockInputStreamPtr & probe_stream)
+{
+    assert(is_spilled);
+    std::unique_lock lock(restore_mutex);
+    if (hasMeetError())
+    {
+        std::lock_guard error_lock(build_probe_mutex);
+        throw Exception(error_message);
+    }
+    if (!isRestorePartitionReadyNoLock(restore_round))
+        return false;
+
+    if (restored_rounds == restore_round)
+    {
+        size_t partition_index = 0;
+        if (nextRestorePartitionNoLock(partition_index))
+        {
+            /// Reading the spilled data and building the hash table may block for a long time, so the partition is
+            /// restored in a background thread, and the probe operators wait until `isRestorePartitionReady`.
+            newThreadManager()->scheduleThenDetach(true, "JoinRestore", [join = shared_from_this(), partition_index, probe_header] {
+                JoinPtr restored;
+                BlockInputStreams probe_streams;
+                try
+                {
+                    join->buildRestorePartition(partition_index, probe_header, restored, probe_streams);
+                }
+                catch (...)
+                {
+                    join->meetError(getCurrentExceptionMessage(false));
+                    std::lock_guard lock(join->restore_mutex);
+                    join->is_restoring = false;
+                    join->restore_cv.notify_all();
+                    return;
+                }
+                std::lock_guard lock(join->restore_mutex);
+                join->setRestoredPartitionNoLock(std::move(restored), std::move(probe_streams));
+            });
+            return false;
+        }
+        setRestoredPartitionNoLock(nullptr, {});
+    }
+
+    restored_join = restore_join;
+    if (restored_join)
+        probe_stream = restore_probe_streams[probe_index];
+    return true;
+}
+
+JoinPtr Join::restorePartition(
+    size_t probe_index,
+    size_t restore_round,
+    const Block & probe_header,
+    BlockInputStreamPtr & probe_stream,
+    const std::function<bool()> & is_cancelled)
+{
+    while (true)
+    {
+        JoinPtr restored_join;
+        if (tryRestorePartition(probe_index, restore_round, probe_header, restored_join, probe_stream))
+            return restored_join;
+
+        std::unique_lock lock(restore_mutex);
+        restore_cv.wait(lock, [&]() {
+            return is_cancelled() || hasMeetError() || isRestorePartitionReadyNoLock(restore_round);
+        });
+        if (hasMeetError())
+        {
+            std::lock_guard error_lock(build_probe_mutex);
+            throw Exception(error_message);
+        }
+        if (is_cancelled())
+            return nullptr;
+    }
+}
+
+void Join::finishRestorePartition()
+{
+    std::lock_guard lock(restore_mutex);
+    assert(active_restore_probe_concurrency > 0);
+    --active_restore_probe_concurrency;
+    if (active_restore_probe_concurrency == 0)
+    {
+        /// Release the memory of the partition before the next one is restored.
+        restore_join.reset();
+        restore_probe_streams.clear();
+        restore_cv.notify_all();
+    }
+}
+
+void Join::wakeUpRestoreWaiters()
+{
+    std::lock_guard lock(restore_mutex);
+    restore_cv.notify_all();
+}
+
 namespace
 {
 template <ASTTableJoin::Kind KIND, ASTTableJoin::Strictness STRICTNESS, typename Map>
@@ -2006,7 +2391,11 @@ void Join::finishOneProbe()
     }
     --active_probe_concurrency;
     if (active_probe_concurrency == 0)
+    {
+        if (probe_spiller)
+            probe_spiller->finishSpill();
         probe_cv.notify_all();
+    }
 }
 void Join::finishOneBuild()
 {
@@ -2017,7 +2406,16 @@ void Join::finishOneBuild()
     }
     --active_build_concurrency;
     if (active_build_concurrency == 0)
+    {
+        if (is_spilled)
+            build_spiller->finishSpill();
+        if (!meet_error)
+        {
+            for (const auto & runtime_filter : runtime_filters)
+                runtime_filter->finalize();
+        }
         build_cv.notify_all();
+    }
 }
 
 void Join::waitUntilAllProbeFinished() const
@@ -2040,6 +2438,22 @@ void Join::waitUntilAllBuildFinished() const
         throw Exception(error_message);
 }
 
+bool Join::isAllProbeFinished() const
+{
+    std::unique_lock lock(build_probe_mutex);
+    if (meet_error)
+        throw Exception(error_message);
+    return active_probe_concurrency == 0;
+}
+
+bool Join::isAllBuildFinished() const
+{
+    std::unique_lock lock(build_probe_mutex);
+    if (meet_error)
+        throw Exception(error_message);
+    return active_build_concurrency == 0;
+}
+
 Block Join::joinBlock(ProbeProcessInfo & probe_process_info) const
 {
     waitUntilAllBuildFinished();
@@ -20,18 +20,25 @@
 #include <Common/Arena.h>
 #include <Common/HashTable/HashMap.h>
 #include <Common/Logger.h>
+#include <Core/Spiller.h>
 #include <DataStreams/IBlockInputStream.h>
 #include <Interpreters/AggregationCommon.h>
 #include <Interpreters/ExpressionActions.h>
+#include <Interpreters/RuntimeFilter.h>
 #include <Interpreters/SettingsCommon.h>
 #include <Parsers/ASTTablesInSelectQuery.h>
 #include <common/ThreadPool.h>
 
+#include <functional>
+#include <optional>
 #include <shared_mutex>
 
 namespace DB
 {
 struct ProbeProcessInfo;
+class Join;
+using JoinPtr = std::shared_ptr<Join>;
+
 /** Data structure for implementation of JOIN.
   * It is just a hash table: keys -> rows of joined ("right") table.
   * Additionally, CROSS JOIN is supported: instead of hash table, it use just set of blocks without keys.
@@ -84,8 +91,16 @@ struct ProbeProcessInfo;
   *
   * Always generate Nullable column and substitute NULLs for non-joined rows,
   *  as in standard SQL.
+  *
+  * Spill to disk (grace hash join):
+  *
+  * If spill is enabled and the input bytes of "right" table exceeds `max_bytes_before_external_join`,
+  *  all the build data is partitioned by the hash of join keys and spilled to disk, and so are the subsequent build blocks.
+  * The probe blocks are partitioned and spilled in the same way after the build is finished.
+  * After all the probe finished, the spilled partitions are restored one at a time,
+  *  each restored partition is built into a new in-memory Join and probed by all the probe streams, see `restorePartition`.
   */
-class Join
+class Join : public std::enable_shared_from_this<Join>
 {
 public:
     Join(const Names & key_names_left_,
@@ -161,6 +176,8 @@ public:
     }
     void finishOneBuild();
     void waitUntilAllBuildFinished() const;
+    /// Non-blocking version of `waitUntilAllBuildFinished` for the pipeline model.
+    bool isAllBuildFinished() const;
 
     size_t getProbeConcurrency() const
     {
@@ -175,6 +192,8 @@ public:
     }
     void finishOneProbe();
     void waitUntilAllProbeFinished() const;
+    /// Non-blocking version of `waitUntilAllProbeFinished` for the pipeline model.
+    bool isAllProbeFinished() const;
 
     size_t getBuildConcurrency() const
     {
@@ -184,6 +203,57 @@ public:
 
     void meetError(const String & error_message);
 
+    /// The runtime filters are fed with the build side keys, and are ready once all the build finished.
+    void setRuntimeFilters(const RuntimeFilters & runtime_filters_) { runtime_filters = runtime_filters_; }
+
+    void setSpillConfig(
+        const SpillConfig & build_spill_config_,
+        const SpillConfig & probe_spill_config_,
+        size_t max_bytes_before_external_join_,
+        size_t spill_partition_num_);
+    /// Cross join and null-aware semi join do not support spill.
+    bool isEnableSpill() const;
+    /// Only valid after all build finished.
+    bool isSpilled() const { return is_spilled; }
+    /// Must be called only if the build side has been spilled.
+    void spillProbeBlock(const Block & block);
+    /** The spilled partitions are restored one at a time and shared by all the probe streams:
+      * the first probe stream reaching a partition builds a new Join from the build data of the partition,
+      *  every probe stream probes it with its share of the probe data of the partition,
+      *  and the next partition is not restored until all the probe streams have called `finishRestorePartition`.
+      * `restore_round` is the number of partitions the calling probe stream has finished.
+      * Must be called after all probe finished.
+      */
+    /// Return nullptr if all the partitions have been restored or the stream is cancelled,
+    ///  otherwise set `probe_stream` to read the probe data of `probe_index` in the partition.
+    JoinPtr restorePartition(
+        size_t probe_index,
+        size_t restore_round,
+        const Block & probe_header,
+        BlockInputStreamPtr & probe_stream,
+        const std::function<bool()> & is_cancelled);
+    /// Non-blocking version of `restorePartition`, return false if it has to wait for the other probe streams.
+    /// The partition is restored in the calling thread.
+    bool tryRestorePartition(
+        size_t probe_index,
+        size_t restore_round,
+        const Block & probe_header,
+        JoinPtr & restored_join,
+        BlockInputStreamPtr & probe_stream);
+    /// Same as `tryRestorePartition`, but the partition is restored in a background thread for the pipeline model,
+    /// so that the pipeline worker threads never block on the spilled data. Return false until it is restored.
+    bool tryRestorePartitionAsync(
+        size_t probe_index,
+        size_t restore_round,
+        const Block & probe_header,
+        JoinPtr & restored_join,
+        BlockInputStreamPtr & probe_stream);
+    /// Non-blocking check for the pipeline model whether `tryRestorePartitionAsync` could return true or throw.
+    bool isRestorePartitionReady(size_t restore_round) const;
+    void finishRestorePartition();
+    /// Wake up the probe streams waiting in `restorePartition` to check whether they are cancelled.
+    void wakeUpRestoreWaiters();
+
     /// Reference to the row in block.
     struct RowRef
     {
@@ -314,6 +384,8 @@ private:
     bool meet_error = false;
     String error_message;
 
+    RuntimeFilters runtime_filters;
+
 private:
     /// collators for the join key
     const TiDB::TiDBCollators collators;
@@ -374,6 +446,30 @@ private:
     bool enable_fine_grained_shuffle = false;
     size_t fine_grained_shuffle_count = 0;
 
+    /// The sample block used to init this join, keep it to init the join of restored partitions.
+    Block build_sample_block;
+
+    std::optional<SpillConfig> build_spill_config;
+    std::optional<SpillConfig> probe_spill_config;
+    size_t max_bytes_before_external_join = 0;
+    size_t spill_partition_num = 0;
+    std::atomic<size_t> total_input_build_bytes{0};
+    std::atomic<bool> is_spilled{false};
+    std::unique_ptr<Spiller> build_spiller;
+    /// probe_spiller is created lazily by the first spilled probe block.
+    std::mutex probe_spiller_mutex;
+    std::unique_ptr<Spiller> probe_spiller;
+    /// Protect the state of the partition being restored, see `restorePartition`.
+    mutable std::mutex restore_mutex;
+    std::condition_variable restore_cv;
+    size_t next_restore_partition = 0;
+    /// The number of partitions that have been restored, including the final empty one.
+    size_t restored_rounds = 0;
+    bool is_restoring = false;
+    size_t active_restore_probe_concurrency = 0;
+    JoinPtr restore_join;
+    BlockInputStreams restore_probe_streams;
+
     size_t getBuildConcurrencyInternal() const
     {
         if (unlikely(build_concurrency == 0))
@@ -397,6 +493,8 @@ private:
     /// Throw an exception if blocks have different types of key columns.
     void checkTypesOfKeys(const Block & block_left, const Block & block_right) const;
 
+    void insertToRuntimeFilters(const Block & block);
+
     /** Add block of data from right hand of JOIN to the map.
       * Returns false, if some limit was exceeded and you should not insert more data.
       */
@@ -412,6 +510,28 @@ private:
     void handleOtherConditions(Block & block, std::unique_ptr<IColumn::Filter> & filter, std::unique_ptr<IColumn::Offsets> & offsets_to_replicate, const std::vector<size_t> & right_table_column) const;
 
 
+    /// Split the block into `spill_partition_num` blocks by the hash of the key columns.
+    Blocks partitionBlock(const Block & block, const Names & key_names) const;
+
+    void spillBuildBlock(const Block & block);
+
+    /// Spill all the build data in memory and reset the hash maps, must be called with the unique lock of rwlock.
+    void spillAllBuildData();
+
+    bool hasMeetError() const;
+    /// Must be called with restore_mutex held.
+    bool isRestorePartitionReadyNoLock(size_t restore_round) const;
+    /// Pick the next partition with spilled data and mark it restoring, return false if there is none.
+    /// Must be called with restore_mutex held.
+    bool nextRestorePartitionNoLock(size_t & partition_index);
+    /// Build a new Join and the probe streams from the spilled data of the partition.
+    void buildRestorePartition(size_t partition_index, const Block & probe_header, JoinPtr & join, BlockInputStreams & probe_streams);
+    /// Publish the restored partition, nullptr means all the partitions have been restored.
+    /// Must be called with restore_mutex held.
+    void setRestoredPartitionNoLock(JoinPtr && join, BlockInputStreams && probe_streams);
+    /// Build a new Join from the spilled build data of the partition.
+    JoinPtr buildRestoreJoin(size_t partition_index);
+
     template <ASTTableJoin::Kind KIND, ASTTableJoin::Strictness STRICTNESS>
     void joinBlockImplCross(Block & block) const;
 
@@ -419,7 +539,6 @@ private:
     void joinBlockImplCrossInternal(Block & block, ConstNullMapPtr null_map) const;
 };
 
-using JoinPtr = std::shared_ptr<Join>;
 using Joins = std::vector<JoinPtr>;
 
 struct ProbeProcessInfo
@@ -0,0 +1,237 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnsNumber.h>
+#include <Common/HashTable/Hash.h>
+#include <Common/TiFlashMetrics.h>
+#include <Functions/FunctionHelpers.h>
+#include <Interpreters/RuntimeFilter.h>
+#include <common/logger_useful.h>
+
+#include <algorithm>
+#include <array>
+
+namespace DB
+{
+namespace
+{
+constexpr size_t bloom_filter_hash_count = 3;
+
+/// Call `f` with the data of the column if it is a column of integers, return false otherwise.
+template <typename F>
+bool visitIntegerColumn(const IColumn & column, F && f)
+{
+    auto try_visit = [&](auto type_tag) {
+        using T = decltype(type_tag);
+        if (const auto * col = checkAndGetColumn<ColumnVector<T>>(&column))
+        {
+            f(col->getData());
+            return true;
+        }
+        return false;
+    };
+    return try_visit(Int8{}) || try_visit(Int16{}) || try_visit(Int32{}) || try_visit(Int64{})
+        || try_visit(UInt8{}) || try_visit(UInt16{}) || try_visit(UInt32{}) || try_visit(UInt64{});
+}
+
+/// Split the column into the nested column and the null map, if any.
+std::pair<const IColumn *, const NullMap *> getNestedColumnAndNullMap(const IColumn & column)
+{
+    if (const auto * nullable_column = checkAndGetColumn<ColumnNullable>(&column))
+        return {&nullable_column->getNestedColumn(), &nullable_column->getNullMapData()};
+    return {&column, nullptr};
+}
+
+size_t roundUpBloomFilterBits(size_t bits)
+{
+    size_t res = 64;
+    while (res < bits)
+        res <<= 1;
+    return res;
+}
+
+UInt64 hashValue(Int128 value)
+{
+    return intHash64(static_cast<UInt64>(value) ^ intHash64(static_cast<UInt64>(value >> 64)));
+}
+} // namespace
+
+RuntimeFilter::RuntimeFilter(
+    size_t build_key_index_,
+    Int64 target_column_id_,
+    size_t target_column_index_,
+    size_t max_in_values_,
+    size_t bloom_filter_bits_)
+    : build_key_index(build_key_index_)
+    , target_column_id(target_column_id_)
+    , target_column_index(target_column_index_)
+    , max_in_values(max_in_values_)
+    , bloom_filter_bits(roundUpBloomFilterBits(bloom_filter_bits_))
+{}
+
+void RuntimeFilter::insert(const ColumnWithTypeAndName & column)
+{
+    if (getStatus() != Status::Building)
+        return;
+
+    ColumnPtr full_column = column.column->convertToFullColumnIfConst();
+    auto [nested_column, null_map] = getNestedColumnAndNullMap(full_column ? *full_column : *column.column);
+
+    std::vector<Int128> values;
+    values.reserve(nested_column->size());
+    bool supported = visitIntegerColumn(*nested_column, [&](const auto & data) {
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            if (!null_map || !(*null_map)[i])
+                values.push_back(static_cast<Int128>(data[i]));
+        }
+    });
+    if (unlikely(!supported))
+    {
+        disable(fmt::format("unsupported join key type {}", column.type->getName()));
+        return;
+    }
+    if (values.empty())
+        return;
+
+    auto [min_it, max_it] = std::minmax_element(values.begin(), values.end());
+
+    std::lock_guard lock(mu);
+    if (getStatus() != Status::Building)
+        return;
+    min_value = rows == 0 ? *min_it : std::min(min_value, *min_it);
+    max_value = rows == 0 ? *max_it : std::max(max_value, *max_it);
+    rows += values.size();
+
+    size_t i = 0;
+    if (bloom_filter.empty())
+    {
+        for (; i < values.size() && in_values.size() <= max_in_values; ++i)
+            in_values.insert(values[i]);
+        if (in_values.size() <= max_in_values)
+            return;
+
+        /// Too many distinct values, switch to the bloom filter.
+        bloom_filter.assign(bloom_filter_bits / 64, 0);
+        for (const auto & value : in_values)
+            insertToBloomFilter(value);
+        in_values.clear();
+    }
+    for (; i < values.size(); ++i)
+        insertToBloomFilter(values[i]);
+}
+
+void RuntimeFilter::finalize()
+{
+    {
+        std::lock_guard lock(mu);
+        if (getStatus() != Status::Building)
+            return;
+        status.store(Status::Ready, std::memory_order_release);
+    }
+    cv.notify_all();
+    GET_METRIC(tiflash_runtime_filter, type_ready).Increment();
+}
+
+void RuntimeFilter::disable(const String & reason)
+{
+    {
+        std::lock_guard lock(mu);
+        if (getStatus() != Status::Building)
+            return;
+        disabled_reason = reason;
+        in_values.clear();
+        bloom_filter.clear();
+        status.store(Status::Disabled, std::memory_order_release);
+    }
+    cv.notify_all();
+    GET_METRIC(tiflash_runtime_filter, type_disabled).Increment();
+}
+
+bool RuntimeFilter::waitReady(UInt64 timeout_ms) const
+{
+    std::unique_lock lock(mu);
+    cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this] { return getStatus() != Status::Building; });
+    return getStatus() == Status::Ready;
+}
+
+void RuntimeFilter::insertToBloomFilter(Int128 value)
+{
+    UInt64 hash = hashValue(value);
+    UInt64 delta = intHash64(hash) | 1;
+    for (size_t k = 0; k < bloom_filter_hash_count; ++k)
+    {
+        size_t pos = (hash + k * delta) & (bloom_filter_bits - 1);
+        bloom_filter[pos / 64] |= (1ULL << (pos % 64));
+    }
+}
+
+bool RuntimeFilter::mayContain(Int128 value) const
+{
+    if (value < min_value || value > max_value)
+        return false;
+    if (hasInValues())
+        return in_values.count(value) > 0;
+
+    UInt64 hash = hashValue(value);
+    UInt64 delta = intHash64(hash) | 1;
+    for (size_t k = 0; k < bloom_filter_hash_count; ++k)
+    {
+        size_t pos = (hash + k * delta) & (bloom_filter_bits - 1);
+        if (!(bloom_filter[pos / 64] & (1ULL << (pos % 64))))
+            return false;
+    }
+    return true;
+}
+
+size_t RuntimeFilter::filterRows(const ColumnWithTypeAndName & column, IColumn::Filter & filter) const
+{
+    if (!isReady())
+        return 0;
+
+    ColumnPtr full_column = column.column->convertToFullColumnIfConst();
+    auto [nested_column, null_map] = getNestedColumnAndNullMap(full_column ? *full_column : *column.column);
+
+    size_t cleared = 0;
+    visitIntegerColumn(*nested_column, [&](const auto & data) {
+        assert(data.size() == filter.size());
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            if (!filter[i])
+                continue;
+            if ((null_map && (*null_map)[i]) || empty() || !mayContain(static_cast<Int128>(data[i])))
+            {
+                filter[i] = 0;
+                ++cleared;
+            }
+        }
+    });
+    return cleared;
+}
+
+String RuntimeFilter::toDebugString() const
+{
+    static constexpr std::array<const char *, 3> status_names{"building", "ready", "disabled"};
+    std::lock_guard lock(mu);
+    return fmt::format(
+        "{{build_key_index: {}, target_column_id: {}, status: {}, rows: {}, filter: {}{}}}",
+        build_key_index,
+        target_column_id,
+        status_names[static_cast<size_t>(getStatus())],
+        rows,
+        hasInValues() ? fmt::format("in_set({})", in_values.size()) : fmt::format("bloom({} bits)", bloom_filter_bits),
+        disabled_reason.empty() ? "" : fmt::format(", reason: {}", disabled_reason));
+}
+} // namespace DB
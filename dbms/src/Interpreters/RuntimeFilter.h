@@ -0,0 +1,117 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/IColumn.h>
+#include <Core/ColumnWithTypeAndName.h>
+#include <Core/Types.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace DB
+{
+class RuntimeFilter;
+using RuntimeFilterPtr = std::shared_ptr<RuntimeFilter>;
+using RuntimeFilters = std::vector<RuntimeFilterPtr>;
+
+/** A filter on one join key, built from the build side of a hash join and applied
+  * by the probe side table scan to skip packs and rows that can not match any build row.
+  *
+  * It keeps the min/max of the build keys, and the distinct build keys as an IN set
+  * while there are no more than `max_in_values` of them, or a bloom filter otherwise.
+  * Only integer join keys are supported, the values are kept as Int128 so that both
+  * signed and unsigned columns can be handled.
+  *
+  * The filter is registered before the join and the table scan are built (see
+  * `DAGContext::initRuntimeFilters`), so the scan may start reading before the filter
+  * is ready. The scan waits for it with a timeout and falls back to reading everything.
+  */
+class RuntimeFilter
+{
+public:
+    enum class Status
+    {
+        Building,
+        Ready,
+        Disabled,
+    };
+
+    RuntimeFilter(
+        size_t build_key_index_,
+        Int64 target_column_id_,
+        size_t target_column_index_,
+        size_t max_in_values_,
+        size_t bloom_filter_bits_);
+
+    /// Build side, `insert` can be called concurrently by the build streams.
+    void insert(const ColumnWithTypeAndName & column);
+    /// Called once all the build streams are finished.
+    void finalize();
+    /// Called if the build fails, the probe side will not wait for it any more.
+    void disable(const String & reason);
+
+    /// Probe side.
+    Status getStatus() const { return status.load(std::memory_order_acquire); }
+    bool isReady() const { return getStatus() == Status::Ready; }
+    /// Wait until the filter is not building any more or timeout, return whether it is ready.
+    bool waitReady(UInt64 timeout_ms) const;
+
+    /// Only valid after the filter is ready.
+    bool empty() const { return rows == 0; }
+    Int128 getMin() const { return min_value; }
+    Int128 getMax() const { return max_value; }
+    /// Whether the build keys are kept in the IN set.
+    bool hasInValues() const { return bloom_filter.empty(); }
+    const std::set<Int128> & getInValues() const { return in_values; }
+
+    /// Clear the bit of `filter` for the rows of `column` that can not match any build key.
+    /// NULL values never match. Return the number of rows that are cleared.
+    size_t filterRows(const ColumnWithTypeAndName & column, IColumn::Filter & filter) const;
+
+    String toDebugString() const;
+
+    /// The index of the join key in the build keys of the join.
+    const size_t build_key_index;
+    /// The column id of the probe side table scan column.
+    const Int64 target_column_id;
+    /// The index of the column in the output of the probe side table scan.
+    const size_t target_column_index;
+
+private:
+    void insertToBloomFilter(Int128 value);
+    bool mayContain(Int128 value) const;
+
+private:
+    const size_t max_in_values;
+    const size_t bloom_filter_bits;
+
+    mutable std::mutex mu;
+    mutable std::condition_variable cv;
+    std::atomic<Status> status{Status::Building};
+    String disabled_reason;
+
+    size_t rows = 0;
+    Int128 min_value = 0;
+    Int128 max_value = 0;
+    std::set<Int128> in_values;
+    /// Empty until the number of distinct values exceeds `max_in_values`.
+    std::vector<UInt64> bloom_filter;
+};
+} // namespace DB
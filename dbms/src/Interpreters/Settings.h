@@ -51,6 +51,9 @@ struct Settings
     M(SettingInt64, dag_records_per_chunk, DEFAULT_DAG_RECORDS_PER_CHUNK, "default chunk size of a DAG response.")                                                                                                                      \
     M(SettingInt64, batch_send_min_limit, DEFAULT_BATCH_SEND_MIN_LIMIT, "default minimal chunk size of exchanging data among TiFlash.")                                                                                                 \
     M(SettingInt64, batch_send_min_limit_compression, -1, "default minimal chunk size of exchanging data among TiFlash when using data compression.") \
+    M(SettingUInt64, mpp_exchange_adaptive_compression_bandwidth, 0, "The expected network bandwidth in MiB/s of each hash exchange sender. If it is not 0, the compression method of each " \
+                                                                     "tunnel is chosen by the sampled compression ratio and encode speed instead of the compression mode of the query.") \
+    M(SettingBool, mpp_exchange_lightweight_encoding, false, "Encode the columns of hash exchange with dictionary/RLE/delta/frame-of-reference encodings. It requires all TiFlash nodes to support MPPDataPacketV2.") \
     M(SettingInt64, schema_version, DEFAULT_UNSPECIFIED_SCHEMA_VERSION, "tmt schema version.")                                                                                                                                          \
     M(SettingUInt64, mpp_task_timeout, DEFAULT_MPP_TASK_TIMEOUT, "mpp task max endurable time.")                                                                                                                                        \
     M(SettingUInt64, mpp_task_running_timeout, DEFAULT_MPP_TASK_RUNNING_TIMEOUT, "mpp task max time that running without any progress.")                                                                                                \
@@ -172,6 +175,16 @@ struct Settings
                                                                                                                                                                                                                                         \
     M(SettingUInt64, max_bytes_before_external_sort, 0, "")                                                                                                                                                                             \
                                                                                                                                                                                                                                         \
+    M(SettingUInt64, max_bytes_before_external_join, 0, "Spill the hash join to disk once the build side data exceeds the bytes, 0 means disable spill.")                                                                               \
+    M(SettingUInt64, join_spill_partition_num, 16, "The number of partitions the spilled hash join data is split into, must be greater than 1.")                                                                                        \
+    M(SettingUInt64, max_bytes_before_external_window, 0, "Spill the window blocks of a large partition to disk once the blocks in memory exceed the bytes, 0 means disable spill.")                                                    \
+    M(SettingBool, enable_runtime_filter, false, "Build runtime filters from the join keys of the build side and apply them to the probe side table scan in the same MPP task.")                                                        \
+    M(SettingUInt64, runtime_filter_wait_time_ms, 1000, "The max time in milliseconds the probe side table scan waits for the runtime filters to be built.")                                                                            \
+    M(SettingUInt64, runtime_filter_max_in_values, 1024, "The max number of distinct build side keys kept as an IN set by a runtime filter, a bloom filter is used beyond it.")                                                         \
+    M(SettingUInt64, runtime_filter_bloom_filter_bits, 8388608, "The number of bits of the bloom filter of a runtime filter.")                                                                                                          \
+    M(SettingBool, enable_streaming_agg, true, "Aggregate in streaming mode, emitting every group once its key changes, when the input is a single table scan stream sorted by the group by key.")                                      \
+    M(SettingBool, enable_short_circuit_evaluation, true, "Evaluate the branches of and/or/if/multiIf lazily on the rows that need them in the expressions of the DAG request.")                                                        \
+                                                                                                                                                                                                                                        \
                                                                                                                                                                                                                                         \
     /* TODO: Check also when merging and finalizing aggregate functions. */                                                                                                                                                             \
                                                                                                                                                                                                                                         \
@@ -249,6 +262,8 @@ struct Settings
     M(SettingDouble, dt_page_gc_threshold, 0.5, "Max valid rate of deciding to do a GC in PageStorage")                                                                                                                                 \
     M(SettingBool, dt_enable_read_thread, true, "Enable storage read thread or not")                                                                                                                                                    \
     M(SettingBool, dt_enable_bitmap_filter, true, "Use bitmap filter to read data or not")                                                                                                                                              \
+    M(SettingBool, dt_enable_ngram_index, false, "Write a per-pack ngram index for string columns, so that LIKE filters can skip packs.")                                                                                               \
+    M(SettingBool, dt_enable_bloom_filter_index, false, "Write a per-pack bloom filter for integer and string columns, so that equal filters can skip packs.")                                                                          \
     M(SettingDouble, dt_read_thread_count_scale, 1.0, "Number of read thread = number of logical cpu cores * dt_read_thread_count_scale.  Only has meaning at server startup.")                                                                                               \
                                                                                                                                                                                                                                         \
     M(SettingChecksumAlgorithm, dt_checksum_algorithm, ChecksumAlgo::XXH3, "Checksum algorithm for delta tree stable storage")                                                                                                          \
@@ -283,6 +298,11 @@ struct Settings
     M(SettingUInt64, task_scheduler_thread_soft_limit, 5000, "The soft limit of threads for min_tso task scheduler.")                                                                                                                   \
     M(SettingUInt64, task_scheduler_thread_hard_limit, 10000, "The hard limit of threads for min_tso task scheduler.")                                                                                                                  \
     M(SettingUInt64, task_scheduler_active_set_soft_limit, 0, "The soft limit of count of active query set for min_tso task scheduler.")                                                                                                \
+    M(SettingUInt64, task_scheduler_memory_soft_limit, 0, "The soft limit of estimated memory usage in bytes for min_tso task scheduler, 0 means unlimited.")                                                                           \
+    M(SettingUInt64, task_scheduler_memory_hard_limit, 0, "The hard limit of estimated memory usage in bytes for min_tso task scheduler, 0 means unlimited.")                                                                           \
+    M(SettingBool, task_scheduler_enable_fair_share, false, "Whether to limit a query to its fair share of the soft limits for min_tso task scheduler when other queries are waiting.")                                                 \
+    M(SettingUInt64, task_scheduler_estimated_memory_per_thread, 8388608, "The estimated memory usage of each thread of a MPP task for min_tso task scheduler.")                                                                        \
+    M(SettingUInt64, task_scheduler_estimated_memory_per_stateful_executor, 268435456, "The estimated memory usage of each join/agg/sort/window executor without spill threshold for min_tso task scheduler.")                          \
     M(SettingUInt64, max_grpc_pollers, 200, "The maximum number of grpc thread pool's non-temporary threads, better tune it up to avoid frequent creation/destruction of threads.")                                                     \
     M(SettingBool, enable_elastic_threadpool, true, "Enable elastic thread pool for thread create usages.")                                                                                                                             \
     M(SettingUInt64, elastic_threadpool_init_cap, 400, "The size of elastic thread pool.")                                                                                                                                              \
@@ -305,6 +325,7 @@ struct Settings
     M(SettingBool, enable_planner, true, "Enable planner")                                                                                                                                                                              \
     M(SettingBool, enable_pipeline, false, "Enable pipeline model")                                                                                                                                                                     \
     M(SettingUInt64, pipeline_task_thread_pool_size, 0, "The size of task thread pool. 0 means using number_of_logical_cpu_cores.") \
+    M(SettingString, pipeline_task_queue_type, "fifo", "The task queue of task thread pool, fifo, mlfq(multi-level feedback queue) or work_stealing.") \
     M(SettingUInt64, local_tunnel_version, 1, "1: not refined, 2: refined")
 // clang-format on
 #define DECLARE(TYPE, NAME, DEFAULT, DESCRIPTION) TYPE NAME{DEFAULT};
@@ -0,0 +1,132 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Functions/FunctionFactory.h>
+#include <Functions/registerFunctions.h>
+#include <Interpreters/ExpressionActions.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+
+namespace DB
+{
+namespace tests
+{
+/// Compare the eager and the short-circuit evaluation of `and(k < selectivity, regexp(...))` and
+/// `multiIf(k < selectivity, json_unquote(...), ...)`, where k is uniformly distributed in [0, 100).
+/// The first argument of a benchmark is the percentage of rows that need the expensive branch,
+/// the second one is whether short-circuit evaluation is enabled.
+class ShortCircuitExpressionBench : public benchmark::Fixture
+{
+public:
+    static constexpr size_t rows = 8192;
+
+    ColumnsWithTypeAndName input;
+    NamesAndTypes input_types;
+
+    void SetUp(const benchmark::State &) override
+    {
+        try
+        {
+            DB::registerFunctions();
+        }
+        catch (DB::Exception &)
+        {
+            // Maybe another test has already registered, ignore exception here.
+        }
+
+        std::vector<Int64> k(rows);
+        std::vector<String> s(rows);
+        std::vector<String> j(rows);
+        for (size_t i = 0; i < rows; ++i)
+        {
+            k[i] = (i * 37) % 100;
+            s[i] = fmt::format("user_{}@example.com/path/to/resource/{}?q={}", i, i * 7, i % 13);
+            j[i] = fmt::format(R"("name\t{}é\n\"quoted\" value with some escaped \\ characters 中文 {}")", i, i * 3);
+        }
+        input = {
+            createColumn<Int64>(k, "k"),
+            createColumn<String>(s, "s"),
+            createColumn<String>(j, "j"),
+        };
+        input_types.clear();
+        for (const auto & column : input)
+            input_types.emplace_back(column.name, column.type);
+    }
+
+    static String apply(const Context & context, const ExpressionActionsPtr & actions, const String & name, const Names & arguments)
+    {
+        auto action = ExpressionAction::applyFunction(FunctionFactory::instance().get(name, context), arguments);
+        actions->add(action);
+        return action.result_name;
+    }
+
+    static String literal(const ExpressionActionsPtr & actions, const ColumnWithTypeAndName & column)
+    {
+        actions->add(ExpressionAction::addColumn(column));
+        return column.name;
+    }
+
+    void run(benchmark::State & state, const std::function<String(const Context &, const ExpressionActionsPtr &, Int64)> & builder)
+    {
+        auto context = TiFlashTestEnv::getContext();
+        auto dag_context_ptr = std::make_unique<DAGContext>(1024);
+        context.setDAGContext(dag_context_ptr.get());
+
+        auto actions = std::make_shared<ExpressionActions>(input_types);
+        String result = builder(context, actions, state.range(0));
+        actions->finalize({result}, state.range(1));
+
+        for (auto _ : state)
+        {
+            Block block(input);
+            actions->execute(block);
+            benchmark::DoNotOptimize(block);
+        }
+        state.SetItemsProcessed(state.iterations() * rows);
+    }
+};
+
+BENCHMARK_DEFINE_F(ShortCircuitExpressionBench, regexpAnd)
+(benchmark::State & state)
+try
+{
+    run(state, [](const Context & context, const ExpressionActionsPtr & actions, Int64 selectivity) {
+        auto cond = apply(context, actions, "less", {"k", literal(actions, createConstColumn<Int64>(1, selectivity, "selectivity"))});
+        auto pattern = literal(actions, createConstColumn<String>(1, "^user_[0-9]*7@.*/resource/[0-9]+\\?q=(1|3|5)$", "pattern"));
+        auto match = apply(context, actions, "regexp", {"s", pattern});
+        return apply(context, actions, "and", {cond, match});
+    });
+}
+CATCH
+
+BENCHMARK_DEFINE_F(ShortCircuitExpressionBench, jsonMultiIf)
+(benchmark::State & state)
+try
+{
+    run(state, [](const Context & context, const ExpressionActionsPtr & actions, Int64 selectivity) {
+        auto cond = apply(context, actions, "less", {"k", literal(actions, createConstColumn<Int64>(1, selectivity, "selectivity"))});
+        auto unquoted = apply(context, actions, "json_unquote", {"j"});
+        return apply(context, actions, "multiIf", {cond, unquoted, "s"});
+    });
+}
+CATCH
+
+BENCHMARK_REGISTER_F(ShortCircuitExpressionBench, regexpAnd)
+    ->ArgsProduct({{1, 10, 50, 90, 100}, {0, 1}});
+BENCHMARK_REGISTER_F(ShortCircuitExpressionBench, jsonMultiIf)
+    ->ArgsProduct({{1, 10, 50, 90, 100}, {0, 1}});
+
+} // namespace tests
+} // namespace DB
@@ -0,0 +1,147 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Interpreters/RuntimeFilter.h>
+#include <TestUtils/FunctionTestUtils.h>
+
+#include <thread>
+
+namespace DB
+{
+namespace tests
+{
+namespace
+{
+IColumn::Filter filterOf(const RuntimeFilter & runtime_filter, const ColumnWithTypeAndName & column, size_t & cleared)
+{
+    IColumn::Filter filter(column.column->size(), 1);
+    cleared = runtime_filter.filterRows(column, filter);
+    return filter;
+}
+} // namespace
+
+TEST(RuntimeFilterTest, InSet)
+try
+{
+    RuntimeFilter runtime_filter(0, 1, 0, 16, 1024);
+    runtime_filter.insert(createColumn<Int64>({1, 5}));
+    runtime_filter.insert(createColumn<Nullable<Int64>>({3, {}, 5}));
+
+    auto probe = createColumn<Nullable<Int32>>({1, 2, 3, {}, 5, 6, -1});
+    size_t cleared = 0;
+    // Nothing is filtered before the runtime filter is ready.
+    ASSERT_EQ(filterOf(runtime_filter, probe, cleared), IColumn::Filter(7, 1));
+    ASSERT_EQ(cleared, 0);
+
+    runtime_filter.finalize();
+    ASSERT_TRUE(runtime_filter.isReady());
+    ASSERT_TRUE(runtime_filter.hasInValues());
+    ASSERT_EQ(runtime_filter.getInValues().size(), 3);
+    ASSERT_TRUE(runtime_filter.getMin() == 1);
+    ASSERT_TRUE(runtime_filter.getMax() == 5);
+    ASSERT_EQ(filterOf(runtime_filter, probe, cleared), IColumn::Filter({1, 0, 1, 0, 1, 0, 0}));
+    ASSERT_EQ(cleared, 4);
+
+    // Unsigned probe column.
+    auto unsigned_probe = createColumn<UInt64>({5, 4, 3, 18446744073709551615ULL});
+    ASSERT_EQ(filterOf(runtime_filter, unsigned_probe, cleared), IColumn::Filter({1, 0, 1, 0}));
+    ASSERT_EQ(cleared, 2);
+
+    // Inserting after ready is ignored.
+    runtime_filter.insert(createColumn<Int64>({2}));
+    ASSERT_EQ(runtime_filter.getInValues().size(), 3);
+}
+CATCH
+
+TEST(RuntimeFilterTest, BloomFilter)
+try
+{
+    RuntimeFilter runtime_filter(0, 1, 0, 4, 1 << 16);
+    std::vector<Int64> build_keys;
+    for (Int64 i = 0; i < 2000; i += 2)
+        build_keys.push_back(i);
+    runtime_filter.insert(createColumn<Int64>(build_keys));
+    runtime_filter.finalize();
+    ASSERT_FALSE(runtime_filter.hasInValues());
+    ASSERT_TRUE(runtime_filter.getMin() == 0);
+    ASSERT_TRUE(runtime_filter.getMax() == 1998);
+
+    // No false negative.
+    size_t cleared = 0;
+    ASSERT_EQ(filterOf(runtime_filter, createColumn<Int64>(build_keys), cleared), IColumn::Filter(build_keys.size(), 1));
+    ASSERT_EQ(cleared, 0);
+
+    // Values out of [min, max] are always filtered, and few false positive for the others.
+    std::vector<Int64> probe_keys;
+    for (Int64 i = -999; i < 3000; i += 2)
+        probe_keys.push_back(i);
+    filterOf(runtime_filter, createColumn<Int64>(probe_keys), cleared);
+    ASSERT_GE(cleared, probe_keys.size() - 50);
+}
+CATCH
+
+TEST(RuntimeFilterTest, EmptyBuildSide)
+try
+{
+    RuntimeFilter runtime_filter(0, 1, 0, 16, 1024);
+    runtime_filter.insert(createColumn<Nullable<Int64>>({{}, {}}));
+    runtime_filter.finalize();
+    ASSERT_TRUE(runtime_filter.empty());
+
+    size_t cleared = 0;
+    ASSERT_EQ(filterOf(runtime_filter, createColumn<Int64>({0, 1, 2}), cleared), IColumn::Filter(3, 0));
+    ASSERT_EQ(cleared, 3);
+}
+CATCH
+
+TEST(RuntimeFilterTest, WaitReady)
+try
+{
+    {
+        RuntimeFilter runtime_filter(0, 1, 0, 16, 1024);
+        ASSERT_FALSE(runtime_filter.waitReady(10));
+        ASSERT_EQ(runtime_filter.getStatus(), RuntimeFilter::Status::Building);
+
+        std::thread builder([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            runtime_filter.insert(createColumn<Int64>({1}));
+            runtime_filter.finalize();
+        });
+        ASSERT_TRUE(runtime_filter.waitReady(60000));
+        builder.join();
+    }
+    {
+        RuntimeFilter runtime_filter(0, 1, 0, 16, 1024);
+        runtime_filter.insert(createColumn<Int64>({1}));
+        runtime_filter.disable("build side failed");
+        ASSERT_FALSE(runtime_filter.waitReady(60000));
+        ASSERT_EQ(runtime_filter.getStatus(), RuntimeFilter::Status::Disabled);
+
+        // A disabled filter never filters anything, and can not be finalized any more.
+        runtime_filter.finalize();
+        size_t cleared = 0;
+        ASSERT_EQ(filterOf(runtime_filter, createColumn<Int64>({0, 1, 2}), cleared), IColumn::Filter(3, 1));
+        ASSERT_EQ(cleared, 0);
+    }
+    {
+        // Unsupported join key type disables the filter.
+        RuntimeFilter runtime_filter(0, 1, 0, 16, 1024);
+        runtime_filter.insert(createColumn<String>({"a"}));
+        ASSERT_EQ(runtime_filter.getStatus(), RuntimeFilter::Status::Disabled);
+    }
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
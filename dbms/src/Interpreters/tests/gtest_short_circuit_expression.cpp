@@ -0,0 +1,221 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Functions/FunctionFactory.h>
+#include <Interpreters/ExpressionActions.h>
+#include <TestUtils/FunctionTestUtils.h>
+
+namespace DB
+{
+namespace tests
+{
+class ShortCircuitExpressionTest : public FunctionTest
+{
+protected:
+    static constexpr size_t rows = 1000;
+
+    ColumnsWithTypeAndName input;
+    NamesAndTypes input_types;
+    size_t const_id = 0;
+
+    void SetUp() override
+    {
+        FunctionTest::SetUp();
+
+        std::vector<std::optional<Int64>> a(rows);
+        std::vector<Int64> b(rows);
+        std::vector<String> s(rows);
+        for (size_t i = 0; i < rows; ++i)
+        {
+            if (i % 7 != 3)
+                a[i] = static_cast<Int64>(i % 100) - 20;
+            b[i] = i % 3;
+            s[i] = (i % 3 == 0 ? "a" : "b") + std::to_string(i) + (i % 4 == 0 ? "b" : "c");
+        }
+        input = {
+            createColumn<Nullable<Int64>>(a, "a"),
+            createColumn<Int64>(b, "b"),
+            createColumn<String>(s, "s"),
+        };
+        for (const auto & column : input)
+            input_types.emplace_back(column.name, column.type);
+    }
+
+    String apply(const ExpressionActionsPtr & actions, const String & name, const Names & arguments)
+    {
+        auto action = ExpressionAction::applyFunction(FunctionFactory::instance().get(name, context), arguments);
+        actions->add(action);
+        return action.result_name;
+    }
+
+    template <typename T>
+    String literal(const ExpressionActionsPtr & actions, const InferredFieldType<T> & value)
+    {
+        auto column = createConstColumn<T>(1, value, fmt::format("literal_{}", const_id++));
+        actions->add(ExpressionAction::addColumn(column));
+        return column.name;
+    }
+
+    using ExpressionBuilder = std::function<Names(const ExpressionActionsPtr &)>;
+
+    ExpressionActionsPtr build(const ExpressionBuilder & builder, bool enable_short_circuit)
+    {
+        const_id = 0;
+        auto actions = std::make_shared<ExpressionActions>(input_types);
+        Names outputs = builder(actions);
+        actions->finalize(outputs, enable_short_circuit);
+        return actions;
+    }
+
+    static bool hasLazyArguments(const ExpressionActionsPtr & actions)
+    {
+        for (const auto & action : actions->getActions())
+        {
+            if (!action.lazy_arguments.empty())
+                return true;
+        }
+        return false;
+    }
+
+    /// Execute the expression with and without short-circuit evaluation, and check that the results are the same.
+    void checkSameAsEager(const ExpressionBuilder & builder, bool expect_lazy = true)
+    {
+        auto lazy_actions = build(builder, true);
+        auto eager_actions = build(builder, false);
+        ASSERT_EQ(hasLazyArguments(lazy_actions), expect_lazy) << lazy_actions->dumpActions();
+        ASSERT_FALSE(hasLazyArguments(eager_actions));
+
+        for (size_t limit : {rows, static_cast<size_t>(10), static_cast<size_t>(1), static_cast<size_t>(0)})
+        {
+            Block lazy_block;
+            for (const auto & column : input)
+                lazy_block.insert({column.column->cut(0, limit), column.type, column.name});
+            Block eager_block = lazy_block;
+
+            lazy_actions->execute(lazy_block);
+            eager_actions->execute(eager_block);
+            ASSERT_EQ(lazy_block.columns(), eager_block.columns());
+            for (const auto & column : eager_block)
+                ASSERT_COLUMN_EQ(column, lazy_block.getByName(column.name));
+        }
+    }
+};
+
+TEST_F(ShortCircuitExpressionTest, And)
+try
+{
+    checkSameAsEager([&](const ExpressionActionsPtr & actions) -> Names {
+        auto cond = apply(actions, "greater", {"a", literal<Int64>(actions, 30)});
+        auto like = apply(actions, "regexp", {"s", literal<String>(actions, "^a.*b$")});
+        return {apply(actions, "and", {cond, like})};
+    });
+    checkSameAsEager([&](const ExpressionActionsPtr & actions) -> Names {
+        auto cond1 = apply(actions, "less", {"a", literal<Int64>(actions, 10)});
+        auto cond2 = apply(actions, "notEquals", {"b", literal<Int64>(actions, 2)});
+        auto like = apply(actions, "regexp", {"s", literal<String>(actions, "1")});
+        return {apply(actions, "and", {cond1, cond2, like})};
+    });
+}
+CATCH
+
+TEST_F(ShortCircuitExpressionTest, Or)
+try
+{
+    checkSameAsEager([&](const ExpressionActionsPtr & actions) -> Names {
+        auto cond = apply(actions, "isNull", {"a"});
+        auto like = apply(actions, "regexp", {"s", literal<String>(actions, "^b")});
+        return {apply(actions, "or", {cond, like})};
+    });
+    /// Nested short-circuit functions.
+    checkSameAsEager([&](const ExpressionActionsPtr & actions) -> Names {
+        auto cond1 = apply(actions, "greater", {"a", literal<Int64>(actions, 50)});
+        auto cond2 = apply(actions, "equals", {"b", literal<Int64>(actions, 1)});
+        auto like = apply(actions, "regexp", {"s", literal<String>(actions, "c$")});
+        return {apply(actions, "or", {cond1, apply(actions, "and", {cond2, like})})};
+    });
+}
+CATCH
+
+TEST_F(ShortCircuitExpressionTest, MultiIf)
+try
+{
+    checkSameAsEager([&](const ExpressionActionsPtr & actions) -> Names {
+        auto cond1 = apply(actions, "greater", {"a", literal<Int64>(actions, 50)});
+        auto then1 = apply(actions, "plus", {"a", "b"});
+        auto cond2 = apply(actions, "regexp", {"s", literal<String>(actions, "^a")});
+        auto then2 = apply(actions, "multiply", {"a", literal<Int64>(actions, 2)});
+        auto otherwise = apply(actions, "minus", {"b", literal<Int64>(actions, 1)});
+        return {apply(actions, "multiIf", {cond1, then1, cond2, then2, otherwise})};
+    });
+    checkSameAsEager([&](const ExpressionActionsPtr & actions) -> Names {
+        auto cond = apply(actions, "isNull", {"a"});
+        auto then = apply(actions, "plus", {"b", literal<Int64>(actions, 1)});
+        auto otherwise = apply(actions, "assumeNotNull", {"a"});
+        return {apply(actions, "multiIf", {cond, then, otherwise})};
+    });
+}
+CATCH
+
+TEST_F(ShortCircuitExpressionTest, SharedArgument)
+try
+{
+    /// The branch is also an output column, so it must be computed for every row.
+    checkSameAsEager(
+        [&](const ExpressionActionsPtr & actions) -> Names {
+            auto cond = apply(actions, "greater", {"a", literal<Int64>(actions, 30)});
+            auto like = apply(actions, "regexp", {"s", literal<String>(actions, "^a.*b$")});
+            return {apply(actions, "and", {cond, like}), like};
+        },
+        false);
+    /// The branch is used by another function outside of the short-circuit function.
+    checkSameAsEager(
+        [&](const ExpressionActionsPtr & actions) -> Names {
+            auto sum = apply(actions, "plus", {"a", "b"});
+            auto cond = apply(actions, "greater", {"b", literal<Int64>(actions, 2)});
+            auto then = apply(actions, "multiply", {"b", "b"});
+            return {apply(actions, "multiIf", {cond, sum, then}), apply(actions, "minus", {sum, "b"})};
+        },
+        true);
+}
+CATCH
+
+TEST_F(ShortCircuitExpressionTest, SkipRowsThatDoNotNeedBranch)
+try
+{
+    /// intDiv throws on division by zero, so it must only be computed on the rows with non zero divisor.
+    /// One third of the divisors are zero, so the branch is computed on a filtered sub block.
+    auto builder = [&](const ExpressionActionsPtr & actions) -> Names {
+        auto cond = apply(actions, "notEquals", {"b", literal<Int64>(actions, 0)});
+        auto quotient = apply(actions, "intDiv", {literal<Int64>(actions, 100), "b"});
+        return {apply(actions, "multiIf", {cond, quotient, literal<Int64>(actions, -1)})};
+    };
+    auto lazy_actions = build(builder, true);
+    auto eager_actions = build(builder, false);
+
+    Block block(input);
+    ASSERT_THROW(eager_actions->execute(block), Exception);
+
+    block = Block(input);
+    lazy_actions->execute(block);
+    const auto & result = *block.getByPosition(block.columns() - 1).column;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        Int64 b = i % 3;
+        ASSERT_EQ(result.getInt(i), b == 0 ? -1 : 100 / b);
+    }
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
@@ -0,0 +1,36 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Operators/AggregateBuildSinkOp.h>
+
+namespace DB
+{
+OperatorStatus AggregateBuildSinkOp::writeImpl(Block && block)
+{
+    if (unlikely(!block))
+    {
+        agg_context->finishBuild(index);
+        return OperatorStatus::FINISHED;
+    }
+    total_rows += block.rows();
+    agg_context->executeOnBlock(index, block);
+    return OperatorStatus::NEED_INPUT;
+}
+
+void AggregateBuildSinkOp::operateSuffix()
+{
+    LOG_DEBUG(log, "finish build with {} rows", total_rows);
+}
+} // namespace DB
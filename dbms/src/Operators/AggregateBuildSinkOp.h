@@ -0,0 +1,57 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <Operators/AggregateContext.h>
+#include <Operators/Operator.h>
+
+namespace DB
+{
+// The sink operator of the aggregation build pipeline.
+// Each AggregateBuildSinkOp owns an `AggregatedDataVariants` in AggregateContext and aggregates its input locally.
+class AggregateBuildSinkOp : public SinkOp
+{
+public:
+    AggregateBuildSinkOp(
+        PipelineExecutorStatus & exec_status_,
+        size_t index_,
+        AggregateContextPtr agg_context_,
+        const String & req_id)
+        : SinkOp(exec_status_)
+        , index(index_)
+        , agg_context(agg_context_)
+        , log(Logger::get(req_id))
+    {
+    }
+
+    String getName() const override
+    {
+        return "AggregateBuildSinkOp";
+    }
+
+protected:
+    OperatorStatus writeImpl(Block && block) override;
+
+    void operateSuffix() override;
+
+private:
+    size_t index{};
+    uint64_t total_rows{};
+    AggregateContextPtr agg_context;
+    const LoggerPtr log;
+};
+} // namespace DB
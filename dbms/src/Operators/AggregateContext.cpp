@@ -0,0 +1,168 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <DataStreams/MergingAggregatedMemoryEfficientBlockInputStream.h>
+#include <Operators/AggregateContext.h>
+
+#include <magic_enum.hpp>
+
+namespace DB
+{
+void AggregateContext::initBuild(
+    const Aggregator::Params & params_,
+    size_t max_threads_,
+    size_t temporary_data_merge_threads_,
+    Aggregator::CancellationHook && hook)
+{
+    RUNTIME_CHECK(status.load() == AggStatus::init);
+    params = std::make_unique<Aggregator::Params>(params_);
+    aggregator = std::make_unique<Aggregator>(*params, log->identifier());
+    aggregator->setCancellationHook(std::move(hook));
+    max_threads = max_threads_;
+    temporary_data_merge_threads = temporary_data_merge_threads_;
+    RUNTIME_CHECK(max_threads > 0);
+    for (size_t i = 0; i < max_threads; ++i)
+    {
+        threads_data.emplace_back(params->keys_size, params->aggregates_size);
+        many_data.emplace_back(std::make_shared<AggregatedDataVariants>());
+    }
+    aggregator->initThresholdByAggregatedDataVariantsSize(many_data.size());
+    status = AggStatus::build;
+    LOG_TRACE(log, "Aggregate context inited with max_threads: {}", max_threads);
+}
+
+void AggregateContext::executeOnBlock(size_t task_index, const Block & block)
+{
+    assert(status.load() == AggStatus::build);
+    assert(task_index < max_threads);
+    aggregator->executeOnBlock(
+        block,
+        *many_data[task_index],
+        threads_data[task_index].key_columns,
+        threads_data[task_index].aggregate_columns);
+    threads_data[task_index].src_rows += block.rows();
+    threads_data[task_index].src_bytes += block.bytes();
+}
+
+void AggregateContext::finishBuild(size_t task_index)
+{
+    assert(status.load() == AggStatus::build);
+    assert(task_index < max_threads);
+    if (aggregator->hasSpilledData())
+    {
+        /// Flush data in the RAM to disk. So it's easier to unite them later.
+        auto & data = *many_data[task_index];
+        if (data.isConvertibleToTwoLevel())
+            data.convertToTwoLevel();
+        if (!data.empty())
+            aggregator->spill(data);
+    }
+}
+
+void AggregateContext::initConvergent()
+{
+    RUNTIME_CHECK(status.load() == AggStatus::build);
+
+    size_t total_src_rows = 0;
+    size_t total_src_bytes = 0;
+    for (const auto & thread_data : threads_data)
+    {
+        total_src_rows += thread_data.src_rows;
+        total_src_bytes += thread_data.src_bytes;
+    }
+    LOG_TRACE(
+        log,
+        "Total aggregated {} rows (from {:.3f} MiB)",
+        total_src_rows,
+        (total_src_bytes / 1048576.0));
+
+    if (aggregator->hasSpilledData())
+    {
+        initConvergentForSpilledData();
+        return;
+    }
+
+    /// If there was no data, and we aggregate without keys, we must return single row with the result of empty aggregation.
+    /// To do this, we pass a block with zero rows to aggregate.
+    if (total_src_rows == 0 && params->keys_size == 0 && !params->empty_result_for_aggregation_by_empty_set)
+        aggregator->executeOnBlock(
+            params->src_header,
+            *many_data[0],
+            threads_data[0].key_columns,
+            threads_data[0].aggregate_columns);
+
+    merging_buckets = aggregator->mergeAndConvertToBlocks(many_data, /*final=*/true, max_threads);
+    status = AggStatus::convergent;
+}
+
+void AggregateContext::initConvergentForSpilledData()
+{
+    /// It may happen that some data has not yet been flushed,
+    /// because at the time of `finishBuild` call, no data has been flushed to disk, and then some were.
+    for (auto & data : many_data)
+    {
+        if (data->isConvertibleToTwoLevel())
+            data->convertToTwoLevel();
+        if (!data->empty())
+            aggregator->spill(*data);
+    }
+    aggregator->finishSpill();
+    // TODO merge the restored data in a non-blocking way.
+    restore_stream = std::make_unique<MergingAggregatedMemoryEfficientBlockInputStream>(
+        aggregator->restoreSpilledData(),
+        *params,
+        /*final=*/true,
+        temporary_data_merge_threads,
+        temporary_data_merge_threads,
+        log->identifier());
+    status = AggStatus::restore;
+}
+
+size_t AggregateContext::getConvergentConcurrency()
+{
+    switch (status.load())
+    {
+    case AggStatus::convergent:
+        return merging_buckets ? merging_buckets->getConcurrency() : 1;
+    case AggStatus::restore:
+        // The restore stream does the parallel merging by itself.
+        return 1;
+    default:
+        throw Exception(fmt::format("Unexpected aggregate context status {} for convergent", magic_enum::enum_name(status.load())));
+    }
+}
+
+Block AggregateContext::readForConvergent(size_t index)
+{
+    switch (status.load())
+    {
+    case AggStatus::convergent:
+        if (unlikely(!merging_buckets))
+            return {};
+        return merging_buckets->getData(index);
+    case AggStatus::restore:
+        assert(index == 0);
+        return restore_stream->read();
+    default:
+        throw Exception(fmt::format("Unexpected aggregate context status {} for convergent", magic_enum::enum_name(status.load())));
+    }
+}
+
+Block AggregateContext::getHeader() const
+{
+    assert(aggregator);
+    return aggregator->getHeader(/*final=*/true);
+}
+} // namespace DB
@@ -0,0 +1,105 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <DataStreams/IBlockInputStream.h>
+#include <Interpreters/Aggregator.h>
+
+namespace DB
+{
+/// Shared state of the two pipelines of a hash aggregation.
+/// - In the build stage, every AggregateBuildSinkOp aggregates its input into its own `AggregatedDataVariants`.
+/// - In the convergent stage, the partial results are merged and converted to blocks by AggregateConvergentSourceOps.
+///   For two-level hash tables, the buckets are merged in parallel.
+class AggregateContext
+{
+public:
+    explicit AggregateContext(const String & req_id)
+        : log(Logger::get(req_id))
+    {}
+
+    void initBuild(
+        const Aggregator::Params & params,
+        size_t max_threads_,
+        size_t temporary_data_merge_threads_,
+        Aggregator::CancellationHook && hook);
+
+    size_t getBuildConcurrency() const { return max_threads; }
+
+    void executeOnBlock(size_t task_index, const Block & block);
+
+    /// Called by each build task after all of its input blocks have been processed.
+    void finishBuild(size_t task_index);
+
+    void initConvergent();
+
+    size_t getConvergentConcurrency();
+
+    Block readForConvergent(size_t index);
+
+    Block getHeader() const;
+
+private:
+    void initConvergentForSpilledData();
+
+private:
+    struct ThreadData
+    {
+        size_t src_rows = 0;
+        size_t src_bytes = 0;
+
+        ColumnRawPtrs key_columns;
+        Aggregator::AggregateColumns aggregate_columns;
+
+        ThreadData(size_t keys_size, size_t aggregates_size)
+        {
+            key_columns.resize(keys_size);
+            aggregate_columns.resize(aggregates_size);
+        }
+    };
+
+    /**
+     * init────►build───┬───►convergent
+     *                  │
+     *                  └───►restore (when the aggregator has spilled data)
+     */
+    enum class AggStatus
+    {
+        init,
+        build,
+        convergent,
+        restore,
+    };
+    std::atomic<AggStatus> status{AggStatus::init};
+
+    std::unique_ptr<Aggregator::Params> params;
+    std::unique_ptr<Aggregator> aggregator;
+
+    ManyAggregatedDataVariants many_data;
+    std::vector<ThreadData> threads_data;
+    size_t max_threads{};
+
+    MergingBucketsPtr merging_buckets;
+
+    // Only used when the aggregator has spilled data.
+    std::unique_ptr<IBlockInputStream> restore_stream;
+    size_t temporary_data_merge_threads{};
+
+    const LoggerPtr log;
+};
+using AggregateContextPtr = std::shared_ptr<AggregateContext>;
+} // namespace DB
@@ -0,0 +1,44 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Operators/AggregateConvergentSourceOp.h>
+
+namespace DB
+{
+AggregateConvergentSourceOp::AggregateConvergentSourceOp(
+    PipelineExecutorStatus & exec_status_,
+    const AggregateContextPtr & agg_context_,
+    size_t index_,
+    const String & req_id)
+    : SourceOp(exec_status_)
+    , agg_context(agg_context_)
+    , index(index_)
+    , log(Logger::get(req_id))
+{
+    setHeader(agg_context->getHeader());
+}
+
+OperatorStatus AggregateConvergentSourceOp::readImpl(Block & block)
+{
+    block = agg_context->readForConvergent(index);
+    total_rows += block.rows();
+    return OperatorStatus::HAS_OUTPUT;
+}
+
+void AggregateConvergentSourceOp::operateSuffix()
+{
+    LOG_DEBUG(log, "finish read {} rows from aggregate context", total_rows);
+}
+} // namespace DB
@@ -0,0 +1,233 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Operators/HashJoinProbeTransformOp.h>
+
+namespace DB
+{
+HashJoinProbeTransformOp::HashJoinProbeTransformOp(
+    PipelineExecutorStatus & exec_status_,
+    const String & req_id,
+    const JoinPtr & join_,
+    size_t probe_index_,
+    size_t max_block_size,
+    const Block & input_header)
+    : TransformOp(exec_status_)
+    , join(join_)
+    , probe_index(probe_index_)
+    , probe_process_info(max_block_size)
+    , probe_header(input_header.cloneEmpty())
+    , log(Logger::get(req_id))
+{
+    RUNTIME_CHECK_MSG(join != nullptr, "join ptr should not be null.");
+    RUNTIME_CHECK_MSG(join->getProbeConcurrency() > 0, "Join probe concurrency must be greater than 0");
+    if (join->needReturnNonJoinedData())
+        non_joined_stream = join->createStreamWithNonJoinedRows(input_header, probe_index, join->getProbeConcurrency(), max_block_size);
+}
+
+void HashJoinProbeTransformOp::transformHeaderImpl(Block & header_)
+{
+    assert(header_.rows() == 0);
+    ProbeProcessInfo header_probe_process_info(0);
+    header_probe_process_info.resetBlock(std::move(header_));
+    header_ = join->joinBlock(header_probe_process_info);
+}
+
+void HashJoinProbeTransformOp::operateSuffix()
+{
+    LOG_DEBUG(log, "Finish join probe, total output rows {}, joined rows {}, non joined rows {}", joined_rows + non_joined_rows, joined_rows, non_joined_rows);
+}
+
+OperatorStatus HashJoinProbeTransformOp::onOutput(Block & block)
+{
+    if (join->isSpilled())
+    {
+        // The probe block will be joined after the spilled partitions are restored.
+        join->spillProbeBlock(probe_process_info.block);
+        probe_process_info.all_rows_joined_finish = true;
+        return OperatorStatus::NEED_INPUT;
+    }
+    block = join->joinBlock(probe_process_info);
+    joined_rows += block.rows();
+    return OperatorStatus::HAS_OUTPUT;
+}
+
+OperatorStatus HashJoinProbeTransformOp::onProbeFinish(Block & block)
+{
+    assert(status == ProbeStatus::PROBE);
+    assert(!block);
+    join->finishOneProbe();
+    if (join->needReturnNonJoinedData() || join->isEnableSpill())
+    {
+        // The non-joined data can only be read after all probe operators finish,
+        // and whether the join is spilled is only known after all build finish, see `awaitImpl`.
+        status = ProbeStatus::WAIT_FOR_READ_NON_JOINED_DATA;
+        return OperatorStatus::WAITING;
+    }
+    status = ProbeStatus::FINISHED;
+    return OperatorStatus::HAS_OUTPUT;
+}
+
+OperatorStatus HashJoinProbeTransformOp::onRestore(Block & block)
+{
+    assert(status == ProbeStatus::WAIT_FOR_RESTORE);
+    // The partition is restored in a background thread, wait until it is built.
+    // Another operator may also have started to restore the partition since `awaitImpl`.
+    if (!join->tryRestorePartitionAsync(probe_index, restore_round, probe_header, restore_join, restore_probe_stream))
+        return OperatorStatus::WAITING;
+    if (!restore_join)
+    {
+        status = ProbeStatus::FINISHED;
+        return OperatorStatus::HAS_OUTPUT;
+    }
+    if (restore_join->needReturnNonJoinedData())
+        non_joined_stream = restore_join->createStreamWithNonJoinedRows(probe_header, probe_index, restore_join->getProbeConcurrency(), probe_process_info.max_block_size);
+    restore_probe_stream->readPrefix();
+    status = ProbeStatus::RESTORE_PROBE;
+    return onRestoreProbe(block);
+}
+
+OperatorStatus HashJoinProbeTransformOp::onRestoreProbe(Block & block)
+{
+    assert(status == ProbeStatus::RESTORE_PROBE);
+    if (probe_process_info.all_rows_joined_finish)
+    {
+        Block probe_block = restore_probe_stream->read();
+        if (!probe_block)
+        {
+            restore_probe_stream->readSuffix();
+            restore_join->finishOneProbe();
+            if (restore_join->needReturnNonJoinedData())
+            {
+                status = ProbeStatus::WAIT_FOR_READ_NON_JOINED_DATA;
+                return OperatorStatus::WAITING;
+            }
+            return onRestorePartitionFinish();
+        }
+        probe_process_info.resetBlock(std::move(probe_block));
+    }
+    block = restore_join->joinBlock(probe_process_info);
+    joined_rows += block.rows();
+    return OperatorStatus::HAS_OUTPUT;
+}
+
+OperatorStatus HashJoinProbeTransformOp::onRestorePartitionFinish()
+{
+    // Release the partition before waiting for the other operators to finish it.
+    restore_probe_stream.reset();
+    non_joined_stream.reset();
+    restore_join.reset();
+    join->finishRestorePartition();
+    ++restore_round;
+    status = ProbeStatus::WAIT_FOR_RESTORE;
+    return OperatorStatus::WAITING;
+}
+
+OperatorStatus HashJoinProbeTransformOp::transformImpl(Block & block)
+{
+    assert(status == ProbeStatus::PROBE);
+    assert(probe_process_info.all_rows_joined_finish);
+    if unlikely (!block)
+        return onProbeFinish(block);
+
+    join->checkTypes(block);
+    probe_process_info.resetBlock(std::move(block));
+    assert(!block);
+    // The hash table may not be ready yet, the probe block is kept in probe_process_info until then.
+    if unlikely (!join->isAllBuildFinished())
+        return OperatorStatus::WAITING;
+    return onOutput(block);
+}
+
+OperatorStatus HashJoinProbeTransformOp::tryOutputImpl(Block & block)
+{
+    switch (status)
+    {
+    case ProbeStatus::PROBE:
+        if (probe_process_info.all_rows_joined_finish)
+            return OperatorStatus::NEED_INPUT;
+        return onOutput(block);
+    case ProbeStatus::WAIT_FOR_READ_NON_JOINED_DATA:
+        return OperatorStatus::WAITING;
+    case ProbeStatus::READ_NON_JOINED_DATA:
+        block = non_joined_stream->read();
+        non_joined_rows += block.rows();
+        if (!block)
+        {
+            non_joined_stream->readSuffix();
+            if (restore_join)
+                return onRestorePartitionFinish();
+            status = ProbeStatus::FINISHED;
+        }
+        return OperatorStatus::HAS_OUTPUT;
+    case ProbeStatus::WAIT_FOR_RESTORE:
+        return onRestore(block);
+    case ProbeStatus::RESTORE_PROBE:
+        return onRestoreProbe(block);
+    case ProbeStatus::FINISHED:
+        return OperatorStatus::HAS_OUTPUT;
+    }
+    __builtin_unreachable();
+}
+
+OperatorStatus HashJoinProbeTransformOp::awaitImpl()
+{
+    switch (status)
+    {
+    case ProbeStatus::PROBE:
+        if unlikely (!join->isAllBuildFinished())
+            return OperatorStatus::WAITING;
+        return probe_process_info.all_rows_joined_finish ? OperatorStatus::NEED_INPUT : OperatorStatus::HAS_OUTPUT;
+    case ProbeStatus::WAIT_FOR_READ_NON_JOINED_DATA:
+    {
+        // While restoring a spilled partition, wait for the probe operators of the restored join instead.
+        const auto & current_join = restore_join ? restore_join : join;
+        if (!current_join->isAllBuildFinished())
+            return OperatorStatus::WAITING;
+        // A join that is not spilled does not wait for the other probe operators unless it returns non-joined data.
+        if (!current_join->needReturnNonJoinedData() && !current_join->isSpilled())
+        {
+            status = ProbeStatus::FINISHED;
+            return OperatorStatus::HAS_OUTPUT;
+        }
+        if (!current_join->isAllProbeFinished())
+            return OperatorStatus::WAITING;
+        // For spilled join, all the joined and non-joined rows are produced by restoring the spilled partitions.
+        // The partition is restored in `tryOutputImpl` to keep `awaitImpl` cheap.
+        if (current_join->isSpilled())
+        {
+            non_joined_stream.reset();
+            status = ProbeStatus::WAIT_FOR_RESTORE;
+            return OperatorStatus::HAS_OUTPUT;
+        }
+        if (!non_joined_stream)
+        {
+            status = ProbeStatus::FINISHED;
+            return OperatorStatus::HAS_OUTPUT;
+        }
+        status = ProbeStatus::READ_NON_JOINED_DATA;
+        non_joined_stream->readPrefix();
+        return OperatorStatus::HAS_OUTPUT;
+    }
+    case ProbeStatus::WAIT_FOR_RESTORE:
+        return join->isRestorePartitionReady(restore_round) ? OperatorStatus::HAS_OUTPUT : OperatorStatus::WAITING;
+    case ProbeStatus::READ_NON_JOINED_DATA:
+    case ProbeStatus::RESTORE_PROBE:
+    case ProbeStatus::FINISHED:
+        return OperatorStatus::HAS_OUTPUT;
+    }
+    __builtin_unreachable();
+}
+} // namespace DB
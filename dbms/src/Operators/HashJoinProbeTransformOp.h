@@ -0,0 +1,105 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <DataStreams/IBlockInputStream.h>
+#include <Interpreters/Join.h>
+#include <Operators/Operator.h>
+
+namespace DB
+{
+// The transform operator of the join probe pipeline.
+// Unlike HashJoinProbeBlockInputStream, it never blocks the worker thread:
+// - it returns `WAITING` until the hash table has been built.
+// - for RIGHT/FULL join, after its input is exhausted, it returns `WAITING` until all probe operators of the same join finish,
+//   and then outputs the non-joined rows of the build side that belongs to it.
+// - for spilled join, the probe blocks are spilled, and after all probe operators finish,
+//   the spilled partitions are restored one at a time and probed by all probe operators of the same join,
+//   it returns `WAITING` until the other operators finish the current partition, see `Join::restorePartition`.
+class HashJoinProbeTransformOp : public TransformOp
+{
+public:
+    HashJoinProbeTransformOp(
+        PipelineExecutorStatus & exec_status_,
+        const String & req_id,
+        const JoinPtr & join_,
+        size_t probe_index_,
+        size_t max_block_size,
+        const Block & input_header);
+
+    String getName() const override
+    {
+        return "HashJoinProbeTransformOp";
+    }
+
+protected:
+    OperatorStatus transformImpl(Block & block) override;
+
+    OperatorStatus tryOutputImpl(Block & block) override;
+
+    OperatorStatus awaitImpl() override;
+
+    void transformHeaderImpl(Block & header_) override;
+
+    void operateSuffix() override;
+
+private:
+    OperatorStatus onProbeFinish(Block & block);
+
+    OperatorStatus onOutput(Block & block);
+
+    OperatorStatus onRestore(Block & block);
+
+    OperatorStatus onRestoreProbe(Block & block);
+
+    OperatorStatus onRestorePartitionFinish();
+
+private:
+    JoinPtr join;
+
+    size_t probe_index;
+
+    ProbeProcessInfo probe_process_info;
+
+    Block probe_header;
+
+    // For spilled join, it is replaced by the non-joined stream of the partition being restored.
+    BlockInputStreamPtr non_joined_stream;
+
+    // The join and the probe data of the spilled partition being restored.
+    JoinPtr restore_join;
+    BlockInputStreamPtr restore_probe_stream;
+    // The number of restored partitions this operator has finished.
+    size_t restore_round = 0;
+
+    size_t joined_rows = 0;
+    size_t non_joined_rows = 0;
+
+    enum class ProbeStatus
+    {
+        PROBE, /// probe data
+        WAIT_FOR_READ_NON_JOINED_DATA, /// wait all probe operators finish
+        READ_NON_JOINED_DATA, /// output non joined data
+        WAIT_FOR_RESTORE, /// wait all probe operators finish the previous restored partition and the next one is restored
+        RESTORE_PROBE, /// probe the restored partition
+        FINISHED, /// the final state
+    };
+    ProbeStatus status{ProbeStatus::PROBE};
+
+    const LoggerPtr log;
+};
+} // namespace DB
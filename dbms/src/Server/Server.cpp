@@ -20,6 +20,7 @@
 #include <Common/CurrentMetrics.h>
 #include <Common/DynamicThreadPool.h>
 #include <Common/FailPoint.h>
+#include <Common/IOUring.h>
 #include <Common/Macros.h>
 #include <Common/RedactHelpers.h>
 #include <Common/StringUtils/StringUtils.h>
@@ -74,6 +75,7 @@
 #include <Storages/FormatVersion.h>
 #include <Storages/IManageableStorage.h>
 #include <Storages/PathCapacityMetrics.h>
+#include <Storages/S3/FileCache.h>
 #include <Storages/S3/S3Common.h>
 #include <Storages/System/attachSystemTables.h>
 #include <Storages/Transaction/FileEncryption.h>
@@ -950,6 +952,9 @@ int Server::main(const std::vector<std::string> & /*args*/)
     if (storage_config.s3_config.isS3Enabled())
     {
         S3::ClientFactory::instance().init(storage_config.s3_config);
+        // The compute nodes read the data from S3, cache the hot parts of the remote files on local disk.
+        if (global_context->isDisaggregatedComputeMode() && storage_config.s3_config.isFileCacheEnabled())
+            S3::FileCache::initialize(storage_config.s3_config.cache_dir, storage_config.s3_config.cache_capacity);
     }
 
     if (storage_config.format_version)
@@ -1171,6 +1176,11 @@ int Server::main(const std::vector<std::string> & /*args*/)
     bool use_l0_opt = config().getBool("l0_optimize", false);
     global_context->setUseL0Opt(use_l0_opt);
 
+    /// Read files by io_uring. It falls back to the synchronous reads if the kernel does not support io_uring.
+    bool enable_io_uring = config().getBool("enable_io_uring", false);
+    IOUring::setEnabled(enable_io_uring);
+    LOG_INFO(log, "enable_io_uring={}, io_uring is supported: {}", enable_io_uring, IOUring::isSupported());
+
     /// Size of cache for marks (index of MergeTree family of tables). It is necessary.
     size_t mark_cache_size = config().getUInt64("mark_cache_size", DEFAULT_MARK_CACHE_SIZE);
     if (mark_cache_size)
@@ -1181,6 +1191,11 @@ int Server::main(const std::vector<std::string> & /*args*/)
     if (minmax_index_cache_size)
         global_context->setMinMaxIndexCache(minmax_index_cache_size);
 
+    /// Size of cache for decompressed packs of DMFile, used by DeltaMerge engine. Zero means disabled.
+    size_t dmfile_pack_cache_size = config().getUInt64("dmfile_pack_cache_size", 0);
+    if (dmfile_pack_cache_size)
+        global_context->setDMFilePackCache(dmfile_pack_cache_size);
+
     /// Size of max memory usage of DeltaIndex, used by DeltaMerge engine.
     size_t delta_index_cache_size = config().getUInt64("delta_index_cache_size", 0);
     global_context->setDeltaIndexManager(delta_index_cache_size);
@@ -1264,6 +1279,7 @@ int Server::main(const std::vector<std::string> & /*args*/)
         DB::DM::SegmentReaderPoolManager::instance().stop();
         if (storage_config.s3_config.isS3Enabled())
         {
+            S3::FileCache::shutdown();
             S3::ClientFactory::instance().shutdown();
         }
         global_context->shutdown();
@@ -1299,7 +1315,19 @@ int Server::main(const std::vector<std::string> & /*args*/)
         auto get_pool_size = [](const auto & setting) {
             return setting == 0 ? getNumberOfLogicalCPUCores() : static_cast<size_t>(setting);
         };
-        TaskSchedulerConfig config{get_pool_size(settings.pipeline_task_thread_pool_size)};
+        auto get_queue_type = [](const String & setting) {
+            if (setting == "fifo")
+                return TaskQueueType::FIFO;
+            if (setting == "mlfq")
+                return TaskQueueType::MLFQ;
+            if (setting == "work_stealing")
+                return TaskQueueType::WORK_STEALING;
+            throw Exception(fmt::format("Unknown pipeline task queue type: {}", setting), ErrorCodes::INVALID_CONFIG_PARAMETER);
+        };
+        TaskSchedulerConfig config{
+            get_pool_size(settings.pipeline_task_thread_pool_size),
+            get_queue_type(settings.pipeline_task_queue_type),
+        };
         assert(!TaskScheduler::instance);
         TaskScheduler::instance = std::make_unique<TaskScheduler>(config);
     }
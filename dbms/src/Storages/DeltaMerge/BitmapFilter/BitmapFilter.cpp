@@ -15,13 +15,262 @@
 #include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
 #include <Storages/DeltaMerge/DeltaMergeHelpers.h>
 #include <Storages/DeltaMerge/Segment.h>
+#include <common/defines.h>
+
+#include <array>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 namespace DB::DM
 {
+namespace
+{
+constexpr UInt64 ALL_ONES = ~static_cast<UInt64>(0);
+
+// Mask of the bits [begin, end) in a word, 0 <= begin < end <= 64.
+inline UInt64 wordMask(UInt32 begin, UInt32 end)
+{
+    UInt64 high = end == 64 ? ALL_ONES : ((static_cast<UInt64>(1) << end) - 1);
+    return high & (ALL_ONES << begin);
+}
+
+void setBitRange(UInt64 * words, UInt32 begin, UInt32 end)
+{
+    while (begin < end)
+    {
+        UInt32 word_end = std::min((begin | 63) + 1, end);
+        words[begin >> 6] |= wordMask(begin & 63, word_end - (begin & ~63u));
+        begin = word_end;
+    }
+}
+
+bool isBitRangeAllSet(const UInt64 * words, UInt32 begin, UInt32 end)
+{
+    while (begin < end)
+    {
+        UInt32 word_end = std::min((begin | 63) + 1, end);
+        UInt64 mask = wordMask(begin & 63, word_end - (begin & ~63u));
+        if ((words[begin >> 6] & mask) != mask)
+            return false;
+        begin = word_end;
+    }
+    return true;
+}
+
+// Return the position of the first bit in [begin, end) that equals `value`, or `end` if there is none.
+UInt32 findBit(const UInt64 * words, UInt32 begin, UInt32 end, bool value)
+{
+    while (begin < end)
+    {
+        UInt64 word = value ? words[begin >> 6] : ~words[begin >> 6];
+        word &= ALL_ONES << (begin & 63);
+        if (word != 0)
+            return std::min((begin & ~63u) + __builtin_ctzll(word), end);
+        begin = (begin | 63) + 1;
+    }
+    return end;
+}
+
+#if !defined(__AVX2__)
+// BIT_TO_BYTES[x] holds the 8 bits of `x` expanded to 8 bytes of 0/1, in little-endian order.
+struct BitToBytesTable
+{
+    std::array<UInt64, 256> data{};
+    constexpr BitToBytesTable()
+    {
+        for (UInt64 x = 0; x < 256; ++x)
+            for (UInt64 i = 0; i < 8; ++i)
+                data[x] |= ((x >> i) & 1) << (i * 8);
+    }
+};
+constexpr BitToBytesTable BIT_TO_BYTES;
+#endif
+
+// Expand 64 bits to 64 bytes of 0/1.
+ALWAYS_INLINE inline void expandWord(UInt64 word, UInt8 * out)
+{
+#if defined(__AVX2__)
+    // Broadcast 32 bits, move byte i of them to the bytes [8 * i, 8 * i + 8) and test one bit per byte.
+    const __m256i shuffle = _mm256_setr_epi8(
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, //
+        2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i bit_mask = _mm256_set1_epi64x(0x8040201008040201);
+    const __m256i ones = _mm256_set1_epi8(1);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        __m256i v = _mm256_set1_epi32(static_cast<Int32>(static_cast<UInt32>(word >> (32 * i))));
+        v = _mm256_shuffle_epi8(v, shuffle);
+        v = _mm256_cmpeq_epi8(_mm256_and_si256(v, bit_mask), bit_mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 32 * i), _mm256_and_si256(v, ones));
+    }
+#else
+    for (size_t i = 0; i < 8; ++i)
+    {
+        UInt64 bytes = BIT_TO_BYTES.data[(word >> (8 * i)) & 0xFF];
+        memcpy(out + 8 * i, &bytes, sizeof(bytes));
+    }
+#endif
+}
+
+void expandBits(const UInt64 * words, UInt32 begin, UInt32 end, UInt8 * out)
+{
+    for (; begin < end && (begin & 63) != 0; ++begin)
+        *out++ = (words[begin >> 6] >> (begin & 63)) & 1;
+    for (; begin + 64 <= end; begin += 64, out += 64)
+        expandWord(words[begin >> 6], out);
+    for (; begin < end; ++begin)
+        *out++ = (words[begin >> 6] >> (begin & 63)) & 1;
+}
+} // namespace
+
+void BitmapFilter::Container::reset(ContainerType type_)
+{
+    type = type_;
+    std::vector<Run>().swap(runs);
+    std::vector<UInt64>().swap(bits);
+}
+
+void BitmapFilter::Container::toBitset()
+{
+    if (type == ContainerType::Bitset)
+        return;
+
+    std::vector<UInt64> new_bits(CONTAINER_WORDS, 0);
+    if (type == ContainerType::Full)
+    {
+        setBitRange(new_bits.data(), 0, rows);
+    }
+    else if (type == ContainerType::Runs)
+    {
+        for (const auto & run : runs)
+            setBitRange(new_bits.data(), run.begin, run.end);
+    }
+    reset(ContainerType::Bitset);
+    bits.swap(new_bits);
+}
+
+bool BitmapFilter::Container::isAllSet(UInt32 begin, UInt32 end) const
+{
+    switch (type)
+    {
+    case ContainerType::Empty:
+        return false;
+    case ContainerType::Full:
+        return true;
+    case ContainerType::Runs:
+    {
+        // The run that may contain `begin` is the last one that begins at or before it.
+        auto itr = std::upper_bound(runs.begin(), runs.end(), begin, [](UInt32 row, const Run & run) { return row < run.begin; });
+        return itr != runs.begin() && std::prev(itr)->end >= end;
+    }
+    case ContainerType::Bitset:
+        return isBitRangeAllSet(bits.data(), begin, end);
+    }
+    __builtin_unreachable();
+}
+
+void BitmapFilter::Container::fill(UInt8 * out, UInt32 begin, UInt32 end) const
+{
+    switch (type)
+    {
+    case ContainerType::Empty:
+        memset(out, 0, end - begin);
+        break;
+    case ContainerType::Full:
+        memset(out, 1, end - begin);
+        break;
+    case ContainerType::Runs:
+    {
+        memset(out, 0, end - begin);
+        auto itr = std::upper_bound(runs.begin(), runs.end(), begin, [](UInt32 row, const Run & run) { return row < run.begin; });
+        if (itr != runs.begin())
+            --itr;
+        for (; itr != runs.end() && itr->begin < end; ++itr)
+        {
+            UInt32 run_begin = std::max(itr->begin, begin);
+            UInt32 run_end = std::min(itr->end, end);
+            if (run_begin < run_end)
+                memset(out + (run_begin - begin), 1, run_end - run_begin);
+        }
+        break;
+    }
+    case ContainerType::Bitset:
+        expandBits(bits.data(), begin, end, out);
+        break;
+    }
+}
+
+size_t BitmapFilter::Container::count() const
+{
+    switch (type)
+    {
+    case ContainerType::Empty:
+        return 0;
+    case ContainerType::Full:
+        return rows;
+    case ContainerType::Runs:
+    {
+        size_t n = 0;
+        for (const auto & run : runs)
+            n += run.end - run.begin;
+        return n;
+    }
+    case ContainerType::Bitset:
+    {
+        size_t n = 0;
+        for (auto word : bits)
+            n += __builtin_popcountll(word);
+        return n;
+    }
+    }
+    __builtin_unreachable();
+}
+
+void BitmapFilter::Container::optimize()
+{
+    if (type != ContainerType::Bitset)
+        return;
+
+    auto n = count();
+    if (n == 0)
+    {
+        reset(ContainerType::Empty);
+        return;
+    }
+    if (n == rows)
+    {
+        reset(ContainerType::Full);
+        return;
+    }
+
+    // Only use runs when they are smaller than the bitset.
+    static constexpr size_t max_runs = CONTAINER_WORDS * sizeof(UInt64) / sizeof(Run) - 1;
+    std::vector<Run> new_runs;
+    for (UInt32 begin = findBit(bits.data(), 0, rows, true); begin < rows;)
+    {
+        UInt32 end = findBit(bits.data(), begin, rows, false);
+        if (new_runs.size() >= max_runs)
+            return;
+        new_runs.push_back(Run{begin, end});
+        begin = findBit(bits.data(), end, rows, true);
+    }
+    reset(ContainerType::Runs);
+    runs.swap(new_runs);
+}
+
 BitmapFilter::BitmapFilter(UInt32 size_, bool default_value)
-    : filter(size_, default_value)
+    : total_rows(size_)
+    , containers((size_ + CONTAINER_ROWS - 1) >> CONTAINER_ROWS_SHIFT)
     , all_match(default_value)
-{}
+{
+    for (size_t i = 0; i < containers.size(); ++i)
+    {
+        containers[i].type = default_value ? ContainerType::Full : ContainerType::Empty;
+        containers[i].rows = std::min(CONTAINER_ROWS, total_rows - static_cast<UInt32>(i << CONTAINER_ROWS_SHIFT));
+    }
+}
 
 void BitmapFilter::set(BlockInputStreamPtr & stream)
 {
@@ -48,6 +297,24 @@ void BitmapFilter::set(const ColumnPtr & col, const FilterPtr & f)
     set(v->data(), v->size(), f);
 }
 
+ALWAYS_INLINE inline void BitmapFilter::setBit(UInt32 row_id, bool value)
+{
+    RUNTIME_CHECK(row_id < total_rows, row_id, total_rows);
+    auto & container = containers[row_id >> CONTAINER_ROWS_SHIFT];
+    if (container.type != ContainerType::Bitset)
+    {
+        if (container.type == (value ? ContainerType::Full : ContainerType::Empty))
+            return;
+        container.toBitset();
+    }
+    UInt32 offset = row_id & CONTAINER_ROWS_MASK;
+    UInt64 mask = static_cast<UInt64>(1) << (offset & 63);
+    if (value)
+        container.bits[offset >> 6] |= mask;
+    else
+        container.bits[offset >> 6] &= ~mask;
+}
+
 void BitmapFilter::set(const UInt32 * data, UInt32 size, const FilterPtr & f)
 {
     if (size == 0)
@@ -58,54 +325,103 @@ void BitmapFilter::set(const UInt32 * data, UInt32 size, const FilterPtr & f)
     {
         for (UInt32 i = 0; i < size; i++)
         {
-            UInt32 row_id = *(data + i);
-            filter[row_id] = true;
+            setBit(data[i], true);
         }
     }
     else
     {
         RUNTIME_CHECK(size == f->size(), size, f->size());
+        bool has_unset = false;
         for (UInt32 i = 0; i < size; i++)
         {
-            UInt32 row_id = *(data + i);
-            filter[row_id] = (*f)[i];
+            bool value = (*f)[i];
+            has_unset |= !value;
+            setBit(data[i], value);
         }
+        all_match = all_match && !has_unset;
     }
 }
 
 void BitmapFilter::set(UInt32 start, UInt32 limit)
 {
-    RUNTIME_CHECK(start + limit <= filter.size(), start, limit, filter.size());
-    std::fill(filter.begin() + start, filter.begin() + start + limit, true);
+    RUNTIME_CHECK(start + limit <= total_rows, start, limit, total_rows);
+    for (UInt32 row = start, end = start + limit; row < end;)
+    {
+        auto & container = containers[row >> CONTAINER_ROWS_SHIFT];
+        UInt32 container_start = row & ~CONTAINER_ROWS_MASK;
+        UInt32 begin = row - container_start;
+        UInt32 stop = std::min(end - container_start, container.rows);
+        if (begin == 0 && stop == container.rows)
+        {
+            container.reset(ContainerType::Full);
+        }
+        else if (container.type != ContainerType::Full)
+        {
+            container.toBitset();
+            setBitRange(container.bits.data(), begin, stop);
+        }
+        row = container_start + stop;
+    }
+}
+
+bool BitmapFilter::isAllSet(UInt32 start, UInt32 limit) const
+{
+    for (UInt32 row = start, end = start + limit; row < end;)
+    {
+        const auto & container = containers[row >> CONTAINER_ROWS_SHIFT];
+        UInt32 container_start = row & ~CONTAINER_ROWS_MASK;
+        UInt32 stop = std::min(end - container_start, container.rows);
+        if (!container.isAllSet(row - container_start, stop))
+            return false;
+        row = container_start + stop;
+    }
+    return true;
+}
+
+void BitmapFilter::fill(UInt8 * out, UInt32 start, UInt32 limit) const
+{
+    for (UInt32 row = start, end = start + limit; row < end;)
+    {
+        const auto & container = containers[row >> CONTAINER_ROWS_SHIFT];
+        UInt32 container_start = row & ~CONTAINER_ROWS_MASK;
+        UInt32 stop = std::min(end - container_start, container.rows);
+        container.fill(out + (row - start), row - container_start, stop);
+        row = container_start + stop;
+    }
 }
 
 bool BitmapFilter::get(IColumn::Filter & f, UInt32 start, UInt32 limit) const
 {
-    RUNTIME_CHECK(start + limit <= filter.size(), start, limit, filter.size());
-    auto begin = filter.cbegin() + start;
-    auto end = filter.cbegin() + start + limit;
-    if (all_match || std::find(begin, end, false) == end)
+    RUNTIME_CHECK(start + limit <= total_rows, start, limit, total_rows);
+    if (all_match || isAllSet(start, limit))
     {
         return true;
     }
     else
     {
-        std::copy(begin, end, f.begin());
+        fill(f.data(), start, limit);
         return false;
     }
 }
 
 void BitmapFilter::runOptimize()
 {
-    all_match = std::find(filter.begin(), filter.end(), false) == filter.end();
+    all_match = true;
+    for (auto & container : containers)
+    {
+        container.optimize();
+        all_match = all_match && container.type == ContainerType::Full;
+    }
 }
 
 String BitmapFilter::toDebugString() const
 {
-    String s(filter.size(), '1');
-    for (UInt32 i = 0; i < filter.size(); i++)
+    IColumn::Filter f(total_rows);
+    fill(f.data(), 0, total_rows);
+    String s(total_rows, '1');
+    for (UInt32 i = 0; i < total_rows; i++)
     {
-        if (!filter[i])
+        if (!f[i])
         {
             s[i] = '0';
         }
@@ -115,6 +431,9 @@ String BitmapFilter::toDebugString() const
 
 size_t BitmapFilter::count() const
 {
-    return std::count(filter.cbegin(), filter.cend(), true);
+    size_t n = 0;
+    for (const auto & container : containers)
+        n += container.count();
+    return n;
 }
-} // namespace DB::DM
\ No newline at end of file
+} // namespace DB::DM
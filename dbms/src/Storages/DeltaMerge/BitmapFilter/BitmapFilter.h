@@ -20,6 +20,13 @@
 namespace DB::DM
 {
 
+/// A compressed bitmap of the rows that are visible to a read in Bitmap read mode.
+///
+/// Rows are split into containers of `CONTAINER_ROWS` rows, in the spirit of roaring bitmaps.
+/// Each container is either empty, full, a list of sorted runs or a plain bitset. Containers
+/// are materialized as bitsets while the filter is being built, and `runOptimize` converts each
+/// of them to its cheapest representation afterward. Most of the rows are visible when the delta
+/// is small, so most of the containers end up as `Full` and cost nothing to store or to scan.
 class BitmapFilter
 {
 public:
@@ -38,7 +45,50 @@ public:
     size_t count() const;
 
 private:
-    std::vector<bool> filter;
+    static constexpr UInt32 CONTAINER_ROWS_SHIFT = 16;
+    static constexpr UInt32 CONTAINER_ROWS = 1u << CONTAINER_ROWS_SHIFT;
+    static constexpr UInt32 CONTAINER_ROWS_MASK = CONTAINER_ROWS - 1;
+    static constexpr UInt32 CONTAINER_WORDS = CONTAINER_ROWS / 64;
+
+    enum class ContainerType : UInt8
+    {
+        Empty,
+        Full,
+        Runs,
+        Bitset,
+    };
+
+    // [begin, end) of the rows that are set, relative to the beginning of the container.
+    struct Run
+    {
+        UInt32 begin;
+        UInt32 end;
+    };
+
+    struct Container
+    {
+        ContainerType type = ContainerType::Empty;
+        // The number of rows in this container, only the last container may be smaller than `CONTAINER_ROWS`.
+        UInt32 rows = 0;
+        // Valid when `type == Runs`.
+        std::vector<Run> runs;
+        // Valid when `type == Bitset`. The bits beyond `rows` are always zero.
+        std::vector<UInt64> bits;
+
+        void reset(ContainerType type_);
+        void toBitset();
+        bool isAllSet(UInt32 begin, UInt32 end) const;
+        void fill(UInt8 * out, UInt32 begin, UInt32 end) const;
+        size_t count() const;
+        void optimize();
+    };
+
+    void setBit(UInt32 row_id, bool value);
+    bool isAllSet(UInt32 start, UInt32 limit) const;
+    void fill(UInt8 * out, UInt32 start, UInt32 limit) const;
+
+    UInt32 total_rows;
+    std::vector<Container> containers;
     bool all_match;
 };
 
@@ -37,6 +37,9 @@ struct ColumnStat
     size_t nullmap_data_bytes = 0;
     size_t nullmap_mark_bytes = 0;
     size_t index_bytes = 0;
+    // The size of the optional bloom filter, 0 means the column has no bloom filter. It is not a part of
+    // `serializeToBuffer` for compatibility, metav2 persists it in a separate meta block.
+    size_t bloom_filter_bytes = 0;
     void serializeToBuffer(WriteBuffer & buf) const
     {
         writeIntBinary(col_id, buf);
@@ -28,7 +28,9 @@
 #include <common/logger_useful.h>
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <boost/algorithm/string/classification.hpp>
+#include <optional>
 #include <utility>
 
 namespace DB
@@ -57,6 +59,8 @@ inline constexpr static const char * FOLDER_PREFIX_DROPPED = ".del.dmf_";
 inline constexpr static const char * DATA_FILE_SUFFIX = ".dat";
 inline constexpr static const char * INDEX_FILE_SUFFIX = ".idx";
 inline constexpr static const char * MARK_FILE_SUFFIX = ".mrk";
+inline constexpr static const char * BLOOM_FILTER_FILE_SUFFIX = ".bf";
+inline constexpr static const char * NGRAM_INDEX_FILE_SUFFIX = ".ngram";
 
 inline String getNGCPath(const String & prefix)
 {
@@ -185,6 +189,32 @@ bool DMFile::isColIndexExist(const ColId & col_id) const
     }
 }
 
+bool DMFile::isColBloomFilterExist(const ColId & col_id) const
+{
+    if (useMetaV2())
+    {
+        auto itr = column_stats.find(col_id);
+        return itr != column_stats.end() && itr->second.bloom_filter_bytes > 0;
+    }
+    else
+    {
+        return column_bloom_filters.count(col_id) != 0;
+    }
+}
+
+bool DMFile::isColNgramIndexExist(const ColId & col_id) const
+{
+    if (useMetaV2())
+    {
+        // Ngram indexes are not recorded in the metav2, check the local file directly.
+        return Poco::File(colNgramIndexPath(getFileNameBase(col_id))).exists();
+    }
+    else
+    {
+        return column_ngram_indexes.count(col_id) != 0;
+    }
+}
+
 size_t DMFile::colIndexSize(ColId id)
 {
     if (useMetaV2())
@@ -204,6 +234,25 @@ size_t DMFile::colIndexSize(ColId id)
     }
 }
 
+size_t DMFile::colBloomFilterSize(ColId id)
+{
+    if (useMetaV2())
+    {
+        if (auto itr = column_stats.find(id); itr != column_stats.end() && itr->second.bloom_filter_bytes > 0)
+        {
+            return itr->second.bloom_filter_bytes;
+        }
+        else
+        {
+            throw Exception(ErrorCodes::FILE_DOESNT_EXIST, "Bloom filter of {} not exist", id);
+        }
+    }
+    else
+    {
+        return Poco::File(colBloomFilterPath(getFileNameBase(id))).getSize();
+    }
+}
+
 size_t DMFile::colDataSize(ColId id)
 {
     if (useMetaV2())
@@ -244,6 +293,16 @@ EncryptionPath DMFile::encryptionMarkPath(const FileNameBase & file_name_base) c
     return EncryptionPath(encryptionBasePath(), file_name_base + details::MARK_FILE_SUFFIX);
 }
 
+EncryptionPath DMFile::encryptionBloomFilterPath(const FileNameBase & file_name_base) const
+{
+    return EncryptionPath(encryptionBasePath(), file_name_base + details::BLOOM_FILTER_FILE_SUFFIX);
+}
+
+EncryptionPath DMFile::encryptionNgramIndexPath(const FileNameBase & file_name_base) const
+{
+    return EncryptionPath(encryptionBasePath(), file_name_base + details::NGRAM_INDEX_FILE_SUFFIX);
+}
+
 EncryptionPath DMFile::encryptionMetaPath() const
 {
     return EncryptionPath(encryptionBasePath(), metaFileName());
@@ -281,6 +340,14 @@ String DMFile::colMarkFileName(const FileNameBase & file_name_base)
 {
     return file_name_base + details::MARK_FILE_SUFFIX;
 }
+String DMFile::colBloomFilterFileName(const FileNameBase & file_name_base)
+{
+    return file_name_base + details::BLOOM_FILTER_FILE_SUFFIX;
+}
+String DMFile::colNgramIndexFileName(const FileNameBase & file_name_base)
+{
+    return file_name_base + details::NGRAM_INDEX_FILE_SUFFIX;
+}
 
 DMFile::OffsetAndSize DMFile::writeMetaToBuffer(WriteBuffer & buffer)
 {
@@ -758,6 +825,14 @@ void DMFile::initializeIndices()
         {
             column_indices.insert(decode(removeSuffix(name, strlen(details::INDEX_FILE_SUFFIX)))); // strip tailing `.idx`
         }
+        else if (endsWith(name, details::BLOOM_FILTER_FILE_SUFFIX))
+        {
+            column_bloom_filters.insert(decode(removeSuffix(name, strlen(details::BLOOM_FILTER_FILE_SUFFIX)))); // strip tailing `.bf`
+        }
+        else if (endsWith(name, details::NGRAM_INDEX_FILE_SUFFIX))
+        {
+            column_ngram_indexes.insert(decode(removeSuffix(name, strlen(details::NGRAM_INDEX_FILE_SUFFIX)))); // strip tailing `.ngram`
+        }
     }
 }
 
@@ -809,17 +884,47 @@ DMFile::MetaBlockHandle DMFile::writeColumnStatToBuffer(WriteBuffer & buffer, DB
     return MetaBlockHandle{MetaBlockType::ColumnStat, offset, buffer.count() - offset};
 }
 
+DMFile::MetaBlockHandle DMFile::writeColumnBloomFilterStatToBuffer(WriteBuffer & buffer, DB::UnifiedDigestBaseBox & digest)
+{
+    auto offset = buffer.count();
+    auto tmp_buffer = WriteBufferFromOwnString{};
+    size_t count = std::count_if(column_stats.begin(), column_stats.end(), [](const auto & kv) { return kv.second.bloom_filter_bytes > 0; });
+    writeIntBinary(count, tmp_buffer);
+    for (const auto & [id, stat] : column_stats)
+    {
+        if (stat.bloom_filter_bytes == 0)
+            continue;
+        writeIntBinary(id, tmp_buffer);
+        writeIntBinary(stat.bloom_filter_bytes, tmp_buffer);
+    }
+    auto serialized = tmp_buffer.releaseStr();
+    if (digest)
+    {
+        digest->update(serialized.data(), serialized.length());
+    }
+    writeString(serialized.data(), serialized.size(), buffer);
+    return MetaBlockHandle{MetaBlockType::ColumnBloomFilterStat, offset, buffer.count() - offset};
+}
+
 void DMFile::finalizeMetaV2(WriteBuffer & buffer)
 {
     auto digest = configuration ? configuration->createUnifiedDigest() : nullptr;
     auto pack_stats_handle = writeSLPackStatToBuffer(buffer, digest);
     auto pack_properties_handle = writeSLPackPropertyToBuffer(buffer, digest);
     auto column_stats_handle = writeColumnStatToBuffer(buffer, digest);
+    // Only write the bloom filter stat when it is not empty, so that a DMFile without bloom filters
+    // can still be read by the versions that do not know this meta block.
+    bool has_bloom_filter = std::any_of(column_stats.begin(), column_stats.end(), [](const auto & kv) { return kv.second.bloom_filter_bytes > 0; });
+    std::optional<MetaBlockHandle> bloom_filter_stat_handle;
+    if (has_bloom_filter)
+        bloom_filter_stat_handle = writeColumnBloomFilterStatToBuffer(buffer, digest);
 
     writePODBinary(pack_stats_handle, buffer);
     writePODBinary(pack_properties_handle, buffer);
     writePODBinary(column_stats_handle, buffer);
-    UInt64 meta_block_handle_count = 3;
+    if (bloom_filter_stat_handle)
+        writePODBinary(*bloom_filter_stat_handle, buffer);
+    UInt64 meta_block_handle_count = bloom_filter_stat_handle ? 4 : 3;
     writeIntBinary(meta_block_handle_count, buffer);
     writeIntBinary(version, buffer);
 
@@ -828,6 +933,8 @@ void DMFile::finalizeMetaV2(WriteBuffer & buffer)
         digest->update(reinterpret_cast<const char *>(&pack_stats_handle), sizeof(MetaBlockHandle));
         digest->update(reinterpret_cast<const char *>(&pack_properties_handle), sizeof(MetaBlockHandle));
         digest->update(reinterpret_cast<const char *>(&column_stats_handle), sizeof(MetaBlockHandle));
+        if (bloom_filter_stat_handle)
+            digest->update(reinterpret_cast<const char *>(&*bloom_filter_stat_handle), sizeof(MetaBlockHandle));
         digest->update(reinterpret_cast<const char *>(&meta_block_handle_count), sizeof(UInt64));
         digest->update(reinterpret_cast<const char *>(&version), sizeof(DMFileFormat::Version));
 
@@ -898,6 +1005,8 @@ void DMFile::parseMetaV2(std::string_view buffer)
     ptr = ptr - sizeof(UInt64);
     auto meta_block_handle_count = *(reinterpret_cast<const UInt64 *>(ptr));
 
+    // The bloom filter stat updates the column stats, parse it after all other meta blocks.
+    std::optional<std::string_view> bloom_filter_stat_buffer;
     for (UInt64 i = 0; i < meta_block_handle_count; ++i)
     {
         ptr = ptr - sizeof(MetaBlockHandle);
@@ -913,10 +1022,15 @@ void DMFile::parseMetaV2(std::string_view buffer)
         case MetaBlockType::PackStat:
             parsePackStat(buffer.substr(handle->offset, handle->size));
             break;
+        case MetaBlockType::ColumnBloomFilterStat:
+            bloom_filter_stat_buffer = buffer.substr(handle->offset, handle->size);
+            break;
         default:
             throw Exception(ErrorCodes::INCORRECT_DATA, "MetaBlockType {} is not recognized", magic_enum::enum_name(handle->type));
         }
     }
+    if (bloom_filter_stat_buffer)
+        parseColumnBloomFilterStat(*bloom_filter_stat_buffer);
 }
 
 void DMFile::parseColumnStat(std::string_view buffer)
@@ -933,6 +1047,22 @@ void DMFile::parseColumnStat(std::string_view buffer)
     }
 }
 
+void DMFile::parseColumnBloomFilterStat(std::string_view buffer)
+{
+    ReadBufferFromString rbuf(buffer);
+    size_t count;
+    readIntBinary(count, rbuf);
+    for (size_t i = 0; i < count; ++i)
+    {
+        ColId id;
+        size_t bytes;
+        readIntBinary(id, rbuf);
+        readIntBinary(bytes, rbuf);
+        if (auto itr = column_stats.find(id); itr != column_stats.end())
+            itr->second.bloom_filter_bytes = bytes;
+    }
+}
+
 void DMFile::parsePackProperty(std::string_view buffer)
 {
     const auto * pp = reinterpret_cast<const PackProperty *>(buffer.data());
@@ -170,6 +170,8 @@ public:
         PackStat = 0,
         PackProperty,
         ColumnStat,
+        // The sizes of the optional bloom filters, only written when some column has a bloom filter.
+        ColumnBloomFilterStat,
     };
     struct MetaBlockHandle
     {
@@ -362,20 +364,27 @@ public:
     size_t colDataSizeByName(const FileNameBase & file_name_base) { return Poco::File(colDataPath(file_name_base)).getSize(); }
     size_t colIndexSize(ColId id);
     size_t colDataSize(ColId id);
+    size_t colBloomFilterSize(ColId id);
 
     String colDataPath(const FileNameBase & file_name_base) const { return subFilePath(colDataFileName(file_name_base)); }
     String colIndexPath(const FileNameBase & file_name_base) const { return subFilePath(colIndexFileName(file_name_base)); }
     String colMarkPath(const FileNameBase & file_name_base) const { return subFilePath(colMarkFileName(file_name_base)); }
+    String colBloomFilterPath(const FileNameBase & file_name_base) const { return subFilePath(colBloomFilterFileName(file_name_base)); }
+    String colNgramIndexPath(const FileNameBase & file_name_base) const { return subFilePath(colNgramIndexFileName(file_name_base)); }
 
     String colIndexCacheKey(const FileNameBase & file_name_base) const;
     String colMarkCacheKey(const FileNameBase & file_name_base) const;
 
     bool isColIndexExist(const ColId & col_id) const;
+    bool isColBloomFilterExist(const ColId & col_id) const;
+    bool isColNgramIndexExist(const ColId & col_id) const;
 
     String encryptionBasePath() const;
     EncryptionPath encryptionDataPath(const FileNameBase & file_name_base) const;
     EncryptionPath encryptionIndexPath(const FileNameBase & file_name_base) const;
     EncryptionPath encryptionMarkPath(const FileNameBase & file_name_base) const;
+    EncryptionPath encryptionBloomFilterPath(const FileNameBase & file_name_base) const;
+    EncryptionPath encryptionNgramIndexPath(const FileNameBase & file_name_base) const;
     EncryptionPath encryptionMetaPath() const;
     EncryptionPath encryptionPackStatPath() const;
     EncryptionPath encryptionPackPropertyPath() const;
@@ -396,6 +405,8 @@ public:
     static String colDataFileName(const FileNameBase & file_name_base);
     static String colIndexFileName(const FileNameBase & file_name_base);
     static String colMarkFileName(const FileNameBase & file_name_base);
+    static String colBloomFilterFileName(const FileNameBase & file_name_base);
+    static String colNgramIndexFileName(const FileNameBase & file_name_base);
 
     using OffsetAndSize = std::tuple<size_t, size_t>;
     OffsetAndSize writeMetaToBuffer(WriteBuffer & buffer);
@@ -441,9 +452,11 @@ public:
     MetaBlockHandle writeSLPackStatToBuffer(WriteBuffer & buffer, DB::UnifiedDigestBaseBox & digest);
     MetaBlockHandle writeSLPackPropertyToBuffer(WriteBuffer & buffer, DB::UnifiedDigestBaseBox & digest);
     MetaBlockHandle writeColumnStatToBuffer(WriteBuffer & buffer, DB::UnifiedDigestBaseBox & digest);
+    MetaBlockHandle writeColumnBloomFilterStatToBuffer(WriteBuffer & buffer, DB::UnifiedDigestBaseBox & digest);
     std::vector<char> readMetaV2(const FileProviderPtr & file_provider);
     void parseMetaV2(std::string_view buffer);
     void parseColumnStat(std::string_view buffer);
+    void parseColumnBloomFilterStat(std::string_view buffer);
     void parsePackProperty(std::string_view buffer);
     void parsePackStat(std::string_view buffer);
     void finalizeDirName();
@@ -460,6 +473,8 @@ private:
     PackProperties pack_properties;
     ColumnStats column_stats;
     std::unordered_set<ColId> column_indices;
+    std::unordered_set<ColId> column_bloom_filters;
+    std::unordered_set<ColId> column_ngram_indexes;
 
     Status status;
     DMConfigurationOpt configuration; // configuration
@@ -24,7 +24,7 @@ DMFileBlockInputStreamBuilder::DMFileBlockInputStreamBuilder(const Context & con
 {
     // init from global context
     const auto & global_context = context.getGlobalContext();
-    setCaches(global_context.getMarkCache(), global_context.getMinMaxIndexCache());
+    setCaches(global_context.getMarkCache(), global_context.getMinMaxIndexCache(), global_context.getDMFilePackCache());
     // init from settings
     setFromSettings(context.getSettingsRef());
 }
@@ -66,6 +66,7 @@ DMFileBlockInputStreamPtr DMFileBlockInputStreamBuilder::build(const DMFilePtr &
         mark_cache,
         enable_column_cache,
         column_cache,
+        pack_cache,
         aio_threshold,
         max_read_buffer_size,
         file_provider,
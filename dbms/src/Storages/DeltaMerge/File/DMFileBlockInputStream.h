@@ -81,7 +81,7 @@ class DMFileBlockInputStreamBuilder
 public:
     // Construct a builder by `context`.
     // It implicitly set the params by
-    // - mark cache and min-max-index cache from global context
+    // - mark cache, min-max-index cache and pack cache from global context
     // - current settings from this context
     // - current read limiter form this context
     // - current file provider from this context
@@ -163,10 +163,11 @@ private:
         enable_read_thread = settings.dt_enable_read_thread;
         return *this;
     }
-    DMFileBlockInputStreamBuilder & setCaches(const MarkCachePtr & mark_cache_, const MinMaxIndexCachePtr & index_cache_)
+    DMFileBlockInputStreamBuilder & setCaches(const MarkCachePtr & mark_cache_, const MinMaxIndexCachePtr & index_cache_, const DMFilePackCachePtr & pack_cache_)
     {
         mark_cache = mark_cache_;
         index_cache = index_cache_;
+        pack_cache = pack_cache_;
         return *this;
     }
 
@@ -185,6 +186,7 @@ private:
     IdSetPtr read_packs{};
     MarkCachePtr mark_cache;
     MinMaxIndexCachePtr index_cache;
+    DMFilePackCachePtr pack_cache;
     // column cache
     bool enable_column_cache = false;
     ColumnCachePtr column_cache;
@@ -43,7 +43,9 @@ public:
             DMFileWriter::Options{
                 CompressionSettings(context.getSettingsRef().dt_compression_method, context.getSettingsRef().dt_compression_level),
                 context.getSettingsRef().min_compress_block_size,
-                context.getSettingsRef().max_compress_block_size})
+                context.getSettingsRef().max_compress_block_size,
+                context.getSettingsRef().dt_enable_ngram_index,
+                context.getSettingsRef().dt_enable_bloom_filter_index})
     {
     }
 
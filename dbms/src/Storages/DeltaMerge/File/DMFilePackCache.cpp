@@ -0,0 +1,121 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Common/TiFlashMetrics.h>
+#include <Storages/DeltaMerge/File/DMFilePackCache.h>
+
+namespace DB
+{
+namespace DM
+{
+namespace
+{
+// The bytes evicted by the last `set` of the current thread, see `onRemoveOverflowWeightLoss`.
+thread_local size_t last_evicted_bytes = 0;
+
+// Used to estimate how many keys the doorkeeper should remember.
+constexpr size_t ESTIMATED_PACK_BYTES = 64 * 1024;
+} // namespace
+
+DMFilePackCache::DMFilePackCache(size_t max_size_in_bytes)
+    : Base(max_size_in_bytes)
+    // A single pack should not take a notable part of the cache.
+    , max_pack_bytes(std::max(static_cast<size_t>(1), max_size_in_bytes / 16))
+    // Remember the keys of about twice the capacity of the cache.
+    , max_doorkeeper_size(std::max(static_cast<size_t>(1024), max_size_in_bytes / ESTIMATED_PACK_BYTES * 2))
+{}
+
+ColumnPtr DMFilePackCache::getPack(const Key & key)
+{
+    auto pack = Base::get(key);
+    if (pack)
+    {
+        GET_METRIC(tiflash_storage_pack_cache, type_hit).Increment();
+        return pack->column;
+    }
+    GET_METRIC(tiflash_storage_pack_cache, type_miss).Increment();
+    return nullptr;
+}
+
+bool DMFilePackCache::getPacks(const Key & first_key, size_t pack_count, std::vector<ColumnPtr> & packs)
+{
+    packs.clear();
+    packs.reserve(pack_count);
+    Key key = first_key;
+    for (size_t i = 0; i < pack_count; ++i, ++key.pack_id)
+    {
+        auto pack = Base::get(key);
+        if (!pack)
+        {
+            packs.clear();
+            GET_METRIC(tiflash_storage_pack_cache, type_miss).Increment(pack_count);
+            return false;
+        }
+        packs.push_back(pack->column);
+    }
+    GET_METRIC(tiflash_storage_pack_cache, type_hit).Increment(pack_count);
+    return true;
+}
+
+bool DMFilePackCache::admit(const Key & key, size_t pack_bytes)
+{
+    if (pack_bytes > max_pack_bytes || !checkDoorkeeper(key))
+    {
+        GET_METRIC(tiflash_storage_pack_cache, type_reject).Increment();
+        return false;
+    }
+    return true;
+}
+
+size_t DMFilePackCache::putPack(const Key & key, const ColumnPtr & column)
+{
+    last_evicted_bytes = 0;
+    Base::set(key, std::make_shared<DecompressedPack>(DecompressedPack{column}));
+    GET_METRIC(tiflash_storage_pack_cache, type_admit).Increment();
+    return last_evicted_bytes;
+}
+
+bool DMFilePackCache::tryPutPack(const Key & key, const ColumnPtr & column, size_t & evicted_bytes)
+{
+    evicted_bytes = 0;
+    if (!admit(key, column->allocatedBytes()))
+        return false;
+    evicted_bytes = putPack(key, column);
+    return true;
+}
+
+void DMFilePackCache::onRemoveOverflowWeightLoss(size_t weight_loss)
+{
+    // Called by `set` in the same thread while holding the lock of the cache.
+    last_evicted_bytes += weight_loss;
+    if (weight_loss > 0)
+        GET_METRIC(tiflash_storage_pack_cache, type_evict_bytes).Increment(weight_loss);
+}
+
+bool DMFilePackCache::checkDoorkeeper(const Key & key)
+{
+    const UInt64 h = DMFilePackCacheKeyHash{}(key);
+    std::lock_guard lock(doorkeeper_mutex);
+    if (doorkeeper.erase(h) > 0)
+        return true;
+    // Forget everything when it is full, so the doorkeeper only reflects the recent reads.
+    if (doorkeeper.size() >= max_doorkeeper_size)
+        doorkeeper.clear();
+    doorkeeper.insert(h);
+    return false;
+}
+
+} // namespace DM
+} // namespace DB
@@ -0,0 +1,119 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <Columns/IColumn.h>
+#include <Common/HashTable/Hash.h>
+#include <Common/LRUCache.h>
+#include <Storages/DeltaMerge/DeltaMergeDefines.h>
+
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace DB
+{
+namespace DM
+{
+struct DMFilePackCacheKey
+{
+    UInt64 file_id;
+    // DMFiles of different tables may share the same file id, so the parent path is also a part of the key.
+    UInt64 parent_path_hash;
+    ColId col_id;
+    UInt64 pack_id;
+
+    bool operator==(const DMFilePackCacheKey & other) const
+    {
+        return file_id == other.file_id && parent_path_hash == other.parent_path_hash && col_id == other.col_id && pack_id == other.pack_id;
+    }
+};
+
+struct DMFilePackCacheKeyHash
+{
+    size_t operator()(const DMFilePackCacheKey & key) const
+    {
+        UInt64 h = intHash64(key.file_id ^ key.parent_path_hash);
+        h = intHash64(h ^ static_cast<UInt64>(key.col_id));
+        return intHash64(h ^ key.pack_id);
+    }
+};
+
+/// The decompressed data of one column in one pack.
+struct DecompressedPack
+{
+    ColumnPtr column;
+};
+
+struct DecompressedPackWeightFunction
+{
+    size_t operator()(const DecompressedPack & pack) const
+    {
+        return pack.column->allocatedBytes();
+    }
+};
+
+/** A global cache of the decompressed column data of DMFile packs.
+  * Hot small tables, like the dimension tables of joins, are read by every MPP task. With this cache they
+  * are decompressed only once.
+  *
+  * To prevent a single big scan from flushing the cache, a pack is admitted only when it is read again
+  * while it is still remembered by the "doorkeeper", a bounded set of the keys that were read recently.
+  * So the packs that are only read once by a scan stay in the doorkeeper and never enter the cache.
+  */
+class DMFilePackCache : public LRUCache<DMFilePackCacheKey, DecompressedPack, DMFilePackCacheKeyHash, DecompressedPackWeightFunction>
+{
+private:
+    using Base = LRUCache<DMFilePackCacheKey, DecompressedPack, DMFilePackCacheKeyHash, DecompressedPackWeightFunction>;
+
+public:
+    explicit DMFilePackCache(size_t max_size_in_bytes);
+
+    /// Return nullptr if the pack is not cached.
+    ColumnPtr getPack(const Key & key);
+
+    /// Get `pack_count` continuous packs starting from `first_key` into `packs`. Return false unless all of
+    /// them are cached, and a partial hit is counted as a miss because the caller reads all of them again.
+    bool getPacks(const Key & first_key, size_t pack_count, std::vector<ColumnPtr> & packs);
+
+    /// Return whether a pack of `pack_bytes` passes the admission. It is checked before the caller materializes
+    /// the pack, so that the rejected packs cost nothing.
+    bool admit(const Key & key, size_t pack_bytes);
+
+    /// Put an admitted pack into the cache, return the bytes evicted to make room for it.
+    size_t putPack(const Key & key, const ColumnPtr & column);
+
+    /// Put the pack into the cache if it passes the admission.
+    /// Return whether the pack is admitted, and the bytes evicted to make room for it in `evicted_bytes`.
+    bool tryPutPack(const Key & key, const ColumnPtr & column, size_t & evicted_bytes);
+
+private:
+    void onRemoveOverflowWeightLoss(size_t weight_loss) override;
+
+    /// Return true if `key` was seen recently, otherwise remember it.
+    bool checkDoorkeeper(const Key & key);
+
+    const size_t max_pack_bytes;
+    const size_t max_doorkeeper_size;
+
+    std::mutex doorkeeper_mutex;
+    std::unordered_set<UInt64> doorkeeper;
+};
+
+using DMFilePackCachePtr = std::shared_ptr<DMFilePackCache>;
+
+} // namespace DM
+} // namespace DB
@@ -23,6 +23,8 @@
 #include <Storages/DeltaMerge/File/DMFile.h>
 #include <Storages/DeltaMerge/Filter/FilterHelper.h>
 #include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
+#include <Storages/DeltaMerge/Index/NgramIndex.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
 #include <Storages/DeltaMerge/ScanContext.h>
 
@@ -194,12 +196,16 @@ private:
             for (auto & attr : attrs)
             {
                 tryLoadIndex(attr.col_id);
+                tryLoadEqualIndex(attr.col_id);
+                tryLoadNgramIndex(attr.col_id);
             }
 
+            param.like_pruned_packs = 0;
             for (size_t i = 0; i < pack_count; ++i)
             {
                 use_packs[i] = (static_cast<bool>(use_packs[i])) && (filter->roughCheck(i, param) != None);
             }
+            scan_context->total_dmfile_like_pruned_packs += param.like_pruned_packs;
         }
 
         for (auto u : use_packs)
@@ -280,6 +286,40 @@ private:
         indexes.emplace(col_id, RSIndex(type, minmax_index));
     }
 
+    template <typename Index>
+    static std::shared_ptr<Index> loadOptionalIndex(const DMFilePtr & dmfile,
+                                                    const FileProviderPtr & file_provider,
+                                                    const String & path,
+                                                    const EncryptionPath & encryption_path,
+                                                    size_t file_size,
+                                                    const ReadLimiterPtr & read_limiter)
+    {
+        if (!dmfile->configuration)
+        {
+            auto buf = ReadBufferFromFileProvider(
+                file_provider,
+                path,
+                encryption_path,
+                std::min(static_cast<size_t>(DBMS_DEFAULT_BUFFER_SIZE), file_size),
+                read_limiter);
+            return Index::read(buf, file_size);
+        }
+        else
+        {
+            auto buf = createReadBufferFromFileBaseByFileProvider(file_provider,
+                                                                  path,
+                                                                  encryption_path,
+                                                                  file_size,
+                                                                  read_limiter,
+                                                                  dmfile->configuration->getChecksumAlgorithm(),
+                                                                  dmfile->configuration->getChecksumFrameLength());
+            auto header_size = dmfile->configuration->getChecksumHeaderLength();
+            auto frame_total_size = dmfile->configuration->getChecksumFrameLength() + header_size;
+            auto frame_count = file_size / frame_total_size + (file_size % frame_total_size != 0);
+            return Index::read(*buf, file_size - header_size * frame_count);
+        }
+    }
+
     void tryLoadIndex(const ColId col_id)
     {
         if (param.indexes.count(col_id))
@@ -294,6 +334,53 @@ private:
         scan_context->total_dmfile_rough_set_index_load_time_ns += watch.elapsed();
     }
 
+    // The bloom filter and the ngram index are only useful for the filter in where clause, so they are
+    // loaded separately from the minmax index, which is also used for handle ranges and versions.
+    void tryLoadEqualIndex(const ColId col_id)
+    {
+        auto it = param.indexes.find(col_id);
+        if (it == param.indexes.end() || it->second.equal)
+            return;
+
+        if (!dmfile->isColBloomFilterExist(col_id))
+            return;
+
+        Stopwatch watch;
+        const auto file_name_base = DMFile::getFileNameBase(col_id);
+        it->second.equal = loadOptionalIndex<BloomFilterIndex>(
+            dmfile,
+            file_provider,
+            dmfile->colBloomFilterPath(file_name_base),
+            dmfile->encryptionBloomFilterPath(file_name_base),
+            dmfile->colBloomFilterSize(col_id),
+            read_limiter);
+
+        scan_context->total_dmfile_rough_set_index_load_time_ns += watch.elapsed();
+    }
+
+    void tryLoadNgramIndex(const ColId col_id)
+    {
+        auto it = param.indexes.find(col_id);
+        if (it == param.indexes.end() || it->second.ngram)
+            return;
+
+        if (!dmfile->isColNgramIndexExist(col_id))
+            return;
+
+        Stopwatch watch;
+        const auto file_name_base = DMFile::getFileNameBase(col_id);
+        const auto path = dmfile->colNgramIndexPath(file_name_base);
+        it->second.ngram = loadOptionalIndex<NgramIndex>(
+            dmfile,
+            file_provider,
+            path,
+            dmfile->encryptionNgramIndexPath(file_name_base),
+            Poco::File(path).getSize(),
+            read_limiter);
+
+        scan_context->total_dmfile_rough_set_index_load_time_ns += watch.elapsed();
+    }
+
 private:
     DMFilePtr dmfile;
     MinMaxIndexCachePtr index_cache;
@@ -182,6 +182,7 @@ DMFileReader::DMFileReader(
     const MarkCachePtr & mark_cache_,
     bool enable_column_cache_,
     const ColumnCachePtr & column_cache_,
+    const DMFilePackCachePtr & pack_cache_,
     size_t aio_threshold,
     size_t max_read_buffer_size,
     const FileProviderPtr & file_provider_,
@@ -204,6 +205,8 @@ DMFileReader::DMFileReader(
     , mark_cache(mark_cache_)
     , enable_column_cache(enable_column_cache_ && column_cache_)
     , column_cache(column_cache_)
+    , pack_cache(pack_cache_)
+    , parent_path_hash(std::hash<String>{}(dmfile->parentPath()))
     , scan_context(scan_context_)
     , rows_threshold_per_read(rows_threshold_per_read_)
     , file_provider(file_provider_)
@@ -231,6 +234,17 @@ DMFileReader::DMFileReader(
         const auto data_type = dmfile->getColumnStat(cd.id).type;
         data_type->enumerateStreams(callback, {});
     }
+
+    // Queue the reads of the first packs to read for all the streams, so they can be submitted to the kernel
+    // together when the file buffers support it. It is a no-op for the synchronous buffers.
+    const auto & use_packs = pack_filter.getUsePacks();
+    if (auto first_pack = std::find_if(use_packs.begin(), use_packs.end(), [](UInt8 use) { return use != 0; });
+        first_pack != use_packs.end())
+    {
+        const size_t first_pack_id = first_pack - use_packs.begin();
+        for (auto & iter : column_streams)
+            iter.second->buf->prefetch(iter.second->getOffsetInFile(first_pack_id));
+    }
     if (enable_col_sharing_cache)
     {
         col_data_cache = std::make_unique<ColumnSharingCacheMap>(path(), read_columns, log);
@@ -664,17 +678,19 @@ void DMFileReader::readColumn(ColumnDefine & column_define,
                               size_t read_rows,
                               size_t skip_packs)
 {
-    if (!getCachedPacks(column_define.id, start_pack_id, pack_count, read_rows, column))
+    if (getCachedPacks(column_define.id, start_pack_id, pack_count, read_rows, column)
+        || getPacksFromPackCache(column_define, start_pack_id, pack_count, read_rows, column))
+    {
+        last_read_from_cache[column_define.id] = true;
+    }
+    else
     {
         auto data_type = dmfile->getColumnStat(column_define.id).type;
         auto col = data_type->createColumn();
         readFromDisk(column_define, col, start_pack_id, read_rows, skip_packs, last_read_from_cache[column_define.id]);
         column = std::move(col);
         last_read_from_cache[column_define.id] = false;
-    }
-    else
-    {
-        last_read_from_cache[column_define.id] = true;
+        putPacksToPackCache(column_define.id, start_pack_id, pack_count, column);
     }
 
     if (col_data_cache != nullptr)
@@ -709,5 +725,58 @@ bool DMFileReader::getCachedPacks(ColId col_id, size_t start_pack_id, size_t pac
     col_data_cache->del(col_id, next_pack_id);
     return found;
 }
+
+bool DMFileReader::getPacksFromPackCache(const ColumnDefine & column_define, size_t start_pack_id, size_t pack_count, size_t read_rows, ColumnPtr & col)
+{
+    if (pack_cache == nullptr)
+        return false;
+
+    // Only use the cache when all of the packs are hit, so the packs read from disk are always continuous.
+    // A partial hit reads all of the packs from disk, so it is counted as a miss.
+    std::vector<ColumnPtr> packs;
+    if (!pack_cache->getPacks(DMFilePackCacheKey{dmfile->fileId(), parent_path_hash, column_define.id, start_pack_id}, pack_count, packs))
+    {
+        scan_context->total_dmfile_pack_cache_miss_packs += pack_count;
+        return false;
+    }
+    scan_context->total_dmfile_pack_cache_hit_packs += pack_count;
+
+    if (pack_count == 1)
+    {
+        col = std::move(packs[0]);
+        return true;
+    }
+    auto column = dmfile->getColumnStat(column_define.id).type->createColumn();
+    column->reserve(read_rows);
+    for (const auto & pack : packs)
+        column->insertRangeFrom(*pack, 0, pack->size());
+    col = std::move(column);
+    return true;
+}
+
+void DMFileReader::putPacksToPackCache(ColId col_id, size_t start_pack_id, size_t pack_count, const ColumnPtr & col)
+{
+    if (pack_cache == nullptr)
+        return;
+
+    const auto & pack_stats = dmfile->getPackStats();
+    const size_t total_rows = std::max(col->size(), static_cast<size_t>(1));
+    const size_t total_bytes = col->allocatedBytes();
+    size_t rows_offset = 0;
+    for (size_t pack_id = start_pack_id; pack_id < start_pack_id + pack_count; ++pack_id)
+    {
+        const size_t rows = pack_stats[pack_id].rows;
+        const DMFilePackCacheKey key{dmfile->fileId(), parent_path_hash, col_id, pack_id};
+        // Most packs are rejected by the admission, estimate the bytes of the pack by its rows so that
+        // only the admitted packs are cut from the column.
+        if (pack_cache->admit(key, total_bytes * rows / total_rows))
+        {
+            // Share the column directly if there is only one pack, it is immutable after being read.
+            ColumnPtr pack = pack_count == 1 ? col : col->cut(rows_offset, rows);
+            scan_context->total_dmfile_pack_cache_evicted_bytes += pack_cache->putPack(key, pack);
+        }
+        rows_offset += rows;
+    }
+}
 } // namespace DM
 } // namespace DB
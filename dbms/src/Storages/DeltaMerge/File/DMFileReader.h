@@ -21,6 +21,7 @@
 #include <Storages/DeltaMerge/DeltaMergeHelpers.h>
 #include <Storages/DeltaMerge/File/ColumnCache.h>
 #include <Storages/DeltaMerge/File/DMFile.h>
+#include <Storages/DeltaMerge/File/DMFilePackCache.h>
 #include <Storages/DeltaMerge/File/DMFilePackFilter.h>
 #include <Storages/DeltaMerge/ReadThread/ColumnSharingCache.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
@@ -87,6 +88,7 @@ public:
         const MarkCachePtr & mark_cache_,
         bool enable_column_cache_,
         const ColumnCachePtr & column_cache_,
+        const DMFilePackCachePtr & pack_cache_,
         size_t aio_threshold,
         size_t max_read_buffer_size,
         const FileProviderPtr & file_provider_,
@@ -136,6 +138,8 @@ private:
                     size_t read_rows,
                     size_t skip_packs);
     bool getCachedPacks(ColId col_id, size_t start_pack_id, size_t pack_count, size_t read_rows, ColumnPtr & col);
+    bool getPacksFromPackCache(const ColumnDefine & column_define, size_t start_pack_id, size_t pack_count, size_t read_rows, ColumnPtr & col);
+    void putPacksToPackCache(ColId col_id, size_t start_pack_id, size_t pack_count, const ColumnPtr & col);
 
 private:
     DMFilePtr dmfile;
@@ -166,6 +170,9 @@ private:
     MarkCachePtr mark_cache;
     const bool enable_column_cache;
     ColumnCachePtr column_cache;
+    // Shared among queries, nullptr if it is disabled
+    DMFilePackCachePtr pack_cache;
+    const UInt64 parent_path_hash;
 
     const ScanContextPtr scan_context;
 
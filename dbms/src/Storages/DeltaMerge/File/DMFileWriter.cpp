@@ -46,8 +46,14 @@ DMFileWriter::DMFileWriter(const DMFilePtr & dmfile_,
         // TODO: currently we only generate index for Integers, Date, DateTime types, and this should be configurable by user.
         /// for handle column always generate index
         auto type = removeNullable(cd.type);
-        bool do_index = cd.id == EXTRA_HANDLE_COLUMN_ID || type->isInteger() || type->isDateOrDateTime();
-        addStreams(cd.id, cd.type, do_index);
+        bool do_index = cd.id == EXTRA_HANDLE_COLUMN_ID || type->isInteger() || type->isDateOrDateTime() || type->isString();
+        /// The minmax index of other string columns is only used by the prefix check of LIKE, keep short prefixes of the values.
+        size_t minmax_max_string_size = cd.id != EXTRA_HANDLE_COLUMN_ID && type->isString() ? MINMAX_MAX_STRING_SIZE : 0;
+        /// The extra columns are never compared by an equal filter, and the handle is already pruned by the minmax index.
+        bool do_bloom_filter = options.enable_bloom_filter_index && cd.id != EXTRA_HANDLE_COLUMN_ID && cd.id != VERSION_COLUMN_ID
+            && cd.id != TAG_COLUMN_ID && BloomFilterIndex::isSupportedType(type);
+        bool do_ngram_index = options.enable_ngram_index && NgramIndex::isSupportedType(type);
+        addStreams(cd.id, cd.type, do_index, minmax_max_string_size, do_bloom_filter, do_ngram_index);
         dmfile->column_stats.emplace(cd.id, ColumnStat{cd.id, cd.type, /*avg_size=*/0});
     }
 }
@@ -96,7 +102,7 @@ DMFileWriter::WriteBufferFromFileBasePtr DMFileWriter::createPackStatsFile()
                                      options.max_compress_block_size);
 }
 
-void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index)
+void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index, size_t minmax_max_string_size, bool do_bloom_filter, bool do_ngram_index)
 {
     auto callback = [&](const IDataType::SubstreamPath & substream_path) {
         const auto stream_name = DMFile::getFileNameBase(col_id, substream_path);
@@ -108,7 +114,10 @@ void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index)
             options.max_compress_block_size,
             file_provider,
             write_limiter,
-            IDataType::isNullMap(substream_path) ? false : do_index);
+            IDataType::isNullMap(substream_path) ? false : do_index,
+            minmax_max_string_size,
+            IDataType::isNullMap(substream_path) ? false : do_bloom_filter,
+            IDataType::isNullMap(substream_path) ? false : do_ngram_index);
         column_streams.emplace(stream_name, std::move(stream));
     };
 
@@ -200,6 +209,10 @@ void DMFileWriter::writeColumn(ColId col_id, const IDataType & type, const IColu
                 // For TAG Column, we also ignore del_mark when add minmax index.
                 stream->minmaxes->addPack(column, (col_id == EXTRA_HANDLE_COLUMN_ID || col_id == TAG_COLUMN_ID) ? nullptr : del_mark);
             }
+            if (stream->bloom_filter)
+                stream->bloom_filter->addPack(column, type, del_mark);
+            if (stream->ngram_index)
+                stream->ngram_index->addPack(column, del_mark);
 
             /// There could already be enough data to compress into the new block.
             if (stream->compressed_buf->offset() >= options.min_compress_block_size)
@@ -244,6 +257,7 @@ void DMFileWriter::finalizeColumn(ColId col_id, DataTypePtr type)
     size_t nullmap_data_bytes = 0;
     size_t nullmap_mark_bytes = 0;
     size_t index_bytes = 0;
+    size_t bloom_filter_bytes = 0;
 #ifndef NDEBUG
     auto examine_buffer_size = [](auto & buf, auto & fp) {
         if (!fp.isEncryptionEnabled())
@@ -265,6 +279,28 @@ void DMFileWriter::finalizeColumn(ColId col_id, DataTypePtr type)
         }
         return false;
     };
+    auto write_optional_index = [&](const String & path, const EncryptionPath & encryption_path, auto && write) {
+        if (!dmfile->configuration)
+        {
+            WriteBufferFromFileProvider buf(file_provider, path, encryption_path, false, write_limiter);
+            write(buf);
+            buf.sync();
+            return buf.getMaterializedBytes();
+        }
+        else
+        {
+            auto buf = createWriteBufferFromFileBaseByFileProvider(file_provider,
+                                                                   path,
+                                                                   encryption_path,
+                                                                   false,
+                                                                   write_limiter,
+                                                                   dmfile->configuration->getChecksumAlgorithm(),
+                                                                   dmfile->configuration->getChecksumFrameLength());
+            write(*buf);
+            buf->sync();
+            return buf->getMaterializedBytes();
+        }
+    };
     auto callback = [&](const IDataType::SubstreamPath & substream) {
         const auto stream_name = DMFile::getFileNameBase(col_id, substream);
         auto & stream = column_streams.at(stream_name);
@@ -325,6 +361,22 @@ void DMFileWriter::finalizeColumn(ColId col_id, DataTypePtr type)
 #endif
             }
         }
+        // The bloom filter and the ngram index are optional indexes that can be absent for any column, they are
+        // not counted in `serialized_bytes`, so that it stays consistent with the metav2 fields.
+        // The size of the bloom filter is recorded in `bloom_filter_bytes`, so that the reader of metav2 knows
+        // whether it exists without checking the file.
+        if (stream->bloom_filter)
+        {
+            bloom_filter_bytes = write_optional_index(dmfile->colBloomFilterPath(stream_name), dmfile->encryptionBloomFilterPath(stream_name), [&](WriteBuffer & buf) {
+                stream->bloom_filter->write(buf);
+            });
+        }
+        if (stream->ngram_index)
+        {
+            write_optional_index(dmfile->colNgramIndexPath(stream_name), dmfile->encryptionNgramIndexPath(stream_name), [&](WriteBuffer & buf) {
+                stream->ngram_index->write(buf);
+            });
+        }
     };
     type->enumerateStreams(callback, {});
 
@@ -336,6 +388,7 @@ void DMFileWriter::finalizeColumn(ColId col_id, DataTypePtr type)
     col_stat.nullmap_data_bytes = nullmap_data_bytes;
     col_stat.nullmap_mark_bytes = nullmap_mark_bytes;
     col_stat.index_bytes = index_bytes;
+    col_stat.bloom_filter_bytes = bloom_filter_bytes;
 }
 
 } // namespace DM
@@ -22,7 +22,9 @@
 #include <IO/WriteBufferFromOStream.h>
 #include <Storages/DeltaMerge/DMChecksumConfig.h>
 #include <Storages/DeltaMerge/File/DMFile.h>
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
+#include <Storages/DeltaMerge/Index/NgramIndex.h>
 
 namespace DB
 {
@@ -53,7 +55,10 @@ public:
                size_t max_compress_block_size,
                FileProviderPtr & file_provider,
                const WriteLimiterPtr & write_limiter_,
-               bool do_index)
+               bool do_index,
+               size_t minmax_max_string_size,
+               bool do_bloom_filter,
+               bool do_ngram_index)
             : plain_file(
                 WriteBufferByFileProviderBuilder(
                     dmfile->configuration.has_value(),
@@ -69,7 +74,9 @@ public:
             , compressed_buf(dmfile->configuration
                                  ? std::unique_ptr<WriteBuffer>(new CompressedWriteBuffer<false>(*plain_file, compression_settings))
                                  : std::unique_ptr<WriteBuffer>(new CompressedWriteBuffer<true>(*plain_file, compression_settings)))
-            , minmaxes(do_index ? std::make_shared<MinMaxIndex>(*type) : nullptr)
+            , minmaxes(do_index ? std::make_shared<MinMaxIndex>(*type, minmax_max_string_size) : nullptr)
+            , bloom_filter(do_bloom_filter ? std::make_shared<BloomFilterIndex>() : nullptr)
+            , ngram_index(do_ngram_index ? std::make_shared<NgramIndex>() : nullptr)
             , mark_file(WriteBufferByFileProviderBuilder(
                             dmfile->configuration.has_value(),
                             file_provider,
@@ -85,7 +92,7 @@ public:
 
         void flush()
         {
-            // Note that this method won't flush minmaxes.
+            // Note that this method won't flush minmaxes, bloom_filter and ngram_index.
             compressed_buf->next();
             plain_file->next();
 
@@ -94,8 +101,8 @@ public:
         }
 
         // Get written bytes of `plain_file` && `mark_file`. Should be called after `flush`.
-        // Note that this class don't take responsible for serializing `minmaxes`,
-        // bytes of `minmaxes` won't be counted in this method.
+        // Note that this class don't take responsible for serializing `minmaxes`, `bloom_filter` and `ngram_index`,
+        // bytes of them won't be counted in this method.
         size_t getWrittenBytes() const { return plain_file->getMaterializedBytes() + mark_file->getMaterializedBytes(); }
 
         // compressed_buf -> plain_file
@@ -103,6 +110,8 @@ public:
         WriteBufferPtr compressed_buf;
 
         MinMaxIndexPtr minmaxes;
+        BloomFilterIndexPtr bloom_filter;
+        NgramIndexPtr ngram_index;
         WriteBufferFromFileBasePtr mark_file;
     };
     using StreamPtr = std::unique_ptr<Stream>;
@@ -121,19 +130,31 @@ public:
         CompressionSettings compression_settings;
         size_t min_compress_block_size{};
         size_t max_compress_block_size{};
+        /// Whether to write the ngram index for string columns.
+        bool enable_ngram_index = false;
+        /// Whether to write the bloom filter for integer and string columns.
+        bool enable_bloom_filter_index = false;
 
         Options() = default;
 
-        Options(CompressionSettings compression_settings_, size_t min_compress_block_size_, size_t max_compress_block_size_)
+        Options(CompressionSettings compression_settings_,
+                size_t min_compress_block_size_,
+                size_t max_compress_block_size_,
+                bool enable_ngram_index_ = false,
+                bool enable_bloom_filter_index_ = false)
             : compression_settings(compression_settings_)
             , min_compress_block_size(min_compress_block_size_)
             , max_compress_block_size(max_compress_block_size_)
+            , enable_ngram_index(enable_ngram_index_)
+            , enable_bloom_filter_index(enable_bloom_filter_index_)
         {
         }
 
         Options(const Options & from) = default;
     };
 
+    /// The max size of the min/max values in the minmax index of the non-handle string columns.
+    static constexpr size_t MINMAX_MAX_STRING_SIZE = 64;
 
 public:
     DMFileWriter(const DMFilePtr & dmfile_,
@@ -157,7 +178,7 @@ private:
     /// Add streams with specified column id. Since a single column may have more than one Stream,
     /// for example Nullable column has a NullMap column, we would track them with a mapping
     /// FileNameBase -> Stream.
-    void addStreams(ColId col_id, DataTypePtr type, bool do_index);
+    void addStreams(ColId col_id, DataTypePtr type, bool do_index, size_t minmax_max_string_size, bool do_bloom_filter, bool do_ngram_index);
 
     WriteBufferFromFileBasePtr createMetaFile();
     WriteBufferFromFileBasePtr createMetaV2File();
@@ -32,7 +32,11 @@ public:
     RSResult roughCheck(size_t pack_id, const RSCheckParam & param) override
     {
         GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME(param, attr, rsindex);
-        return rsindex.minmax->checkEqual(pack_id, value, rsindex.type);
+        auto res = rsindex.minmax->checkEqual(pack_id, value, rsindex.type);
+        // The equal index can tell that the value is absent even if it is in the range of [min, max].
+        if (res != None && rsindex.equal && rsindex.equal->checkEqual(pack_id, value, rsindex.type) == None)
+            return None;
+        return res;
     }
 };
 
@@ -52,9 +52,15 @@ public:
     {
         GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME(param, attr, rsindex);
         // TODO optimize for IN
-        RSResult res = rsindex.minmax->checkEqual(pack_id, values[0], rsindex.type);
+        auto check_equal = [&](const Field & value) {
+            auto res = rsindex.minmax->checkEqual(pack_id, value, rsindex.type);
+            if (res != None && rsindex.equal && rsindex.equal->checkEqual(pack_id, value, rsindex.type) == None)
+                return None;
+            return res;
+        };
+        RSResult res = check_equal(values[0]);
         for (size_t i = 1; i < values.size(); ++i)
-            res = res || rsindex.minmax->checkEqual(pack_id, values[i], rsindex.type);
+            res = res || check_equal(values[i]);
         return res;
     }
 };
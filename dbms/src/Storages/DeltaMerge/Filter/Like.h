@@ -20,19 +20,100 @@ namespace DB
 {
 namespace DM
 {
+/// Rough check of `column LIKE pattern` for string columns with a binary collation.
+/// - The literal prefix of the pattern is checked against the minmax index.
+/// - The literal parts of the pattern are checked against the ngram index, if exists.
 class Like : public ColCmpVal
 {
 public:
-    Like(const Attr & attr_, const Field & value_)
+    Like(const Attr & attr_, const Field & value_, Int64 escape_ = '\\')
         : ColCmpVal(attr_, value_, 0)
-    {}
+    {
+        if (value.getType() == Field::Types::String)
+            compile(value.get<String>(), escape_);
+    }
 
     String name() override { return "like"; }
 
-    RSResult roughCheck(size_t /*pack_id*/, const RSCheckParam & /*param*/) override { return Some; }
+    RSResult roughCheck(size_t pack_id, const RSCheckParam & param) override
+    {
+        auto res = checkPattern(pack_id, param);
+        if (res == None)
+            ++param.like_pruned_packs;
+        return res;
+    }
+
+protected:
+    RSResult checkPattern(size_t pack_id, const RSCheckParam & param)
+    {
+        if (!compiled)
+            return Some;
+        GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME(param, attr, rsindex);
+
+        RSResult res = Some;
+        if (!prefix.empty())
+        {
+            res = rsindex.minmax->checkStartsWith(pack_id, prefix, rsindex.type);
+            // Only `prefix%` matches exactly the strings starting with the prefix.
+            if (res == All && !is_prefix_match)
+                res = Some;
+        }
+        if (res == Some && rsindex.ngram && !rsindex.ngram->mayContainAll(pack_id, ngrams))
+            res = None;
+        return res;
+    }
+
+private:
+    // Follow the pattern matching of the binary collators, the escaped character and
+    // the characters other than '%' and '_' match themselves.
+    void compile(const String & pattern, Int64 escape)
+    {
+        // Multi-byte escape character is rare, just skip it.
+        if (escape < 0 || escape > 127)
+            return;
+
+        std::vector<String> literals(1);
+        bool has_wildcard = false;
+        is_prefix_match = true;
+        for (size_t i = 0; i < pattern.size(); ++i)
+        {
+            char c = pattern[i];
+            if (c == escape)
+            {
+                if (i + 1 < pattern.size())
+                    c = pattern[++i];
+            }
+            else if (c == '%' || c == '_')
+            {
+                if (!has_wildcard)
+                    prefix = literals.back();
+                has_wildcard = true;
+                is_prefix_match &= c == '%';
+                literals.emplace_back();
+                continue;
+            }
+            literals.back().push_back(c);
+            is_prefix_match &= !has_wildcard;
+        }
+        if (!has_wildcard)
+        {
+            // An exact match.
+            prefix = literals.back();
+            is_prefix_match = false;
+        }
+        for (const auto & literal : literals)
+            NgramIndex::extractNgrams(literal.data(), literal.size(), ngrams);
+        compiled = true;
+    }
+
+    bool compiled = false;
+    String prefix;
+    /// Whether the pattern is `prefix%`, `prefix%%`, ...
+    bool is_prefix_match = false;
+    std::vector<UInt64> ngrams;
 };
 
 
 } // namespace DM
 
-} // namespace DB
\ No newline at end of file
+} // namespace DB
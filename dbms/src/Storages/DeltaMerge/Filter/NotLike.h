@@ -14,24 +14,43 @@
 
 #pragma once
 
-#include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <Storages/DeltaMerge/Filter/Like.h>
 
 namespace DB
 {
 namespace DM
 {
-class NotLike : public ColCmpVal
+/// `NOT LIKE` can only rule out the packs in which every value matches the pattern,
+/// that is, `Like` returns `All`.
+class NotLike : public Like
 {
 public:
-    NotLike(const Attr & attr_, const Field & value_)
-        : ColCmpVal(attr_, value_, 0)
+    NotLike(const Attr & attr_, const Field & value_, Int64 escape_ = '\\')
+        : Like(attr_, value_, escape_)
     {}
 
     String name() override { return "not_like"; }
 
-    RSResult roughCheck(size_t /*pack_id*/, const RSCheckParam & /*param*/) override { return Some; }
+    RSResult roughCheck(size_t pack_id, const RSCheckParam & param) override
+    {
+        auto res = !checkPattern(pack_id, param);
+        // `NULL NOT LIKE pattern` is NULL rather than true, so the packs with null values are not `All`,
+        // otherwise an enclosing `Not` would rule them out.
+        if (res == All && mayContainNull(pack_id, param))
+            res = Some;
+        if (res == None)
+            ++param.like_pruned_packs;
+        return res;
+    }
+
+private:
+    bool mayContainNull(size_t pack_id, const RSCheckParam & param) const
+    {
+        auto it = param.indexes.find(attr.col_id);
+        return it == param.indexes.end() || it->second.minmax->checkIsNull(pack_id) != None;
+    }
 };
 
 } // namespace DM
 
-} // namespace DB
\ No newline at end of file
+} // namespace DB
@@ -27,6 +27,7 @@
 #include <Storages/DeltaMerge/Filter/NotLike.h>
 #include <Storages/DeltaMerge/Filter/Or.h>
 #include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <Storages/DeltaMerge/Filter/RuntimeFilterCheck.h>
 #include <Storages/DeltaMerge/Filter/Unsupported.h>
 
 namespace DB
@@ -41,14 +42,15 @@ RSOperatorPtr createGreaterEqual(const Attr & attr, const Field & value, int nul
 RSOperatorPtr createIn(const Attr & attr, const Fields & values)                                { return std::make_shared<In>(attr, values); }
 RSOperatorPtr createLess(const Attr & attr, const Field & value, int null_direction)            { return std::make_shared<Less>(attr, value, null_direction); }
 RSOperatorPtr createLessEqual(const Attr & attr, const Field & value, int null_direction)       { return std::make_shared<LessEqual>(attr, value, null_direction); }
-RSOperatorPtr createLike(const Attr & attr, const Field & value)                                { return std::make_shared<Like>(attr, value); }
+RSOperatorPtr createLike(const Attr & attr, const Field & value, Int64 escape)                  { return std::make_shared<Like>(attr, value, escape); }
 RSOperatorPtr createNot(const RSOperatorPtr & op)                                               { return std::make_shared<Not>(op); }
 RSOperatorPtr createNotEqual(const Attr & attr, const Field & value)                            { return std::make_shared<NotEqual>(attr, value); }
 RSOperatorPtr createNotIn(const Attr & attr, const Fields & values)                             { return std::make_shared<NotIn>(attr, values); }
-RSOperatorPtr createNotLike(const Attr & attr, const Field & value)                             { return std::make_shared<NotLike>(attr, value); }
+RSOperatorPtr createNotLike(const Attr & attr, const Field & value, Int64 escape)               { return std::make_shared<NotLike>(attr, value, escape); }
 RSOperatorPtr createOr(const RSOperators & children)                                            { return std::make_shared<Or>(children); }
 RSOperatorPtr createIsNull(const Attr & attr)                                                   { return std::make_shared<IsNull>(attr);}
 RSOperatorPtr createUnsupported(const String & content, const String & reason, bool is_not)     { return std::make_shared<Unsupported>(content, reason, is_not); }
+RSOperatorPtr createRuntimeFilterCheck(const Attr & attr, const RuntimeFilterPtr & runtime_filter) { return std::make_shared<RuntimeFilterCheck>(attr, runtime_filter); }
 // clang-format on
 } // namespace DM
 } // namespace DB
\ No newline at end of file
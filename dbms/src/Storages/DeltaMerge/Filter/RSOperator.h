@@ -21,6 +21,9 @@
 
 namespace DB
 {
+class RuntimeFilter;
+using RuntimeFilterPtr = std::shared_ptr<RuntimeFilter>;
+
 namespace DM
 {
 class RSOperator;
@@ -33,6 +36,8 @@ inline static const RSOperatorPtr EMPTY_FILTER{};
 struct RSCheckParam
 {
     ColumnIndexes indexes;
+    /// Number of packs that LIKE / NOT LIKE returns None for, reported to ScanContext.
+    mutable size_t like_pruned_packs = 0;
 };
 
 
@@ -140,12 +145,14 @@ RSOperatorPtr createLessEqual(const Attr & attr, const Field & value, int null_d
 RSOperatorPtr createIn(const Attr & attr, const Fields & values);
 RSOperatorPtr createNotIn(const Attr & attr, const Fields & values);
 //
-RSOperatorPtr createLike(const Attr & attr, const Field & value);
-RSOperatorPtr createNotLike(const Attr & attr, const Field & values);
+RSOperatorPtr createLike(const Attr & attr, const Field & value, Int64 escape = '\\');
+RSOperatorPtr createNotLike(const Attr & attr, const Field & value, Int64 escape = '\\');
 //
 RSOperatorPtr createIsNull(const Attr & attr);
 //
 RSOperatorPtr createUnsupported(const String & content, const String & reason, bool is_not);
+//
+RSOperatorPtr createRuntimeFilterCheck(const Attr & attr, const RuntimeFilterPtr & runtime_filter);
 
 
 } // namespace DM
@@ -0,0 +1,133 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <DataTypes/DataTypeNullable.h>
+#include <Interpreters/RuntimeFilter.h>
+#include <Storages/DeltaMerge/Filter/RSOperator.h>
+
+#include <atomic>
+#include <mutex>
+
+namespace DB
+{
+namespace DM
+{
+/// Check packs with a runtime filter built by the join build side.
+/// The runtime filter may not be ready when the packs are checked, all packs
+/// are kept in that case. Once it is ready, it is converted into an IN or a
+/// range check on the min-max index.
+class RuntimeFilterCheck : public RSOperator
+{
+    Attr attr;
+    RuntimeFilterPtr runtime_filter;
+
+    std::mutex mu;
+    std::atomic<bool> resolved{false};
+    /// Nullptr if the filter can not be used for pruning.
+    RSOperatorPtr resolved_op;
+    bool prune_all = false;
+
+public:
+    RuntimeFilterCheck(const Attr & attr_, const RuntimeFilterPtr & runtime_filter_)
+        : attr(attr_)
+        , runtime_filter(runtime_filter_)
+    {}
+
+    String name() override { return "runtime_filter"; }
+
+    Attrs getAttrs() override { return {attr}; }
+
+    String toDebugString() override
+    {
+        return R"({"op":")" + name() + R"(","col":")" + attr.col_name + R"(","filter":")" + runtime_filter->toDebugString() + "\"}";
+    }
+
+    RSResult roughCheck(size_t pack_id, const RSCheckParam & param) override
+    {
+        if (!resolve())
+            return Some;
+        if (prune_all)
+            return None;
+        return resolved_op ? resolved_op->roughCheck(pack_id, param) : Some;
+    }
+
+private:
+    /// Return false if the runtime filter is still building.
+    bool resolve()
+    {
+        if (resolved.load(std::memory_order_acquire))
+            return true;
+        if (runtime_filter->getStatus() == RuntimeFilter::Status::Building)
+            return false;
+
+        std::lock_guard lock(mu);
+        if (resolved.load(std::memory_order_relaxed))
+            return true;
+        if (runtime_filter->isReady() && attr.type && removeNullable(attr.type)->isInteger())
+        {
+            // Values out of the range of the column type can never be matched.
+            auto [lower, upper] = getTypeRange();
+            if (runtime_filter->empty())
+            {
+                prune_all = true;
+            }
+            else if (runtime_filter->hasInValues())
+            {
+                Fields values;
+                for (const auto & v : runtime_filter->getInValues())
+                {
+                    if (v >= lower && v <= upper)
+                        values.push_back(toField(v));
+                }
+                if (values.empty())
+                    prune_all = true;
+                else
+                    resolved_op = createIn(attr, values);
+            }
+            else
+            {
+                auto min_value = std::max(runtime_filter->getMin(), lower);
+                auto max_value = std::min(runtime_filter->getMax(), upper);
+                if (min_value > max_value)
+                    prune_all = true;
+                else
+                    resolved_op = createAnd({createGreaterEqual(attr, toField(min_value), -1), createLessEqual(attr, toField(max_value), -1)});
+            }
+        }
+        resolved.store(true, std::memory_order_release);
+        return true;
+    }
+
+    std::pair<Int128, Int128> getTypeRange() const
+    {
+        auto type = removeNullable(attr.type);
+        size_t bits = type->getSizeOfValueInMemory() * 8;
+        if (type->isUnsignedInteger())
+            return {0, (static_cast<Int128>(1) << bits) - 1};
+        return {-(static_cast<Int128>(1) << (bits - 1)), (static_cast<Int128>(1) << (bits - 1)) - 1};
+    }
+
+    Field toField(Int128 value) const
+    {
+        if (removeNullable(attr.type)->isUnsignedInteger())
+            return Field(static_cast<UInt64>(value));
+        return Field(static_cast<Int64>(value));
+    }
+};
+
+} // namespace DM
+
+} // namespace DB
@@ -93,6 +93,31 @@ ColumnID getColumnIDForColumnExpr(const tipb::Expr & expr, const ColumnDefines &
     return columns_to_read[column_index].id;
 }
 
+inline bool isStringType(const Int32 field_type)
+{
+    switch (field_type)
+    {
+    case TiDB::TypeVarchar:
+    case TiDB::TypeVarString:
+    case TiDB::TypeString:
+    case TiDB::TypeTinyBlob:
+    case TiDB::TypeMediumBlob:
+    case TiDB::TypeLongBlob:
+    case TiDB::TypeBlob:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Equal on a string column is checked by the bloom filter on the hash of the bytes, and by the
+// minmax index in byte order. Both are only consistent with the binary collation, note that the
+// padding binary collation ignores the trailing spaces.
+inline bool isEqualSupportedCollator(const TiDB::TiDBCollatorPtr & collator)
+{
+    return collator == nullptr || collator->isBinary();
+}
+
 enum class OperandType
 {
     Unknown = 0,
@@ -135,7 +160,9 @@ inline RSOperatorPtr parseTiCompareExpr( //
                 return createUnsupported(expr.ShortDebugString(), "ColumnRef with no field type is not supported", false);
 
             auto field_type = child.field_type().tp();
-            if (!isRoughSetFilterSupportType(field_type))
+            bool is_string_equal = filter_type == FilterParser::RSFilterType::Equal && isStringType(field_type)
+                && isEqualSupportedCollator(getCollatorFromExpr(expr));
+            if (!isRoughSetFilterSupportType(field_type) && !is_string_equal)
                 return createUnsupported(
                     expr.ShortDebugString(),
                     "ColumnRef with field type(" + DB::toString(field_type) + ") is not supported",
@@ -243,6 +270,49 @@ inline RSOperatorPtr parseTiCompareExpr( //
     return op;
 }
 
+// LIKE is matched byte by byte (or char by char) under these collations, which is
+// consistent with the order of the minmax index and the ngrams of the values.
+inline bool isLikeSupportedCollator(const TiDB::TiDBCollatorPtr & collator)
+{
+    return collator == nullptr || collator->isBinary() || collator->isPaddingBinary();
+}
+
+// Only support `column LIKE 'literal' ESCAPE 'literal'` with a binary collation.
+inline RSOperatorPtr parseTiLikeExpr(
+    const tipb::Expr & expr,
+    const FilterParser::RSFilterType filter_type,
+    const ColumnDefines & columns_to_read,
+    const FilterParser::AttrCreatorByColumnID & creator)
+{
+    if (unlikely(expr.children_size() != 3))
+        return createUnsupported(expr.ShortDebugString(),
+                                 tipb::ScalarFuncSig_Name(expr.sig()) + " with " + DB::toString(expr.children_size())
+                                     + " children is not supported",
+                                 false);
+
+    const auto & column_expr = expr.children(0);
+    const auto & pattern_expr = expr.children(1);
+    const auto & escape_expr = expr.children(2);
+    if (!isColumnExpr(column_expr) || !isLiteralExpr(pattern_expr) || !isLiteralExpr(escape_expr))
+        return createUnsupported(expr.ShortDebugString(), "only column like literal is supported", false);
+    if (unlikely(!column_expr.has_field_type()) || !isStringType(column_expr.field_type().tp()))
+        return createUnsupported(expr.ShortDebugString(), "like on non-string column is not supported", false);
+    if (!isLikeSupportedCollator(getCollatorFromExpr(expr)))
+        return createUnsupported(expr.ShortDebugString(), "like with non-binary collation is not supported", false);
+
+    Field pattern = decodeLiteral(pattern_expr);
+    Field escape = decodeLiteral(escape_expr);
+    if (pattern.getType() != Field::Types::String
+        || (escape.getType() != Field::Types::Int64 && escape.getType() != Field::Types::UInt64))
+        return createUnsupported(expr.ShortDebugString(), "like with unknown literal type is not supported", false);
+
+    Attr attr = creator(getColumnIDForColumnExpr(column_expr, columns_to_read));
+    Int64 escape_char = escape.getType() == Field::Types::Int64 ? escape.get<Int64>() : static_cast<Int64>(escape.get<UInt64>());
+    if (filter_type == FilterParser::RSFilterType::Like)
+        return createLike(attr, pattern, escape_char);
+    return createNotLike(attr, pattern, escape_char);
+}
+
 RSOperatorPtr parseTiExpr(const tipb::Expr & expr,
                           const ColumnDefines & columns_to_read,
                           const FilterParser::AttrCreatorByColumnID & creator,
@@ -277,7 +347,9 @@ RSOperatorPtr parseTiExpr(const tipb::Expr & expr,
             else
             {
                 const auto & child = expr.children(0);
-                if (likely(isFunctionExpr(child)))
+                if (isScalarFunctionExpr(child) && child.sig() == tipb::ScalarFuncSig::LikeSig)
+                    op = parseTiLikeExpr(child, FilterParser::RSFilterType::NotLike, columns_to_read, creator);
+                else if (likely(isFunctionExpr(child)))
                     op = createNot(parseTiExpr(child, columns_to_read, creator, timezone_info, log));
                 else
                     op = createUnsupported(child.ShortDebugString(), "child of logical not is not function", false);
@@ -355,10 +427,13 @@ RSOperatorPtr parseTiExpr(const tipb::Expr & expr,
         }
         break;
 
-        case FilterParser::RSFilterType::In:
-        case FilterParser::RSFilterType::NotIn:
         case FilterParser::RSFilterType::Like:
         case FilterParser::RSFilterType::NotLike:
+            op = parseTiLikeExpr(expr, filter_type, columns_to_read, creator);
+            break;
+
+        case FilterParser::RSFilterType::In:
+        case FilterParser::RSFilterType::NotIn:
         case FilterParser::RSFilterType::Unsupported:
             op = createUnsupported(expr.ShortDebugString(), tipb::ScalarFuncSig_Name(expr.sig()) + " is not supported", false);
             break;
@@ -750,7 +825,7 @@ std::unordered_map<tipb::ScalarFuncSig, FilterParser::RSFilterType> FilterParser
     //{tipb::ScalarFuncSig::IsIPv6, "cast"},
     //{tipb::ScalarFuncSig::UUID, "cast"},
 
-    // {tipb::ScalarFuncSig::LikeSig, "like3Args"},
+    {tipb::ScalarFuncSig::LikeSig, FilterParser::RSFilterType::Like},
     //{tipb::ScalarFuncSig::RegexpBinarySig, "cast"},
     //{tipb::ScalarFuncSig::RegexpSig, "cast"},
 
@@ -0,0 +1,140 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Common/TiFlashException.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
+#include <city.h>
+
+namespace DB
+{
+namespace DM
+{
+namespace
+{
+inline UInt64 hashBytes(const char * data, size_t size)
+{
+    return CityHash_v1_0_2::CityHash64(data, size);
+}
+
+inline UInt64 toKey(const IColumn & column, size_t row, bool is_integer)
+{
+    // Signed and unsigned values share the same key when their bits are equal. It only
+    // introduces false positives, a value is never missed.
+    if (is_integer)
+        return static_cast<UInt64>(column.getInt(row));
+    // String and UUID values are keyed by the hash of their raw bytes.
+    auto data = column.getDataAt(row);
+    return hashBytes(data.data, data.size);
+}
+
+inline bool toKey(const Field & value, bool is_integer, UInt64 & key)
+{
+    switch (value.getType())
+    {
+    case Field::Types::UInt64:
+        if (!is_integer)
+            return false;
+        key = value.get<UInt64>();
+        return true;
+    case Field::Types::Int64:
+        if (!is_integer)
+            return false;
+        key = static_cast<UInt64>(value.get<Int64>());
+        return true;
+    case Field::Types::UInt128:
+    {
+        if (is_integer)
+            return false;
+        const auto & v = value.get<UInt128>();
+        key = hashBytes(reinterpret_cast<const char *>(&v), sizeof(UInt128));
+        return true;
+    }
+    case Field::Types::String:
+    {
+        if (is_integer)
+            return false;
+        const auto & v = value.get<String>();
+        key = hashBytes(v.data(), v.size());
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+} // namespace
+
+bool BloomFilterIndex::isSupportedType(const DataTypePtr & type)
+{
+    auto nested_type = removeNullable(type);
+    return nested_type->isInteger() || nested_type->isString() || nested_type->getTypeId() == TypeIndex::UUID;
+}
+
+void BloomFilterIndex::addPack(const IColumn & column, const IDataType & type, const ColumnVector<UInt8> * del_mark)
+{
+    const auto * del_mark_data = (!del_mark) ? nullptr : &(del_mark->getData());
+    const IDataType * nested_type = &type;
+    if (type.isNullable())
+        nested_type = static_cast<const DataTypeNullable &>(type).getNestedType().get();
+    const bool is_integer = nested_type->isInteger();
+    const IColumn * nested_column = &column;
+    const NullMap * null_map = nullptr;
+    if (column.isColumnNullable())
+    {
+        const auto & nullable_column = static_cast<const ColumnNullable &>(column);
+        nested_column = &nullable_column.getNestedColumn();
+        null_map = &nullable_column.getNullMapData();
+    }
+
+    auto is_valid = [&](size_t i) {
+        return (!del_mark_data || !(*del_mark_data)[i]) && (!null_map || !(*null_map)[i]);
+    };
+
+    size_t valid_rows = 0;
+    for (size_t i = 0; i < column.size(); ++i)
+        valid_rows += is_valid(i);
+
+    // A pack without any valid value owns no words, and it never contains any value.
+    filters.appendPack((valid_rows * BITS_PER_ROW + 63) / 64);
+    for (size_t i = 0; i < column.size(); ++i)
+    {
+        if (is_valid(i))
+            filters.insertKey(toKey(*nested_column, i, is_integer));
+    }
+}
+
+RSResult BloomFilterIndex::checkEqual(size_t pack_index, const Field & value, const DataTypePtr & type) const
+{
+    UInt64 key = 0;
+    if (unlikely(pack_index >= packCount()) || !isSupportedType(type) || !toKey(value, removeNullable(type)->isInteger(), key))
+        return RSResult::Some;
+    return filters.mayContain(pack_index, key) ? RSResult::Some : RSResult::None;
+}
+
+BloomFilterIndexPtr BloomFilterIndex::read(ReadBuffer & buf, size_t bytes_limit)
+{
+    auto index = std::make_shared<BloomFilterIndex>();
+    size_t bytes_read = index->filters.read(buf);
+    if (unlikely(bytes_read != bytes_limit))
+    {
+        throw DB::TiFlashException("Bad file format: expected read bloom filter content size: " + std::to_string(bytes_limit)
+                                       + " vs. actual: " + std::to_string(bytes_read),
+                                   Errors::DeltaTree::Internal);
+    }
+    return index;
+}
+
+} // namespace DM
+} // namespace DB
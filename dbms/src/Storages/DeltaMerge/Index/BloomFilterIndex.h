@@ -0,0 +1,59 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/ColumnVector.h>
+#include <DataTypes/IDataType.h>
+#include <Storages/DeltaMerge/Index/PackBloomFilters.h>
+#include <Storages/DeltaMerge/Index/RSIndex.h>
+
+namespace DB
+{
+namespace DM
+{
+class BloomFilterIndex;
+using BloomFilterIndexPtr = std::shared_ptr<BloomFilterIndex>;
+
+/// A per-pack bloom filter over the values of an integer, string or UUID column.
+/// It is stored in a separate file next to the minmax index, and is used to prove that
+/// a pack does not contain a value even when the value lies inside the [min, max] range of the pack.
+class BloomFilterIndex : public EqualIndex
+{
+public:
+    /// Number of bits reserved for each row in a pack, about 1% false positive rate with 3 probes.
+    static constexpr size_t BITS_PER_ROW = 10;
+
+    /// Integers are keyed by their value. Strings and UUIDs are keyed by the hash of their raw bytes,
+    /// so a string column can only be checked by a filter with a binary collation.
+    static bool isSupportedType(const DataTypePtr & type);
+
+    size_t byteSize() const { return filters.byteSize(); }
+
+    size_t packCount() const { return filters.packCount(); }
+
+    void addPack(const IColumn & column, const IDataType & type, const ColumnVector<UInt8> * del_mark);
+
+    void write(WriteBuffer & buf) const { filters.write(buf); }
+
+    static BloomFilterIndexPtr read(ReadBuffer & buf, size_t bytes_limit);
+
+    RSResult checkEqual(size_t pack_index, const Field & value, const DataTypePtr & type) const override;
+
+private:
+    PackBloomFilters filters;
+};
+
+} // namespace DM
+} // namespace DB
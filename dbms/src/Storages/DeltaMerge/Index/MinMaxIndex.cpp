@@ -123,8 +123,16 @@ void MinMaxIndex::addPack(const IColumn & column, const ColumnVector<UInt8> * de
     {
         has_null_marks->push_back(has_null);
         has_value_marks->push_back(1);
-        minmaxes->insertFrom(column, min_index);
-        minmaxes->insertFrom(column, max_index);
+        if (max_string_size > 0)
+        {
+            insertTruncatedString(column, min_index, false);
+            insertTruncatedString(column, max_index, true);
+        }
+        else
+        {
+            minmaxes->insertFrom(column, min_index);
+            minmaxes->insertFrom(column, max_index);
+        }
     }
     else
     {
@@ -135,6 +143,43 @@ void MinMaxIndex::addPack(const IColumn & column, const ColumnVector<UInt8> * de
     }
 }
 
+void MinMaxIndex::insertTruncatedString(const IColumn & column, size_t row, bool is_max)
+{
+    const IColumn * from = &column;
+    IColumn * to = minmaxes.get();
+    if (column.isColumnNullable())
+    {
+        from = &static_cast<const ColumnNullable &>(column).getNestedColumn();
+        auto & to_nullable = static_cast<ColumnNullable &>(*minmaxes);
+        to_nullable.getNullMapData().push_back(0);
+        to = &to_nullable.getNestedColumn();
+    }
+
+    const auto value = from->getDataAt(row);
+    if (value.size <= max_string_size)
+    {
+        to->insertData(value.data, value.size);
+        return;
+    }
+    if (!is_max)
+    {
+        // A prefix is never greater than the value.
+        to->insertData(value.data, max_string_size);
+        return;
+    }
+    // Increase the last byte of the prefix that is not 0xFF to get a greater value, e.g. "ab\xFFc" -> "ac".
+    String bound(value.data, max_string_size);
+    while (!bound.empty() && static_cast<UInt8>(bound.back()) == 0xFF)
+        bound.pop_back();
+    if (bound.empty())
+    {
+        to->insertData(value.data, value.size);
+        return;
+    }
+    bound.back() = static_cast<char>(static_cast<UInt8>(bound.back()) + 1);
+    to->insertData(bound.data(), bound.size());
+}
+
 void MinMaxIndex::write(const IDataType & type, WriteBuffer & buf)
 {
     UInt64 size = has_null_marks->size();
@@ -249,10 +294,10 @@ RSResult MinMaxIndex::checkNullableEqual(size_t pack_index, const Field & value,
         size_t pos = pack_index * 2;
         size_t prev_offset = pos == 0 ? 0 : offsets[pos - 1];
         // todo use StringRef instead of String
-        auto min = String(chars[prev_offset], offsets[pos] - prev_offset - 1);
+        auto min = String(reinterpret_cast<const char *>(&chars[prev_offset]), offsets[pos] - prev_offset - 1);
         pos = pack_index * 2 + 1;
         prev_offset = offsets[pos - 1];
-        auto max = String(chars[prev_offset], offsets[pos] - prev_offset - 1);
+        auto max = String(reinterpret_cast<const char *>(&chars[prev_offset]), offsets[pos] - prev_offset - 1);
         return RoughCheck::checkEqual<String>(value, type, min, max);
     }
     return RSResult::Some;
@@ -312,10 +357,10 @@ RSResult MinMaxIndex::checkEqual(size_t pack_index, const Field & value, const D
         size_t pos = pack_index * 2;
         size_t prev_offset = pos == 0 ? 0 : offsets[pos - 1];
         // todo use StringRef instead of String
-        auto min = String(chars[prev_offset], offsets[pos] - prev_offset - 1);
+        auto min = String(reinterpret_cast<const char *>(&chars[prev_offset]), offsets[pos] - prev_offset - 1);
         pos = pack_index * 2 + 1;
         prev_offset = offsets[pos - 1];
-        auto max = String(chars[prev_offset], offsets[pos] - prev_offset - 1);
+        auto max = String(reinterpret_cast<const char *>(&chars[prev_offset]), offsets[pos] - prev_offset - 1);
         return RoughCheck::checkEqual<String>(value, type, min, max);
     }
     return RSResult::Some;
@@ -378,10 +423,10 @@ RSResult MinMaxIndex::checkNullableGreater(size_t pack_index, const Field & valu
         size_t pos = pack_index * 2;
         size_t prev_offset = pos == 0 ? 0 : offsets[pos - 1];
         // todo use StringRef instead of String
-        auto min = String(chars[prev_offset], offsets[pos] - prev_offset - 1);
+        auto min = String(reinterpret_cast<const char *>(&chars[prev_offset]), offsets[pos] - prev_offset - 1);
         pos = pack_index * 2 + 1;
         prev_offset = offsets[pos - 1];
-        auto max = String(chars[prev_offset], offsets[pos] - prev_offset - 1);
+        auto max = String(reinterpret_cast<const char *>(&chars[prev_offset]), offsets[pos] - prev_offset - 1);
         return RoughCheck::checkGreater<String>(value, type, min, max);
     }
     return RSResult::Some;
@@ -441,10 +486,10 @@ RSResult MinMaxIndex::checkGreater(size_t pack_index, const Field & value, const
         size_t pos = pack_index * 2;
         size_t prev_offset = pos == 0 ? 0 : offsets[pos - 1];
         // todo use StringRef instead of String
-        auto min = String(chars[prev_offset], offsets[pos] - prev_offset - 1);
+        auto min = String(reinterpret_cast<const char *>(&chars[prev_offset]), offsets[pos] - prev_offset - 1);
         pos = pack_index * 2 + 1;
         prev_offset = offsets[pos - 1];
-        auto max = String(chars[prev_offset], offsets[pos] - prev_offset - 1);
+        auto max = String(reinterpret_cast<const char *>(&chars[prev_offset]), offsets[pos] - prev_offset - 1);
         return RoughCheck::checkGreater<String>(value, type, min, max);
     }
     return RSResult::Some;
@@ -592,6 +637,42 @@ RSResult MinMaxIndex::checkIsNull(size_t pack_index)
     }
 }
 
+RSResult MinMaxIndex::checkStartsWith(size_t pack_index, const String & prefix, const DataTypePtr & type)
+{
+    if (!(*has_value_marks)[pack_index])
+        return RSResult::None;
+    if (!removeNullable(type)->isString())
+        return RSResult::Some;
+
+    const IColumn * column = minmaxes.get();
+    if (column->isColumnNullable())
+    {
+        const auto & column_nullable = static_cast<const ColumnNullable &>(*column);
+        // The minmax index generated by the version before v6.4 may have a null min value.
+        if (column_nullable.isNullAt(pack_index * 2))
+            return RSResult::Some;
+        column = &column_nullable.getNestedColumn();
+    }
+
+    const StringRef prefix_ref(prefix);
+    auto starts_with = [&](const StringRef & s) {
+        return s.size >= prefix_ref.size && memcmp(s.data, prefix_ref.data, prefix_ref.size) == 0;
+    };
+    const auto min = column->getDataAt(pack_index * 2);
+    const auto max = column->getDataAt(pack_index * 2 + 1);
+    const bool min_match = starts_with(min);
+    if (min_match && starts_with(max))
+    {
+        // All the values in between share the prefix too. Null values never match.
+        return (*has_null_marks)[pack_index] ? RSResult::Some : RSResult::All;
+    }
+    // Strings with the prefix are all in [prefix, the largest string with the prefix],
+    // a min value greater than `prefix` without the prefix is greater than all of them.
+    if (max < prefix_ref || (!min_match && prefix_ref < min))
+        return RSResult::None;
+    return RSResult::Some;
+}
+
 String MinMaxIndex::toString()
 {
     return "";
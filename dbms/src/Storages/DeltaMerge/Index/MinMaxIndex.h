@@ -40,6 +40,8 @@ private:
     HasNullMarkPtr has_null_marks;
     HasValueMarkPtr has_value_marks;
     MutableColumnPtr minmaxes;
+    /// Only for the string columns, if not 0, the min/max values longer than it are truncated to a lower/upper bound of this size.
+    size_t max_string_size = 0;
 
 public:
 #ifndef DBMS_PUBLIC_GTEST
@@ -53,10 +55,11 @@ private:
     }
 
 public:
-    explicit MinMaxIndex(const IDataType & type)
+    explicit MinMaxIndex(const IDataType & type, size_t max_string_size_ = 0)
         : has_null_marks(std::make_shared<PaddedPODArray<UInt8>>())
         , has_value_marks(std::make_shared<PaddedPODArray<UInt8>>())
         , minmaxes(type.createColumn())
+        , max_string_size(max_string_size_)
     {
     }
 
@@ -81,11 +84,16 @@ public:
     RSResult checkGreater(size_t pack_index, const Field & value, const DataTypePtr & type, int nan_direction);
     RSResult checkGreaterEqual(size_t pack_index, const Field & value, const DataTypePtr & type, int nan_direction);
     RSResult checkIsNull(size_t pack_index);
+    /// Check whether the string values of the pack start with `prefix`. Only for string columns.
+    RSResult checkStartsWith(size_t pack_index, const String & prefix, const DataTypePtr & type);
 
     static String toString();
     RSResult checkNullableEqual(size_t pack_index, const Field & value, const DataTypePtr & type);
     RSResult checkNullableGreater(size_t pack_index, const Field & value, const DataTypePtr & type);
     RSResult checkNullableGreaterEqual(size_t pack_index, const Field & value, const DataTypePtr & type);
+
+private:
+    void insertTruncatedString(const IColumn & column, size_t row, bool is_max);
 };
 
 
@@ -0,0 +1,99 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Common/TiFlashException.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <Storages/DeltaMerge/Index/NgramIndex.h>
+
+#include <algorithm>
+
+namespace DB
+{
+namespace DM
+{
+bool NgramIndex::isSupportedType(const DataTypePtr & type)
+{
+    return removeNullable(type)->isString();
+}
+
+void NgramIndex::extractNgrams(const char * str, size_t size, std::vector<UInt64> & keys)
+{
+    static_assert(NGRAM_SIZE <= sizeof(UInt64));
+    for (size_t i = 0; i + NGRAM_SIZE <= size; ++i)
+    {
+        UInt64 key = 0;
+        for (size_t j = 0; j < NGRAM_SIZE; ++j)
+            key = (key << 8) | static_cast<UInt8>(str[i + j]);
+        keys.push_back(key);
+    }
+}
+
+void NgramIndex::addPack(const IColumn & column, const ColumnVector<UInt8> * del_mark)
+{
+    const auto * del_mark_data = (!del_mark) ? nullptr : &(del_mark->getData());
+    const IColumn * nested_column = &column;
+    const NullMap * null_map = nullptr;
+    if (column.isColumnNullable())
+    {
+        const auto & nullable_column = static_cast<const ColumnNullable &>(column);
+        nested_column = &nullable_column.getNestedColumn();
+        null_map = &nullable_column.getNullMapData();
+    }
+    const auto & string_column = static_cast<const ColumnString &>(*nested_column);
+
+    std::vector<UInt64> keys;
+    for (size_t i = 0; i < column.size(); ++i)
+    {
+        if ((del_mark_data && (*del_mark_data)[i]) || (null_map && (*null_map)[i]))
+            continue;
+        auto value = string_column.getDataAt(i);
+        extractNgrams(value.data, value.size, keys);
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    filters.appendPack(std::min((keys.size() * BITS_PER_NGRAM + 63) / 64, MAX_WORDS_PER_PACK));
+    for (auto key : keys)
+        filters.insertKey(key);
+}
+
+bool NgramIndex::mayContainAll(size_t pack_index, const std::vector<UInt64> & keys) const
+{
+    if (unlikely(pack_index >= packCount()))
+        return true;
+    for (auto key : keys)
+    {
+        if (!filters.mayContain(pack_index, key))
+            return false;
+    }
+    return true;
+}
+
+NgramIndexPtr NgramIndex::read(ReadBuffer & buf, size_t bytes_limit)
+{
+    auto index = std::make_shared<NgramIndex>();
+    size_t bytes_read = index->filters.read(buf);
+    if (unlikely(bytes_read != bytes_limit))
+    {
+        throw DB::TiFlashException("Bad file format: expected read ngram index content size: " + std::to_string(bytes_limit)
+                                       + " vs. actual: " + std::to_string(bytes_read),
+                                   Errors::DeltaTree::Internal);
+    }
+    return index;
+}
+
+} // namespace DM
+} // namespace DB
@@ -0,0 +1,62 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/ColumnVector.h>
+#include <DataTypes/IDataType.h>
+#include <Storages/DeltaMerge/Index/PackBloomFilters.h>
+
+namespace DB
+{
+namespace DM
+{
+class NgramIndex;
+using NgramIndexPtr = std::shared_ptr<NgramIndex>;
+
+/// A per-pack bloom filter over the byte ngrams of a string column.
+/// A LIKE pattern can only match a row when every ngram of its literal parts occurs in the row,
+/// so a pack missing any of them can be skipped, e.g. `msg LIKE '%timeout%'`.
+class NgramIndex
+{
+public:
+    static constexpr size_t NGRAM_SIZE = 3;
+    static constexpr size_t BITS_PER_NGRAM = 8;
+    /// Upper bound of the filter size of each pack, 64 KiB. Packs with more ngrams get a higher false positive rate.
+    static constexpr size_t MAX_WORDS_PER_PACK = 8192;
+
+    static bool isSupportedType(const DataTypePtr & type);
+
+    /// Append the keys of all ngrams in `str` to `keys`.
+    static void extractNgrams(const char * str, size_t size, std::vector<UInt64> & keys);
+
+    size_t byteSize() const { return filters.byteSize(); }
+
+    size_t packCount() const { return filters.packCount(); }
+
+    void addPack(const IColumn & column, const ColumnVector<UInt8> * del_mark);
+
+    void write(WriteBuffer & buf) const { filters.write(buf); }
+
+    static NgramIndexPtr read(ReadBuffer & buf, size_t bytes_limit);
+
+    /// Return false if there is no row in the pack containing all of the ngram `keys`.
+    bool mayContainAll(size_t pack_index, const std::vector<UInt64> & keys) const;
+
+private:
+    PackBloomFilters filters;
+};
+
+} // namespace DM
+} // namespace DB
@@ -0,0 +1,95 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/HashTable/Hash.h>
+#include <IO/ReadHelpers.h>
+#include <IO/WriteHelpers.h>
+#include <Storages/DeltaMerge/Index/PackBloomFilters.h>
+
+namespace DB
+{
+namespace DM
+{
+namespace
+{
+template <typename F>
+inline void forEachBit(UInt64 key, UInt64 num_bits, F && f)
+{
+    const UInt64 hash = intHash64(key);
+    const UInt64 h1 = hash & 0xFFFFFFFF;
+    const UInt64 h2 = (hash >> 32) | 1;
+    for (size_t i = 0; i < PackBloomFilters::NUM_HASHES; ++i)
+    {
+        if (!f((h1 + i * h2) % num_bits))
+            return;
+    }
+}
+} // namespace
+
+void PackBloomFilters::appendPack(size_t num_words)
+{
+    words.resize_fill(words.size() + num_words, 0);
+    pack_offsets.push_back(words.size());
+}
+
+void PackBloomFilters::insertKey(UInt64 key)
+{
+    const size_t pack_index = packCount() - 1;
+    UInt64 * pack_words = words.data() + pack_offsets[pack_index];
+    const UInt64 num_bits = (pack_offsets[pack_index + 1] - pack_offsets[pack_index]) * 64;
+    if (unlikely(num_bits == 0))
+        return;
+    forEachBit(key, num_bits, [&](UInt64 bit) {
+        pack_words[bit / 64] |= (1ULL << (bit % 64));
+        return true;
+    });
+}
+
+bool PackBloomFilters::mayContain(size_t pack_index, UInt64 key) const
+{
+    const UInt64 num_bits = (pack_offsets[pack_index + 1] - pack_offsets[pack_index]) * 64;
+    if (num_bits == 0)
+        return false;
+
+    const UInt64 * pack_words = words.data() + pack_offsets[pack_index];
+    bool contains = true;
+    forEachBit(key, num_bits, [&](UInt64 bit) {
+        contains = pack_words[bit / 64] & (1ULL << (bit % 64));
+        return contains;
+    });
+    return contains;
+}
+
+void PackBloomFilters::write(WriteBuffer & buf) const
+{
+    UInt64 size = packCount();
+    DB::writeIntBinary(size, buf);
+    buf.write(reinterpret_cast<const char *>(pack_offsets.data()), sizeof(UInt64) * pack_offsets.size());
+    buf.write(reinterpret_cast<const char *>(words.data()), sizeof(UInt64) * words.size());
+}
+
+size_t PackBloomFilters::read(ReadBuffer & buf)
+{
+    size_t buf_pos = buf.count();
+    UInt64 size = 0;
+    DB::readIntBinary(size, buf);
+    pack_offsets.resize(size + 1);
+    buf.readStrict(reinterpret_cast<char *>(pack_offsets.data()), sizeof(UInt64) * pack_offsets.size());
+    words.resize(pack_offsets.back());
+    buf.readStrict(reinterpret_cast<char *>(words.data()), sizeof(UInt64) * words.size());
+    return buf.count() - buf_pos;
+}
+
+} // namespace DM
+} // namespace DB
@@ -0,0 +1,61 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/PODArray.h>
+#include <IO/ReadBuffer.h>
+#include <IO/WriteBuffer.h>
+
+namespace DB
+{
+namespace DM
+{
+/// A list of bloom filters, one for each pack. The keys are already hashed by the caller.
+/// It is the storage shared by the pack level bloom filter indexes.
+class PackBloomFilters
+{
+public:
+    static constexpr size_t NUM_HASHES = 3;
+
+    PackBloomFilters() { pack_offsets.push_back(0); }
+
+    size_t byteSize() const { return sizeof(UInt64) * pack_offsets.size() + sizeof(UInt64) * words.size(); }
+
+    size_t packCount() const { return pack_offsets.size() - 1; }
+
+    /// Append a new pack with `num_words` * 64 bits. A pack without any word contains nothing.
+    void appendPack(size_t num_words);
+
+    /// Insert the key into the last pack.
+    void insertKey(UInt64 key);
+
+    bool mayContain(size_t pack_index, UInt64 key) const;
+
+    void write(WriteBuffer & buf) const;
+
+    /// Read the filters and return the number of bytes read.
+    size_t read(ReadBuffer & buf);
+
+private:
+    using Words = PaddedPODArray<UInt64>;
+    using Offsets = PaddedPODArray<UInt64>;
+
+    /// The bits of pack `i` are `words[pack_offsets[i], pack_offsets[i + 1])`.
+    Offsets pack_offsets;
+    Words words;
+};
+
+} // namespace DM
+} // namespace DB
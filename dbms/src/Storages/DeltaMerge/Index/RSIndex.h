@@ -15,6 +15,7 @@
 #pragma once
 
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
+#include <Storages/DeltaMerge/Index/NgramIndex.h>
 
 namespace DB
 {
@@ -24,10 +25,14 @@ class EqualIndex;
 using EqualIndexPtr = std::shared_ptr<EqualIndex>;
 
 
+/// An index that answers whether a pack may contain a given value.
+/// It can only prove absence, so `checkEqual` returns either `None` or `Some`.
 class EqualIndex
 {
 public:
     virtual ~EqualIndex() = default;
+
+    virtual RSResult checkEqual(size_t pack_index, const Field & value, const DataTypePtr & type) const = 0;
 };
 
 struct RSIndex
@@ -35,6 +40,7 @@ struct RSIndex
     DataTypePtr type;
     MinMaxIndexPtr minmax;
     EqualIndexPtr equal;
+    NgramIndexPtr ngram;
 
     RSIndex(const DataTypePtr & type_, const MinMaxIndexPtr & minmax_)
         : type(type_)
@@ -41,6 +41,17 @@ public:
     /// sum of skipped rows in dmfiles(both stable and ColumnFileBig) among this query
     std::atomic<uint64_t> total_dmfile_skipped_rows{0};
 
+    /// sum of packs that LIKE / NOT LIKE filters rule out in dmfiles among this query.
+    /// It is not sent back to TiDB because `tipb::TiFlashScanContext` has no such field.
+    std::atomic<uint64_t> total_dmfile_like_pruned_packs{0};
+
+    /// sum of packs read from / missed in the global decompressed pack cache, and the bytes evicted from
+    /// it by the packs this query put in. A partial hit of a read is counted as a miss, because all of the
+    /// packs are read from disk then. They are not sent back to TiDB either.
+    std::atomic<uint64_t> total_dmfile_pack_cache_hit_packs{0};
+    std::atomic<uint64_t> total_dmfile_pack_cache_miss_packs{0};
+    std::atomic<uint64_t> total_dmfile_pack_cache_evicted_bytes{0};
+
     std::atomic<uint64_t> total_dmfile_rough_set_index_load_time_ns{0};
     std::atomic<uint64_t> total_dmfile_read_time_ns{0};
     std::atomic<uint64_t> total_create_snapshot_time_ns{0};
@@ -85,6 +96,10 @@ public:
         total_dmfile_skipped_packs += other.total_dmfile_skipped_packs;
         total_dmfile_scanned_rows += other.total_dmfile_scanned_rows;
         total_dmfile_skipped_rows += other.total_dmfile_skipped_rows;
+        total_dmfile_like_pruned_packs += other.total_dmfile_like_pruned_packs;
+        total_dmfile_pack_cache_hit_packs += other.total_dmfile_pack_cache_hit_packs;
+        total_dmfile_pack_cache_miss_packs += other.total_dmfile_pack_cache_miss_packs;
+        total_dmfile_pack_cache_evicted_bytes += other.total_dmfile_pack_cache_evicted_bytes;
         total_dmfile_rough_set_index_load_time_ns += other.total_dmfile_rough_set_index_load_time_ns;
         total_dmfile_read_time_ns += other.total_dmfile_read_time_ns;
         total_create_snapshot_time_ns += other.total_create_snapshot_time_ns;
@@ -2427,6 +2427,7 @@ BitmapFilterPtr Segment::buildBitmapFilterStableOnly(const DMContext & dm_contex
     }
     if (!has_some_packs)
     {
+        bitmap_filter->runOptimize();
         return bitmap_filter;
     }
 
@@ -2457,6 +2458,7 @@ BitmapFilterPtr Segment::buildBitmapFilterStableOnly(const DMContext & dm_contex
         is_common_handle,
         dm_context.tracing_id);
     bitmap_filter->set(stream);
+    bitmap_filter->runOptimize();
     LOG_DEBUG(log, "total_rows={}, cost={}ms", segment_snap->stable->getDMFilesRows(), sw.elapsedMilliseconds());
     return bitmap_filter;
 }
@@ -0,0 +1,115 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Columns/ColumnsCommon.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <random>
+
+namespace DB
+{
+namespace DM
+{
+namespace tests
+{
+namespace
+{
+constexpr UInt32 TOTAL_ROWS = 1000000;
+constexpr UInt32 PACK_ROWS = 8192;
+} // namespace
+
+// Simulate the MVCC result of a segment: `state.range(0)` per mille of the rows are shadowed by newer
+// versions in the delta, the shadowed rows are clustered in packs like the updates of a real workload.
+class BitmapFilterBench : public benchmark::Fixture
+{
+public:
+    void SetUp(const benchmark::State & state) override
+    {
+        std::mt19937 gen(0); // NOLINT(cert-msc51-cpp)
+        row_ids.resize(TOTAL_ROWS);
+        std::iota(row_ids.begin(), row_ids.end(), 0);
+        filter.assign(TOTAL_ROWS, 1);
+
+        const double unset_ratio = state.range(0) / 1000.0;
+        if (unset_ratio == 0)
+            return;
+        // Updates hit 10x more packs than the ratio, and a part of the rows in each of those packs.
+        const double pack_ratio = std::min(1.0, unset_ratio * 10);
+        std::bernoulli_distribution pack_updated(pack_ratio);
+        std::bernoulli_distribution row_updated(unset_ratio / pack_ratio);
+        for (UInt32 start = 0; start < TOTAL_ROWS; start += PACK_ROWS)
+        {
+            if (!pack_updated(gen))
+                continue;
+            for (UInt32 i = start; i < std::min(TOTAL_ROWS, start + PACK_ROWS); ++i)
+                filter[i] = !row_updated(gen);
+        }
+    }
+
+    BitmapFilterPtr build()
+    {
+        auto bitmap_filter = std::make_shared<BitmapFilter>(TOTAL_ROWS, /*default_value*/ false);
+        bitmap_filter->set(row_ids.data(), TOTAL_ROWS, &filter);
+        bitmap_filter->runOptimize();
+        return bitmap_filter;
+    }
+
+    std::vector<UInt32> row_ids;
+    IColumn::Filter filter;
+};
+
+BENCHMARK_DEFINE_F(BitmapFilterBench, build)
+(benchmark::State & state)
+try
+{
+    for (auto _ : state)
+    {
+        auto bitmap_filter = build();
+        benchmark::DoNotOptimize(bitmap_filter);
+    }
+}
+CATCH
+BENCHMARK_REGISTER_F(BitmapFilterBench, build)->Arg(0)->Arg(10)->Arg(300);
+
+BENCHMARK_DEFINE_F(BitmapFilterBench, scan)
+(benchmark::State & state)
+try
+{
+    auto bitmap_filter = build();
+    IColumn::Filter f(PACK_ROWS);
+    for (auto _ : state)
+    {
+        size_t passed = 0;
+        for (UInt32 start = 0; start < TOTAL_ROWS; start += PACK_ROWS)
+        {
+            UInt32 limit = std::min(PACK_ROWS, TOTAL_ROWS - start);
+            if (bitmap_filter->get(f, start, limit))
+                passed += limit;
+            else
+                passed += countBytesInFilter(f.data(), limit);
+        }
+        benchmark::DoNotOptimize(passed);
+    }
+    state.SetItemsProcessed(state.iterations() * TOTAL_ROWS);
+}
+CATCH
+BENCHMARK_REGISTER_F(BitmapFilterBench, scan)->Arg(0)->Arg(10)->Arg(300);
+
+} // namespace tests
+} // namespace DM
+} // namespace DB
@@ -0,0 +1,131 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <numeric>
+#include <random>
+
+namespace DB
+{
+namespace DM
+{
+namespace tests
+{
+namespace
+{
+void checkSame(const BitmapFilter & filter, const std::vector<bool> & expected)
+{
+    ASSERT_EQ(filter.count(), static_cast<size_t>(std::count(expected.begin(), expected.end(), true)));
+    String s = filter.toDebugString();
+    ASSERT_EQ(s.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        ASSERT_EQ(s[i] == '1', expected[i]) << i;
+
+    // Read with the pack size of DMFile and with unaligned ranges.
+    for (UInt32 limit : {8192, 100, 70000})
+    {
+        for (UInt32 start = 0; start < expected.size(); start += limit + 3)
+        {
+            UInt32 n = std::min<UInt32>(limit, expected.size() - start);
+            IColumn::Filter f(n, 2);
+            bool all_match = filter.get(f, start, n);
+            bool expected_all_match = std::find(expected.begin() + start, expected.begin() + start + n, false) == expected.begin() + start + n;
+            ASSERT_EQ(all_match, expected_all_match) << start;
+            if (!all_match)
+            {
+                for (UInt32 i = 0; i < n; ++i)
+                    ASSERT_EQ(f[i], expected[start + i]) << start + i;
+            }
+        }
+    }
+}
+} // namespace
+
+TEST(BitmapFilterTest, SetRanges)
+try
+{
+    const UInt32 rows = 200000;
+    BitmapFilter filter(rows, false);
+    std::vector<bool> expected(rows, false);
+    auto set = [&](UInt32 start, UInt32 limit) {
+        filter.set(start, limit);
+        std::fill(expected.begin() + start, expected.begin() + start + limit, true);
+    };
+    // A whole container, a range across two containers and small ranges.
+    set(0, 65536);
+    set(100000, 40000);
+    set(150000, 1);
+    set(150063, 66);
+    checkSame(filter, expected);
+    filter.runOptimize();
+    checkSame(filter, expected);
+
+    set(0, rows);
+    filter.runOptimize();
+    checkSame(filter, expected);
+}
+CATCH
+
+TEST(BitmapFilterTest, SetRowIds)
+try
+{
+    std::mt19937 gen(0); // NOLINT(cert-msc51-cpp)
+    for (double unset_ratio : {0.0, 0.01, 0.3, 1.0})
+    {
+        const UInt32 rows = 150000;
+        BitmapFilter filter(rows, false);
+        std::vector<bool> expected(rows, false);
+
+        std::vector<UInt32> row_ids(rows);
+        std::iota(row_ids.begin(), row_ids.end(), 0);
+        std::shuffle(row_ids.begin(), row_ids.end(), gen);
+        IColumn::Filter f(rows);
+        std::bernoulli_distribution unset(unset_ratio);
+        for (UInt32 i = 0; i < rows; ++i)
+        {
+            f[i] = !unset(gen);
+            expected[row_ids[i]] = f[i];
+        }
+        filter.set(row_ids.data(), rows, &f);
+        checkSame(filter, expected);
+        filter.runOptimize();
+        checkSame(filter, expected);
+    }
+}
+CATCH
+
+TEST(BitmapFilterTest, DefaultMatch)
+try
+{
+    const UInt32 rows = 100000;
+    BitmapFilter filter(rows, true);
+    std::vector<bool> expected(rows, true);
+    checkSame(filter, expected);
+
+    std::vector<UInt32> row_ids{5, 70000};
+    IColumn::Filter f{0, 1};
+    filter.set(row_ids.data(), row_ids.size(), &f);
+    expected[5] = false;
+    checkSame(filter, expected);
+    filter.runOptimize();
+    checkSame(filter, expected);
+}
+CATCH
+
+} // namespace tests
+} // namespace DM
+} // namespace DB
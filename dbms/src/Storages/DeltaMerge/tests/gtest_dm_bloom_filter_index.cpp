@@ -0,0 +1,167 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <Storages/DeltaMerge/Index/BloomFilterIndex.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+namespace DB
+{
+namespace DM
+{
+namespace tests
+{
+namespace
+{
+constexpr ColId COL_ID = 1;
+
+// Values are 0, 2, 4, ..., so every odd value inside [min, max] is absent.
+ColumnPtr evenColumn(size_t rows, Int64 start)
+{
+    std::vector<Int64> data;
+    for (size_t i = 0; i < rows; ++i)
+        data.push_back(start + 2 * static_cast<Int64>(i));
+    return createColumn<Int64>(data).column;
+}
+} // namespace
+
+TEST(BloomFilterIndexTest, CheckEqual)
+try
+{
+    auto type = std::make_shared<DataTypeInt64>();
+    BloomFilterIndex index;
+    auto pack0 = evenColumn(8192, 0);
+    auto pack1 = evenColumn(8192, 100000);
+    index.addPack(*pack0, *type, nullptr);
+    index.addPack(*pack1, *type, nullptr);
+    ASSERT_EQ(index.packCount(), 2);
+
+    // No false negative.
+    for (Int64 v = 0; v < 8192 * 2; v += 2)
+        ASSERT_EQ(index.checkEqual(0, Field(v), type), RSResult::Some) << v;
+    ASSERT_EQ(index.checkEqual(1, Field(static_cast<UInt64>(100000)), type), RSResult::Some);
+
+    // Most of the absent values are filtered out.
+    size_t false_positives = 0;
+    for (Int64 v = 1; v < 8192 * 2; v += 2)
+        false_positives += index.checkEqual(0, Field(v), type) == RSResult::Some;
+    ASSERT_LT(false_positives, 8192 / 20);
+
+    // Unsupported value type always returns Some.
+    ASSERT_EQ(index.checkEqual(0, Field(String("1")), type), RSResult::Some);
+}
+CATCH
+
+TEST(BloomFilterIndexTest, NullAndDelMark)
+try
+{
+    auto type = makeNullable(std::make_shared<DataTypeInt64>());
+    BloomFilterIndex index;
+    auto column = createColumn<Nullable<Int64>>({1, std::nullopt, 3, 5}).column;
+    auto del_mark = createColumn<UInt8>({0, 0, 0, 1}).column;
+    index.addPack(*column, *type, static_cast<const ColumnUInt8 *>(del_mark.get()));
+
+    // Pack without any valid value.
+    auto all_deleted = createColumn<UInt8>({1, 1, 1, 1}).column;
+    index.addPack(*column, *type, static_cast<const ColumnUInt8 *>(all_deleted.get()));
+
+    ASSERT_EQ(index.checkEqual(0, Field(static_cast<Int64>(1)), type), RSResult::Some);
+    ASSERT_EQ(index.checkEqual(0, Field(static_cast<Int64>(3)), type), RSResult::Some);
+    ASSERT_EQ(index.checkEqual(1, Field(static_cast<Int64>(1)), type), RSResult::None);
+    ASSERT_EQ(index.checkEqual(1, Field(static_cast<Int64>(5)), type), RSResult::None);
+}
+CATCH
+
+TEST(BloomFilterIndexTest, SerializeAndRoughCheck)
+try
+{
+    auto type = std::make_shared<DataTypeInt64>();
+    auto column = evenColumn(8192, 0);
+
+    BloomFilterIndex index;
+    index.addPack(*column, *type, nullptr);
+    auto minmax = std::make_shared<MinMaxIndex>(*type);
+    minmax->addPack(*column, nullptr);
+
+    WriteBufferFromOwnString write_buf;
+    index.write(write_buf);
+    auto data = write_buf.releaseStr();
+    ASSERT_EQ(data.size(), index.byteSize() + sizeof(UInt64));
+    ReadBufferFromString read_buf(data);
+    auto restored = BloomFilterIndex::read(read_buf, data.size());
+    ASSERT_EQ(restored->packCount(), 1);
+
+    RSCheckParam param;
+    param.indexes.emplace(COL_ID, RSIndex(type, minmax, restored));
+    Attr attr{"a", COL_ID, type};
+
+    ASSERT_EQ(createEqual(attr, Field(static_cast<Int64>(100)))->roughCheck(0, param), RSResult::Some);
+    ASSERT_EQ(createIn(attr, {Field(static_cast<Int64>(1)), Field(static_cast<Int64>(100))})->roughCheck(0, param), RSResult::Some);
+
+    // Count the absent values in [min, max] that the equal index filters out.
+    size_t filtered = 0;
+    for (Int64 v = 1; v < 8192 * 2; v += 2)
+    {
+        filtered += createEqual(attr, Field(v))->roughCheck(0, param) == RSResult::None;
+        ASSERT_EQ(minmax->checkEqual(0, Field(v), type), RSResult::Some);
+    }
+    ASSERT_GT(filtered, 8192 - 8192 / 20);
+}
+CATCH
+
+TEST(BloomFilterIndexTest, StringColumn)
+try
+{
+    auto type = makeNullable(std::make_shared<DataTypeString>());
+    std::vector<std::optional<String>> values;
+    for (size_t i = 0; i < 8192; ++i)
+        values.push_back(i % 100 == 0 ? std::nullopt : std::make_optional(fmt::format("key_{}", 2 * i)));
+    auto column = createColumn<Nullable<String>>(values).column;
+
+    auto index = std::make_shared<BloomFilterIndex>();
+    index->addPack(*column, *type, nullptr);
+    auto minmax = std::make_shared<MinMaxIndex>(*type);
+    minmax->addPack(*column, nullptr);
+
+    // No false negative.
+    for (size_t i = 1; i < 8192; ++i)
+    {
+        if (i % 100 != 0)
+            ASSERT_EQ(index->checkEqual(0, Field(fmt::format("key_{}", 2 * i)), type), RSResult::Some) << i;
+    }
+
+    RSCheckParam param;
+    param.indexes.emplace(COL_ID, RSIndex(type, minmax, index));
+    Attr attr{"a", COL_ID, type};
+
+    // Count the absent values that the equal index filters out.
+    size_t filtered = 0;
+    for (size_t i = 0; i < 8192; ++i)
+        filtered += createEqual(attr, Field(fmt::format("key_{}", 2 * i + 1)))->roughCheck(0, param) == RSResult::None;
+    ASSERT_GT(filtered, 8192 - 8192 / 20);
+
+    // Integer values never match a string column.
+    ASSERT_EQ(index->checkEqual(0, Field(static_cast<Int64>(1)), type), RSResult::Some);
+}
+CATCH
+
+} // namespace tests
+} // namespace DM
+} // namespace DB
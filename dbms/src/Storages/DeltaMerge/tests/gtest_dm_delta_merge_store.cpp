@@ -16,8 +16,10 @@
 #include <Common/FailPoint.h>
 #include <Common/MyTime.h>
 #include <Common/SyncPoint/SyncPoint.h>
+#include <DataStreams/RuntimeFilterBlockInputStream.h>
 #include <DataTypes/DataTypeMyDateTime.h>
 #include <Interpreters/Context.h>
+#include <Interpreters/RuntimeFilter.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
 #include <Storages/DeltaMerge/Filter/RSOperator.h>
@@ -569,6 +571,89 @@ try
 CATCH
 
 
+TEST_P(DeltaMergeStoreRWTest, ReadWithRuntimeFilter)
+try
+{
+    const ColumnDefine col_a_define(2, "col_a", std::make_shared<DataTypeInt64>());
+    {
+        auto table_column_defines = DMTestEnv::getDefaultColumns();
+        table_column_defines->emplace_back(col_a_define);
+
+        store = reload(table_column_defines);
+    }
+
+    const size_t num_rows_write = 50000;
+    {
+        // write to store
+        Block block;
+        {
+            block = DMTestEnv::prepareSimpleWriteBlock(0, num_rows_write, false);
+            block.insert(DB::tests::createColumn<Int64>(
+                createSignedNumbers(0, num_rows_write),
+                col_a_define.name,
+                col_a_define.id));
+        }
+
+        switch (mode)
+        {
+        case TestMode::V1_BlockOnly:
+        case TestMode::V2_BlockOnly:
+            store->write(*db_context, db_context->getSettingsRef(), block);
+            break;
+        default:
+        {
+            auto dm_context = store->newDMContext(*db_context, db_context->getSettingsRef());
+            auto [range, file_ids] = genDMFile(*dm_context, block);
+            store->ingestFiles(dm_context, range, file_ids, false);
+            break;
+        }
+        }
+    }
+
+    // merge into stable layer
+    store->flushCache(*db_context, RowKeyRange::newAll(store->isCommonHandle(), store->getRowKeyColumnSize()));
+    store->compact(*db_context, RowKeyRange::newAll(store->isCommonHandle(), store->getRowKeyColumnSize()));
+    store->mergeDeltaAll(*db_context);
+
+    // The build side of the join has two keys, which are in the first and the sixth pack.
+    auto runtime_filter = std::make_shared<RuntimeFilter>(0, col_a_define.id, 0, 16, 1024);
+    runtime_filter->insert(DB::tests::createColumn<Int64>({100, 45000}));
+    runtime_filter->finalize();
+
+    // The table scan checks packs with the runtime filter through the rough set filter, and filters the rows
+    // of the remaining packs by the runtime filter stream, as the probe side table scan of a join does.
+    const auto & columns = store->getTableColumns();
+    auto scan_context = std::make_shared<ScanContext>();
+    auto filter = createRuntimeFilterCheck(Attr{col_a_define.name, col_a_define.id, col_a_define.type}, runtime_filter);
+    BlockInputStreamPtr in = store->read(*db_context,
+                                         db_context->getSettingsRef(),
+                                         columns,
+                                         {RowKeyRange::newAll(store->isCommonHandle(), store->getRowKeyColumnSize())},
+                                         /* num_streams= */ 1,
+                                         /* max_version= */ std::numeric_limits<UInt64>::max(),
+                                         filter,
+                                         TRACING_NAME,
+                                         /* keep_order= */ false,
+                                         /* is_fast_scan= */ false,
+                                         /* expected_block_size= */ 1024,
+                                         /* read_segments */ {},
+                                         /* extra_table_id_index */ InvalidColumnID,
+                                         /* scan_context */ scan_context)[0];
+    in = std::make_shared<RuntimeFilterBlockInputStream>(in, RuntimeFilters{runtime_filter}, Names{col_a_define.name}, 0, TRACING_NAME);
+    ASSERT_INPUTSTREAM_COLS_UR(
+        in,
+        Strings({col_a_define.name}),
+        createColumns({
+            createColumn<Int64>({100, 45000}),
+        }));
+
+    ASSERT_EQ(scan_context->total_dmfile_scanned_packs, 2);
+    ASSERT_EQ(scan_context->total_dmfile_scanned_rows, 8192 * 2);
+    ASSERT_EQ(scan_context->total_dmfile_skipped_packs, 5);
+    ASSERT_EQ(scan_context->total_dmfile_skipped_rows, num_rows_write - 8192 * 2);
+}
+CATCH
+
 TEST_P(DeltaMergeStoreRWTest, WriteCrashBeforeWalWithoutCache)
 try
 {
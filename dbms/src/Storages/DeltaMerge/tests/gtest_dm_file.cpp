@@ -705,6 +705,98 @@ try
 }
 CATCH
 
+TEST_P(DMFileTest, ReadFilteredByBloomFilter)
+try
+{
+    auto cols = DMTestEnv::getDefaultColumns();
+    // Prepare columns
+    ColumnDefine i64_cd(2, "i64", typeFromString("Int64"));
+    ColumnDefine str_cd(3, "str", typeFromString("String"));
+    cols->push_back(i64_cd);
+    cols->push_back(str_cd);
+
+    reload(cols);
+    dbContext().getSettingsRef().dt_enable_bloom_filter_index = true;
+    SCOPE_EXIT({ dbContext().getSettingsRef().dt_enable_bloom_filter_index = false; });
+
+    const Int64 num_rows_write = 1024;
+    const Int64 nparts = 5;
+    // The values are spread over all packs, so that the [min, max] of every pack covers almost all values
+    // and only the bloom filter can skip packs.
+    auto value_of = [](Int64 pk) {
+        return pk * 37 % num_rows_write;
+    };
+
+    {
+        // Prepare some packs in DMFile
+        auto stream = std::make_shared<DMFileBlockOutputStream>(dbContext(), dm_file, *cols);
+
+        DMFileBlockOutputStream::BlockProperty block_property;
+        stream->writePrefix();
+        size_t pk_beg = 0;
+        for (size_t i = 0; i < nparts; ++i)
+        {
+            size_t pk_end = (i == nparts - 1) ? num_rows_write : (pk_beg + num_rows_write / nparts);
+            Block block = DMTestEnv::prepareSimpleWriteBlock(pk_beg, pk_end, false);
+            std::vector<Int64> i64_values;
+            std::vector<String> str_values;
+            for (size_t pk = pk_beg; pk < pk_end; ++pk)
+            {
+                i64_values.push_back(value_of(pk));
+                str_values.push_back(fmt::format("{:04}", value_of(pk)));
+            }
+            block.insert(DB::tests::createColumn<Int64>(i64_values, i64_cd.name, i64_cd.id));
+            block.insert(DB::tests::createColumn<String>(str_values, str_cd.name, str_cd.id));
+            stream->write(block, block_property);
+            pk_beg += num_rows_write / nparts;
+        }
+        stream->writeSuffix();
+    }
+
+    auto test_read_filter = [&](const ColumnDefine & cd, const Field & value) {
+        auto scan_context = std::make_shared<ScanContext>();
+        DMFileBlockInputStreamBuilder builder(dbContext());
+        auto stream = builder
+                          .setColumnCache(column_cache)
+                          .setRSOperator(createEqual(Attr{cd.name, cd.id, cd.type}, value))
+                          .build(dm_file, *cols, RowKeyRanges{RowKeyRange::newAll(false, 1)}, scan_context);
+        size_t num_rows_read = 0;
+        bool found = false;
+        stream->readPrefix();
+        while (Block block = stream->read())
+        {
+            num_rows_read += block.rows();
+            const auto & pk_column = block.getByName(DMTestEnv::pk_name).column;
+            for (size_t i = 0; i < block.rows(); ++i)
+                found |= pk_column->getInt(i) == 500;
+        }
+        stream->readSuffix();
+        ASSERT_TRUE(found);
+        ASSERT_LT(num_rows_read, static_cast<size_t>(num_rows_write));
+        ASSERT_GT(scan_context->total_dmfile_skipped_packs, 0);
+    };
+
+    auto check_bloom_filter_exist = [&]() {
+        // The extra columns never have a bloom filter.
+        ASSERT_FALSE(dm_file->isColBloomFilterExist(EXTRA_HANDLE_COLUMN_ID));
+        ASSERT_FALSE(dm_file->isColBloomFilterExist(VERSION_COLUMN_ID));
+        ASSERT_FALSE(dm_file->isColBloomFilterExist(TAG_COLUMN_ID));
+        ASSERT_TRUE(dm_file->isColBloomFilterExist(i64_cd.id));
+        ASSERT_TRUE(dm_file->isColBloomFilterExist(str_cd.id));
+    };
+
+    check_bloom_filter_exist();
+    test_read_filter(i64_cd, Field(value_of(500)));
+    test_read_filter(str_cd, Field(fmt::format("{:04}", value_of(500))));
+
+    // Restore file from disk and read again
+    dm_file = restoreDMFile();
+    check_bloom_filter_exist();
+    test_read_filter(i64_cd, Field(value_of(500)));
+    test_read_filter(str_cd, Field(fmt::format("{:04}", value_of(500))));
+}
+CATCH
+
 // Test rough filter with some unsupported operations
 TEST_P(DMFileTest, ReadFilteredByRoughSetFilterWithUnsupportedOperation)
 try
@@ -0,0 +1,131 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <Storages/DeltaMerge/File/DMFilePackCache.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <numeric>
+
+namespace DB
+{
+namespace DM
+{
+namespace tests
+{
+namespace
+{
+ColumnPtr createPack(size_t rows)
+{
+    std::vector<Int64> data(rows);
+    std::iota(data.begin(), data.end(), 0);
+    return createColumn<Int64>(data).column;
+}
+} // namespace
+
+TEST(DMFilePackCacheTest, Admission)
+try
+{
+    DMFilePackCache cache(4 * 1024 * 1024);
+    auto pack = createPack(8192);
+    DMFilePackCacheKey key{1, 100, 2, 0};
+    size_t evicted_bytes = 0;
+
+    // The first read only lets the doorkeeper remember the key.
+    ASSERT_EQ(cache.getPack(key), nullptr);
+    ASSERT_FALSE(cache.tryPutPack(key, pack, evicted_bytes));
+    ASSERT_EQ(cache.getPack(key), nullptr);
+
+    // The pack is admitted when it is read again.
+    ASSERT_TRUE(cache.tryPutPack(key, pack, evicted_bytes));
+    ASSERT_EQ(evicted_bytes, 0);
+    auto cached = cache.getPack(key);
+    ASSERT_NE(cached, nullptr);
+    ASSERT_TRUE(columnEqual(pack, cached));
+
+    // Packs of other files, columns or tables are different.
+    ASSERT_EQ(cache.getPack(DMFilePackCacheKey{2, 100, 2, 0}), nullptr);
+    ASSERT_EQ(cache.getPack(DMFilePackCacheKey{1, 101, 2, 0}), nullptr);
+    ASSERT_EQ(cache.getPack(DMFilePackCacheKey{1, 100, 3, 0}), nullptr);
+    ASSERT_EQ(cache.getPack(DMFilePackCacheKey{1, 100, 2, 1}), nullptr);
+}
+CATCH
+
+TEST(DMFilePackCacheTest, PartialHitIsMiss)
+try
+{
+    DMFilePackCache cache(4 * 1024 * 1024);
+    auto pack = createPack(8192);
+
+    // Only the first pack is cached.
+    DMFilePackCacheKey key{1, 100, 2, 0};
+    ASSERT_FALSE(cache.admit(key, pack->allocatedBytes()));
+    ASSERT_TRUE(cache.admit(key, pack->allocatedBytes()));
+    ASSERT_EQ(cache.putPack(key, pack), 0);
+
+    std::vector<ColumnPtr> packs;
+    ASSERT_FALSE(cache.getPacks(key, 2, packs));
+    ASSERT_TRUE(packs.empty());
+    ASSERT_TRUE(cache.getPacks(key, 1, packs));
+    ASSERT_EQ(packs.size(), 1);
+    ASSERT_TRUE(columnEqual(pack, packs[0]));
+
+    // A pack that is too big is rejected without remembering it.
+    DMFilePackCacheKey big_key{1, 100, 2, 1};
+    ASSERT_FALSE(cache.admit(big_key, 4 * 1024 * 1024));
+    ASSERT_FALSE(cache.admit(big_key, pack->allocatedBytes()));
+}
+CATCH
+
+TEST(DMFilePackCacheTest, BigScanNotFlushCache)
+try
+{
+    auto pack = createPack(8192);
+    const size_t pack_bytes = pack->allocatedBytes();
+    DMFilePackCache cache(pack_bytes * 20);
+    size_t evicted_bytes = 0;
+
+    // A hot small table with 10 packs.
+    for (size_t round = 0; round < 2; ++round)
+    {
+        for (UInt64 pack_id = 0; pack_id < 10; ++pack_id)
+            cache.tryPutPack(DMFilePackCacheKey{1, 100, 1, pack_id}, pack, evicted_bytes);
+    }
+    ASSERT_EQ(cache.count(), 10);
+
+    // A big scan reads every pack once.
+    for (UInt64 pack_id = 0; pack_id < 1000; ++pack_id)
+        ASSERT_FALSE(cache.tryPutPack(DMFilePackCacheKey{2, 100, 1, pack_id}, pack, evicted_bytes));
+    for (UInt64 pack_id = 0; pack_id < 10; ++pack_id)
+        ASSERT_NE(cache.getPack(DMFilePackCacheKey{1, 100, 1, pack_id}), nullptr);
+
+    // Another hot table evicts the old packs when the cache is full.
+    size_t total_evicted_bytes = 0;
+    for (size_t round = 0; round < 2; ++round)
+    {
+        for (UInt64 pack_id = 0; pack_id < 15; ++pack_id)
+        {
+            cache.tryPutPack(DMFilePackCacheKey{3, 100, 1, pack_id}, pack, evicted_bytes);
+            total_evicted_bytes += evicted_bytes;
+        }
+    }
+    ASSERT_EQ(cache.count(), 20);
+    ASSERT_EQ(total_evicted_bytes, pack_bytes * 5);
+}
+CATCH
+
+} // namespace tests
+} // namespace DM
+} // namespace DB
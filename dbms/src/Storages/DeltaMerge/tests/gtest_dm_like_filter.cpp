@@ -0,0 +1,184 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <Storages/DeltaMerge/Index/NgramIndex.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+namespace DB
+{
+namespace DM
+{
+namespace tests
+{
+namespace
+{
+constexpr ColId COL_ID = 1;
+
+MinMaxIndexPtr buildMinMax(const DataTypePtr & type, const std::vector<ColumnPtr> & packs)
+{
+    auto minmax = std::make_shared<MinMaxIndex>(*type);
+    for (const auto & pack : packs)
+        minmax->addPack(*pack, nullptr);
+    return minmax;
+}
+} // namespace
+
+TEST(LikeFilterTest, PrefixWithMinMax)
+try
+{
+    auto type = std::make_shared<DataTypeString>();
+    std::vector<ColumnPtr> packs{
+        createColumn<String>({"apple", "apricot", "avocado"}).column,
+        createColumn<String>({"banana", "berry"}).column,
+        createColumn<String>({"apx1", "apx2"}).column,
+        createColumn<String>({"a%b1", "a%b2"}).column,
+    };
+
+    RSCheckParam param;
+    param.indexes.emplace(COL_ID, RSIndex(type, buildMinMax(type, packs)));
+    Attr attr{"a", COL_ID, type};
+
+    auto like = createLike(attr, Field(String("ap%")));
+    ASSERT_EQ(like->roughCheck(0, param), RSResult::Some);
+    ASSERT_EQ(like->roughCheck(1, param), RSResult::None);
+    ASSERT_EQ(like->roughCheck(2, param), RSResult::All);
+    ASSERT_EQ(like->roughCheck(3, param), RSResult::None);
+    ASSERT_EQ(param.like_pruned_packs, 2);
+
+    // Not a pure prefix pattern, the packs can not be All.
+    ASSERT_EQ(createLike(attr, Field(String("ap_%")))->roughCheck(2, param), RSResult::Some);
+    ASSERT_EQ(createLike(attr, Field(String("apx1")))->roughCheck(2, param), RSResult::Some);
+    ASSERT_EQ(createLike(attr, Field(String("%x1")))->roughCheck(1, param), RSResult::Some);
+
+    // The escaped wildcard is part of the prefix.
+    ASSERT_EQ(createLike(attr, Field(String("a\\%b%")))->roughCheck(3, param), RSResult::All);
+    ASSERT_EQ(createLike(attr, Field(String("a|%b%")), '|')->roughCheck(0, param), RSResult::None);
+
+    param.like_pruned_packs = 0;
+    auto not_like = createNotLike(attr, Field(String("ap%")));
+    ASSERT_EQ(not_like->roughCheck(0, param), RSResult::Some);
+    ASSERT_EQ(not_like->roughCheck(1, param), RSResult::All);
+    ASSERT_EQ(not_like->roughCheck(2, param), RSResult::None);
+    ASSERT_EQ(param.like_pruned_packs, 1);
+}
+CATCH
+
+TEST(LikeFilterTest, PrefixWithNull)
+try
+{
+    auto type = makeNullable(std::make_shared<DataTypeString>());
+    std::vector<ColumnPtr> packs{
+        createColumn<Nullable<String>>({"apx1", std::nullopt}).column,
+        createColumn<Nullable<String>>({std::nullopt, std::nullopt}).column,
+        createColumn<Nullable<String>>({"banana", std::nullopt}).column,
+    };
+
+    RSCheckParam param;
+    param.indexes.emplace(COL_ID, RSIndex(type, buildMinMax(type, packs)));
+    Attr attr{"a", COL_ID, type};
+
+    // NULL LIKE 'ap%' is NULL, so neither LIKE nor NOT LIKE is All.
+    ASSERT_EQ(createLike(attr, Field(String("ap%")))->roughCheck(0, param), RSResult::Some);
+    ASSERT_EQ(createNotLike(attr, Field(String("ap%")))->roughCheck(0, param), RSResult::Some);
+    ASSERT_EQ(createLike(attr, Field(String("ap%")))->roughCheck(1, param), RSResult::None);
+    ASSERT_EQ(createNotLike(attr, Field(String("ap%")))->roughCheck(1, param), RSResult::Some);
+    ASSERT_EQ(createLike(attr, Field(String("ap%")))->roughCheck(2, param), RSResult::None);
+    ASSERT_EQ(createNotLike(attr, Field(String("ap%")))->roughCheck(2, param), RSResult::Some);
+    ASSERT_EQ(createNot(createNotLike(attr, Field(String("ap%"))))->roughCheck(2, param), RSResult::Some);
+}
+CATCH
+
+TEST(LikeFilterTest, TruncatedMinMax)
+try
+{
+    auto type = std::make_shared<DataTypeString>();
+    auto minmax = std::make_shared<MinMaxIndex>(*type, 4);
+    minmax->addPack(*createColumn<String>({"apple pie", "apricot jam"}).column, nullptr);
+    minmax->addPack(*createColumn<String>({"ab\xFF\xFFz", "abc"}).column, nullptr);
+    minmax->addPack(*createColumn<String>({"\xFF\xFF\xFF\xFFz"}).column, nullptr);
+
+    auto [min0, max0] = minmax->getStringMinMax(0);
+    ASSERT_EQ(min0.toString(), "appl");
+    ASSERT_EQ(max0.toString(), "aprj");
+    auto [min1, max1] = minmax->getStringMinMax(1);
+    ASSERT_EQ(min1.toString(), "abc");
+    ASSERT_EQ(max1.toString(), "ac");
+    auto [min2, max2] = minmax->getStringMinMax(2);
+    ASSERT_EQ(min2.toString(), "\xFF\xFF\xFF\xFF");
+    ASSERT_EQ(max2.toString(), "\xFF\xFF\xFF\xFFz");
+
+    RSCheckParam param;
+    param.indexes.emplace(COL_ID, RSIndex(type, minmax));
+    Attr attr{"a", COL_ID, type};
+    ASSERT_EQ(createLike(attr, Field(String("ap%")))->roughCheck(0, param), RSResult::All);
+    ASSERT_EQ(createLike(attr, Field(String("apple%")))->roughCheck(0, param), RSResult::Some);
+    ASSERT_EQ(createLike(attr, Field(String("b%")))->roughCheck(0, param), RSResult::None);
+}
+CATCH
+
+TEST(LikeFilterTest, NgramIndex)
+try
+{
+    auto type = std::make_shared<DataTypeString>();
+    ASSERT_TRUE(NgramIndex::isSupportedType(type));
+    ASSERT_TRUE(NgramIndex::isSupportedType(makeNullable(type)));
+
+    std::vector<ColumnPtr> packs{
+        createColumn<String>({"connection timeout", "ok"}).column,
+        createColumn<String>({"all good", "fine"}).column,
+    };
+    auto del_mark = createColumn<UInt8>({0, 1}).column;
+
+    NgramIndex index;
+    index.addPack(*packs[0], nullptr);
+    index.addPack(*packs[1], static_cast<const ColumnUInt8 *>(del_mark.get()));
+
+    WriteBufferFromOwnString write_buf;
+    index.write(write_buf);
+    auto data = write_buf.releaseStr();
+    ReadBufferFromString read_buf(data);
+    auto restored = NgramIndex::read(read_buf, data.size());
+    ASSERT_EQ(restored->packCount(), 2);
+
+    RSCheckParam param;
+    RSIndex rsindex(type, buildMinMax(type, packs));
+    rsindex.ngram = restored;
+    param.indexes.emplace(COL_ID, rsindex);
+    Attr attr{"a", COL_ID, type};
+
+    auto like = createLike(attr, Field(String("%timeout%")));
+    ASSERT_EQ(like->roughCheck(0, param), RSResult::Some);
+    ASSERT_EQ(like->roughCheck(1, param), RSResult::None);
+    // "fine" is deleted.
+    ASSERT_EQ(createLike(attr, Field(String("%fin_")))->roughCheck(1, param), RSResult::None);
+    ASSERT_EQ(createLike(attr, Field(String("%ll go%")))->roughCheck(1, param), RSResult::Some);
+    // Literals shorter than a ngram can not be checked.
+    ASSERT_EQ(createLike(attr, Field(String("%ok%")))->roughCheck(1, param), RSResult::Some);
+    ASSERT_EQ(param.like_pruned_packs, 2);
+
+    // The ngram index never prunes packs for NOT LIKE.
+    ASSERT_EQ(createNotLike(attr, Field(String("%timeout%")))->roughCheck(1, param), RSResult::All);
+}
+CATCH
+
+} // namespace tests
+} // namespace DM
+} // namespace DB
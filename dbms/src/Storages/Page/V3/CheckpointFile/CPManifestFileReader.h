@@ -19,6 +19,7 @@
 #include <Storages/Page/V3/CheckpointFile/Proto/manifest_file.pb.h>
 #include <Storages/Page/V3/CheckpointFile/fwd.h>
 #include <Storages/Page/V3/PageEntriesEdit.h>
+#include <Storages/S3/S3ParallelReadBuffer.h>
 
 #include <string>
 
@@ -38,8 +39,21 @@ public:
         return std::make_unique<CPManifestFileReader>(std::move(options));
     }
 
+    /// Read the manifest file on S3 directly. The byte ranges of the file are fetched concurrently.
+    static CPManifestFileReaderPtr createFromS3(
+        std::shared_ptr<S3::TiFlashS3Client> client,
+        const String & key,
+        const S3::S3ParallelReadBuffer::Options & read_options = {})
+    {
+        return std::make_unique<CPManifestFileReader>(std::make_unique<S3::S3ParallelReadBuffer>(std::move(client), key, read_options));
+    }
+
     explicit CPManifestFileReader(Options options)
-        : file_reader(std::make_unique<ReadBufferFromFile>(options.file_path))
+        : CPManifestFileReader(std::make_unique<ReadBufferFromFile>(options.file_path))
+    {}
+
+    explicit CPManifestFileReader(std::unique_ptr<ReadBuffer> && file_reader_)
+        : file_reader(std::move(file_reader_))
         , compressed_reader(std::make_unique<CompressedReadBuffer<true>>(*file_reader))
     {}
 
@@ -62,7 +76,7 @@ private:
     };
 
     // compressed<plain_file>
-    const std::unique_ptr<ReadBufferFromFile> file_reader;
+    const std::unique_ptr<ReadBuffer> file_reader;
     const ReadBufferPtr compressed_reader;
 
     ReadStage read_stage = ReadStage::ReadingPrefix;
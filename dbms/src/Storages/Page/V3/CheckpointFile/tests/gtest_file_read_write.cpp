@@ -16,6 +16,8 @@
 #include <Storages/Page/V3/CheckpointFile/CPManifestFileReader.h>
 #include <Storages/Page/V3/CheckpointFile/CPWriteDataSource.h>
 #include <Storages/Page/V3/Universal/UniversalWriteBatchImpl.h>
+#include <Storages/S3/MockS3Client.h>
+#include <Storages/S3/S3Common.h>
 #include <Storages/tests/TiFlashStorageTestBasic.h>
 #include <TestUtils/MockDiskDelegator.h>
 #include <TestUtils/TiFlashTestBasic.h>
@@ -643,4 +645,52 @@ try
 }
 CATCH
 
+TEST_F(CheckpointFileTest, ReadManifestFromS3)
+try
+{
+    auto writer = CPFilesWriter::create({
+        .data_file_path = dir + "/data_1",
+        .data_file_id = "data_1",
+        .manifest_file_path = dir + "/manifest_foo",
+        .manifest_file_id = "manifest_foo",
+        .data_source = CPWriteDataSourceFixture::create({}),
+    });
+    writer->writePrefix({
+        .writer = {},
+        .sequence = 5,
+        .last_sequence = 3,
+    });
+    for (size_t i = 0; i < 100; ++i)
+    {
+        auto edits = universal::PageEntriesEdit{};
+        edits.appendRecord({.type = EditRecordType::VAR_DELETE, .page_id = fmt::format("page_{}", i)});
+        writer->writeEditsAndApplyRemoteInfo(edits);
+    }
+    writer->writeSuffix();
+    writer.reset();
+
+    auto client = std::make_shared<S3::tests::MockS3Client>();
+    S3::uploadFile(*client, client->bucket(), dir + "/manifest_foo", "s1/manifest/mf_5");
+
+    // Use a tiny range size so that the manifest is fetched by many ranged GETs.
+    auto manifest_reader = CPManifestFileReader::createFromS3(client, "s1/manifest/mf_5", {.range_size = 64, .max_inflight_ranges = 3});
+    auto prefix = manifest_reader->readPrefix();
+    ASSERT_EQ(5, prefix.local_sequence());
+    ASSERT_EQ(3, prefix.last_local_sequence());
+    CheckpointProto::StringsInternMap im;
+    size_t n_records = 0;
+    while (auto edits_r = manifest_reader->readEdits(im))
+    {
+        for (const auto & record : edits_r->getRecords())
+        {
+            ASSERT_EQ(fmt::format("page_{}", n_records), record.page_id);
+            ++n_records;
+        }
+    }
+    ASSERT_EQ(100, n_records);
+    ASSERT_FALSE(manifest_reader->readLocks().has_value());
+    ASSERT_GT(client->get_object_count, 1);
+}
+CATCH
+
 } // namespace DB::PS::V3::tests
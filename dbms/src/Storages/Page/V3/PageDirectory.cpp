@@ -31,6 +31,7 @@
 #include <Storages/Page/WriteBatchImpl.h>
 #include <common/logger_useful.h>
 
+#include <algorithm>
 #include <magic_enum.hpp>
 #include <memory>
 #include <mutex>
@@ -954,24 +955,31 @@ typename PageDirectory<Trait>::PageIdAndEntry PageDirectory<Trait>::getByIDImpl(
     while (ok)
     {
         typename MVCCMapType::const_iterator iter;
+        bool not_exist = false;
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            iter = mvcc_table_directory.find(id_to_resolve);
-            if (iter == mvcc_table_directory.end())
+            const auto & shard = mvcc_table_directory.getShard(id_to_resolve);
+            std::shared_lock read_lock(shard.mutex);
+            iter = shard.map.find(id_to_resolve);
+            not_exist = iter == shard.map.end();
+        }
+        if (not_exist)
+        {
+            if (throw_on_not_exist)
             {
-                if (throw_on_not_exist)
+                LOG_WARNING(log, "Dump state for invalid page id [page_id={}]", page_id);
+                for (const auto & shard : mvcc_table_directory)
                 {
-                    LOG_WARNING(log, "Dump state for invalid page id [page_id={}]", page_id);
-                    for (const auto & [dump_id, dump_entry] : mvcc_table_directory)
+                    std::shared_lock read_lock(shard.mutex);
+                    for (const auto & [dump_id, dump_entry] : shard.map)
                     {
                         LOG_WARNING(log, "Dumping state [page_id={}] [entry={}]", dump_id, dump_entry == nullptr ? "<null>" : dump_entry->toDebugString());
                     }
-                    throw Exception(fmt::format("Invalid page id, entry not exist [page_id={}] [resolve_id={}]", page_id, id_to_resolve), ErrorCodes::PS_ENTRY_NOT_EXISTS);
-                }
-                else
-                {
-                    return PageIdAndEntry{page_id, PageEntryV3{.file_id = INVALID_BLOBFILE_ID}};
                 }
+                throw Exception(fmt::format("Invalid page id, entry not exist [page_id={}] [resolve_id={}]", page_id, id_to_resolve), ErrorCodes::PS_ENTRY_NOT_EXISTS);
+            }
+            else
+            {
+                return PageIdAndEntry{page_id, PageEntryV3{.file_id = INVALID_BLOBFILE_ID}};
             }
         }
         auto [resolve_state, next_id_to_resolve, next_ver_to_resolve] = iter->second->resolveToPageId(ver_to_resolve.sequence, /*ignore_delete=*/id_to_resolve != page_id, &entry_got);
@@ -1022,9 +1030,10 @@ PageDirectory<Trait>::getByIDsImpl(const typename PageDirectory<Trait>::PageIds
         {
             typename MVCCMapType::const_iterator iter;
             {
-                std::shared_lock read_lock(table_rw_mutex);
-                iter = mvcc_table_directory.find(id_to_resolve);
-                if (iter == mvcc_table_directory.end())
+                const auto & shard = mvcc_table_directory.getShard(id_to_resolve);
+                std::shared_lock read_lock(shard.mutex);
+                iter = shard.map.find(id_to_resolve);
+                if (iter == shard.map.end())
                 {
                     if (throw_on_not_exist)
                     {
@@ -1093,9 +1102,10 @@ typename PageDirectory<Trait>::PageId PageDirectory<Trait>::getNormalPageId(cons
     {
         typename MVCCMapType::const_iterator iter;
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            iter = mvcc_table_directory.find(id_to_resolve);
-            if (iter == mvcc_table_directory.end())
+            const auto & shard = mvcc_table_directory.getShard(id_to_resolve);
+            std::shared_lock read_lock(shard.mutex);
+            iter = shard.map.find(id_to_resolve);
+            if (iter == shard.map.end())
             {
                 if (throw_on_not_exist)
                 {
@@ -1147,7 +1157,7 @@ typename PageDirectory<Trait>::PageId PageDirectory<Trait>::getNormalPageId(cons
 template <typename Trait>
 UInt64 PageDirectory<Trait>::getMaxIdAfterRestart() const
 {
-    std::shared_lock read_lock(table_rw_mutex);
+    // `max_page_id` is only updated when restoring
     return max_page_id;
 }
 
@@ -1156,13 +1166,16 @@ typename PageDirectory<Trait>::PageIdSet PageDirectory<Trait>::getAllPageIds()
 {
     std::set<PageId> page_ids;
 
-    std::shared_lock read_lock(table_rw_mutex);
     const auto seq = sequence.load();
-    for (auto & [page_id, versioned] : mvcc_table_directory)
+    for (const auto & shard : mvcc_table_directory)
     {
-        // Only return the page_id that is visible
-        if (versioned->isVisible(seq))
-            page_ids.insert(page_id);
+        std::shared_lock read_lock(shard.mutex);
+        for (const auto & [page_id, versioned] : shard.map)
+        {
+            // Only return the page_id that is visible
+            if (versioned->isVisible(seq))
+                page_ids.insert(page_id);
+        }
     }
     return page_ids;
 }
@@ -1174,16 +1187,20 @@ typename PageDirectory<Trait>::PageIdSet PageDirectory<Trait>::getAllPageIdsWith
     {
         PageIdSet page_ids;
         auto seq = toConcreteSnapshot(snap_)->sequence;
-        std::shared_lock read_lock(table_rw_mutex);
-        for (auto iter = mvcc_table_directory.lower_bound(prefix);
-             iter != mvcc_table_directory.end();
-             ++iter)
+        // The page ids with `prefix` are spread over all shards
+        for (const auto & shard : mvcc_table_directory)
         {
-            if (!iter->first.hasPrefix(prefix))
-                break;
-            // Only return the page_id that is visible
-            if (iter->second->isVisible(seq))
-                page_ids.insert(iter->first);
+            std::shared_lock read_lock(shard.mutex);
+            for (auto iter = shard.map.lower_bound(prefix);
+                 iter != shard.map.end();
+                 ++iter)
+            {
+                if (!iter->first.hasPrefix(prefix))
+                    break;
+                // Only return the page_id that is visible
+                if (iter->second->isVisible(seq))
+                    page_ids.insert(iter->first);
+            }
         }
         return page_ids;
     }
@@ -1200,16 +1217,20 @@ typename PageDirectory<Trait>::PageIdSet PageDirectory<Trait>::getAllPageIdsInRa
     {
         PageIdSet page_ids;
         auto seq = toConcreteSnapshot(snap_)->sequence;
-        std::shared_lock read_lock(table_rw_mutex);
-        for (auto iter = mvcc_table_directory.lower_bound(start);
-             iter != mvcc_table_directory.end();
-             ++iter)
+        // The page ids in [start, end) are spread over all shards
+        for (const auto & shard : mvcc_table_directory)
         {
-            if (!end.empty() && iter->first >= end)
-                break;
-            // Only return the page_id that is visible
-            if (iter->second->isVisible(seq))
-                page_ids.insert(iter->first);
+            std::shared_lock read_lock(shard.mutex);
+            for (auto iter = shard.map.lower_bound(start);
+                 iter != shard.map.end();
+                 ++iter)
+            {
+                if (!end.empty() && iter->first >= end)
+                    break;
+                // Only return the page_id that is visible
+                if (iter->second->isVisible(seq))
+                    page_ids.insert(iter->first);
+            }
         }
         return page_ids;
     }
@@ -1225,16 +1246,26 @@ std::optional<typename PageDirectory<Trait>::PageId> PageDirectory<Trait>::getLo
     if constexpr (std::is_same_v<Trait, universal::PageDirectoryTrait>)
     {
         auto seq = toConcreteSnapshot(snap_)->sequence;
-        std::shared_lock read_lock(table_rw_mutex);
-        for (auto iter = mvcc_table_directory.lower_bound(start);
-             iter != mvcc_table_directory.end();
-             ++iter)
-        {
-            // Only return the page_id that is visible
-            if (iter->second->isVisible(seq))
-                return iter->first;
+        // Find the first visible page_id in each shard, the lower bound is the minimum of them
+        std::optional<PageId> lower_bound;
+        for (const auto & shard : mvcc_table_directory)
+        {
+            std::shared_lock read_lock(shard.mutex);
+            for (auto iter = shard.map.lower_bound(start);
+                 iter != shard.map.end();
+                 ++iter)
+            {
+                if (lower_bound && !(iter->first < *lower_bound))
+                    break;
+                // Only return the page_id that is visible
+                if (iter->second->isVisible(seq))
+                {
+                    lower_bound = iter->first;
+                    break;
+                }
+            }
         }
-        return std::nullopt;
+        return lower_bound;
     }
     else
     {
@@ -1244,10 +1275,11 @@ std::optional<typename PageDirectory<Trait>::PageId> PageDirectory<Trait>::getLo
 
 template <typename Trait>
 void PageDirectory<Trait>::applyRefEditRecord(
-    MVCCMapType & mvcc_table_directory,
+    const MVCCMap & mvcc_table_directory,
     const VersionedPageEntriesPtr & version_list,
     const typename PageEntriesEdit::EditRecord & rec,
-    const PageVersion & version)
+    const PageVersion & version,
+    const typename MVCCMap::Shard * locked_shard)
 {
     // Assume the `mvcc_table_directory` is:
     // {
@@ -1280,15 +1312,14 @@ void PageDirectory<Trait>::applyRefEditRecord(
     // non-collapse ref chain is much harder and long ref chain make the time of accessing an entry
     // not stable.
 
-    auto [resolve_success, resolved_id, resolved_ver] = [&mvcc_table_directory, ori_page_id = rec.ori_page_id](PageId id_to_resolve, PageVersion ver_to_resolve)
+    auto [resolve_success, resolved_id, resolved_ver] = [&mvcc_table_directory, locked_shard, ori_page_id = rec.ori_page_id](PageId id_to_resolve, PageVersion ver_to_resolve)
         -> std::tuple<bool, PageId, PageVersion> {
         while (true)
         {
-            auto resolve_ver_iter = mvcc_table_directory.find(id_to_resolve);
-            if (resolve_ver_iter == mvcc_table_directory.end())
+            const VersionedPageEntriesPtr resolve_version_list = mvcc_table_directory.find(id_to_resolve, locked_shard);
+            if (resolve_version_list == nullptr)
                 return {false, Trait::PageIdTrait::getInvalidID(), PageVersion(0)};
 
-            const VersionedPageEntriesPtr & resolve_version_list = resolve_ver_iter->second;
             auto [resolve_state, next_id_to_resolve, next_ver_to_resolve] = resolve_version_list->resolveToPageId(
                 ver_to_resolve.sequence,
                 /*ignore_delete=*/id_to_resolve != ori_page_id,
@@ -1329,9 +1360,9 @@ void PageDirectory<Trait>::applyRefEditRecord(
     {
         SYNC_FOR("before_PageDirectory::applyRefEditRecord_incr_ref_count");
         // Add the ref-count of being-ref entry
-        if (auto resolved_iter = mvcc_table_directory.find(resolved_id); resolved_iter != mvcc_table_directory.end())
+        if (auto resolved_version_list = mvcc_table_directory.find(resolved_id, locked_shard); resolved_version_list != nullptr)
         {
-            resolved_iter->second->incrRefCount(resolved_ver);
+            resolved_version_list->incrRefCount(resolved_ver);
         }
         else
         {
@@ -1354,88 +1385,177 @@ void PageDirectory<Trait>::apply(PageEntriesEdit && edit, const WriteLimiterPtr
     // Note that, as read threads use current `sequence` as read_seq, we cannot increase `sequence`
     // before applying edit to `mvcc_table_directory`.
     //
-    // TODO: It is totally serialized by only 1 thread with IO waiting. Make this process a
-    // pipeline so that we can batch the incoming edit when doing IO.
+    // To avoid serializing all writers on the WAL IO, the edits are group committed: every
+    // writer enqueues itself into `writers`, the one at the front becomes the leader. The leader
+    // takes all queued edits, persists them by one WAL write, applies them to `mvcc_table_directory`,
+    // then wakes up the followers. Writers arriving during the IO are batched by the next leader.
 
     Stopwatch watch;
 
+    Writer writer{.edit = &edit};
     std::unique_lock apply_lock(apply_mutex);
+    writers.push_back(&writer);
+    writer.cv.wait(apply_lock, [&] { return writer.done || writers.front() == &writer; });
+    if (writer.done)
+    {
+        // Committed by another leader
+        if (writer.exception)
+            std::rethrow_exception(writer.exception);
+        return;
+    }
+
+    // This writer is the leader, take the queued writers as a group.
+    // Limit the records num of a group so that a single WAL write is not too large.
+    static constexpr size_t max_group_records = 16 * 1024;
+    std::vector<Writer *> group;
+    size_t group_records = 0;
+    for (auto * w : writers)
+    {
+        if (!group.empty() && group_records + w->edit->size() > max_group_records)
+            break;
+        group.push_back(w);
+        group_records += w->edit->size();
+    }
+    apply_lock.unlock();
 
     GET_METRIC(tiflash_storage_page_write_duration_seconds, type_latch).Observe(watch.elapsedSeconds());
     watch.restart();
 
+    SCOPE_EXIT({
+        // Remove the group from the queue, notify the followers and the next leader
+        std::lock_guard lock(apply_mutex);
+        for (auto * w : group)
+        {
+            assert(writers.front() == w);
+            writers.pop_front();
+            if (w != &writer)
+            {
+                w->done = true;
+                w->cv.notify_one();
+            }
+        }
+        if (!writers.empty())
+            writers.front()->cv.notify_one();
+    });
+
+    try
+    {
+        applyGroup(group, write_limiter, watch);
+    }
+    catch (...)
+    {
+        // Failed before applying to `mvcc_table_directory`, all writers in the group fail
+        for (auto * w : group)
+        {
+            if (!w->exception)
+                w->exception = std::current_exception();
+        }
+    }
+
+    if (writer.exception)
+        std::rethrow_exception(writer.exception);
+}
+
+template <typename Trait>
+void PageDirectory<Trait>::applyGroup(const std::vector<Writer *> & group, const WriteLimiterPtr & write_limiter, Stopwatch & watch)
+{
     UInt64 max_sequence = sequence.load();
-    const auto edit_size = edit.size();
+    size_t group_size = 0;
 
     // stage 1, persisted the changes to WAL.
     // In order to handle {put X, ref Y->X, del X} inside one WriteBatch (and
     // in later batch pipeline), we increase the sequence for each record.
-    for (auto & r : edit.getMutRecords())
+    for (auto * w : group)
     {
-        ++max_sequence;
-        r.version = PageVersion(max_sequence, 0);
+        for (auto & r : w->edit->getMutRecords())
+        {
+            ++max_sequence;
+            r.version = PageVersion(max_sequence, 0);
+        }
+        group_size += w->edit->size();
     }
 
-    wal->apply(Trait::Serializer::serializeTo(edit), write_limiter);
+    if (group.size() == 1)
+    {
+        wal->apply(Trait::Serializer::serializeTo(*group[0]->edit), write_limiter);
+    }
+    else
+    {
+        // Merge the edits into one WAL record
+        PageEntriesEdit merged_edit(group_size);
+        for (auto * w : group)
+        {
+            for (const auto & r : w->edit->getRecords())
+                merged_edit.appendRecord(r);
+        }
+        wal->apply(Trait::Serializer::serializeTo(merged_edit), write_limiter);
+    }
     GET_METRIC(tiflash_storage_page_write_duration_seconds, type_wal).Observe(watch.elapsedSeconds());
     watch.restart();
     SCOPE_EXIT({ GET_METRIC(tiflash_storage_page_write_duration_seconds, type_commit).Observe(watch.elapsedSeconds()); });
 
     {
-        std::unique_lock table_lock(table_rw_mutex);
-
         // stage 2, create entry version list for page_id.
-        for (const auto & r : edit.getRecords())
+        for (auto * w : group)
         {
-            // Protected in write_lock
-            auto [iter, created] = mvcc_table_directory.insert(std::make_pair(r.page_id, nullptr));
-            if (created)
-            {
-                iter->second = std::make_shared<VersionedPageEntries<Trait>>();
-            }
-
-            auto & version_list = iter->second;
-            try
+            const auto edit_size = w->edit->size();
+            for (const auto & r : w->edit->getRecords())
             {
-                switch (r.type)
+                // Hold the write lock on the shard until the record is applied, or gc may
+                // remove the new created version list before it is filled
+                auto & shard = mvcc_table_directory.getShard(r.page_id);
+                std::unique_lock write_lock(shard.mutex);
+                auto [iter, created] = shard.map.insert(std::make_pair(r.page_id, nullptr));
+                if (created)
                 {
-                case EditRecordType::PUT_EXTERNAL:
+                    iter->second = std::make_shared<VersionedPageEntries<Trait>>();
+                }
+
+                auto & version_list = iter->second;
+                try
                 {
-                    auto holder = version_list->createNewExternal(r.version);
-                    if (holder)
+                    switch (r.type)
                     {
-                        // put the new created holder into `external_ids`
-                        *holder = r.page_id;
-                        external_ids_by_ns.addExternalId(holder);
+                    case EditRecordType::PUT_EXTERNAL:
+                    {
+                        auto holder = version_list->createNewExternal(r.version);
+                        if (holder)
+                        {
+                            // put the new created holder into `external_ids`
+                            *holder = r.page_id;
+                            external_ids_by_ns.addExternalId(holder);
+                        }
+                        break;
+                    }
+                    case EditRecordType::PUT:
+                        version_list->createNewEntry(r.version, r.entry);
+                        break;
+                    case EditRecordType::DEL:
+                        version_list->createDelete(r.version);
+                        break;
+                    case EditRecordType::REF:
+                        applyRefEditRecord(mvcc_table_directory, version_list, r, r.version, &shard);
+                        break;
+                    case EditRecordType::UPSERT:
+                    case EditRecordType::VAR_DELETE:
+                    case EditRecordType::VAR_ENTRY:
+                    case EditRecordType::VAR_EXTERNAL:
+                    case EditRecordType::VAR_REF:
+                        throw Exception(fmt::format("should not handle edit with invalid type [type={}]", magic_enum::enum_name(r.type)));
                     }
-                    break;
                 }
-                case EditRecordType::PUT:
-                    version_list->createNewEntry(r.version, r.entry);
-                    break;
-                case EditRecordType::DEL:
-                    version_list->createDelete(r.version);
-                    break;
-                case EditRecordType::REF:
-                    applyRefEditRecord(mvcc_table_directory, version_list, r, r.version);
+                catch (DB::Exception & e)
+                {
+                    // Only fail the writer of this edit, the edits of other writers in the group are still applied
+                    e.addMessage(fmt::format(" [type={}] [page_id={}] [ver={}] [edit_size={}]", magic_enum::enum_name(r.type), r.page_id, r.version, edit_size));
+                    w->exception = std::current_exception();
                     break;
-                case EditRecordType::UPSERT:
-                case EditRecordType::VAR_DELETE:
-                case EditRecordType::VAR_ENTRY:
-                case EditRecordType::VAR_EXTERNAL:
-                case EditRecordType::VAR_REF:
-                    throw Exception(fmt::format("should not handle edit with invalid type [type={}]", magic_enum::enum_name(r.type)));
                 }
             }
-            catch (DB::Exception & e)
-            {
-                e.addMessage(fmt::format(" [type={}] [page_id={}] [ver={}] [edit_size={}]", magic_enum::enum_name(r.type), r.page_id, r.version, edit_size));
-                e.rethrow();
-            }
         }
 
-        // stage 3, the edit committed, incr the sequence number to publish changes for `createSnapshot`
-        sequence.fetch_add(edit_size);
+        // stage 3, the edits committed, incr the sequence number to publish changes for `createSnapshot`
+        sequence.fetch_add(group_size);
     }
 }
 
@@ -1454,26 +1574,17 @@ void PageDirectory<Trait>::gcApply(PageEntriesEdit && migrated_edit, const Write
     // Apply migrate edit to the mvcc map
     for (const auto & record : migrated_edit.getRecords())
     {
-        typename MVCCMapType::const_iterator iter;
-        {
-            std::shared_lock read_lock(table_rw_mutex);
-            iter = mvcc_table_directory.find(record.page_id);
-            RUNTIME_CHECK_MSG(iter != mvcc_table_directory.end(), "Can't find [page_id={}] while doing gcApply", record.page_id);
-        } // release the read lock on `table_rw_mutex`
+        const auto versioned_entries = mvcc_table_directory.find(record.page_id);
+        RUNTIME_CHECK_MSG(versioned_entries != nullptr, "Can't find [page_id={}] while doing gcApply", record.page_id);
 
         // Append the gc version to version list
-        const auto & versioned_entries = iter->second;
         auto id_to_deref = versioned_entries->createUpsertEntry(record.version, record.entry);
         if (id_to_deref != Trait::PageIdTrait::getInvalidID())
         {
             // The ref-page is rewritten into a normal page, we need to decrease the ref-count of original page
-            typename MVCCMapType::const_iterator deref_iter;
-            {
-                std::shared_lock read_lock(table_rw_mutex);
-                deref_iter = mvcc_table_directory.find(id_to_deref);
-                RUNTIME_CHECK_MSG(deref_iter != mvcc_table_directory.end(), "Can't find [page_id={}] to deref after gcApply", id_to_deref);
-            }
-            auto deref_res = deref_iter->second->derefAndClean(/*lowest_seq*/ 0, id_to_deref, record.version, 1, nullptr);
+            const auto deref_entries = mvcc_table_directory.find(id_to_deref);
+            RUNTIME_CHECK_MSG(deref_entries != nullptr, "Can't find [page_id={}] to deref after gcApply", id_to_deref);
+            auto deref_res = deref_entries->derefAndClean(/*lowest_seq*/ 0, id_to_deref, record.version, 1, nullptr);
             RUNTIME_ASSERT(!deref_res);
         }
     }
@@ -1496,19 +1607,20 @@ PageDirectory<Trait>::getEntriesByBlobIds(const std::vector<BlobFileId> & blob_i
     UInt64 total_page_nums = 0;
     std::map<PageId, std::tuple<PageId, PageVersion>> ref_ids_maybe_rewrite;
 
+    for (const auto & shard : mvcc_table_directory)
     {
         typename MVCCMapType::const_iterator iter;
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            iter = mvcc_table_directory.cbegin();
-            if (iter == mvcc_table_directory.end())
-                return {blob_versioned_entries, total_page_size};
+            std::shared_lock read_lock(shard.mutex);
+            iter = shard.map.cbegin();
+            if (iter == shard.map.end())
+                continue;
         }
 
         while (true)
         {
             // `iter` is an iter that won't be invalid cause by `apply`/`gcApply`.
-            // do scan on the version list without lock on `mvcc_table_directory`.
+            // do scan on the version list without lock on the shard.
             auto page_id = iter->first;
             const auto & version_entries = iter->second;
             fiu_do_on(FailPoints::pause_before_full_gc_prepare, {
@@ -1526,9 +1638,9 @@ PageDirectory<Trait>::getEntriesByBlobIds(const std::vector<BlobFileId> & blob_i
             }
 
             {
-                std::shared_lock read_lock(table_rw_mutex);
+                std::shared_lock read_lock(shard.mutex);
                 iter++;
-                if (iter == mvcc_table_directory.end())
+                if (iter == shard.map.end())
                     break;
             }
         }
@@ -1541,13 +1653,8 @@ PageDirectory<Trait>::getEntriesByBlobIds(const std::vector<BlobFileId> & blob_i
     {
         const auto ori_id = std::get<0>(ori_id_ver);
         const auto ver = std::get<1>(ori_id_ver);
-        typename MVCCMapType::const_iterator page_iter;
-        {
-            std::shared_lock read_lock(table_rw_mutex);
-            page_iter = mvcc_table_directory.find(ori_id);
-            RUNTIME_CHECK(page_iter != mvcc_table_directory.end(), ref_id, ori_id, ver);
-        }
-        const auto & version_entries = page_iter->second;
+        const auto version_entries = mvcc_table_directory.find(ori_id);
+        RUNTIME_CHECK(version_entries != nullptr, ref_id, ori_id, ver);
         // After storing all data in one PageStorage instance, we will run full gc
         // with external pages. Skip rewriting if it is an external pages.
         if (version_entries->isExternalPage())
@@ -1666,14 +1773,6 @@ typename PageDirectory<Trait>::PageEntries PageDirectory<Trait>::gcInMemEntries(
     }
 
     PageEntriesV3 all_del_entries;
-    typename MVCCMapType::iterator iter;
-    {
-        std::shared_lock read_lock(table_rw_mutex);
-        iter = mvcc_table_directory.begin();
-        if (iter == mvcc_table_directory.end())
-            return all_del_entries;
-    }
-
     UInt64 invalid_page_nums = 0;
     UInt64 valid_page_nums = 0;
 
@@ -1681,31 +1780,42 @@ typename PageDirectory<Trait>::PageEntries PageDirectory<Trait>::gcInMemEntries(
     // { id_0: <version, num to decrease>, id_1: <...>, ... }
     std::map<PageId, std::pair<PageVersion, Int64>> normal_entries_to_deref;
     // Iterate all page_id and try to clean up useless var entries
-    while (true)
+    for (auto & shard : mvcc_table_directory)
     {
-        // `iter` is an iter that won't be invalid cause by `apply`/`gcApply`.
-        // do gc on the version list without lock on `mvcc_table_directory`.
-        const bool all_deleted = iter->second->cleanOutdatedEntries(
-            lowest_seq,
-            &normal_entries_to_deref,
-            return_removed_entries ? &all_del_entries : nullptr,
-            iter->second->acquireLock());
+        typename MVCCMapType::iterator iter;
+        {
+            std::shared_lock read_lock(shard.mutex);
+            iter = shard.map.begin();
+            if (iter == shard.map.end())
+                continue;
+        }
 
+        while (true)
         {
-            std::unique_lock write_lock(table_rw_mutex);
-            if (all_deleted)
-            {
-                iter = mvcc_table_directory.erase(iter);
-                invalid_page_nums++;
-            }
-            else
+            // `iter` is an iter that won't be invalid cause by `apply`/`gcApply`.
+            // do gc on the version list without lock on the shard.
+            const bool all_deleted = iter->second->cleanOutdatedEntries(
+                lowest_seq,
+                &normal_entries_to_deref,
+                return_removed_entries ? &all_del_entries : nullptr,
+                iter->second->acquireLock());
+
             {
-                valid_page_nums++;
-                iter++;
-            }
+                std::unique_lock write_lock(shard.mutex);
+                if (all_deleted)
+                {
+                    iter = shard.map.erase(iter);
+                    invalid_page_nums++;
+                }
+                else
+                {
+                    valid_page_nums++;
+                    iter++;
+                }
 
-            if (iter == mvcc_table_directory.end())
-                break;
+                if (iter == shard.map.end())
+                    break;
+            }
         }
     }
 
@@ -1714,11 +1824,12 @@ typename PageDirectory<Trait>::PageEntries PageDirectory<Trait>::gcInMemEntries(
     // Iterate all page_id that need to decrease ref count of specified version.
     for (const auto & [page_id, deref_counter] : normal_entries_to_deref)
     {
+        auto & shard = mvcc_table_directory.getShard(page_id);
         typename MVCCMapType::iterator iter;
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            iter = mvcc_table_directory.find(page_id);
-            if (iter == mvcc_table_directory.end())
+            std::shared_lock read_lock(shard.mutex);
+            iter = shard.map.find(page_id);
+            if (iter == shard.map.end())
                 continue;
         }
 
@@ -1731,8 +1842,8 @@ typename PageDirectory<Trait>::PageEntries PageDirectory<Trait>::gcInMemEntries(
 
         if (all_deleted)
         {
-            std::unique_lock write_lock(table_rw_mutex);
-            mvcc_table_directory.erase(iter);
+            std::unique_lock write_lock(shard.mutex);
+            shard.map.erase(iter);
             invalid_page_nums++;
             valid_page_nums--;
         }
@@ -1767,24 +1878,21 @@ typename PageDirectory<Trait>::PageEntriesEdit PageDirectory<Trait>::dumpSnapsho
         snap = createSnapshot(/*tracing_id*/ "");
     }
 
-    PageEntriesEdit edit;
-    typename MVCCMapType::iterator iter;
+    // The page ids are only ordered inside a shard, sort them so that
+    // the records are dumped in the order of page id.
+    std::vector<const typename MVCCMapType::value_type *> pages;
+    for (const auto & shard : mvcc_table_directory)
     {
-        std::shared_lock read_lock(table_rw_mutex);
-        iter = mvcc_table_directory.begin();
-        if (iter == mvcc_table_directory.end())
-            return edit;
+        std::shared_lock read_lock(shard.mutex);
+        for (const auto & page : shard.map)
+            pages.emplace_back(&page);
     }
-    while (true)
-    {
-        iter->second->collapseTo(snap->sequence, iter->first, edit);
+    std::sort(pages.begin(), pages.end(), [](const auto * lhs, const auto * rhs) { return lhs->first < rhs->first; });
 
-        {
-            std::shared_lock read_lock(table_rw_mutex);
-            ++iter;
-            if (iter == mvcc_table_directory.end())
-                break;
-        }
+    PageEntriesEdit edit;
+    for (const auto * page : pages)
+    {
+        page->second->collapseTo(snap->sequence, page->first, edit);
     }
 
     LOG_INFO(log, "Dumped snapshot to edits.[sequence={}]", snap->sequence);
@@ -1796,15 +1904,18 @@ size_t PageDirectory<Trait>::numPagesWithPrefix(const String & prefix) const
 {
     if constexpr (std::is_same_v<Trait, universal::PageDirectoryTrait>)
     {
-        std::shared_lock read_lock(table_rw_mutex);
         size_t num = 0;
-        for (auto iter = mvcc_table_directory.lower_bound(prefix);
-             iter != mvcc_table_directory.end();
-             ++iter)
+        for (const auto & shard : mvcc_table_directory)
         {
-            if (!iter->first.hasPrefix(prefix))
-                break;
-            num++;
+            std::shared_lock read_lock(shard.mutex);
+            for (auto iter = shard.map.lower_bound(prefix);
+                 iter != shard.map.end();
+                 ++iter)
+            {
+                if (!iter->first.hasPrefix(prefix))
+                    break;
+                num++;
+            }
         }
         return num;
     }
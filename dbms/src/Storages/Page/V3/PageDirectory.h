@@ -16,6 +16,7 @@
 
 #include <Common/CurrentMetrics.h>
 #include <Common/Logger.h>
+#include <Common/Stopwatch.h>
 #include <Common/nocopyable.h>
 #include <Encryption/FileProvider.h>
 #include <Poco/Ext/ThreadNumber.h>
@@ -25,6 +26,7 @@
 #include <Storages/Page/V3/MapUtils.h>
 #include <Storages/Page/V3/PageDefines.h>
 #include <Storages/Page/V3/PageDirectory/ExternalIdsByNamespace.h>
+#include <Storages/Page/V3/PageDirectory/MVCCMapShards.h>
 #include <Storages/Page/V3/PageEntriesEdit.h>
 #include <Storages/Page/V3/PageEntry.h>
 #include <Storages/Page/V3/WAL/serialize.h>
@@ -32,6 +34,8 @@
 #include <common/defines.h>
 #include <common/types.h>
 
+#include <condition_variable>
+#include <deque>
 #include <magic_enum.hpp>
 #include <memory>
 #include <mutex>
@@ -377,7 +381,6 @@ public:
     // Approximate number of pages in memory
     size_t numPages() const
     {
-        std::shared_lock read_lock(table_rw_mutex);
         return mvcc_table_directory.size();
     }
     // Only used in test
@@ -407,13 +410,15 @@ private:
     // "No iterators or references are invalidated"
     // https://en.cppreference.com/w/cpp/container/map/insert
     using VersionedPageEntriesPtr = std::shared_ptr<VersionedPageEntries<Trait>>;
-    using MVCCMapType = std::map<PageId, VersionedPageEntriesPtr>;
+    using MVCCMap = MVCCMapShards<PageId, VersionedPageEntriesPtr>;
+    using MVCCMapType = typename MVCCMap::MapType;
 
     static void applyRefEditRecord(
-        MVCCMapType & mvcc_table_directory,
+        const MVCCMap & mvcc_table_directory,
         const VersionedPageEntriesPtr & version_list,
         const typename PageEntriesEdit::EditRecord & rec,
-        const PageVersion & version);
+        const PageVersion & version,
+        const typename MVCCMap::Shard * locked_shard = nullptr);
 
     static inline PageDirectorySnapshotPtr
     toConcreteSnapshot(const DB::PageStorageSnapshotPtr & ptr)
@@ -429,12 +434,27 @@ private:
     UInt64 max_page_id;
     std::atomic<UInt64> sequence;
 
+    // A pending `apply` call. The writer at the front of `writers` becomes the leader,
+    // it commits the edits of all queued writers by one WAL write and wakes them up.
+    struct Writer
+    {
+        PageEntriesEdit * edit;
+        bool done = false;
+        std::exception_ptr exception;
+        std::condition_variable cv;
+    };
+
     // Used for avoid concurrently apply edits to wal and mvcc_table_directory.
-    mutable std::shared_mutex apply_mutex;
+    // Protects `writers`, only the leader writes wal and mvcc_table_directory.
+    std::mutex apply_mutex;
+    std::deque<Writer *> writers;
+
+    // Persist the edits of `group` by one WAL write and apply them to `mvcc_table_directory`.
+    // Called by the leader without holding `apply_mutex`.
+    void applyGroup(const std::vector<Writer *> & group, const WriteLimiterPtr & write_limiter, Stopwatch & watch);
 
-    // Used to protect mvcc_table_directory between apply threads and read threads
-    mutable std::shared_mutex table_rw_mutex;
-    MVCCMapType mvcc_table_directory;
+    // Sharded by page id, each shard has its own lock to protect it between apply threads and read threads
+    MVCCMap mvcc_table_directory;
 
     mutable std::mutex snapshots_mutex;
     mutable std::list<std::weak_ptr<PageDirectorySnapshot>> snapshots;
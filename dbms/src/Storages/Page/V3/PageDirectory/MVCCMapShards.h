@@ -0,0 +1,96 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/nocopyable.h>
+
+#include <array>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+
+namespace DB::PS::V3
+{
+
+// The MVCC table of PageDirectory: page id -> versioned entries.
+// The page ids are split into shards by hash, each shard is protected by its
+// own lock, so that reads, applies and gc on different page ids don't contend
+// on one global lock.
+// Note that page ids are only ordered inside a shard. Scanning a range of page
+// ids must check all shards and merge the results.
+template <typename PageId, typename VersionedPageEntriesPtr>
+class MVCCMapShards
+{
+public:
+    using MapType = std::map<PageId, VersionedPageEntriesPtr>;
+
+    struct Shard
+    {
+        // Used to protect `map` between apply threads and read threads
+        mutable std::shared_mutex mutex;
+        MapType map;
+    };
+
+    static constexpr size_t NUM_SHARDS = 32;
+
+    MVCCMapShards() = default;
+    DISALLOW_COPY_AND_MOVE(MVCCMapShards);
+
+    Shard & getShard(const PageId & page_id)
+    {
+        return shards[std::hash<PageId>()(page_id) % NUM_SHARDS];
+    }
+
+    const Shard & getShard(const PageId & page_id) const
+    {
+        return shards[std::hash<PageId>()(page_id) % NUM_SHARDS];
+    }
+
+    // Return nullptr if `page_id` does not exist.
+    // `locked_shard` is the shard already locked by the caller, finding in it won't acquire the lock again.
+    VersionedPageEntriesPtr find(const PageId & page_id, const Shard * locked_shard = nullptr) const
+    {
+        const auto & shard = getShard(page_id);
+        std::shared_lock read_lock(shard.mutex, std::defer_lock);
+        if (&shard != locked_shard)
+            read_lock.lock();
+        auto iter = shard.map.find(page_id);
+        if (iter == shard.map.end())
+            return nullptr;
+        return iter->second;
+    }
+
+    size_t size() const
+    {
+        size_t num = 0;
+        for (const auto & shard : shards)
+        {
+            std::shared_lock read_lock(shard.mutex);
+            num += shard.map.size();
+        }
+        return num;
+    }
+
+    auto begin() { return shards.begin(); }
+    auto end() { return shards.end(); }
+    auto begin() const { return shards.begin(); }
+    auto end() const { return shards.end(); }
+
+private:
+    std::array<Shard, NUM_SHARDS> shards;
+};
+
+} // namespace DB::PS::V3
@@ -62,16 +62,19 @@ PageDirectoryFactory<Trait>::createFromReader(const String & storage_name, WALSt
         // the latest entry to `blob_stats`, or we may meet error since
         // some entries may be removed in memory but not get compacted
         // in the log file.
-        for (const auto & [page_id, entries] : dir->mvcc_table_directory)
+        for (const auto & shard : dir->mvcc_table_directory)
         {
-            (void)page_id;
-
-            // We should restore the entry to `blob_stats` even if it is marked as "deleted",
-            // or we will mistakenly reuse the space to write other blobs down into that space.
-            // So we need to use `getLastEntry` instead of `getEntry(version)` here.
-            if (auto entry = entries->getLastEntry(std::nullopt); entry)
+            for (const auto & [page_id, entries] : shard.map)
             {
-                blob_stats->restoreByEntry(*entry);
+                (void)page_id;
+
+                // We should restore the entry to `blob_stats` even if it is marked as "deleted",
+                // or we will mistakenly reuse the space to write other blobs down into that space.
+                // So we need to use `getLastEntry` instead of `getEntry(version)` here.
+                if (auto entry = entries->getLastEntry(std::nullopt); entry)
+                {
+                    blob_stats->restoreByEntry(*entry);
+                }
             }
         }
 
@@ -114,16 +117,19 @@ PageDirectoryFactory<Trait>::createFromEdit(const String & storage_name, FilePro
         // the latest entry to `blob_stats`, or we may meet error since
         // some entries may be removed in memory but not get compacted
         // in the log file.
-        for (const auto & [page_id, entries] : dir->mvcc_table_directory)
+        for (const auto & shard : dir->mvcc_table_directory)
         {
-            (void)page_id;
-
-            // We should restore the entry to `blob_stats` even if it is marked as "deleted",
-            // or we will mistakenly reuse the space to write other blobs down into that space.
-            // So we need to use `getLastEntry` instead of `getEntry(version)` here.
-            if (auto entry = entries->getLastEntry(std::nullopt); entry)
+            for (const auto & [page_id, entries] : shard.map)
             {
-                blob_stats->restoreByEntry(*entry);
+                (void)page_id;
+
+                // We should restore the entry to `blob_stats` even if it is marked as "deleted",
+                // or we will mistakenly reuse the space to write other blobs down into that space.
+                // So we need to use `getLastEntry` instead of `getEntry(version)` here.
+                if (auto entry = entries->getLastEntry(std::nullopt); entry)
+                {
+                    blob_stats->restoreByEntry(*entry);
+                }
             }
         }
 
@@ -152,7 +158,9 @@ void PageDirectoryFactory<Trait>::applyRecord(
     const PageDirectoryPtr & dir,
     const typename PageEntriesEdit::EditRecord & r)
 {
-    auto [iter, created] = dir->mvcc_table_directory.insert(std::make_pair(r.page_id, nullptr));
+    // Restoring is done by one thread, no need to lock the shard
+    auto & shard = dir->mvcc_table_directory.getShard(r.page_id);
+    auto [iter, created] = shard.map.insert(std::make_pair(r.page_id, nullptr));
     if (created)
     {
         if constexpr (std::is_same_v<Trait, u128::FactoryTrait>)
@@ -231,9 +239,9 @@ void PageDirectoryFactory<Trait>::applyRecord(
             if (Trait::PageIdTrait::getU64ID(id_to_deref) != INVALID_PAGE_U64_ID)
             {
                 // The ref-page is rewritten into a normal page, we need to decrease the ref-count of the original page
-                auto deref_iter = dir->mvcc_table_directory.find(id_to_deref);
-                RUNTIME_CHECK_MSG(deref_iter != dir->mvcc_table_directory.end(), "Can't find [page_id={}] to deref when applying upsert", id_to_deref);
-                auto deref_res = deref_iter->second->derefAndClean(/*lowest_seq*/ 0, id_to_deref, restored_version, 1, nullptr);
+                auto deref_entries = dir->mvcc_table_directory.find(id_to_deref);
+                RUNTIME_CHECK_MSG(deref_entries != nullptr, "Can't find [page_id={}] to deref when applying upsert", id_to_deref);
+                auto deref_res = deref_entries->derefAndClean(/*lowest_seq*/ 0, id_to_deref, restored_version, 1, nullptr);
                 RUNTIME_ASSERT(!deref_res);
             }
             break;
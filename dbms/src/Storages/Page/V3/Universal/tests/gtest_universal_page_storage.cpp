@@ -406,6 +406,58 @@ TEST_F(UniPageStorageTest, Scan)
     }
 }
 
+TEST_F(UniPageStorageTest, ScanAcrossShards)
+{
+    // The page ids are spread over many shards of the mvcc table, check
+    // the range scan returns the visible page ids in order.
+    UInt64 tag = 0;
+    const UInt64 region_id = 100;
+    const String region_prefix = UniversalPageIdFormat::toFullRaftLogPrefix(region_id);
+    const size_t num_pages = 1000;
+    {
+        UniversalWriteBatch wb;
+        for (size_t i = 0; i < num_pages; ++i)
+            wb.putPage(UniversalPageIdFormat::toFullPageId(region_prefix, i), tag, std::make_shared<ReadBufferFromMemory>(c_buff, buf_sz), buf_sz);
+        page_storage->write(std::move(wb));
+    }
+    {
+        UniversalWriteBatch wb;
+        for (size_t i = 0; i < num_pages; i += 3)
+            wb.delPage(UniversalPageIdFormat::toFullPageId(region_prefix, i));
+        page_storage->write(std::move(wb));
+    }
+
+    RaftDataReader reader(*page_storage);
+    {
+        auto start = UniversalPageIdFormat::toFullPageId(region_prefix, 100);
+        auto end = UniversalPageIdFormat::toFullPageId(region_prefix, 900);
+        std::vector<UInt64> ids;
+        auto checker = [&](const UniversalPageId & page_id, const DB::Page & page) {
+            UNUSED(page);
+            ids.emplace_back(UniversalPageIdFormat::getU64ID(page_id));
+        };
+        reader.traverse(start, end, checker);
+        std::vector<UInt64> expected_ids;
+        for (UInt64 i = 100; i < 900; ++i)
+        {
+            if (i % 3 != 0)
+                expected_ids.emplace_back(i);
+        }
+        ASSERT_EQ(ids, expected_ids);
+    }
+    {
+        // 300 is deleted
+        auto result_id = reader.getLowerBound(UniversalPageIdFormat::toFullPageId(region_prefix, 300));
+        ASSERT_TRUE(result_id.has_value());
+        ASSERT_EQ(*result_id, UniversalPageIdFormat::toFullPageId(region_prefix, 301));
+    }
+    {
+        // 999 is deleted and it is the last one
+        auto result_id = reader.getLowerBound(UniversalPageIdFormat::toFullPageId(region_prefix, 999));
+        ASSERT_TRUE(!result_id.has_value());
+    }
+}
+
 TEST(UniPageStorageIdTest, UniversalPageId)
 {
     {
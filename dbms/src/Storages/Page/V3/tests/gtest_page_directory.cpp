@@ -285,6 +285,105 @@ try
 }
 CATCH
 
+TEST_F(PageDirectoryTest, ConcurrentApply)
+try
+{
+    // Edits applied concurrently are group committed, all of them should be
+    // visible after apply returns and can be restored from the WAL.
+    const size_t num_writers = 32;
+    const size_t num_edits_per_writer = 100;
+    auto entry_of = [](PageIdU64 page_id) {
+        return PageEntryV3{.file_id = 1, .size = 1024, .padded_size = 0, .tag = 0, .offset = page_id * 1024, .checksum = page_id};
+    };
+
+    std::vector<std::future<void>> writers;
+    for (size_t w = 0; w < num_writers; ++w)
+    {
+        writers.emplace_back(std::async(std::launch::async, [&, w]() {
+            for (size_t i = 0; i < num_edits_per_writer; ++i)
+            {
+                PageIdU64 page_id = (w * num_edits_per_writer + i) * 2 + 1;
+                PageEntriesEdit edit;
+                edit.put(buildV3Id(TEST_NAMESPACE_ID, page_id), entry_of(page_id));
+                edit.put(buildV3Id(TEST_NAMESPACE_ID, page_id + 1), entry_of(page_id + 1));
+                dir->apply(std::move(edit));
+                // The edit must be visible once `apply` returns
+                auto snap = dir->createSnapshot();
+                EXPECT_ENTRY_EQ(entry_of(page_id + 1), dir, page_id + 1, snap);
+            }
+        }));
+    }
+    for (auto & w : writers)
+        w.get();
+
+    const size_t num_pages = num_writers * num_edits_per_writer * 2;
+    auto check_all_pages = [&]() {
+        auto snap = dir->createSnapshot();
+        ASSERT_EQ(snap->sequence, num_pages);
+        ASSERT_EQ(dir->numPages(), num_pages);
+        for (PageIdU64 page_id = 1; page_id <= num_pages; ++page_id)
+            EXPECT_ENTRY_EQ(entry_of(page_id), dir, page_id, snap);
+    };
+    check_all_pages();
+
+    dir.reset();
+    dir = restoreFromDisk();
+    check_all_pages();
+}
+CATCH
+
+TEST_F(PageDirectoryTest, ConcurrentApplyWithFailedEdits)
+try
+{
+    PageEntryV3 entry1{.file_id = 1, .size = 1024, .padded_size = 0, .tag = 0, .offset = 0x123, .checksum = 0x4567};
+    {
+        PageEntriesEdit edit;
+        edit.put(buildV3Id(TEST_NAMESPACE_ID, 1), entry1);
+        edit.ref(buildV3Id(TEST_NAMESPACE_ID, 2), buildV3Id(TEST_NAMESPACE_ID, 1));
+        dir->apply(std::move(edit));
+    }
+
+    // A failed edit only fails its own writer even if it is committed
+    // in the same group with other edits.
+    const size_t num_writers = 16;
+    const size_t num_edits_per_writer = 100;
+    PageEntryV3 entry_updated{.file_id = 999, .size = 16, .padded_size = 0, .tag = 0, .offset = 0x123, .checksum = 0x123};
+    std::vector<std::future<void>> writers;
+    for (size_t w = 0; w < num_writers; ++w)
+    {
+        writers.emplace_back(std::async(std::launch::async, [&, w]() {
+            for (size_t i = 0; i < num_edits_per_writer; ++i)
+            {
+                PageEntriesEdit edit;
+                if (w % 2 == 0)
+                {
+                    // Update on ref page is not allowed
+                    edit.put(buildV3Id(TEST_NAMESPACE_ID, 2), entry_updated);
+                    EXPECT_ANY_THROW(dir->apply(std::move(edit)));
+                }
+                else
+                {
+                    PageIdU64 page_id = 10 + w * num_edits_per_writer + i;
+                    edit.put(buildV3Id(TEST_NAMESPACE_ID, page_id), entry1);
+                    dir->apply(std::move(edit));
+                }
+            }
+        }));
+    }
+    for (auto & w : writers)
+        w.get();
+
+    auto snap = dir->createSnapshot();
+    EXPECT_ENTRY_EQ(entry1, dir, 1, snap);
+    EXPECT_ENTRY_EQ(entry1, dir, 2, snap);
+    for (size_t w = 1; w < num_writers; w += 2)
+    {
+        for (size_t i = 0; i < num_edits_per_writer; ++i)
+            EXPECT_ENTRY_EQ(entry1, dir, 10 + w * num_edits_per_writer + i, snap);
+    }
+}
+CATCH
+
 TEST_F(PageDirectoryTest, ApplyUpdateOnRefEntries)
 try
 {
@@ -204,7 +204,7 @@ private:
         // Other display mode need to restore ps instance
         PageStorageImpl ps(String(NAME), delegator, config, provider);
         ps.restore();
-        PageDirectory<u128::PageDirectoryTrait>::MVCCMapType & mvcc_table_directory = ps.page_directory->mvcc_table_directory;
+        const PageDirectory<u128::PageDirectoryTrait>::MVCCMap & mvcc_table_directory = ps.page_directory->mvcc_table_directory;
 
         switch (options.mode)
         {
@@ -292,7 +292,7 @@ private:
         return stats_info.toString();
     }
 
-    static String getDirectoryInfo(PageDirectory<u128::PageDirectoryTrait>::MVCCMapType & mvcc_table_directory, UInt64 ns_id, UInt64 page_id)
+    static String getDirectoryInfo(const PageDirectory<u128::PageDirectoryTrait>::MVCCMap & mvcc_table_directory, UInt64 ns_id, UInt64 page_id)
     {
         auto page_info = [](UInt128 page_internal_id_, const u128::VersionedPageEntriesPtr & versioned_entries) {
             FmtBuffer page_str;
@@ -336,28 +336,25 @@ private:
 
         FmtBuffer directory_info;
         directory_info.append("  Directory specific info: \n\n");
-        for (const auto & [internal_id, versioned_entries] : mvcc_table_directory)
+        if (page_id != UINT64_MAX)
         {
-            if (page_id != UINT64_MAX)
-            {
-                if (internal_id.low == page_id && internal_id.high == ns_id)
-                {
-                    directory_info.append(page_info(internal_id, versioned_entries));
-                    return directory_info.toString();
-                }
-                continue;
-            }
-            directory_info.append(page_info(internal_id, versioned_entries));
+            const auto page_internal_id = buildV3Id(ns_id, page_id);
+            if (const auto versioned_entries = mvcc_table_directory.find(page_internal_id); versioned_entries != nullptr)
+                directory_info.append(page_info(page_internal_id, versioned_entries));
+            else
+                directory_info.fmtAppend("    no found page {}", page_id);
+            return directory_info.toString();
         }
 
-        if (page_id != UINT64_MAX)
+        for (const auto & shard : mvcc_table_directory)
         {
-            directory_info.fmtAppend("    no found page {}", page_id);
+            for (const auto & [internal_id, versioned_entries] : shard.map)
+                directory_info.append(page_info(internal_id, versioned_entries));
         }
         return directory_info.toString();
     }
 
-    static String getSummaryInfo(PageDirectory<u128::PageDirectoryTrait>::MVCCMapType & mvcc_table_directory, BlobStore<u128::BlobStoreTrait> & blob_store)
+    static String getSummaryInfo(const PageDirectory<u128::PageDirectoryTrait>::MVCCMap & mvcc_table_directory, BlobStore<u128::BlobStoreTrait> & blob_store)
     {
         UInt64 longest_version_chaim = 0;
         UInt64 shortest_version_chaim = UINT64_MAX;
@@ -365,11 +362,14 @@ private:
 
         dir_summary_info.append("  Directory summary info: \n");
 
-        for (const auto & [internal_id, versioned_entries] : mvcc_table_directory)
+        for (const auto & shard : mvcc_table_directory)
         {
-            (void)internal_id;
-            longest_version_chaim = std::max(longest_version_chaim, versioned_entries->size());
-            shortest_version_chaim = std::min(shortest_version_chaim, versioned_entries->size());
+            for (const auto & [internal_id, versioned_entries] : shard.map)
+            {
+                (void)internal_id;
+                longest_version_chaim = std::max(longest_version_chaim, versioned_entries->size());
+                shortest_version_chaim = std::min(shortest_version_chaim, versioned_entries->size());
+            }
         }
 
         dir_summary_info.fmtAppend("    total pages: {}, longest version chaim: {} , shortest version chaim: {} \n\n",
@@ -404,20 +404,20 @@ private:
         return dir_summary_info.toString();
     }
 
-    static String checkSinglePage(PageDirectory<u128::PageDirectoryTrait>::MVCCMapType & mvcc_table_directory, BlobStore<u128::BlobStoreTrait> & blob_store, UInt64 ns_id, UInt64 page_id)
+    static String checkSinglePage(const PageDirectory<u128::PageDirectoryTrait>::MVCCMap & mvcc_table_directory, BlobStore<u128::BlobStoreTrait> & blob_store, UInt64 ns_id, UInt64 page_id)
     {
         const auto & page_internal_id = buildV3Id(ns_id, page_id);
-        const auto & it = mvcc_table_directory.find(page_internal_id);
-        if (it == mvcc_table_directory.end())
+        const auto versioned_entries = mvcc_table_directory.find(page_internal_id);
+        if (versioned_entries == nullptr)
         {
             return fmt::format("Can't find {}", page_internal_id);
         }
 
         FmtBuffer error_msg;
         size_t error_count = 0;
-        for (const auto & [version, entry_or_del] : it->second->entries)
+        for (const auto & [version, entry_or_del] : versioned_entries->entries)
         {
-            if (entry_or_del.isEntry() && it->second->type == EditRecordType::VAR_ENTRY)
+            if (entry_or_del.isEntry() && versioned_entries->type == EditRecordType::VAR_ENTRY)
             {
                 (void)blob_store;
                 try
@@ -460,7 +460,7 @@ private:
         return error_msg.toString();
     }
 
-    static String checkAllDataCrc(PageDirectory<u128::PageDirectoryTrait>::MVCCMapType & mvcc_table_directory, BlobStore<u128::BlobStoreTrait> & blob_store, bool enable_fo_check)
+    static String checkAllDataCrc(const PageDirectory<u128::PageDirectoryTrait>::MVCCMap & mvcc_table_directory, BlobStore<u128::BlobStoreTrait> & blob_store, bool enable_fo_check)
     {
         size_t total_pages = mvcc_table_directory.size();
         size_t cut_index = 0;
@@ -468,49 +468,52 @@ private:
         std::cout << fmt::format("Begin to check all of datas CRC. enable_fo_check={}", static_cast<int>(enable_fo_check)) << std::endl;
 
         std::list<std::pair<UInt128, PageVersion>> error_versioned_pages;
-        for (const auto & [internal_id, versioned_entries] : mvcc_table_directory)
+        for (const auto & shard : mvcc_table_directory)
         {
-            if (index == total_pages / 10 * cut_index)
+            for (const auto & [internal_id, versioned_entries] : shard.map)
             {
-                std::cout << fmt::format("processing : {}%", cut_index * 10) << std::endl;
-                cut_index++;
-            }
+                if (index == total_pages / 10 * cut_index)
+                {
+                    std::cout << fmt::format("processing : {}%", cut_index * 10) << std::endl;
+                    cut_index++;
+                }
 
-            // TODO : need replace by getLastEntry();
-            for (const auto & [version, entry_or_del] : versioned_entries->entries)
-            {
-                if (entry_or_del.isEntry() && versioned_entries->type == EditRecordType::VAR_ENTRY)
+                // TODO : need replace by getLastEntry();
+                for (const auto & [version, entry_or_del] : versioned_entries->entries)
                 {
-                    (void)blob_store;
-                    try
+                    if (entry_or_del.isEntry() && versioned_entries->type == EditRecordType::VAR_ENTRY)
                     {
-                        PageIDAndEntryV3 to_read_entry;
-                        const PageEntryV3 & entry = entry_or_del.entry;
-                        PageIDAndEntriesV3 to_read;
-                        to_read_entry.first = internal_id;
-                        to_read_entry.second = entry;
-
-                        to_read.emplace_back(to_read_entry);
-                        blob_store.read(to_read);
-
-                        if (enable_fo_check && !entry.field_offsets.empty())
+                        (void)blob_store;
+                        try
                         {
-                            DB::PageStorage::FieldIndices indices(entry.field_offsets.size());
-                            std::iota(std::begin(indices), std::end(indices), 0);
-
-                            BlobStore<u128::BlobStoreTrait>::FieldReadInfos infos;
-                            BlobStore<u128::BlobStoreTrait>::FieldReadInfo info(internal_id, entry, indices);
-                            infos.emplace_back(info);
-                            blob_store.read(infos);
+                            PageIDAndEntryV3 to_read_entry;
+                            const PageEntryV3 & entry = entry_or_del.entry;
+                            PageIDAndEntriesV3 to_read;
+                            to_read_entry.first = internal_id;
+                            to_read_entry.second = entry;
+
+                            to_read.emplace_back(to_read_entry);
+                            blob_store.read(to_read);
+
+                            if (enable_fo_check && !entry.field_offsets.empty())
+                            {
+                                DB::PageStorage::FieldIndices indices(entry.field_offsets.size());
+                                std::iota(std::begin(indices), std::end(indices), 0);
+
+                                BlobStore<u128::BlobStoreTrait>::FieldReadInfos infos;
+                                BlobStore<u128::BlobStoreTrait>::FieldReadInfo info(internal_id, entry, indices);
+                                infos.emplace_back(info);
+                                blob_store.read(infos);
+                            }
+                        }
+                        catch (DB::Exception & e)
+                        {
+                            error_versioned_pages.emplace_back(std::make_pair(internal_id, version));
                         }
-                    }
-                    catch (DB::Exception & e)
-                    {
-                        error_versioned_pages.emplace_back(std::make_pair(internal_id, version));
                     }
                 }
+                index++;
             }
-            index++;
         }
 
         if (error_versioned_pages.empty())
@@ -21,6 +21,7 @@
 #include <Storages/Page/workload/PSStressEnv.h>
 #include <Storages/Page/workload/PSWorkload.h>
 #include <Storages/Page/workload/PageStorageInMemoryCapacity.h>
+#include <Storages/Page/workload/ReadWriteScalability.h>
 #include <Storages/Page/workload/ThousandsOfOffset.h>
 
 using namespace DB::PS::tests;
@@ -36,6 +37,7 @@ int StressWorkload::mainEntry(int argc, char ** argv)
         work_load_register<HoldSnapshotsLongTime>();
         work_load_register<PageStorageInMemoryCapacity>();
         work_load_register<NormalWorkload>();
+        work_load_register<ReadWriteScalability>();
         work_load_register<ThousandsOfOffset>();
     }
     try
@@ -391,4 +391,32 @@ RandomPageId PSIncreaseWriter::genRandomPageId()
 {
     return RandomPageId(begin_page_id++);
 }
+
+bool PSRoundWriter::runImpl()
+{
+    if (round_stop)
+        return false;
+
+    const auto r = genRandomPageId();
+    auto buff_ptr = getRandomData();
+    DB::WriteBatch wb{DB::TEST_NAMESPACE_ID};
+    wb.putPage(r.page_id, 0, buff_ptr, buff_ptr->buffer().size());
+    ps->write(std::move(wb));
+
+    pages_used += 1;
+    bytes_used += buff_ptr->buffer().size();
+    return true;
+}
+
+void PSRoundWriter::setPageRange(size_t max_page_id_)
+{
+    max_page_id = max_page_id_;
+}
+
+bool PSRoundReader::runImpl()
+{
+    if (round_stop)
+        return false;
+    return PSReader::runImpl();
+}
 } // namespace DB::PS::tests
@@ -284,4 +284,42 @@ protected:
     size_t snapshot_get_interval_ms = 0;
     std::list<DB::PageStorage::SnapshotPtr> snapshots;
 };
+
+// PSRoundWriter and PSRoundReader keep running until `round_stop` is set, they are
+// used for measuring the QPS of PageStorage under different concurrency round by round.
+// PSRoundWriter writes one page to a random page id in each write batch. It doesn't
+// commit to `global_stat` to avoid the contention on it.
+class PSRoundWriter : public PSWriter
+{
+public:
+    PSRoundWriter(const PSPtr & ps_, DB::UInt32 index_, const std::unique_ptr<GlobalStat> & global_stat_, const std::atomic<bool> & round_stop_)
+        : PSWriter(ps_, index_, global_stat_)
+        , round_stop(round_stop_)
+    {}
+
+    String description() override { return fmt::format("(Stress Test Round Writer {})", index); }
+
+    bool runImpl() override;
+
+    void setPageRange(size_t max_page_id_);
+
+protected:
+    const std::atomic<bool> & round_stop;
+};
+
+class PSRoundReader : public PSReader
+{
+public:
+    PSRoundReader(const PSPtr & ps_, DB::UInt32 index_, const std::unique_ptr<GlobalStat> & global_stat_, const std::atomic<bool> & round_stop_)
+        : PSReader(ps_, index_, global_stat_)
+        , round_stop(round_stop_)
+    {}
+
+    String description() override { return fmt::format("(Stress Test Round Reader {})", index); }
+
+    bool runImpl() override;
+
+protected:
+    const std::atomic<bool> & round_stop;
+};
 } // namespace DB::PS::tests
@@ -0,0 +1,176 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/getNumberOfCPUCores.h>
+#include <IO/ReadBufferFromMemory.h>
+#include <Storages/Page/WriteBatchImpl.h>
+#include <Storages/Page/workload/PSRunnable.h>
+#include <Storages/Page/workload/PSWorkload.h>
+
+#include <thread>
+
+namespace DB::PS::tests
+{
+// Run readers and writers on small pages round by round, the number of readers and
+// writers are doubled in each round until reaching the number of CPU cores.
+// The cost of small pages is mostly on the page directory instead of IO, so the
+// read/write QPS of each round shows how PageStorage scales with the concurrency.
+class ReadWriteScalability : public StressWorkload
+    , public StressWorkloadFunc<ReadWriteScalability>
+{
+public:
+    explicit ReadWriteScalability(const StressEnv & options_)
+        : StressWorkload(options_)
+    {}
+
+    static String name()
+    {
+        return "ReadWriteScalability";
+    }
+
+    static UInt64 mask()
+    {
+        return 1 << 8;
+    }
+
+private:
+    String desc() override
+    {
+        return fmt::format("Some of options will be ignored"
+                           "`paths` will only used first one. which is {}. Data will store in {}"
+                           "Please cleanup folder after this test."
+                           "The current workload will run {} seconds for each round of concurrency [1, {}]",
+                           options.paths[0],
+                           options.paths[0] + "/" + name(),
+                           round_seconds,
+                           max_concurrency);
+    }
+
+    void run() override
+    {
+        DB::PageStorageConfig config;
+        initPageStorage(config, name());
+        initSmallPages();
+
+        // 1, 2, 4, ..., max_concurrency
+        std::vector<size_t> rounds;
+        for (size_t concurrency = 1; concurrency < max_concurrency; concurrency *= 2)
+            rounds.emplace_back(concurrency);
+        rounds.emplace_back(max_concurrency);
+
+        startBackgroundTimer();
+        stop_watch.start();
+        for (const auto concurrency : rounds)
+        {
+            // Stopped by timeout or exception
+            if (!StressEnvStatus::getInstance().isRunning())
+                break;
+            runRound(concurrency);
+        }
+        stop_watch.stop();
+    }
+
+    void onDumpResult() override
+    {
+        for (const auto & res : round_results)
+        {
+            LOG_INFO(options.logger,
+                     "concurrency: {}, W: {:.2f} QPS, R: {:.2f} QPS",
+                     res.concurrency,
+                     res.write_qps,
+                     res.read_qps);
+        }
+        if (options.status_interval != 0)
+        {
+            LOG_INFO(options.logger, metrics_dumper->toString());
+        }
+    }
+
+    void initSmallPages()
+    {
+        char buff[max_page_size] = {};
+        for (DB::PageIdU64 page_id = 0; page_id < num_pages;)
+        {
+            DB::WriteBatch wb{DB::TEST_NAMESPACE_ID};
+            for (size_t i = 0; i < 1000 && page_id < num_pages; ++i, ++page_id)
+                wb.putPage(page_id, 0, std::make_shared<DB::ReadBufferFromMemory>(buff, max_page_size), max_page_size);
+            ps->write(std::move(wb));
+        }
+        LOG_INFO(StressEnv::logger, "init {} small pages done", num_pages);
+    }
+
+    // Run `concurrency` writers and `concurrency` readers for `round_seconds`
+    void runRound(size_t concurrency)
+    {
+        std::atomic<bool> round_stop = false;
+        Poco::ThreadPool round_pool(2 * concurrency, 2 * concurrency);
+        std::vector<std::shared_ptr<PSRunnable>> round_writers;
+        std::vector<std::shared_ptr<PSRunnable>> round_readers;
+        for (size_t i = 0; i < concurrency; ++i)
+        {
+            auto writer = std::make_shared<PSRoundWriter>(ps, i, runtime_stat, round_stop);
+            writer->setBufferSizeRange(min_page_size, max_page_size);
+            writer->setPageRange(num_pages);
+            round_writers.emplace_back(writer);
+            round_pool.start(*writer, "writer" + DB::toString(i));
+
+            auto reader = std::make_shared<PSRoundReader>(ps, i, runtime_stat, round_stop);
+            reader->setReadDelay(0);
+            reader->setReadPageRange(num_pages - 1);
+            reader->setReadPageNums(1);
+            round_readers.emplace_back(reader);
+            round_pool.start(*reader, "reader" + DB::toString(i));
+        }
+
+        Stopwatch watch;
+        std::this_thread::sleep_for(std::chrono::seconds(round_seconds));
+        round_stop = true;
+        round_pool.joinAll();
+        const double seconds_run = watch.elapsedSeconds();
+
+        size_t pages_written = 0;
+        size_t pages_read = 0;
+        for (const auto & writer : round_writers)
+            pages_written += writer->pages_used;
+        for (const auto & reader : round_readers)
+            pages_read += reader->pages_used;
+
+        round_results.emplace_back(RoundResult{
+            .concurrency = concurrency,
+            .write_qps = pages_written / seconds_run,
+            .read_qps = pages_read / seconds_run,
+        });
+        LOG_INFO(StressEnv::logger,
+                 "round done, concurrency: {}, W: {:.2f} QPS, R: {:.2f} QPS",
+                 concurrency,
+                 round_results.back().write_qps,
+                 round_results.back().read_qps);
+    }
+
+private:
+    static constexpr size_t num_pages = 100000;
+    static constexpr size_t min_page_size = 64;
+    static constexpr size_t max_page_size = 256;
+    static constexpr size_t round_seconds = 10;
+    const size_t max_concurrency = getNumberOfPhysicalCPUCores();
+
+    struct RoundResult
+    {
+        size_t concurrency;
+        double write_qps;
+        double read_qps;
+    };
+    std::vector<RoundResult> round_results;
+};
+} // namespace DB::PS::tests
@@ -0,0 +1,237 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Common/TiFlashMetrics.h>
+#include <IO/ReadBufferFromFile.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Storages/S3/FileCache.h>
+#include <Storages/S3/S3Common.h>
+#include <common/logger_useful.h>
+#include <unistd.h>
+
+namespace DB::S3
+{
+namespace
+{
+std::unique_ptr<FileCache> global_file_cache;
+} // namespace
+
+void FileCache::initialize(const String & cache_dir, UInt64 capacity, UInt64 segment_size)
+{
+    RUNTIME_CHECK(global_file_cache == nullptr);
+    global_file_cache = std::make_unique<FileCache>(ClientFactory::instance().sharedTiFlashClient(), cache_dir, capacity, segment_size);
+}
+
+FileCache * FileCache::instance()
+{
+    return global_file_cache.get();
+}
+
+void FileCache::shutdown()
+{
+    global_file_cache.reset();
+}
+
+FileCache::Segment::~Segment()
+{
+    try
+    {
+        if (Poco::File file(local_path); file.exists())
+            file.remove();
+    }
+    catch (...)
+    {
+        tryLogCurrentException(__PRETTY_FUNCTION__, fmt::format("Remove cached segment failed, local_path={}", local_path));
+    }
+}
+
+String FileCache::getCacheDir(const String & cache_dir)
+{
+    return fmt::format("{}/remote_cache", cache_dir);
+}
+
+FileCache::FileCache(std::shared_ptr<TiFlashS3Client> client_, const String & cache_dir_, UInt64 capacity_, UInt64 segment_size_)
+    : client(std::move(client_))
+    , cache_dir(getCacheDir(cache_dir_))
+    , capacity(capacity_)
+    , segment_size(segment_size_)
+    , log(Logger::get())
+{
+    RUNTIME_CHECK(client != nullptr);
+    RUNTIME_CHECK_MSG(segment_size > 0 && segment_size <= capacity, "Invalid remote cache config, capacity={} segment_size={}", capacity, segment_size);
+
+    // The cached segments are not restored after restart, clean up the files left by the last process.
+    // Only the directory owned by the cache is removed, never the configured directory itself.
+    Poco::File dir(cache_dir);
+    if (dir.exists())
+        dir.remove(/*recursive*/ true);
+    dir.createDirectories();
+    GET_METRIC(tiflash_storage_remote_cache_bytes, type_used).Set(0);
+    LOG_INFO(log, "Initialize remote file cache, cache_dir={} capacity={} segment_size={}", cache_dir, capacity, segment_size);
+}
+
+String FileCache::nextLocalPath(const String & s3_key, UInt64 segment_idx)
+{
+    return fmt::format("{}/{}.seg_{}_{}", cache_dir, s3_key, segment_idx, next_segment_id++);
+}
+
+std::pair<FileCache::SegmentPtr, bool> FileCache::getOrDownload(const String & s3_key, UInt64 segment_idx)
+{
+    SegmentKey key{s3_key, segment_idx};
+    std::unique_lock lock(mtx);
+    while (true)
+    {
+        auto iter = segments.find(key);
+        if (iter == segments.end())
+            break;
+        auto & entry = iter->second;
+        if (entry.segment->downloaded)
+        {
+            lru.splice(lru.end(), lru, *entry.lru_pos);
+            GET_METRIC(tiflash_storage_remote_cache, type_hit).Increment();
+            return {entry.segment, true};
+        }
+        // Another thread is downloading it. Wait and check again, the download may fail.
+        download_cv.wait(lock);
+    }
+
+    GET_METRIC(tiflash_storage_remote_cache, type_miss).Increment();
+    auto segment = std::make_shared<Segment>(nextLocalPath(s3_key, segment_idx));
+    segments.emplace(key, Entry{segment, std::nullopt});
+    lock.unlock();
+
+    UInt64 downloaded_size = 0;
+    const auto tmp_path = segment->local_path + ".tmp";
+    try
+    {
+        Poco::File(Poco::Path(segment->local_path).parent()).createDirectories();
+        downloaded_size = downloadFileRange(*client, client->bucket(), tmp_path, s3_key, segment_idx * segment_size, segment_size);
+        Poco::File(tmp_path).renameTo(segment->local_path);
+    }
+    catch (...)
+    {
+        // Best effort, the tmp file is owned by this download only.
+        ::unlink(tmp_path.c_str());
+        lock.lock();
+        if (auto iter = segments.find(key); iter != segments.end() && iter->second.segment == segment)
+            segments.erase(iter);
+        download_cv.notify_all();
+        throw;
+    }
+    GET_METRIC(tiflash_storage_remote_cache, type_download_bytes).Increment(downloaded_size);
+
+    lock.lock();
+    segment->size = downloaded_size;
+    segment->downloaded = true;
+    // The object may be removed from the cache by `remove` during downloading.
+    if (auto iter = segments.find(key); iter != segments.end() && iter->second.segment == segment)
+    {
+        iter->second.lru_pos = lru.insert(lru.end(), key);
+        used_bytes += downloaded_size;
+        evictOverflow();
+    }
+    download_cv.notify_all();
+    return {segment, false};
+}
+
+void FileCache::evictOverflow()
+{
+    UInt64 evicted_bytes = 0;
+    while (used_bytes > capacity && !lru.empty())
+    {
+        auto iter = segments.find(lru.front());
+        lru.pop_front();
+        RUNTIME_CHECK(iter != segments.end());
+        // The local file is removed after the readers that holding the segment finish.
+        used_bytes -= iter->second.segment->size;
+        evicted_bytes += iter->second.segment->size;
+        segments.erase(iter);
+    }
+    GET_METRIC(tiflash_storage_remote_cache, type_evict_bytes).Increment(evicted_bytes);
+    GET_METRIC(tiflash_storage_remote_cache_bytes, type_used).Set(used_bytes);
+}
+
+void FileCache::read(const String & s3_key, UInt64 offset, UInt64 size, char * buf)
+{
+    const UInt64 end = offset + size;
+    for (UInt64 segment_idx = offset / segment_size; offset < end; ++segment_idx)
+    {
+        auto [segment, hit] = getOrDownload(s3_key, segment_idx);
+        const UInt64 segment_begin = segment_idx * segment_size;
+        const UInt64 offset_in_segment = offset - segment_begin;
+        const UInt64 read_size = std::min(end, segment_begin + segment_size) - offset;
+        RUNTIME_CHECK_MSG(
+            offset_in_segment + read_size <= segment->size,
+            "Read beyond the end of object, key={} offset={} size={} object_size={}",
+            s3_key,
+            offset,
+            read_size,
+            segment_begin + segment->size);
+
+        ReadBufferFromFile file(segment->local_path, std::min<UInt64>(read_size, DBMS_DEFAULT_BUFFER_SIZE));
+        file.seek(offset_in_segment);
+        file.readStrict(buf, read_size);
+        if (hit)
+            GET_METRIC(tiflash_storage_remote_cache, type_hit_bytes).Increment(read_size);
+
+        buf += read_size;
+        offset += read_size;
+    }
+}
+
+void FileCache::warmUp(const String & s3_key, UInt64 offset, UInt64 size)
+{
+    if (size == 0)
+        return;
+    const UInt64 last_segment_idx = (offset + size - 1) / segment_size;
+    for (UInt64 segment_idx = offset / segment_size; segment_idx <= last_segment_idx; ++segment_idx)
+        getOrDownload(s3_key, segment_idx);
+}
+
+void FileCache::warmUp(const String & s3_key)
+{
+    auto object_size = getObjectSize(*client, client->bucket(), s3_key, /*version_id*/ "", /*throw_on_error*/ true);
+    warmUp(s3_key, 0, object_size);
+}
+
+void FileCache::remove(const String & s3_key)
+{
+    std::lock_guard lock(mtx);
+    for (auto iter = segments.lower_bound(SegmentKey{s3_key, 0}); iter != segments.end() && iter->first.first == s3_key;)
+    {
+        if (iter->second.lru_pos)
+        {
+            lru.erase(*iter->second.lru_pos);
+            used_bytes -= iter->second.segment->size;
+        }
+        iter = segments.erase(iter);
+    }
+    GET_METRIC(tiflash_storage_remote_cache_bytes, type_used).Set(used_bytes);
+}
+
+UInt64 FileCache::getUsedBytes() const
+{
+    std::lock_guard lock(mtx);
+    return used_bytes;
+}
+
+size_t FileCache::getSegmentCount() const
+{
+    std::lock_guard lock(mtx);
+    return segments.size();
+}
+
+} // namespace DB::S3
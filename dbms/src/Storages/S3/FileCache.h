@@ -0,0 +1,133 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <Common/nocopyable.h>
+#include <common/types.h>
+
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace DB::S3
+{
+class TiFlashS3Client;
+
+/** A capacity-bounded cache of remote objects on the local disk. The disaggregated compute nodes use it
+  * to serve the repeated reads of the same DMFile columns or checkpoint data from local SSD.
+  *
+  * An object is split into aligned segments of `segment_size` bytes. A read only fetches the segments
+  * that cover the requested range (usually a column of some packs) by ranged GetObject, and stores
+  * them as local files. The segments are evicted in LRU order once the total size exceeds the capacity.
+  * The objects on S3 are immutable, so a cached segment never becomes stale.
+  *
+  * The segments that are being downloaded are not accounted, so the disk usage may exceed the capacity
+  * by at most `segment_size` for each concurrent reader. The segments are stored in the `remote_cache`
+  * subdirectory of `cache_dir`, which is cleared when the process restarts.
+  */
+class FileCache
+{
+public:
+    static constexpr UInt64 DEFAULT_SEGMENT_SIZE = 1024 * 1024;
+
+    static void initialize(const String & cache_dir, UInt64 capacity, UInt64 segment_size = DEFAULT_SEGMENT_SIZE);
+    // Return nullptr if the cache is not initialized
+    static FileCache * instance();
+    static void shutdown();
+
+    FileCache(std::shared_ptr<TiFlashS3Client> client_, const String & cache_dir_, UInt64 capacity_, UInt64 segment_size_ = DEFAULT_SEGMENT_SIZE);
+
+    // Return the directory owned by the cache under the configured `cache_dir`.
+    static String getCacheDir(const String & cache_dir);
+
+    DISALLOW_COPY_AND_MOVE(FileCache);
+
+    // Read [offset, offset + size) of the object `s3_key` into `buf`.
+    // Throws if the range exceeds the end of the object.
+    void read(const String & s3_key, UInt64 offset, UInt64 size, char * buf);
+
+    // Fetch [offset, offset + size) of the object into the cache in advance.
+    void warmUp(const String & s3_key, UInt64 offset, UInt64 size);
+    // Fetch the whole object into the cache in advance.
+    void warmUp(const String & s3_key);
+
+    // Drop the cached segments of the object, e.g. after it is removed from S3.
+    void remove(const String & s3_key);
+
+    UInt64 getUsedBytes() const;
+    size_t getSegmentCount() const;
+    UInt64 getCapacity() const { return capacity; }
+    UInt64 getSegmentSize() const { return segment_size; }
+
+#ifndef DBMS_PUBLIC_GTEST
+private:
+#endif
+    struct Segment
+    {
+        explicit Segment(const String & local_path_)
+            : local_path(local_path_)
+        {}
+        // The local file is removed when nobody holds the segment. A segment downloaded again
+        // after being evicted gets a new local path, so it never removes the file of another segment.
+        ~Segment();
+
+        const String local_path;
+        UInt64 size = 0;
+        bool downloaded = false;
+    };
+    using SegmentPtr = std::shared_ptr<Segment>;
+
+    // (s3_key, segment index)
+    using SegmentKey = std::pair<String, UInt64>;
+
+    struct Entry
+    {
+        SegmentPtr segment;
+        // Only the downloaded segments are linked in the LRU list.
+        std::optional<std::list<SegmentKey>::iterator> lru_pos;
+    };
+
+    // Return the downloaded segment and whether it hits the cache.
+    std::pair<SegmentPtr, bool> getOrDownload(const String & s3_key, UInt64 segment_idx);
+
+private:
+    // Must be called with `mtx` locked.
+    String nextLocalPath(const String & s3_key, UInt64 segment_idx);
+
+    void evictOverflow();
+
+private:
+    const std::shared_ptr<TiFlashS3Client> client;
+    const String cache_dir;
+    const UInt64 capacity;
+    const UInt64 segment_size;
+
+    mutable std::mutex mtx;
+    // Notified when a segment finishes downloading (or fails).
+    std::condition_variable download_cv;
+    std::map<SegmentKey, Entry> segments;
+    std::list<SegmentKey> lru;
+    UInt64 used_bytes = 0;
+    // Make the local path of each Segment unique.
+    UInt64 next_segment_id = 0;
+
+    LoggerPtr log;
+};
+
+} // namespace DB::S3
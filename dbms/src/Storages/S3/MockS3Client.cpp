@@ -20,6 +20,8 @@
 #include <aws/s3/S3Errors.h>
 #include <aws/s3/S3ServiceClientModel.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
+#include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/model/GetObjectResult.h>
 #include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/HeadObjectResult.h>
 #include <aws/s3/model/ListObjectsV2Request.h>
@@ -27,24 +29,81 @@
 #include <aws/s3/model/Object.h>
 #include <aws/s3/model/PutObjectRequest.h>
 
+#include <cstdio>
+#include <sstream>
+#include <thread>
+
 namespace DB::S3::tests
 {
 using namespace Aws::S3;
 
 Model::PutObjectOutcome MockS3Client::PutObject(const Model::PutObjectRequest & r) const
 {
+    std::lock_guard lock(mtx);
     put_keys.emplace_back(r.GetKey());
+    String content;
+    if (auto body = r.GetBody(); body != nullptr)
+        content = String{std::istreambuf_iterator<char>(*body), std::istreambuf_iterator<char>()};
+    storage[r.GetKey()] = std::move(content);
     return Model::PutObjectOutcome{Aws::AmazonWebServiceResult<Aws::Utils::Xml::XmlDocument>{}};
 }
 
+Model::GetObjectOutcome MockS3Client::GetObject(const Model::GetObjectRequest & r) const
+{
+    String body;
+    {
+        std::lock_guard lock(mtx);
+        auto itr = storage.find(r.GetKey());
+        if (itr == storage.end())
+        {
+            Aws::Client::AWSError error(S3Errors::NO_SUCH_KEY, false);
+            return Model::GetObjectOutcome{error};
+        }
+        const auto & content = itr->second;
+
+        // Only the form "bytes=<first>-<last>" is supported.
+        size_t first = 0;
+        size_t last = content.empty() ? 0 : content.size() - 1;
+        if (r.RangeHasBeenSet())
+        {
+            const auto & range = r.GetRange();
+            if (sscanf(range.c_str(), "bytes=%zu-%zu", &first, &last) != 2 || first > last || first >= content.size())
+            {
+                Aws::Client::AWSError error(S3Errors::INVALID_PARAMETER_VALUE, "InvalidRange", "The requested range is not satisfiable", false);
+                return Model::GetObjectOutcome{error};
+            }
+            last = std::min(last, content.size() - 1);
+        }
+        size_t length = content.empty() ? 0 : last - first + 1;
+        body = content.substr(first, length);
+        ++get_object_count;
+        get_object_bytes += length;
+    }
+
+    // Simulate the round trip and the transfer time of a single stream without holding the lock.
+    auto latency = get_object_latency;
+    if (get_object_stream_bytes_per_sec > 0)
+        latency += std::chrono::microseconds(body.size() * 1000000 / get_object_stream_bytes_per_sec);
+    if (latency.count() > 0)
+        std::this_thread::sleep_for(latency);
+
+    Model::GetObjectResult result;
+    result.SetContentLength(body.size());
+    // `GetObjectResult` takes the ownership of the body.
+    result.ReplaceBody(new std::stringstream(std::move(body)));
+    return Model::GetObjectOutcome{std::move(result)};
+}
+
 Model::DeleteObjectOutcome MockS3Client::DeleteObject(const Model::DeleteObjectRequest & r) const
 {
+    std::lock_guard lock(mtx);
     delete_keys.emplace_back(r.GetKey());
     return Model::DeleteObjectOutcome{Aws::AmazonWebServiceResult<Aws::Utils::Xml::XmlDocument>{}};
 }
 
 Model::ListObjectsV2Outcome MockS3Client::ListObjectsV2(const Model::ListObjectsV2Request & r) const
 {
+    std::lock_guard lock(mtx);
     Model::ListObjectsV2Result resp;
     for (const auto & k : put_keys)
     {
@@ -91,11 +150,13 @@ Model::ListObjectsV2Outcome MockS3Client::ListObjectsV2(const Model::ListObjects
 
 Model::HeadObjectOutcome MockS3Client::HeadObject(const Model::HeadObjectRequest & r) const
 {
+    std::lock_guard lock(mtx);
     for (const auto & k : put_keys)
     {
         if (r.GetKey() == k)
         {
             Model::HeadObjectResult resp;
+            resp.SetContentLength(storage[k].size());
             return Model::HeadObjectOutcome{resp};
         }
     }
@@ -112,6 +173,10 @@ Model::HeadObjectOutcome MockS3Client::HeadObject(const Model::HeadObjectRequest
 
 void MockS3Client::clear()
 {
+    std::lock_guard lock(mtx);
+    storage.clear();
+    get_object_count = 0;
+    get_object_bytes = 0;
     put_keys.clear();
     delete_keys.clear();
     list_result.clear();
@@ -18,6 +18,10 @@
 #include <aws/s3/S3Client.h>
 #include <common/defines.h>
 
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
 namespace DB::S3::tests
 {
 class MockS3Client final : public S3::TiFlashS3Client
@@ -34,6 +38,15 @@ public:
     Aws::S3::Model::PutObjectOutcome PutObject(const Aws::S3::Model::PutObjectRequest & r) const override;
     mutable Strings put_keys;
 
+    // Return the content put by `PutObject`. The "Range" of the request is respected.
+    Aws::S3::Model::GetObjectOutcome GetObject(const Aws::S3::Model::GetObjectRequest & r) const override;
+    mutable size_t get_object_count = 0;
+    mutable UInt64 get_object_bytes = 0;
+    // Injected latency of each GetObject: a fixed round trip plus the transfer time at the
+    // bandwidth of a single stream (0 means unlimited)
+    std::chrono::microseconds get_object_latency{0};
+    UInt64 get_object_stream_bytes_per_sec = 0;
+
     Aws::S3::Model::DeleteObjectOutcome DeleteObject(const Aws::S3::Model::DeleteObjectRequest & r) const override;
     mutable Strings delete_keys;
 
@@ -42,5 +55,10 @@ public:
 
     std::optional<Aws::Utils::DateTime> head_result_mtime;
     Aws::S3::Model::HeadObjectOutcome HeadObject(const Aws::S3::Model::HeadObjectRequest & request) const override;
+
+private:
+    mutable std::mutex mtx;
+    // key -> content of the objects put by `PutObject`
+    mutable std::unordered_map<String, String> storage;
 };
 } // namespace DB::S3::tests
@@ -38,6 +38,8 @@
 namespace ProfileEvents
 {
 extern const Event S3HeadObject;
+extern const Event S3GetObject;
+extern const Event S3ReadBytes;
 }
 
 namespace DB::ErrorCodes
@@ -347,6 +349,54 @@ void downloadFile(const Aws::S3::S3Client & client, const String & bucket, const
     LOG_DEBUG(log, "local_fname={}, remote_fname={}, cost={}ms", local_fname, remote_fname, sw.elapsedMilliseconds());
 }
 
+UInt64 downloadFileRange(const Aws::S3::S3Client & client, const String & bucket, const String & local_fname, const String & remote_fname, UInt64 offset, UInt64 size)
+{
+    RUNTIME_CHECK(size > 0, remote_fname, offset, size);
+    Stopwatch sw;
+    ProfileEvents::increment(ProfileEvents::S3GetObject);
+    Aws::S3::Model::GetObjectRequest req;
+    req.SetBucket(bucket);
+    req.SetKey(remote_fname);
+    req.SetRange(fmt::format("bytes={}-{}", offset, offset + size - 1));
+    auto result = client.GetObject(req);
+    if (!result.IsSuccess())
+    {
+        throw details::fromS3Error(result.GetError(), "S3 GetObject failed, local_fname={} bucket={} key={} offset={} size={}", local_fname, bucket, remote_fname, offset, size);
+    }
+    UInt64 downloaded = result.GetResult().GetContentLength();
+    ProfileEvents::increment(ProfileEvents::S3ReadBytes, downloaded);
+    Aws::OFStream ostr(local_fname, std::ios_base::out | std::ios_base::binary);
+    ostr << result.GetResult().GetBody().rdbuf();
+    ostr.flush();
+    RUNTIME_CHECK_MSG(ostr.good(), "Write downloaded data failed, local_fname={} key={} offset={} size={}", local_fname, remote_fname, offset, downloaded);
+    static auto log = Logger::get();
+    LOG_DEBUG(log, "local_fname={}, remote_fname={}, offset={}, size={}, cost={}ms", local_fname, remote_fname, offset, downloaded, sw.elapsedMilliseconds());
+    return downloaded;
+}
+
+UInt64 readObjectRange(const Aws::S3::S3Client & client, const String & bucket, const String & key, UInt64 offset, UInt64 size, char * buf)
+{
+    RUNTIME_CHECK(size > 0, key, offset, size);
+    ProfileEvents::increment(ProfileEvents::S3GetObject);
+    Aws::S3::Model::GetObjectRequest req;
+    req.SetBucket(bucket);
+    req.SetKey(key);
+    req.SetRange(fmt::format("bytes={}-{}", offset, offset + size - 1));
+    auto result = client.GetObject(req);
+    if (!result.IsSuccess())
+    {
+        throw details::fromS3Error(result.GetError(), "S3 GetObject failed, bucket={} key={} offset={} size={}", bucket, key, offset, size);
+    }
+    const UInt64 expected = result.GetResult().GetContentLength();
+    RUNTIME_CHECK(expected <= size, key, offset, size, expected);
+    auto & body = result.GetResult().GetBody();
+    body.read(buf, expected);
+    const UInt64 read_bytes = body.gcount();
+    RUNTIME_CHECK_MSG(read_bytes == expected, "S3 GetObject returns less data than expected, key={} offset={} expected={} actual={}", key, offset, expected, read_bytes);
+    ProfileEvents::increment(ProfileEvents::S3ReadBytes, read_bytes);
+    return read_bytes;
+}
+
 void listPrefix(
     const Aws::S3::S3Client & client,
     const String & bucket,
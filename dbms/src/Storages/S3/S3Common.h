@@ -102,6 +102,14 @@ void uploadEmptyFile(const Aws::S3::S3Client & client, const String & bucket, co
 
 void downloadFile(const Aws::S3::S3Client & client, const String & bucket, const String & local_fname, const String & remote_fname);
 
+// Download the byte range [offset, offset + size) of the object to `local_fname`.
+// Return the number of bytes downloaded, which is less than `size` if the range exceeds the end of the object.
+UInt64 downloadFileRange(const Aws::S3::S3Client & client, const String & bucket, const String & local_fname, const String & remote_fname, UInt64 offset, UInt64 size);
+
+// Read the byte range [offset, offset + size) of the object into `buf`.
+// Return the number of bytes read, which is less than `size` if the range exceeds the end of the object.
+UInt64 readObjectRange(const Aws::S3::S3Client & client, const String & bucket, const String & key, UInt64 offset, UInt64 size, char * buf);
+
 struct PageResult
 {
     size_t num_keys;
@@ -0,0 +1,112 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Common/ThreadManager.h>
+#include <Storages/S3/S3Common.h>
+#include <Storages/S3/S3ParallelReadBuffer.h>
+
+namespace DB::S3
+{
+S3ParallelReadBuffer::S3ParallelReadBuffer(std::shared_ptr<TiFlashS3Client> client_, const String & key_, const Options & options_)
+    : S3ParallelReadBuffer(
+        client_,
+        key_,
+        getObjectSize(*client_, client_->bucket(), key_, /*version_id*/ "", /*throw_on_error*/ true),
+        options_)
+{}
+
+S3ParallelReadBuffer::S3ParallelReadBuffer(std::shared_ptr<TiFlashS3Client> client_, const String & key_, UInt64 object_size_, const Options & options_)
+    : ReadBuffer(nullptr, 0)
+    , client(std::move(client_))
+    , key(key_)
+    , object_size(object_size_)
+    , options(options_)
+{
+    RUNTIME_CHECK(options.range_size > 0 && options.max_inflight_ranges > 0, options.range_size, options.max_inflight_ranges);
+    thread_pool = newThreadPoolManager(options.max_inflight_ranges);
+    scheduleRanges();
+}
+
+S3ParallelReadBuffer::~S3ParallelReadBuffer()
+{
+    // The ranges not started yet are skipped. Wait for the running ones because they reference `this`.
+    cancelled = true;
+    try
+    {
+        thread_pool->wait();
+    }
+    catch (...)
+    {
+        tryLogCurrentException(__PRETTY_FUNCTION__);
+    }
+}
+
+void S3ParallelReadBuffer::scheduleRanges()
+{
+    while (inflight_ranges.size() < options.max_inflight_ranges && next_offset_to_schedule < object_size)
+    {
+        auto range = std::make_shared<Range>();
+        range->offset = next_offset_to_schedule;
+        range->size = std::min(options.range_size, object_size - next_offset_to_schedule);
+        next_offset_to_schedule += range->size;
+        inflight_ranges.push_back(range);
+        thread_pool->schedule(/*propagate_memory_tracker*/ true, [this, range] { fetchRange(range); });
+    }
+}
+
+void S3ParallelReadBuffer::fetchRange(const RangePtr & range)
+{
+    try
+    {
+        if (!cancelled)
+        {
+            range->data.resize(range->size);
+            auto n = readObjectRange(*client, client->bucket(), key, range->offset, range->size, range->data.data());
+            RUNTIME_CHECK_MSG(n == range->size, "The object is truncated, key={} offset={} expected={} actual={}", key, range->offset, range->size, n);
+        }
+    }
+    catch (...)
+    {
+        range->exception = std::current_exception();
+    }
+    {
+        std::lock_guard lock(mtx);
+        range->finished = true;
+    }
+    finish_cv.notify_all();
+}
+
+bool S3ParallelReadBuffer::nextImpl()
+{
+    // Release the consumed range before fetching more, so that the memory usage is bounded.
+    current_range.reset();
+    if (inflight_ranges.empty())
+        return false;
+
+    current_range = inflight_ranges.front();
+    inflight_ranges.pop_front();
+    {
+        std::unique_lock lock(mtx);
+        finish_cv.wait(lock, [&] { return current_range->finished; });
+    }
+    if (current_range->exception)
+        std::rethrow_exception(current_range->exception);
+    scheduleRanges();
+
+    working_buffer = Buffer(current_range->data.data(), current_range->data.data() + current_range->data.size());
+    return true;
+}
+
+} // namespace DB::S3
@@ -0,0 +1,94 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <IO/ReadBuffer.h>
+#include <common/types.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace DB
+{
+class ThreadPoolManager;
+}
+
+namespace DB::S3
+{
+class TiFlashS3Client;
+
+/** Read an object on S3 sequentially while fetching its byte ranges concurrently, so a large object
+  * (e.g. a checkpoint data file of several GBs) is not read at single-stream throughput.
+  *
+  * The object is split into ranges of `range_size` bytes. At most `max_inflight_ranges` ranges are
+  * being fetched or waiting to be consumed, so the memory usage is bounded by about
+  * `(max_inflight_ranges + 1) * range_size`. The ranges are exposed as the working buffer in order.
+  */
+class S3ParallelReadBuffer : public ReadBuffer
+{
+public:
+    struct Options
+    {
+        UInt64 range_size = 8 * 1024 * 1024;
+        size_t max_inflight_ranges = 4;
+    };
+
+    S3ParallelReadBuffer(std::shared_ptr<TiFlashS3Client> client_, const String & key_, const Options & options_);
+
+    // Skip the HEAD request when the size of the object is already known.
+    S3ParallelReadBuffer(std::shared_ptr<TiFlashS3Client> client_, const String & key_, UInt64 object_size_, const Options & options_);
+
+    ~S3ParallelReadBuffer() override;
+
+    UInt64 getObjectSize() const { return object_size; }
+
+private:
+    struct Range
+    {
+        UInt64 offset = 0;
+        UInt64 size = 0;
+        String data;
+        bool finished = false;
+        std::exception_ptr exception;
+    };
+    using RangePtr = std::shared_ptr<Range>;
+
+    bool nextImpl() override;
+
+    void scheduleRanges();
+    void fetchRange(const RangePtr & range);
+
+private:
+    const std::shared_ptr<TiFlashS3Client> client;
+    const String key;
+    const UInt64 object_size;
+    const Options options;
+
+    std::shared_ptr<ThreadPoolManager> thread_pool;
+    UInt64 next_offset_to_schedule = 0;
+    // The ranges being fetched or waiting to be consumed, in the order of offset.
+    std::deque<RangePtr> inflight_ranges;
+    // The range exposed as the working buffer.
+    RangePtr current_range;
+
+    std::mutex mtx;
+    std::condition_variable finish_cv;
+    std::atomic<bool> cancelled = false;
+};
+
+} // namespace DB::S3
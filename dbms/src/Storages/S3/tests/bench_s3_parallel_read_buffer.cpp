@@ -0,0 +1,99 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <IO/ReadHelpers.h>
+#include <Poco/Environment.h>
+#include <Storages/S3/MockS3Client.h>
+#include <Storages/S3/S3Common.h>
+#include <Storages/S3/S3ParallelReadBuffer.h>
+#include <aws/core/Aws.h>
+#include <aws/s3/model/PutObjectRequest.h>
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+
+namespace DB::S3::tests
+{
+namespace
+{
+constexpr UInt64 OBJECT_SIZE = 64 * 1024 * 1024;
+constexpr auto OBJECT_KEY = "s1/data/dat_1_0";
+} // namespace
+
+// Each GetObject costs 10ms of round trip, and a single stream transfers at 200MB/s.
+class S3ParallelReadBufferBench : public benchmark::Fixture
+{
+public:
+    void SetUp(const benchmark::State &) override
+    {
+        // The AWS SDK is not initialized by the bench main.
+        Poco::Environment::set("AWS_EC2_METADATA_DISABLED", "true");
+        Aws::InitAPI(aws_options);
+        client = std::make_shared<MockS3Client>();
+        Aws::S3::Model::PutObjectRequest req;
+        req.WithBucket(client->bucket()).WithKey(OBJECT_KEY);
+        req.SetBody(std::make_shared<std::stringstream>(String(OBJECT_SIZE, 'a')));
+        client->PutObject(req);
+        client->get_object_latency = std::chrono::milliseconds(10);
+        client->get_object_stream_bytes_per_sec = 200 * 1024 * 1024;
+    }
+
+    void TearDown(const benchmark::State &) override
+    {
+        client.reset();
+        Aws::ShutdownAPI(aws_options);
+    }
+
+    Aws::SDKOptions aws_options;
+    std::shared_ptr<MockS3Client> client;
+};
+
+BENCHMARK_DEFINE_F(S3ParallelReadBufferBench, SingleGet)
+(benchmark::State & state)
+{
+    String res(OBJECT_SIZE, '\0');
+    for (auto _ : state)
+    {
+        auto n = readObjectRange(*client, client->bucket(), OBJECT_KEY, 0, OBJECT_SIZE, res.data());
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetBytesProcessed(state.iterations() * OBJECT_SIZE);
+}
+
+// range(0): range size in MiB, range(1): max inflight ranges
+BENCHMARK_DEFINE_F(S3ParallelReadBufferBench, ParallelRead)
+(benchmark::State & state)
+{
+    const S3ParallelReadBuffer::Options options{
+        .range_size = static_cast<UInt64>(state.range(0)) * 1024 * 1024,
+        .max_inflight_ranges = static_cast<size_t>(state.range(1)),
+    };
+    String res;
+    for (auto _ : state)
+    {
+        S3ParallelReadBuffer buf(client, OBJECT_KEY, OBJECT_SIZE, options);
+        res.clear();
+        readStringUntilEOF(res, buf);
+        benchmark::DoNotOptimize(res.data());
+    }
+    state.SetBytesProcessed(state.iterations() * OBJECT_SIZE);
+}
+
+BENCHMARK_REGISTER_F(S3ParallelReadBufferBench, SingleGet)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_REGISTER_F(S3ParallelReadBufferBench, ParallelRead)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->ArgsProduct({{4, 8, 16}, {1, 4, 8}});
+
+} // namespace DB::S3::tests
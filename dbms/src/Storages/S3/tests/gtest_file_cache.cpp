@@ -0,0 +1,192 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Storages/S3/FileCache.h>
+#include <Storages/S3/MockS3Client.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <TestUtils/TiFlashTestEnv.h>
+#include <aws/s3/model/PutObjectRequest.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace DB::S3::tests
+{
+class FileCacheTest : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        client = std::make_shared<MockS3Client>();
+        cache_dir = DB::tests::TiFlashTestEnv::getTemporaryPath("FileCacheTest");
+    }
+
+    String putObject(const String & key, size_t size)
+    {
+        String content(size, '\0');
+        for (size_t i = 0; i < size; ++i)
+            content[i] = static_cast<char>(i * 7 + key.size());
+        Aws::S3::Model::PutObjectRequest req;
+        req.WithBucket(client->bucket()).WithKey(key);
+        req.SetBody(std::make_shared<std::stringstream>(content));
+        client->PutObject(req);
+        return content;
+    }
+
+    static String readRange(FileCache & cache, const String & key, UInt64 offset, UInt64 size)
+    {
+        String buf(size, '\0');
+        cache.read(key, offset, size, buf.data());
+        return buf;
+    }
+
+protected:
+    std::shared_ptr<MockS3Client> client;
+    String cache_dir;
+};
+
+TEST_F(FileCacheTest, ReadRange)
+try
+{
+    auto content = putObject("s1/data/dmf_1/1.dat", 10000);
+    FileCache cache(client, cache_dir, /*capacity*/ 1 << 20, /*segment_size*/ 1024);
+
+    // The first read fetches only the covered segments [1, 3).
+    ASSERT_EQ(readRange(cache, "s1/data/dmf_1/1.dat", 1500, 1000), content.substr(1500, 1000));
+    ASSERT_EQ(client->get_object_count, 2);
+    ASSERT_EQ(client->get_object_bytes, 2048);
+    ASSERT_EQ(cache.getSegmentCount(), 2);
+    ASSERT_EQ(cache.getUsedBytes(), 2048);
+
+    // Served from the local disk.
+    ASSERT_EQ(readRange(cache, "s1/data/dmf_1/1.dat", 1024, 2048), content.substr(1024, 2048));
+    ASSERT_EQ(client->get_object_count, 2);
+
+    // The last segment is shorter than the segment size.
+    ASSERT_EQ(readRange(cache, "s1/data/dmf_1/1.dat", 9000, 1000), content.substr(9000, 1000));
+    ASSERT_EQ(client->get_object_count, 3);
+    ASSERT_EQ(cache.getUsedBytes(), 2048 + 10000 - 9 * 1024);
+
+    // Beyond the end of the object.
+    ASSERT_ANY_THROW(readRange(cache, "s1/data/dmf_1/1.dat", 9500, 1000));
+    ASSERT_ANY_THROW(readRange(cache, "s1/data/dmf_1/1.dat", 20000, 10));
+    ASSERT_ANY_THROW(readRange(cache, "s1/data/dmf_1/not_exist.dat", 0, 10));
+}
+CATCH
+
+TEST_F(FileCacheTest, EvictLRU)
+try
+{
+    auto content = putObject("s1/data/dmf_2/1.dat", 8 * 1024);
+    FileCache cache(client, cache_dir, /*capacity*/ 4 * 1024, /*segment_size*/ 1024);
+
+    for (size_t i = 0; i < 4; ++i)
+        readRange(cache, "s1/data/dmf_2/1.dat", i * 1024, 1);
+    ASSERT_EQ(cache.getUsedBytes(), 4 * 1024);
+
+    // Touch segment 0, then segment 1 is the least recently used one.
+    readRange(cache, "s1/data/dmf_2/1.dat", 0, 1);
+    readRange(cache, "s1/data/dmf_2/1.dat", 4 * 1024, 1);
+    ASSERT_EQ(cache.getSegmentCount(), 4);
+    ASSERT_EQ(cache.getUsedBytes(), 4 * 1024);
+    ASSERT_EQ(client->get_object_count, 5);
+
+    readRange(cache, "s1/data/dmf_2/1.dat", 0, 1);
+    ASSERT_EQ(client->get_object_count, 5);
+    ASSERT_EQ(readRange(cache, "s1/data/dmf_2/1.dat", 1024, 1024), content.substr(1024, 1024));
+    ASSERT_EQ(client->get_object_count, 6);
+    ASSERT_EQ(cache.getUsedBytes(), 4 * 1024);
+}
+CATCH
+
+TEST_F(FileCacheTest, WarmUpAndRemove)
+try
+{
+    auto content = putObject("s1/data/dmf_3/1.dat", 3000);
+    FileCache cache(client, cache_dir, /*capacity*/ 1 << 20, /*segment_size*/ 1024);
+
+    cache.warmUp("s1/data/dmf_3/1.dat");
+    ASSERT_EQ(cache.getSegmentCount(), 3);
+    ASSERT_EQ(cache.getUsedBytes(), 3000);
+    ASSERT_EQ(client->get_object_count, 3);
+
+    ASSERT_EQ(readRange(cache, "s1/data/dmf_3/1.dat", 0, 3000), content);
+    ASSERT_EQ(client->get_object_count, 3);
+
+    cache.remove("s1/data/dmf_3/1.dat");
+    ASSERT_EQ(cache.getSegmentCount(), 0);
+    ASSERT_EQ(cache.getUsedBytes(), 0);
+    std::vector<String> files;
+    Poco::File(FileCache::getCacheDir(cache_dir) + "/s1/data/dmf_3").list(files);
+    ASSERT_TRUE(files.empty());
+
+    ASSERT_EQ(readRange(cache, "s1/data/dmf_3/1.dat", 100, 10), content.substr(100, 10));
+    ASSERT_EQ(client->get_object_count, 4);
+}
+CATCH
+
+TEST_F(FileCacheTest, EvictWhileHeld)
+try
+{
+    const String key = "s1/data/dmf_4/1.dat";
+    auto content = putObject(key, 2 * 1024);
+    FileCache cache(client, cache_dir, /*capacity*/ 1024, /*segment_size*/ 1024);
+
+    auto [held, hit] = cache.getOrDownload(key, 0);
+    ASSERT_FALSE(hit);
+
+    // Evict segment 0 while it is held, then download it again.
+    readRange(cache, key, 1024, 1);
+    ASSERT_EQ(cache.getSegmentCount(), 1);
+    ASSERT_EQ(readRange(cache, key, 0, 1024), content.substr(0, 1024));
+    ASSERT_EQ(client->get_object_count, 3);
+
+    // Releasing the evicted segment must not remove the file of the new one.
+    const auto held_path = held->local_path;
+    held.reset();
+    ASSERT_FALSE(Poco::File(held_path).exists());
+    ASSERT_EQ(readRange(cache, key, 0, 1024), content.substr(0, 1024));
+    ASSERT_EQ(client->get_object_count, 3);
+
+    // The same for the segments dropped by `remove`.
+    std::tie(held, hit) = cache.getOrDownload(key, 0);
+    ASSERT_TRUE(hit);
+    cache.remove(key);
+    ASSERT_EQ(readRange(cache, key, 0, 1024), content.substr(0, 1024));
+    held.reset();
+    ASSERT_EQ(readRange(cache, key, 0, 1024), content.substr(0, 1024));
+    ASSERT_EQ(client->get_object_count, 4);
+}
+CATCH
+
+TEST_F(FileCacheTest, OnlyCleanOwnDirectory)
+try
+{
+    Poco::File(cache_dir).createDirectories();
+    const String other_file = cache_dir + "/other_data";
+    Poco::File(other_file).createFile();
+    const String left_segment = FileCache::getCacheDir(cache_dir) + "/s1/data/dmf_5/1.dat.seg_0_0";
+    Poco::File(Poco::Path(left_segment).parent()).createDirectories();
+    Poco::File(left_segment).createFile();
+
+    FileCache cache(client, cache_dir, /*capacity*/ 1 << 20, /*segment_size*/ 1024);
+    ASSERT_TRUE(Poco::File(other_file).exists());
+    ASSERT_FALSE(Poco::File(left_segment).exists());
+}
+CATCH
+
+} // namespace DB::S3::tests
@@ -0,0 +1,104 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <IO/ReadHelpers.h>
+#include <Storages/S3/MockS3Client.h>
+#include <Storages/S3/S3ParallelReadBuffer.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <aws/s3/model/PutObjectRequest.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+namespace DB::S3::tests
+{
+class S3ParallelReadBufferTest : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        client = std::make_shared<MockS3Client>();
+    }
+
+    String putObject(const String & key, size_t size)
+    {
+        String content(size, '\0');
+        for (size_t i = 0; i < size; ++i)
+            content[i] = static_cast<char>(i * 13 + i / 256);
+        Aws::S3::Model::PutObjectRequest req;
+        req.WithBucket(client->bucket()).WithKey(key);
+        req.SetBody(std::make_shared<std::stringstream>(content));
+        client->PutObject(req);
+        return content;
+    }
+
+protected:
+    std::shared_ptr<MockS3Client> client;
+};
+
+TEST_F(S3ParallelReadBufferTest, ReadAll)
+try
+{
+    auto content = putObject("s1/data/dat_1_0", 100000);
+    for (UInt64 range_size : {7, 999, 1024, 100000, 200000})
+    {
+        for (size_t max_inflight_ranges : {1, 4})
+        {
+            client->get_object_count = 0;
+            S3ParallelReadBuffer buf(client, "s1/data/dat_1_0", {.range_size = range_size, .max_inflight_ranges = max_inflight_ranges});
+            ASSERT_EQ(buf.getObjectSize(), content.size());
+            String res;
+            readStringUntilEOF(res, buf);
+            ASSERT_EQ(res, content) << range_size << " " << max_inflight_ranges;
+            ASSERT_EQ(client->get_object_count, (content.size() + range_size - 1) / range_size);
+        }
+    }
+}
+CATCH
+
+TEST_F(S3ParallelReadBufferTest, ReadPartly)
+try
+{
+    auto content = putObject("s1/data/dat_1_1", 100000);
+    {
+        // Destroy the buffer before all ranges are consumed.
+        S3ParallelReadBuffer buf(client, "s1/data/dat_1_1", {.range_size = 100, .max_inflight_ranges = 8});
+        String res(1050, '\0');
+        buf.readStrict(res.data(), res.size());
+        ASSERT_EQ(res, content.substr(0, 1050));
+    }
+    // Only the ranges in the window are fetched.
+    ASSERT_LE(client->get_object_count, 11 + 8);
+}
+CATCH
+
+TEST_F(S3ParallelReadBufferTest, EmptyAndNotExist)
+try
+{
+    putObject("s1/data/dat_1_2", 0);
+    {
+        S3ParallelReadBuffer buf(client, "s1/data/dat_1_2", {});
+        ASSERT_TRUE(buf.eof());
+        ASSERT_EQ(client->get_object_count, 0);
+    }
+    ASSERT_ANY_THROW(S3ParallelReadBuffer(client, "s1/data/not_exist", {}));
+    {
+        // The size is larger than the actual object.
+        S3ParallelReadBuffer buf(client, "s1/data/dat_1_2", 10, {});
+        ASSERT_ANY_THROW(buf.eof());
+    }
+}
+CATCH
+
+} // namespace DB::S3::tests
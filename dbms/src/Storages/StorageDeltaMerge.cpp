@@ -25,6 +25,7 @@
 #include <DataTypes/isSupportedDataTypeCast.h>
 #include <Databases/IDatabase.h>
 #include <Debug/MockTiDB.h>
+#include <Flash/Coprocessor/DAGQueryInfo.h>
 #include <Interpreters/Context.h>
 #include <Parsers/ASTCreateQuery.h>
 #include <Parsers/ASTExpressionList.h>
@@ -725,7 +726,22 @@ DM::RSOperatorPtr StorageDeltaMerge::parseRoughSetFilter(const SelectQueryInfo &
                 // Maybe throw an exception? Or check if `type` is nullptr before creating filter?
                 return Attr{.col_name = "", .col_id = column_id, .type = DataTypePtr{}};
             };
-            rs_operator = FilterParser::parseDAGQuery(*query_info.dag_query, columns_to_read, std::move(create_attr_by_column_id), log);
+            rs_operator = FilterParser::parseDAGQuery(*query_info.dag_query, columns_to_read, create_attr_by_column_id, log);
+
+            /// Runtime filters from the join build side are checked together with the filters of the query.
+            RSOperators children;
+            for (const auto & runtime_filter : query_info.dag_query->runtime_filters)
+            {
+                auto attr = create_attr_by_column_id(runtime_filter->target_column_id);
+                if (attr.type)
+                    children.emplace_back(createRuntimeFilterCheck(attr, runtime_filter));
+            }
+            if (!children.empty())
+            {
+                if (rs_operator != DM::EMPTY_FILTER)
+                    children.emplace_back(rs_operator);
+                rs_operator = children.size() == 1 ? children[0] : createAnd(children);
+            }
         }
         if (likely(rs_operator != DM::EMPTY_FILTER))
             LOG_DEBUG(tracing_logger, "Rough set filter: {}", rs_operator->toDebugString());
@@ -16,6 +16,7 @@
 #include <Flash/Coprocessor/TiDBTime.h>
 #include <Storages/Transaction/DatumCodec.h>
 #include <Storages/Transaction/JsonBinary.h>
+#include <Storages/Transaction/JsonPathExpr.h>
 #include <Storages/Transaction/JsonPathExprRef.h>
 
 #pragma GCC diagnostic push
@@ -87,12 +88,12 @@ JsonBinary JsonBinary::getArrayElement(size_t index) const
     return getValueEntry(HEADER_SIZE + index * VALUE_ENTRY_SIZE);
 }
 
-String JsonBinary::getObjectKey(size_t index) const
+StringRef JsonBinary::getObjectKey(size_t index) const
 {
     size_t cursor = HEADER_SIZE + index * KEY_ENTRY_SIZE;
     auto key_offset = decodeNumeric<UInt32>(cursor, data);
     auto key_length = decodeNumeric<UInt16>(cursor, data);
-    return String(data.data + key_offset, key_length);
+    return getSubRef(key_offset, key_length);
 }
 
 JsonBinary JsonBinary::getObjectValue(size_t index) const
@@ -590,6 +591,58 @@ bool JsonBinary::extract(std::vector<JsonPathExprRefContainerPtr> & path_expr_co
     return found;
 }
 
+bool JsonBinary::extractSinglePath(const JsonPathExpr & path_expr, std::vector<UInt32> & key_hints, JsonBinaryWriteBuffer & write_buffer) const
+{
+    const auto & legs = path_expr.getLegs();
+    RUNTIME_CHECK(!path_expr.couldMatchMultipleValues());
+    if (key_hints.size() < legs.size())
+        key_hints.resize(legs.size(), std::numeric_limits<UInt32>::max());
+
+    JsonBinary current = *this;
+    for (size_t i = 0; i < legs.size(); ++i)
+    {
+        const auto & leg = *legs[i];
+        if (leg.type == JsonPathLeg::JsonPathLegKey)
+        {
+            if (current.type != TYPE_CODE_OBJECT)
+                return false;
+            auto element_count = current.getElementCount();
+            if (element_count == 0)
+                return false;
+
+            const StringRef key(leg.dot_key.key);
+            UInt32 index = key_hints[i];
+            if (index >= element_count || !(current.getObjectKey(index) == key))
+            {
+                index = current.binarySearchKey(leg.dot_key, element_count);
+                if (!(current.getObjectKey(index) == key))
+                    return false;
+                key_hints[i] = index;
+            }
+            current = current.getObjectValue(index);
+        }
+        else
+        {
+            RUNTIME_CHECK(leg.type == JsonPathLeg::JsonPathLegArraySelection && leg.array_selection.type == JsonPathArraySelectionIndex);
+            if (current.type != TYPE_CODE_ARRAY)
+            {
+                /// Same as `extractTo`, a non-array value is selected by [0] itself.
+                if (leg.array_selection.index != 0)
+                    return false;
+                continue;
+            }
+            auto range = leg.array_selection.getIndexRange(current);
+            if (range.first < 0 || range.first > range.second)
+                return false;
+            current = current.getArrayElement(range.first);
+        }
+    }
+
+    write_buffer.write(current.type);
+    write_buffer.write(current.data.data, current.data.size);
+    return true;
+}
+
 bool jsonFinished(std::vector<JsonBinary> & json_binary_vec, bool one)
 {
     return one && !json_binary_vec.empty();
@@ -606,7 +659,7 @@ std::optional<JsonBinary> JsonBinary::searchObjectKey(JsonPathObjectKey & key) c
     {
     case JsonPathObjectKeyCached:
         found_index = key.cached_index;
-        if (found_index < element_count && getObjectKey(found_index) == key.key)
+        if (found_index < element_count && getObjectKey(found_index) == StringRef(key.key))
             return {getObjectValue(found_index)};
         else
             found_index = binarySearchKey(key, element_count);
@@ -618,7 +671,7 @@ std::optional<JsonBinary> JsonBinary::searchObjectKey(JsonPathObjectKey & key) c
         break;
     }
 
-    if (found_index < element_count && getObjectKey(found_index) == key.key)
+    if (found_index < element_count && getObjectKey(found_index) == StringRef(key.key))
     {
         if (key.status == JsonPathObjectKeyUncached)
         {
@@ -634,13 +687,13 @@ std::optional<JsonBinary> JsonBinary::searchObjectKey(JsonPathObjectKey & key) c
 UInt32 JsonBinary::binarySearchKey(const JsonPathObjectKey & key, UInt32 element_count) const
 {
     RUNTIME_CHECK(element_count > 0);
+    const StringRef target(key.key);
     Int32 first = 0;
     Int32 distance = element_count - 1;
     while (distance > 0)
     {
-        Int32 step = distance >> 2;
-        const String & current_key = getObjectKey(first + step);
-        if (current_key < key.key)
+        Int32 step = distance >> 1;
+        if (getObjectKey(first + step) < target)
         {
             first += step;
             ++first;
@@ -31,6 +31,7 @@ using ConstJsonPathExprRawPtr = JsonPathExprRef const *;
 class JsonPathExprRefContainer;
 using JsonPathExprRefContainerPtr = std::unique_ptr<JsonPathExprRefContainer>;
 struct JsonPathObjectKey;
+class JsonPathExpr;
 /**
  * https://github.com/pingcap/tidb/blob/release-6.4/types/json_binary.go
  * https://github.com/pingcap/tidb/blob/release-6.4/types/json_constants.go
@@ -142,6 +143,13 @@ public:
     ///	Serialize final results in 'write_buffer'
     bool extract(std::vector<JsonPathExprRefContainerPtr> & path_expr_container_vec, JsonBinaryWriteBuffer & write_buffer);
 
+    /// Extract a path without any asterisk or range, which matches at most one value, and serialize the value in 'write_buffer'.
+    /// Unlike `extract`, it walks down the binary in place without collecting the matches, and the object keys are binary
+    /// searched over the sorted key entries without being copied.
+    /// 'key_hints' holds the matched key index of each leg, which is usually the same for the rows of a column, it is
+    /// checked before the binary search and updated after it. Returns false if the path doesn't match.
+    bool extractSinglePath(const JsonPathExpr & path_expr, std::vector<UInt32> & key_hints, JsonBinaryWriteBuffer & write_buffer) const;
+
     static String unquoteString(const StringRef & ref);
     static void unquoteStringInBuffer(const StringRef & ref, JsonBinaryWriteBuffer & write_buffer);
     static String unquoteJsonString(const StringRef & ref);
@@ -160,7 +168,7 @@ private:
     StringRef getSubRef(size_t offset, size_t length) const;
 
     JsonBinary getArrayElement(size_t index) const;
-    String getObjectKey(size_t index) const; /// Expect object key not be too long, use String instead of StringRef as return type
+    StringRef getObjectKey(size_t index) const;
     JsonBinary getObjectValue(size_t index) const;
     JsonBinary getValueEntry(size_t value_entry_offset) const;
 
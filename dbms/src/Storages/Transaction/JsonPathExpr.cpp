@@ -258,15 +258,18 @@ std::shared_ptr<JsonPathExpr> JsonPathExpr::parseJsonPathExpr(const StringRef &
         return nullptr;
 
     /// If multiple match could happen, disable LegKey cache index
-    if (JsonPathExpr::containsAnyAsterisk(path_expr->flag) || JsonPathExpr::containsAnyRange(path_expr->flag))
+    if (path_expr->couldMatchMultipleValues())
+        path_expr->disableKeyCache();
+    return path_expr;
+}
+
+void JsonPathExpr::disableKeyCache()
+{
+    for (auto & leg_ptr : legs)
     {
-        for (auto & leg_ptr : path_expr->legs)
-        {
-            if (leg_ptr->type == JsonPathLeg::JsonPathLegKey)
-                leg_ptr->dot_key.status = JsonPathObjectKeyCacheDisabled;
-        }
+        if (leg_ptr->type == JsonPathLeg::JsonPathLegKey)
+            leg_ptr->dot_key.status = JsonPathObjectKeyCacheDisabled;
     }
-    return path_expr;
 }
 
 bool JsonPathExpr::parseJsonPathArray(JsonPathStream & stream, JsonPathExpr * path_expr)
@@ -190,6 +190,12 @@ public:
 
     JsonPathExpressionFlag getFlag() const { return flag; }
 
+    // CouldMatchMultipleValues returns true if pe contains any asterisk or range selection.
+    bool couldMatchMultipleValues() const { return containsAnyAsterisk(flag) || containsAnyRange(flag); }
+
+    /// Disable the key index caching of all legs, so that the path can be shared by concurrent extractions.
+    void disableKeyCache();
+
     const std::vector<JsonPathLegPtr> & getLegs() const { return legs; }
 
 private:
@@ -85,7 +85,10 @@ TMTContext::TMTContext(Context & context_, const TiFlashRaftConfig & raft_config
           std::make_unique<MinTSOScheduler>(
               context.getSettingsRef().task_scheduler_thread_soft_limit,
               context.getSettingsRef().task_scheduler_thread_hard_limit,
-              context.getSettingsRef().task_scheduler_active_set_soft_limit)))
+              context.getSettingsRef().task_scheduler_active_set_soft_limit,
+              context.getSettingsRef().task_scheduler_memory_soft_limit,
+              context.getSettingsRef().task_scheduler_memory_hard_limit,
+              context.getSettingsRef().task_scheduler_enable_fair_share)))
     , engine(raft_config.engine)
     , batch_read_index_timeout_ms(DEFAULT_BATCH_READ_INDEX_TIMEOUT_MS)
     , wait_index_timeout_ms(DEFAULT_WAIT_INDEX_TIMEOUT_MS)
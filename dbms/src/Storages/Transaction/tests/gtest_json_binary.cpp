@@ -731,6 +731,72 @@ try
 }
 CATCH
 
+TEST_F(TestJsonBinary, TestExtractSinglePath)
+try
+{
+    // clang-format off
+    /// `{"\"hello\"": "world", "a": [1, "2", {"aa": "bb"}, 4.0, {"aa": "cc"}], "b": true, "c": ["d"]}`
+    UInt8 bj1[] = {
+        0x4, 0x0, 0x0, 0x0, 0xb6, 0x0, 0x0, 0x0, 0x34, 0x0, 0x0, 0x0, 0x7, 0x0, 0x3b, 0x0, 0x0, 0x0, 0x1, 0x0, 0x3c, 0x0, 0x0,
+        0x0, 0x1, 0x0, 0x3d, 0x0, 0x0, 0x0, 0x1, 0x0, 0xc, 0x3e, 0x0, 0x0, 0x0, 0x3, 0x44, 0x0, 0x0, 0x0, 0x4, 0x1, 0x0, 0x0, 0x0,
+        0x3, 0xa7, 0x0, 0x0, 0x0, 0x22, 0x68, 0x65, 0x6c, 0x6c, 0x6f, 0x22, 0x61, 0x62, 0x63, 0x5, 0x77, 0x6f, 0x72, 0x6c, 0x64, 0x5,
+        0x0, 0x0, 0x0, 0x63, 0x0, 0x0, 0x0, 0x9, 0x21, 0x0, 0x0, 0x0, 0xc, 0x29, 0x0, 0x0, 0x0, 0x1, 0x2b, 0x0, 0x0, 0x0, 0xb, 0x43,
+        0x0, 0x0, 0x0, 0x1, 0x4b, 0x0, 0x0, 0x0, 0x1, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1, 0x32, 0x1, 0x0, 0x0, 0x0, 0x18, 0x0, 0x0,
+        0x0, 0x13, 0x0, 0x0, 0x0, 0x2, 0x0, 0xc, 0x15, 0x0, 0x0, 0x0, 0x61, 0x61, 0x2, 0x62, 0x62, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x10,
+        0x40, 0x1, 0x0, 0x0, 0x0, 0x18, 0x0, 0x0, 0x0, 0x13, 0x0, 0x0, 0x0, 0x2, 0x0, 0xc, 0x15, 0x0, 0x0, 0x0, 0x61, 0x61, 0x2, 0x63,
+        0x63, 0x1, 0x0, 0x0, 0x0, 0xf, 0x0, 0x0, 0x0, 0xc, 0xd, 0x0, 0x0, 0x0, 0x1, 0x64
+    };
+    // clang-format on
+    JsonBinary json_binary_1(JsonBinary::TYPE_CODE_OBJECT, StringRef(bj1, sizeof(bj1) / sizeof(UInt8)));
+
+    const std::vector<String> paths{
+        "$",
+        "$.a",
+        "$.b",
+        "$.c",
+        "$.\"\\\"hello\\\"\"",
+        "$.a[2].aa",
+        "$.a[4].aa",
+        "$.a[last].aa",
+        "$.a[last - 1]",
+        "$.a[5]",
+        "$.a[0][0]",
+        "$.a[0][1]",
+        "$.c[0]",
+        "$.b.d",
+        "$.d",
+        "$.aa",
+        "$[0].a",
+        "$[1]",
+    };
+    for (const auto & path : paths)
+    {
+        auto path_expr = JsonPathExpr::parseJsonPathExpr(path);
+        ASSERT_TRUE(path_expr) << path;
+        ASSERT_FALSE(path_expr->couldMatchMultipleValues()) << path;
+
+        ColumnString::Chars_t expected;
+        WriteBufferFromVector<ColumnString::Chars_t> expected_buffer(expected);
+        std::vector<JsonPathExprRefContainerPtr> path_expr_container_vec;
+        path_expr_container_vec.push_back(std::make_unique<JsonPathExprRefContainer>(path_expr));
+        bool expected_found = json_binary_1.extract(path_expr_container_vec, expected_buffer);
+        expected.resize(expected_buffer.count());
+
+        /// The key hints are reused across extractions, check both the first extraction and the one with hints.
+        std::vector<UInt32> key_hints;
+        for (size_t i = 0; i < 2; ++i)
+        {
+            ColumnString::Chars_t actual;
+            WriteBufferFromVector<ColumnString::Chars_t> actual_buffer(actual);
+            bool found = json_binary_1.extractSinglePath(*path_expr, key_hints, actual_buffer);
+            actual.resize(actual_buffer.count());
+            ASSERT_EQ(found, expected_found) << path;
+            ASSERT_EQ(String(actual.begin(), actual.end()), String(expected.begin(), expected.end())) << path;
+        }
+    }
+}
+CATCH
+
 TEST_F(TestJsonBinary, TestConstant)
 try
 {
@@ -20,6 +20,7 @@
 #include <DataTypes/DataTypesNumber.h>
 #include <Functions/FunctionsConditional.h>
 #include <WindowFunctions/IWindowFunction.h>
+#include <WindowFunctions/WindowFunctionAggregate.h>
 #include <WindowFunctions/WindowFunctionFactory.h>
 
 #include <magic_enum.hpp>
@@ -319,5 +320,11 @@ void registerWindowFunctions(WindowFunctionFactory & factory)
     factory.registerFunction<WindowFunctionRowNumber>();
     factory.registerFunction<WindowFunctionLeadLagBase<LeadImpl>>();
     factory.registerFunction<WindowFunctionLeadLagBase<LagImpl>>();
+    for (const String & name : {"sum", "count", "avg", "min", "max"})
+    {
+        factory.registerFunction(name, [name](const DataTypes & argument_types) {
+            return std::make_shared<WindowFunctionAggregate>(name, argument_types);
+        });
+    }
 }
 } // namespace DB
@@ -18,6 +18,7 @@
 #include <Core/Field.h>
 #include <Core/Types.h>
 #include <DataTypes/IDataType.h>
+#include <Storages/Transaction/Collator.h>
 
 
 namespace DB
@@ -43,6 +44,8 @@ public:
         const ColumnNumbers & arguments)
         = 0;
 
+    virtual void setCollators(TiDB::TiDBCollators &) {}
+
 protected:
     DataTypes argument_types;
 };
@@ -0,0 +1,179 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <Columns/ColumnNullable.h>
+#include <Common/Exception.h>
+#include <Common/assert_cast.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <WindowFunctions/WindowFunctionAggregate.h>
+
+namespace DB
+{
+WindowFunctionAggregate::WindowFunctionAggregate(const String & name_, const DataTypes & argument_types_)
+    : IWindowFunction(argument_types_)
+    , name(name_)
+{
+    RUNTIME_CHECK_MSG(
+        argument_types.size() == 1 || (name == "count" && argument_types.empty()),
+        "Number of arguments for window function {} doesn't match: passed {}, should be 1.",
+        name,
+        argument_types.size());
+
+    DataTypes nested_types;
+    for (const auto & type : argument_types)
+        nested_types.push_back(removeNullable(type));
+    argument_is_nullable = !argument_types.empty() && argument_types[0]->isNullable();
+    aggregate_function = AggregateFunctionFactory::instance().get(name, nested_types);
+
+    if (name == "max")
+        monotonic_direction = 1;
+    else if (name == "min")
+        monotonic_direction = -1;
+    RUNTIME_CHECK_MSG(
+        monotonic_direction != 0 || aggregate_function->isInvertible(),
+        "Aggregate function {} is not supported as window function.",
+        name);
+
+    // count of an empty frame is 0, the others are null.
+    if (name == "count")
+        return_type = aggregate_function->getReturnType();
+    else
+        return_type = makeNullable(aggregate_function->getReturnType());
+}
+
+void WindowFunctionAggregate::setCollators(TiDB::TiDBCollators & collators)
+{
+    if (!collators.empty())
+        collator = collators[0];
+    aggregate_function->setCollators(collators);
+}
+
+bool WindowFunctionAggregate::isNotNullAt(const WindowFunctionWorkspace & workspace, const Columns & columns, size_t row) const
+{
+    return !argument_is_nullable
+        || !assert_cast<const ColumnNullable &>(*columns[workspace.arguments[0]]).isNullAt(row);
+}
+
+const IColumn & WindowFunctionAggregate::getNestedColumn(const IColumn & column) const
+{
+    if (argument_is_nullable)
+        return assert_cast<const ColumnNullable &>(column).getNestedColumn();
+    return column;
+}
+
+int WindowFunctionAggregate::compareAt(
+    const WindowTransformAction & action,
+    const WindowFunctionWorkspace & workspace,
+    const RowNumber & lhs,
+    const RowNumber & rhs) const
+{
+    const auto & lhs_column = getNestedColumn(*action.inputAt(lhs)[workspace.arguments[0]]);
+    const auto & rhs_column = getNestedColumn(*action.inputAt(rhs)[workspace.arguments[0]]);
+    if (collator)
+        return lhs_column.compareAt(lhs.row, rhs.row, rhs_column, 1 /* nan_direction_hint */, *collator);
+    return lhs_column.compareAt(lhs.row, rhs.row, rhs_column, 1 /* nan_direction_hint */);
+}
+
+void WindowFunctionAggregate::reset(WindowFunctionWorkspace & workspace) const
+{
+    if (monotonic_direction == 0)
+    {
+        aggregate_function->destroy(workspace.aggregate_function_state);
+        aggregate_function->create(workspace.aggregate_function_state);
+    }
+    workspace.not_null_rows = 0;
+    workspace.monotonic_rows.clear();
+}
+
+void WindowFunctionAggregate::add(
+    const WindowTransformAction & action,
+    WindowFunctionWorkspace & workspace,
+    const Columns & columns,
+    const RowNumber & row) const
+{
+    if (!isNotNullAt(workspace, columns, row.row))
+        return;
+    ++workspace.not_null_rows;
+
+    if (monotonic_direction == 0)
+    {
+        const IColumn * column = workspace.arguments.empty() ? nullptr : &getNestedColumn(*columns[workspace.arguments[0]]);
+        aggregate_function->add(workspace.aggregate_function_state, &column, row.row, nullptr);
+        return;
+    }
+
+    // The rows before `row` that are not better than it will never be the result again.
+    auto & rows = workspace.monotonic_rows;
+    while (!rows.empty() && compareAt(action, workspace, rows.back(), row) * monotonic_direction <= 0)
+        rows.pop_back();
+    rows.push_back(row);
+}
+
+void WindowFunctionAggregate::remove(
+    WindowFunctionWorkspace & workspace,
+    const Columns & columns,
+    const RowNumber & row) const
+{
+    if (!isNotNullAt(workspace, columns, row.row))
+        return;
+    assert(workspace.not_null_rows > 0);
+    --workspace.not_null_rows;
+
+    if (monotonic_direction == 0)
+    {
+        const IColumn * column = workspace.arguments.empty() ? nullptr : &getNestedColumn(*columns[workspace.arguments[0]]);
+        aggregate_function->decrease(workspace.aggregate_function_state, &column, row.row, nullptr);
+        return;
+    }
+
+    // The rows are removed in order, so `row` can only be at the front.
+    auto & rows = workspace.monotonic_rows;
+    if (!rows.empty() && rows.front() == row)
+        rows.pop_front();
+}
+
+void WindowFunctionAggregate::windowInsertResultInto(
+    WindowTransformAction & action,
+    size_t function_index,
+    const ColumnNumbers & arguments)
+{
+    const auto & workspace = action.workspaces[function_index];
+    IColumn & to = *action.outputAt(action.current_row)[function_index];
+    if (!return_type->isNullable())
+    {
+        aggregate_function->insertResultInto(workspace.aggregate_function_state, to, &action.arena);
+        return;
+    }
+
+    if (workspace.not_null_rows == 0)
+    {
+        to.insertDefault();
+        return;
+    }
+
+    auto & nullable_to = assert_cast<ColumnNullable &>(to);
+    if (monotonic_direction == 0)
+    {
+        aggregate_function->insertResultInto(workspace.aggregate_function_state, nullable_to.getNestedColumn(), &action.arena);
+    }
+    else
+    {
+        const auto & row = workspace.monotonic_rows.front();
+        nullable_to.getNestedColumn().insertFrom(getNestedColumn(*action.inputAt(row)[arguments[0]]), row.row);
+    }
+    nullable_to.getNullMapData().push_back(0);
+}
+
+} // namespace DB
@@ -0,0 +1,91 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <AggregateFunctions/IAggregateFunction.h>
+#include <DataStreams/WindowBlockInputStream.h>
+#include <WindowFunctions/IWindowFunction.h>
+
+namespace DB
+{
+/** Calculates an aggregate function over the frame of each row, e.g. `sum(a) over (rows between 2 preceding and current row)`.
+  * The frame only slides forward, so the state of the frame is updated incrementally rather than recalculated for each row:
+  *  - For the invertible functions(sum/count/avg), the rows entering the frame are added to the state by `IAggregateFunction::add`
+  *    and the rows leaving the frame are removed from the state by `IAggregateFunction::decrease`.
+  *  - For min/max, the rows that can still become the result are kept in a monotonic deque, whose front is the result.
+  * Every row is added and removed once, so the cost is linear to the number of rows regardless of the frame size.
+  * The null arguments are skipped, and the result is null for an empty frame except for count.
+  */
+class WindowFunctionAggregate final : public IWindowFunction
+{
+public:
+    WindowFunctionAggregate(const String & name_, const DataTypes & argument_types_);
+
+    String getName() const override
+    {
+        return name;
+    }
+
+    DataTypePtr getReturnType() const override
+    {
+        return return_type;
+    }
+
+    void setCollators(TiDB::TiDBCollators & collators) override;
+
+    void windowInsertResultInto(
+        WindowTransformAction & action,
+        size_t function_index,
+        const ColumnNumbers & arguments) override;
+
+    const AggregateFunctionPtr & getAggregateFunction() const
+    {
+        return aggregate_function;
+    }
+
+    // Reset the state of `workspace` to an empty frame.
+    void reset(WindowFunctionWorkspace & workspace) const;
+
+    void add(
+        const WindowTransformAction & action,
+        WindowFunctionWorkspace & workspace,
+        const Columns & columns,
+        const RowNumber & row) const;
+
+    // The rows must be removed in the order they are added.
+    void remove(
+        WindowFunctionWorkspace & workspace,
+        const Columns & columns,
+        const RowNumber & row) const;
+
+private:
+    // Return false if the argument of `row` is null.
+    bool isNotNullAt(const WindowFunctionWorkspace & workspace, const Columns & columns, size_t row) const;
+
+    const IColumn & getNestedColumn(const IColumn & column) const;
+
+    int compareAt(const WindowTransformAction & action, const WindowFunctionWorkspace & workspace, const RowNumber & lhs, const RowNumber & rhs) const;
+
+    String name;
+    // Built on the not-null argument types, the null arguments are skipped before calling it.
+    AggregateFunctionPtr aggregate_function;
+    DataTypePtr return_type;
+    bool argument_is_nullable = false;
+    // 1 for max, -1 for min and 0 for the invertible functions.
+    int monotonic_direction = 0;
+    TiDB::TiDBCollatorPtr collator = nullptr;
+};
+
+} // namespace DB
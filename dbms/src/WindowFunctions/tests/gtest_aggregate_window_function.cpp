@@ -0,0 +1,296 @@
+// Copyright 2023 PingCAP, Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataStreams/BlocksListBlockInputStream.h>
+#include <DataStreams/WindowBlockInputStream.h>
+#include <Interpreters/Context.h>
+#include <TestUtils/AggregationTestUtils.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <WindowFunctions/WindowFunctionFactory.h>
+#include <WindowFunctions/registerWindowFunctions.h>
+
+#include <optional>
+#include <random>
+
+namespace DB
+{
+namespace tests
+{
+class AggregateWindowFunctionTest : public AggregationTest
+{
+public:
+    static void SetUpTestCase()
+    {
+        AggregationTest::SetUpTestCase();
+        try
+        {
+            registerWindowFunctions();
+        }
+        catch (DB::Exception &)
+        {
+            // Maybe another test has already registered, ignore exception here.
+        }
+    }
+
+    void SetUp() override
+    {
+        std::mt19937_64 rng(42);
+        for (Int64 partition = 0; partition < 5; ++partition)
+        {
+            // Some partitions are shorter than the frames.
+            size_t partition_rows = partition == 0 ? 2 : rng() % 100 + 1;
+            Int64 order = 0;
+            for (size_t i = 0; i < partition_rows; ++i)
+            {
+                // Duplicated order by values to make peer groups.
+                order += rng() % 2;
+                partitions.push_back(partition);
+                orders.push_back(order);
+                if (rng() % 5 == 0)
+                    values.push_back(std::nullopt);
+                else
+                    values.push_back(static_cast<Int64>(rng() % 1000) - 500);
+            }
+        }
+    }
+
+    BlocksList makeBlocks(size_t block_size) const
+    {
+        BlocksList blocks;
+        for (size_t begin = 0; begin < values.size(); begin += block_size)
+        {
+            size_t end = std::min(begin + block_size, values.size());
+            blocks.push_back(Block{
+                createColumn<Int64>(std::vector<Int64>(partitions.begin() + begin, partitions.begin() + end), "partition"),
+                createColumn<Int64>(std::vector<Int64>(orders.begin() + begin, orders.begin() + end), "order"),
+                createColumn<Nullable<Int64>>(std::vector<std::optional<Int64>>(values.begin() + begin, values.begin() + end), "value")});
+        }
+        return blocks;
+    }
+
+    static WindowFrame makeFrame(
+        WindowFrame::FrameType type,
+        WindowFrame::BoundaryType begin_type,
+        UInt64 begin_offset,
+        bool begin_preceding,
+        WindowFrame::BoundaryType end_type,
+        UInt64 end_offset,
+        bool end_preceding)
+    {
+        WindowFrame frame;
+        frame.is_default = false;
+        frame.type = type;
+        frame.begin_type = begin_type;
+        frame.begin_offset = begin_offset;
+        frame.begin_preceding = begin_preceding;
+        frame.end_type = end_type;
+        frame.end_offset = end_offset;
+        frame.end_preceding = end_preceding;
+        return frame;
+    }
+
+    // Returns the frame of each row as [begin, end) by brute force.
+    std::pair<size_t, size_t> getFrame(const WindowFrame & frame, size_t row) const
+    {
+        size_t partition_begin = row;
+        while (partition_begin > 0 && partitions[partition_begin - 1] == partitions[row])
+            --partition_begin;
+        size_t partition_end = row + 1;
+        while (partition_end < values.size() && partitions[partition_end] == partitions[row])
+            ++partition_end;
+
+        auto peer_group_begin = [&]() {
+            size_t i = row;
+            while (i > partition_begin && orders[i - 1] == orders[row])
+                --i;
+            return i;
+        };
+        auto peer_group_end = [&]() {
+            size_t i = row + 1;
+            while (i < partition_end && orders[i] == orders[row])
+                ++i;
+            return i;
+        };
+        auto rows_offset = [&](UInt64 offset, bool preceding, Int64 delta) {
+            Int64 pos = static_cast<Int64>(row) + (preceding ? -static_cast<Int64>(offset) : static_cast<Int64>(offset)) + delta;
+            return static_cast<size_t>(std::clamp<Int64>(pos, partition_begin, partition_end));
+        };
+
+        size_t begin = partition_begin;
+        if (frame.begin_type == WindowFrame::BoundaryType::Current)
+            begin = frame.type == WindowFrame::FrameType::Rows ? row : peer_group_begin();
+        else if (frame.begin_type == WindowFrame::BoundaryType::Offset)
+            begin = rows_offset(frame.begin_offset.get<UInt64>(), frame.begin_preceding, 0);
+
+        size_t end = partition_end;
+        if (frame.end_type == WindowFrame::BoundaryType::Current)
+            end = frame.type == WindowFrame::FrameType::Rows ? row + 1 : peer_group_end();
+        else if (frame.end_type == WindowFrame::BoundaryType::Offset)
+            end = rows_offset(frame.end_offset.get<UInt64>(), frame.end_preceding, 1);
+        return {begin, std::max(begin, end)};
+    }
+
+    Field calculate(const String & function_name, size_t begin, size_t end) const
+    {
+        Int64 sum = 0;
+        UInt64 count = 0;
+        std::optional<Int64> min, max;
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (!values[i])
+                continue;
+            sum += *values[i];
+            ++count;
+            min = min ? std::min(*min, *values[i]) : *values[i];
+            max = max ? std::max(*max, *values[i]) : *values[i];
+        }
+        if (function_name == "count")
+            return count;
+        if (count == 0)
+            return Null();
+        if (function_name == "sum")
+            return sum;
+        if (function_name == "avg")
+            return static_cast<Float64>(sum) / count;
+        if (function_name == "min")
+            return *min;
+        return *max;
+    }
+
+    void checkFrame(const WindowFrame & frame)
+    {
+        auto header = makeBlocks(values.size()).front().cloneEmpty();
+        auto value_type = header.getByName("value").type;
+
+        WindowDescription window_description;
+        window_description.partition_by = {SortColumnDescription("partition", 1, 1)};
+        window_description.order_by = {SortColumnDescription("order", 1, 1)};
+        window_description.frame = frame;
+        std::vector<String> function_names{"sum", "count", "avg", "min", "max"};
+        for (const auto & name : function_names)
+        {
+            WindowFunctionDescription description;
+            description.window_function = WindowFunctionFactory::instance().get(name, {value_type});
+            description.arguments = {header.getPositionByName("value")};
+            description.argument_names = {"value"};
+            description.column_name = name;
+            window_description.add_columns.emplace_back(name, description.window_function->getReturnType());
+            window_description.window_functions_descriptions.push_back(std::move(description));
+        }
+
+        auto context = TiFlashTestEnv::getContext();
+        SpillConfig spill_config(context.getTemporaryPath(), "aggregate_window_function_test", 0, 0, 0, context.getFileProvider());
+        for (size_t block_size : std::vector<size_t>{1, 3, 7, DEFAULT_BLOCK_SIZE})
+        {
+            WindowBlockInputStream stream(std::make_shared<BlocksListBlockInputStream>(makeBlocks(block_size)), window_description, 0, spill_config, "");
+            size_t row = 0;
+            stream.readPrefix();
+            while (Block block = stream.read())
+            {
+                for (size_t i = 0; i < block.rows(); ++i, ++row)
+                {
+                    auto [begin, end] = getFrame(frame, row);
+                    for (const auto & name : function_names)
+                    {
+                        ASSERT_EQ((*block.getByName(name).column)[i], calculate(name, begin, end))
+                            << "function: " << name << ", row: " << row << ", block size: " << block_size;
+                    }
+                }
+            }
+            stream.readSuffix();
+            ASSERT_EQ(row, values.size());
+        }
+    }
+
+    std::vector<Int64> partitions;
+    std::vector<Int64> orders;
+    std::vector<std::optional<Int64>> values;
+};
+
+TEST_F(AggregateWindowFunctionTest, RowsFrame)
+try
+{
+    using Type = WindowFrame::FrameType;
+    using Boundary = WindowFrame::BoundaryType;
+    // rows between 3 preceding and current row
+    checkFrame(makeFrame(Type::Rows, Boundary::Offset, 3, true, Boundary::Current, 0, false));
+    // rows between 2 preceding and 2 following
+    checkFrame(makeFrame(Type::Rows, Boundary::Offset, 2, true, Boundary::Offset, 2, false));
+    // rows between unbounded preceding and 1 preceding
+    checkFrame(makeFrame(Type::Rows, Boundary::Unbounded, 0, true, Boundary::Offset, 1, true));
+    // rows between 5 preceding and 2 preceding
+    checkFrame(makeFrame(Type::Rows, Boundary::Offset, 5, true, Boundary::Offset, 2, true));
+    // rows between 1 following and 3 following
+    checkFrame(makeFrame(Type::Rows, Boundary::Offset, 1, false, Boundary::Offset, 3, false));
+    // rows between current row and unbounded following
+    checkFrame(makeFrame(Type::Rows, Boundary::Current, 0, true, Boundary::Unbounded, 0, false));
+    // rows between 2 following and 1 following, the frames are empty
+    checkFrame(makeFrame(Type::Rows, Boundary::Offset, 2, false, Boundary::Offset, 1, false));
+}
+CATCH
+
+TEST_F(AggregateWindowFunctionTest, RangeFrame)
+try
+{
+    using Type = WindowFrame::FrameType;
+    using Boundary = WindowFrame::BoundaryType;
+    // range between unbounded preceding and current row
+    checkFrame(makeFrame(Type::Ranges, Boundary::Unbounded, 0, true, Boundary::Current, 0, false));
+    // range between current row and unbounded following
+    checkFrame(makeFrame(Type::Ranges, Boundary::Current, 0, true, Boundary::Unbounded, 0, false));
+    // range between current row and current row
+    checkFrame(makeFrame(Type::Ranges, Boundary::Current, 0, true, Boundary::Current, 0, false));
+    // range between unbounded preceding and unbounded following
+    checkFrame(makeFrame(Type::Ranges, Boundary::Unbounded, 0, true, Boundary::Unbounded, 0, false));
+}
+CATCH
+
+TEST_F(AggregateWindowFunctionTest, DecimalAvg)
+try
+{
+    // The integer argument of avg is cast to decimal by the DAG analyzer, avg keeps the exact decimal result.
+    Block block{
+        createColumn<Int64>({0, 0, 0, 0}, "partition"),
+        createColumn<Int64>({0, 1, 2, 3}, "order"),
+        createColumn<Nullable<Decimal128>>(std::make_tuple(19, 0), {"1", "2", "2", {}}, "value")};
+
+    WindowDescription window_description;
+    window_description.partition_by = {SortColumnDescription("partition", 1, 1)};
+    window_description.order_by = {SortColumnDescription("order", 1, 1)};
+    // rows between 1 preceding and current row
+    window_description.frame = makeFrame(WindowFrame::FrameType::Rows, WindowFrame::BoundaryType::Offset, 1, true, WindowFrame::BoundaryType::Current, 0, false);
+    WindowFunctionDescription description;
+    description.window_function = WindowFunctionFactory::instance().get("avg", {block.getByName("value").type});
+    description.arguments = {block.getPositionByName("value")};
+    description.argument_names = {"value"};
+    description.column_name = "avg";
+    window_description.add_columns.emplace_back("avg", description.window_function->getReturnType());
+    window_description.window_functions_descriptions.push_back(std::move(description));
+
+    auto context = TiFlashTestEnv::getContext();
+    SpillConfig spill_config(context.getTemporaryPath(), "aggregate_window_function_test", 0, 0, 0, context.getFileProvider());
+    WindowBlockInputStream stream(std::make_shared<BlocksListBlockInputStream>(BlocksList{block}), window_description, 0, spill_config, "");
+    stream.readPrefix();
+    Block result = stream.read();
+    ASSERT_FALSE(stream.read());
+    stream.readSuffix();
+    ASSERT_COLUMN_EQ(
+        createColumn<Nullable<Decimal128>>(std::make_tuple(23, 4), {"1.0000", "1.5000", "2.0000", "2.0000"}),
+        result.getByName("avg"));
+}
+CATCH
+
+} // namespace tests
+} // namespace DB